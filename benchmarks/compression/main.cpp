@@ -0,0 +1,156 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/network.h>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Measures how many bytes would be put on the wire per frame and how long compressing and
+// decompressing takes for the different zlib compression levels. The payloads mimic what
+// is typically sent through the SharedData (a large block of mostly static state with a
+// few values that change every frame) and through the data transfer (a large blob that is
+// either compressible, like a mesh or a text file, or not, like an already encoded image)
+
+namespace {
+    constexpr int NumberOfFrames = 200;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    double milliseconds(Clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    // ~200 KB of shared state in which 1% of the values change every frame
+    std::vector<std::vector<char>> sharedDataFrames() {
+        constexpr int NumberOfValues = 50000;
+
+        std::vector<float> values(NumberOfValues);
+        for (int i = 0; i < NumberOfValues; i++) {
+            values[i] = static_cast<float>(i % 512) * 0.25f;
+        }
+
+        std::mt19937 gen(1337);
+        std::uniform_int_distribution<int> index(0, NumberOfValues - 1);
+
+        std::vector<std::vector<char>> frames;
+        frames.reserve(NumberOfFrames);
+        for (int frame = 0; frame < NumberOfFrames; frame++) {
+            for (int i = 0; i < NumberOfValues / 100; i++) {
+                values[index(gen)] = std::sin(static_cast<float>(frame + i));
+            }
+
+            std::vector<char> f(values.size() * sizeof(float));
+            std::memcpy(f.data(), values.data(), f.size());
+            frames.push_back(std::move(f));
+        }
+        return frames;
+    }
+
+    // 4 MB of ASCII vertex data such as it would be found in a correction mesh file
+    std::vector<std::vector<char>> textBlob() {
+        std::string text;
+        for (int i = 0; text.size() < 4 * 1024 * 1024; i++) {
+            text += std::format(
+                "{:.4f} {:.4f} {:.4f} {:.4f} 1.0 1.0 1.0\n",
+                (i % 1024) / 1024.f, (i / 1024) / 1024.f,
+                (i % 1024) / 1024.f, (i / 1024) / 1024.f
+            );
+        }
+        return { std::vector<char>(text.begin(), text.end()) };
+    }
+
+    // 4 MB of random bytes which is the worst case for the compression
+    std::vector<std::vector<char>> randomBlob() {
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> byte(0, 255);
+        std::vector<char> blob(4 * 1024 * 1024);
+        for (char& c : blob) {
+            c = static_cast<char>(byte(gen));
+        }
+        return { std::move(blob) };
+    }
+
+    void benchmark(std::string_view name, const std::vector<std::vector<char>>& frames) {
+        size_t rawBytes = 0;
+        for (const std::vector<char>& f : frames) {
+            rawBytes += f.size();
+        }
+        const double nFrames = static_cast<double>(frames.size());
+
+        std::cout << std::format(
+            "{} ({} payloads, {:.1f} KB each)\n",
+            name, frames.size(), rawBytes / nFrames / 1024.0
+        );
+        std::cout << "  level  wire KB/payload  ratio  compress ms  decompress ms\n";
+
+        std::vector<char> compressed;
+        std::vector<char> decompressed;
+        for (int level = 0; level <= 9; level++) {
+            size_t wireBytes = 0;
+            Clock::duration compressTime = Clock::duration::zero();
+            Clock::duration decompressTime = Clock::duration::zero();
+
+            for (const std::vector<char>& f : frames) {
+                const int length = static_cast<int>(f.size());
+
+                const Clock::time_point t0 = Clock::now();
+                const int size =
+                    sgct::Network::compressData(f.data(), length, compressed, level);
+                const Clock::time_point t1 = Clock::now();
+                compressTime += t1 - t0;
+
+                if (size == 0) {
+                    // Sent uncompressed, just as the NetworkManager would do
+                    wireBytes += f.size();
+                    continue;
+                }
+                wireBytes += size;
+
+                decompressed.resize(f.size());
+                const Clock::time_point t2 = Clock::now();
+                sgct::Network::uncompressData(
+                    compressed.data(),
+                    size,
+                    decompressed.data(),
+                    length
+                );
+                decompressTime += Clock::now() - t2;
+
+                if (std::memcmp(decompressed.data(), f.data(), f.size()) != 0) {
+                    std::cerr << "Decompressed data does not match the input\n";
+                    std::exit(EXIT_FAILURE);
+                }
+            }
+
+            std::cout << std::format(
+                "  {:>5}  {:>15.1f}  {:>5.2f}  {:>11.3f}  {:>13.3f}\n",
+                level,
+                wireBytes / nFrames / 1024.0,
+                static_cast<double>(rawBytes) / static_cast<double>(wireBytes),
+                milliseconds(compressTime) / nFrames,
+                milliseconds(decompressTime) / nFrames
+            );
+        }
+        std::cout << '\n';
+    }
+} // namespace
+
+int main() {
+    benchmark("Shared data", sharedDataFrames());
+    benchmark("Data transfer (text)", textBlob());
+    benchmark("Data transfer (random)", randomBlob());
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/image.h>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Measures how fast screenshots are written to disk and how large the files are for each
+// of the capture formats. The test patterns are 4096x4096 RGBA images, which is the size
+// of a typical fisheye frame that is captured during offline rendering. The directory
+// containing the test patterns can be passed as the first argument, the files are
+// written into the temporary directory
+
+namespace {
+    constexpr int NumberOfRepetitions = 5;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    constexpr std::array<std::pair<sgct::Image::Format, std::string_view>, 6> Formats = {
+        std::pair(sgct::Image::Format::Png, "png"),
+        std::pair(sgct::Image::Format::FastPng, "fastpng"),
+        std::pair(sgct::Image::Format::ParallelPng, "parallel"),
+        std::pair(sgct::Image::Format::Tga, "tga"),
+        std::pair(sgct::Image::Format::Raw, "raw"),
+        std::pair(sgct::Image::Format::Qoi, "qoi")
+    };
+
+    void benchmark(const std::filesystem::path& file) {
+        sgct::Image image;
+        image.load(file);
+
+        const sgct::ivec2 size = image.size();
+        const double rawBytes = static_cast<double>(size.x) * size.y *
+            image.channels() * image.bytesPerChannel();
+
+        std::cout << std::format(
+            "{} ({}x{}, {} channels, {:.1f} MB)\n",
+            file.filename().string(), size.x, size.y, image.channels(),
+            rawBytes / (1024.0 * 1024.0)
+        );
+        std::cout << "  format    ms/image     MB/s  file MB  ratio\n";
+
+        for (const auto& [format, name] : Formats) {
+            const std::filesystem::path out =
+                std::filesystem::temp_directory_path() /
+                std::format("sgct-benchmark.{}", sgct::Image::extension(format));
+
+            Clock::duration saveTime = Clock::duration::zero();
+            for (int i = 0; i < NumberOfRepetitions; i++) {
+                const Clock::time_point t0 = Clock::now();
+                image.save(out, format);
+                saveTime += Clock::now() - t0;
+            }
+
+            const double seconds =
+                std::chrono::duration<double>(saveTime).count() / NumberOfRepetitions;
+            const double fileBytes = static_cast<double>(std::filesystem::file_size(out));
+            std::filesystem::remove(out);
+
+            std::cout << std::format(
+                "  {:<8}  {:>8.1f}  {:>7.1f}  {:>7.2f}  {:>5.2f}\n",
+                name,
+                seconds * 1000.0,
+                rawBytes / seconds / (1024.0 * 1024.0),
+                fileBytes / (1024.0 * 1024.0),
+                rawBytes / fileBytes
+            );
+        }
+        std::cout << '\n';
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::filesystem::path folder = argc > 1 ? argv[1] : SGCT_TEST_PATTERN_PATH;
+
+    for (int i = 0; i < 6; i++) {
+        const std::filesystem::path file = folder / std::format("test-pattern-{}.png", i);
+        if (!std::filesystem::exists(file)) {
+            std::cerr << std::format("Could not find test pattern {}\n", file.string());
+            return EXIT_FAILURE;
+        }
+        benchmark(file);
+    }
+    return EXIT_SUCCESS;
+}
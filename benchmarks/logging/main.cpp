@@ -0,0 +1,176 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/log.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Measures how much a log message costs the thread that logs it. A message with a level
+// that is disabled should cost next to nothing, no matter how expensive its arguments are
+// to format. An enabled message is only formatted and copied into the queue by the
+// calling thread, so its latency should not depend on the console or the disk. The
+// enabled messages are measured on a simulated render thread that logs a burst of
+// messages every frame, alone and while other threads are flooding the log, and are
+// compared to formatting and writing each message to a file on the calling thread
+
+namespace {
+    using namespace sgct;
+
+    constexpr int NumberOfDisabledCalls = 10'000'000;
+    constexpr int NumberOfFrames = 2000;
+    constexpr int MessagesPerFrame = 8;
+    constexpr int NumberOfBackgroundThreads = 3;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct Latency {
+        double median = 0.0;
+        double p99 = 0.0;
+        double p999 = 0.0;
+        double max = 0.0;
+    };
+
+    Latency summarize(std::vector<double>& latencies) {
+        std::sort(latencies.begin(), latencies.end());
+        Latency res;
+        res.median = latencies[latencies.size() / 2];
+        res.p99 = latencies[latencies.size() * 99 / 100];
+        res.p999 = latencies[latencies.size() * 999 / 1000];
+        res.max = latencies.back();
+        return res;
+    }
+
+    /// \return The time in nanoseconds that one call of \p function takes on average
+    template <typename F>
+    double measureDisabled(F function) {
+        const Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < NumberOfDisabledCalls; i++) {
+            function(i);
+        }
+        const std::chrono::duration<double, std::nano> d = Clock::now() - t0;
+        return d.count() / NumberOfDisabledCalls;
+    }
+
+    /// \return The latencies in microseconds of the calls to \p function, which are made
+    ///         in bursts of #MessagesPerFrame once per frame
+    template <typename F>
+    Latency measureFrames(F function) {
+        std::vector<double> latencies;
+        latencies.reserve(NumberOfFrames * MessagesPerFrame);
+        for (int frame = 0; frame < NumberOfFrames; frame++) {
+            for (int i = 0; i < MessagesPerFrame; i++) {
+                const Clock::time_point t0 = Clock::now();
+                function(frame, i);
+                const std::chrono::duration<double, std::micro> d = Clock::now() - t0;
+                latencies.push_back(d.count());
+            }
+            // Sleeping for a full frame would make the benchmark take too long, the
+            // writing thread only needs a chance to catch up
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+        return summarize(latencies);
+    }
+
+    void print(std::string_view name, const Latency& l) {
+        std::cout << std::format(
+            "{:<36}  {:>9.2f}  {:>6.2f}  {:>8.2f}  {:>8.1f}\n",
+            name, l.median, l.p99, l.p999, l.max
+        );
+    }
+} // namespace
+
+int main() {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-benchmark.log";
+    std::filesystem::remove(path);
+
+    Log::instance().setLogToConsole(false);
+    Log::instance().setShowTime(true);
+    Log::instance().setLogFile(path);
+
+    //
+    // Disabled messages
+    Log::instance().setNotifyLevel(Log::Level::Info);
+    const std::string name = "Some window name";
+    const double eager = measureDisabled([&name](int i) {
+        Log::Debug(std::format("Frame {} of window '{}' took {:.3f} ms", i, name, 0.5));
+    });
+    const double lazy = measureDisabled([&name](int i) {
+        Log::Debug("Frame {} of window '{}' took {:.3f} ms", i, name, 0.5);
+    });
+    std::cout << "Disabled level                        ns/call\n";
+    std::cout << std::format("{:<36}  {:>7.2f}\n", "Log::Debug(std::format(...))", eager);
+    std::cout << std::format("{:<36}  {:>7.2f}\n\n", "Log::Debug(format, args...)", lazy);
+
+    //
+    // Enabled messages
+    std::cout <<
+        "Enabled level, render thread          median us  p99 us  p99.9 us  max us\n";
+
+    {
+        std::ofstream file(path.string() + ".sync", std::ios::binary);
+        const Latency l = measureFrames([&file, &name](int frame, int i) {
+            file << std::format("(Info) Frame {} message {} of '{}'", frame, i, name)
+                << '\n' << std::flush;
+        });
+        print("Synchronous write to a file", l);
+    }
+    std::filesystem::remove(path.string() + ".sync");
+
+    {
+        const Latency l = measureFrames([&name](int frame, int i) {
+            Log::Info("Frame {} message {} of '{}'", frame, i, name);
+        });
+        print("Queued", l);
+    }
+
+    {
+        std::atomic_bool isRunning = true;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NumberOfBackgroundThreads; t++) {
+            threads.emplace_back([&isRunning, t]() {
+                int i = 0;
+                while (isRunning) {
+                    Log::Info("Background thread {} message {}", t, i++);
+                    if (i % 16 == 0) {
+                        std::this_thread::sleep_for(std::chrono::microseconds(100));
+                    }
+                }
+            });
+        }
+        const Latency l = measureFrames([&name](int frame, int i) {
+            Log::Info("Frame {} message {} of '{}'", frame, i, name);
+        });
+        isRunning = false;
+        for (std::thread& t : threads) {
+            t.join();
+        }
+        print(std::format("Queued, {} threads flooding", NumberOfBackgroundThreads), l);
+    }
+
+    Log::instance().flush();
+    std::cout << std::format(
+        "\nDropped messages: {}\n", Log::instance().nDroppedMessages()
+    );
+
+    Log::destroy();
+    std::filesystem::remove(path);
+    for (int i = 1; i <= Log::DefaultNumberOfBackups; i++) {
+        std::filesystem::remove(path.string() + std::format(".{}", i));
+    }
+    return EXIT_SUCCESS;
+}
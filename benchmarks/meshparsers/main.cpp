@@ -0,0 +1,273 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/log.h>
+#include <sgct/correction/domeprojection.h>
+#include <sgct/correction/obj.h>
+#include <sgct/correction/paulbourke.h>
+#include <sgct/correction/scalable.h>
+#include <sgct/correction/simcad.h>
+#include <sgct/correction/skyskan.h>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+// Measures the throughput of the correction mesh parsers on synthetic meshes with
+// 1000x1000 vertices. Each file is also read by a baseline that splits it with
+// std::getline and converts every number with std::stof from a temporary std::string,
+// which is how the parsers read files before they were moved to the shared text parser.
+// The baseline does not build a mesh, so it is an upper bound for the old parsers
+
+namespace {
+    using namespace sgct;
+    using namespace sgct::correction;
+
+    constexpr int Size = 1000;
+    constexpr int NumberOfRepetitions = 3;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    struct Format {
+        std::string_view name;
+        std::string_view extension;
+        std::function<void(std::ostream&)> write;
+        std::function<size_t(const std::filesystem::path&)> parse;
+    };
+
+    float coord(int i) {
+        return static_cast<float>(i) / (Size - 1);
+    }
+
+    void writeOBJ(std::ostream& s) {
+        for (int y = 0; y < Size; y++) {
+            for (int x = 0; x < Size; x++) {
+                s << std::format("v {} {} 0\n", coord(x), coord(y));
+            }
+        }
+        for (int y = 0; y < Size; y++) {
+            for (int x = 0; x < Size; x++) {
+                s << std::format("vt {} {}\n", coord(x), coord(y));
+            }
+        }
+        for (int y = 0; y < Size - 1; y++) {
+            for (int x = 0; x < Size - 1; x++) {
+                const int i0 = y * Size + x + 1;
+                const int i1 = i0 + 1;
+                const int i2 = i0 + Size + 1;
+                const int i3 = i0 + Size;
+                s << std::format("f {0}/{0} {1}/{1} {2}/{2}\n", i0, i1, i2);
+                s << std::format("f {0}/{0} {1}/{1} {2}/{2}\n", i0, i2, i3);
+            }
+        }
+    }
+
+    void writeScalable(std::ostream& s) {
+        s << std::format(
+            "OPENMESH Version 1.1\nVERTICES {}\nFACES {}\nMAPPING NORMALIZED\n"
+            "NATIVEXRES 1920\nNATIVEYRES 1200\n",
+            Size * Size, (Size - 1) * (Size - 1) * 2
+        );
+        for (int y = 0; y < Size; y++) {
+            for (int x = 0; x < Size; x++) {
+                s << std::format(
+                    "{} {} 255 {} {}\n",
+                    coord(x) * 1920.f, coord(y) * 1200.f, coord(x), coord(y)
+                );
+            }
+        }
+        for (int y = 0; y < Size - 1; y++) {
+            for (int x = 0; x < Size - 1; x++) {
+                const int i0 = y * Size + x;
+                s << std::format("[ {} {} {} ]\n", i0, i0 + 1, i0 + Size + 1);
+                s << std::format("[ {} {} {} ]\n", i0, i0 + Size + 1, i0 + Size);
+            }
+        }
+    }
+
+    void writeDomeProjection(std::ostream& s) {
+        s << "x;y;u;v;column;row\n";
+        for (int y = 0; y < Size; y++) {
+            for (int x = 0; x < Size; x++) {
+                s << std::format(
+                    "{};{};{};{};{};{}\n", coord(x), coord(y), coord(x), coord(y), x, y
+                );
+            }
+        }
+    }
+
+    void writePaulBourke(std::ostream& s) {
+        s << std::format("2\n{} {}\n", Size, Size);
+        for (int y = 0; y < Size; y++) {
+            for (int x = 0; x < Size; x++) {
+                s << std::format(
+                    "{} {} {} {} 1\n",
+                    coord(x) * 2.f - 1.f, coord(y) * 2.f - 1.f, coord(x), coord(y)
+                );
+            }
+        }
+    }
+
+    void writeSkySkan(std::ostream& s) {
+        s << "Dome Azimuth=0\nDome Elevation=30\nHorizontal FOV=90\nVertical FOV=60\n";
+        s << std::format("{} {}\n", Size, Size);
+        for (int y = 0; y < Size; y++) {
+            for (int x = 0; x < Size; x++) {
+                s << std::format("{} {} {} {}\n", coord(x), coord(y), coord(x), coord(y));
+            }
+        }
+    }
+
+    void writeSimCAD(std::ostream& s) {
+        s << "<?xml version=\"1.0\"?>\n<GeometryFile>\n<GeometryDefinition>\n";
+        for (std::string_view axis : { "X", "Y" }) {
+            s << std::format("<{}-FlatParameters range=\"1.0\">", axis);
+            for (int i = 0; i < Size * Size; i++) {
+                s << std::format("{} ", coord(i % Size) * 0.01f);
+            }
+            s << std::format("</{}-FlatParameters>\n", axis);
+        }
+        s << "</GeometryDefinition>\n</GeometryFile>\n";
+    }
+
+    /// \return The number of values that the baseline found in the file at \p path
+    size_t parseLineByLine(const std::filesystem::path& path) {
+        auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+        auto isNumber = [&isDigit](char c) {
+            return isDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e';
+        };
+
+        std::ifstream file = std::ifstream(path);
+        size_t nValues = 0;
+        float sum = 0.f;
+        std::string line;
+        while (std::getline(file, line)) {
+            const std::string_view l = line;
+            size_t i = 0;
+            while (i < l.size()) {
+                // A number starts with a digit or a sign or point followed by a digit
+                const bool isStart = isDigit(l[i]) ||
+                    (isNumber(l[i]) && i + 1 < l.size() && isDigit(l[i + 1]));
+                if (!isStart) {
+                    i++;
+                    continue;
+                }
+                size_t end = i;
+                while (end < l.size() && isNumber(l[end])) {
+                    end++;
+                }
+                sum += std::stof(std::string(l.substr(i, end - i)));
+                nValues++;
+                i = end;
+            }
+        }
+        // Using the sum keeps the conversions from being optimized away
+        return sum == -1.f ? 0 : nValues;
+    }
+
+    /// \return The throughput of \p parse for the file at \p path in MB/s
+    double measure(const std::function<size_t(const std::filesystem::path&)>& parse,
+                   const std::filesystem::path& path)
+    {
+        // Warm up the file cache
+        parse(path);
+
+        const Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < NumberOfRepetitions; i++) {
+            parse(path);
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        const double megabytes =
+            static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+        return megabytes * NumberOfRepetitions / seconds;
+    }
+} // namespace
+
+int main() {
+    Log::instance().setNotifyLevel(Log::Level::Error);
+
+    constexpr vec2 Pos = vec2{ 0.f, 0.f };
+    constexpr vec2 Extent = vec2{ 1.f, 1.f };
+    const std::array<Format, 6> formats = {
+        Format{
+            "OBJ", ".obj", writeOBJ,
+            [](const std::filesystem::path& p) {
+                return generateOBJMesh(p).vertices.size();
+            }
+        },
+        Format{
+            "Scalable", ".ol", writeScalable,
+            [&](const std::filesystem::path& p) {
+                return generateScalableMesh(p, Pos, Extent).vertices.size();
+            }
+        },
+        Format{
+            "DomeProjection", ".csv", writeDomeProjection,
+            [&](const std::filesystem::path& p) {
+                return generateDomeProjectionMesh(p, Pos, Extent).vertices.size();
+            }
+        },
+        Format{
+            "PaulBourke", ".data", writePaulBourke,
+            [&](const std::filesystem::path& p) {
+                return generatePaulBourkeMesh(p, Pos, Extent, 1.f).vertices.size();
+            }
+        },
+        Format{
+            "SkySkan", ".skyskan", writeSkySkan,
+            [&](const std::filesystem::path& p) {
+                return generateSkySkanMesh(p, Pos, Extent).vertices.size();
+            }
+        },
+        Format{
+            "SimCAD", ".simcad", writeSimCAD,
+            [&](const std::filesystem::path& p) {
+                return generateSimCADMesh(p, Pos, Extent).vertices.size();
+            }
+        }
+    };
+
+    std::cout << std::format("{}x{} vertices, throughput in MB/s\n", Size, Size);
+    std::cout << std::format(
+        "  {:<14}  {:>7}  {:>9}  {:>7}  {:>7}\n",
+        "format", "MB", "baseline", "parser", "speedup"
+    );
+
+    const std::filesystem::path dir = std::filesystem::temp_directory_path();
+    for (const Format& format : formats) {
+        std::filesystem::path path = dir / "sgct-benchmark-mesh";
+        path += format.extension;
+        {
+            std::ofstream file = std::ofstream(path, std::ios::binary);
+            format.write(file);
+        }
+
+        try {
+            const double baseline = measure(parseLineByLine, path);
+            const double parser = measure(format.parse, path);
+            const double megabytes =
+                static_cast<double>(std::filesystem::file_size(path)) / (1024.0 * 1024.0);
+            std::cout << std::format(
+                "  {:<14}  {:>7.1f}  {:>9.1f}  {:>7.1f}  {:>6.1f}x\n",
+                format.name, megabytes, baseline, parser, parser / baseline
+            );
+        }
+        catch (const std::exception& e) {
+            std::cout << std::format("  {:<14}  {}\n", format.name, e.what());
+        }
+        std::filesystem::remove(path);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/pixelops.h>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+// Measures the throughput of the pixel conversions for each instruction set that is
+// supported by the CPU. The images are 4096x4096 pixels, the size of a typical fisheye
+// frame, so the numbers include the cost of going to main memory
+
+namespace {
+    using namespace sgct;
+
+    constexpr size_t Size = 4096;
+    constexpr size_t NumberOfPixels = Size * Size;
+    constexpr int NumberOfRepetitions = 20;
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    std::string_view name(pixelops::InstructionSet set) {
+        switch (set) {
+            case pixelops::InstructionSet::Scalar: return "scalar";
+            case pixelops::InstructionSet::SSSE3:  return "ssse3";
+            case pixelops::InstructionSet::AVX2:   return "avx2";
+            default: throw std::logic_error("Unhandled case label");
+        }
+    }
+
+    struct Kernel {
+        std::string_view name;
+        /// The number of bytes that are read and written by one call
+        size_t nBytes = 0;
+        std::function<void()> function;
+    };
+
+    /// \return The throughput of the \p kernel in GB/s
+    double measure(const Kernel& kernel) {
+        // Warm up the caches and fault in the pages
+        kernel.function();
+
+        const Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < NumberOfRepetitions; i++) {
+            kernel.function();
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - t0).count();
+        return kernel.nBytes * static_cast<double>(NumberOfRepetitions) / seconds / 1e9;
+    }
+} // namespace
+
+int main() {
+    std::vector<unsigned char> rgb(NumberOfPixels * 3);
+    std::vector<unsigned char> rgba(NumberOfPixels * 4);
+    std::vector<unsigned char> out(NumberOfPixels * 4);
+    for (size_t i = 0; i < rgba.size(); i++) {
+        rgba[i] = static_cast<unsigned char>(i * 37);
+        if (i < rgb.size()) {
+            rgb[i] = static_cast<unsigned char>(i * 41);
+        }
+    }
+
+    const std::array<Kernel, 7> kernels = {
+        Kernel{
+            "RGB <-> BGR",
+            NumberOfPixels * 6,
+            [&]() { pixelops::swapRedBlue(rgb.data(), out.data(), NumberOfPixels, 3); }
+        },
+        Kernel{
+            "RGBA <-> BGRA",
+            NumberOfPixels * 8,
+            [&]() { pixelops::swapRedBlue(rgba.data(), out.data(), NumberOfPixels, 4); }
+        },
+        Kernel{
+            "RGBA in place",
+            NumberOfPixels * 8,
+            [&]() { pixelops::swapRedBlue(rgba.data(), rgba.data(), NumberOfPixels, 4); }
+        },
+        Kernel{
+            "16 bit swap",
+            NumberOfPixels * 8,
+            [&]() { pixelops::swapBytes16(rgba.data(), out.data(), NumberOfPixels * 2); }
+        },
+        Kernel{
+            "RGB -> RGBA",
+            NumberOfPixels * 7,
+            [&]() {
+                pixelops::expandToFourChannels(rgb.data(), out.data(), NumberOfPixels);
+            }
+        },
+        Kernel{
+            "RGBA -> RGB",
+            NumberOfPixels * 7,
+            [&]() {
+                pixelops::removeFourthChannel(rgba.data(), out.data(), NumberOfPixels);
+            }
+        },
+        Kernel{
+            "flip",
+            NumberOfPixels * 8,
+            [&]() { pixelops::flipVertically(rgba.data(), Size * 4, Size); }
+        }
+    };
+
+    std::vector<pixelops::InstructionSet> sets = { pixelops::InstructionSet::Scalar };
+    if (pixelops::supportedInstructionSet() >= pixelops::InstructionSet::SSSE3) {
+        sets.push_back(pixelops::InstructionSet::SSSE3);
+    }
+    if (pixelops::supportedInstructionSet() >= pixelops::InstructionSet::AVX2) {
+        sets.push_back(pixelops::InstructionSet::AVX2);
+    }
+
+    std::cout << std::format("{}x{} pixels, throughput in GB/s\n", Size, Size);
+    std::cout << std::format("  {:<14}", "kernel");
+    for (pixelops::InstructionSet set : sets) {
+        std::cout << std::format("  {:>7}", name(set));
+    }
+    std::cout << '\n';
+
+    for (const Kernel& kernel : kernels) {
+        std::cout << std::format("  {:<14}", kernel.name);
+        for (pixelops::InstructionSet set : sets) {
+            pixelops::setInstructionSet(set);
+            std::cout << std::format("  {:>7.2f}", measure(kernel));
+        }
+        std::cout << '\n';
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,225 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/log.h>
+#include <sgct/network.h>
+#include <sgct/networkreactor.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <winsock2.h>
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <sys/resource.h>
+#endif // WIN32
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Measures how long it takes from sending a small message until the receiving side of the
+// connection has woken up and decoded it and how much CPU time the process spends doing
+// so. Every simulated client is a pair of loopback sync connections, which are the only
+// connections that the NetworkManager registers with the reactor. The server ends either
+// receive with one thread per connection or through a NetworkReactor. The client ends
+// always use their own threads, so the difference in CPU time between the two modes is
+// caused by the server ends only
+
+namespace {
+    constexpr int NumberOfRounds = 200;
+    constexpr int BasePort = 20450;
+    constexpr std::array<int, 3> NumberOfClients = { 8, 32, 64 };
+
+    using Clock = std::chrono::steady_clock;
+
+    // The CPU time that was used by all threads of this process so far in milliseconds
+    double processCpuTime() {
+#ifdef WIN32
+        FILETIME creation;
+        FILETIME exit;
+        FILETIME kernel;
+        FILETIME user;
+        GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+        auto toMs = [](FILETIME t) {
+            ULARGE_INTEGER v;
+            v.LowPart = t.dwLowDateTime;
+            v.HighPart = t.dwHighDateTime;
+            return static_cast<double>(v.QuadPart) / 10000.0;
+        };
+        return toMs(kernel) + toMs(user);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        auto toMs = [](timeval t) {
+            return static_cast<double>(t.tv_sec) * 1000.0 + t.tv_usec / 1000.0;
+        };
+        return toMs(usage.ru_utime) + toMs(usage.ru_stime);
+#endif // WIN32
+    }
+
+    struct Result {
+        double meanLatency = 0.0;
+        double medianLatency = 0.0;
+        double p99Latency = 0.0;
+        double cpuPerRound = 0.0;
+    };
+
+    Result benchmark(int nClients, bool useReactor) {
+        using namespace sgct;
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        int nReceived = 0;
+        std::vector<double> latencies;
+        latencies.reserve(static_cast<size_t>(nClients) * NumberOfRounds);
+
+        std::unique_ptr<NetworkReactor> reactor;
+        if (useReactor) {
+            reactor = std::make_unique<NetworkReactor>();
+        }
+
+        // The servers have to be listening before the clients try to connect
+        std::vector<std::unique_ptr<Network>> servers;
+        for (int i = 0; i < nClients; i++) {
+            auto s = std::make_unique<Network>(
+                BasePort + i,
+                "127.0.0.1",
+                true,
+                Network::ConnectionType::SyncConnection
+            );
+            s->setReactor(reactor.get());
+            s->setDecodeFunction([&](const char* data, int) {
+                const Clock::time_point received = Clock::now();
+                int64_t sent = 0;
+                std::memcpy(&sent, data, sizeof(sent));
+                const Clock::duration d = received.time_since_epoch() -
+                    Clock::duration(static_cast<Clock::rep>(sent));
+
+                const std::unique_lock lock(mutex);
+                latencies.push_back(std::chrono::duration<double, std::micro>(d).count());
+                nReceived++;
+                cond.notify_one();
+            });
+            s->initialize();
+            servers.push_back(std::move(s));
+        }
+
+        std::vector<std::unique_ptr<Network>> clients;
+        for (int i = 0; i < nClients; i++) {
+            auto c = std::make_unique<Network>(
+                BasePort + i,
+                "127.0.0.1",
+                false,
+                Network::ConnectionType::SyncConnection
+            );
+            c->initialize();
+            clients.push_back(std::move(c));
+        }
+
+        auto allConnected = [](const std::vector<std::unique_ptr<Network>>& ns) {
+            return std::all_of(
+                ns.begin(),
+                ns.end(),
+                [](const std::unique_ptr<Network>& n) { return n->isConnected(); }
+            );
+        };
+        while (!allConnected(servers) || !allConnected(clients)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        // Give both ends time to exchange their capabilities
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        const double cpuBegin = processCpuTime();
+        for (int round = 0; round < NumberOfRounds; round++) {
+            for (const std::unique_ptr<Network>& c : clients) {
+                const int64_t now = Clock::now().time_since_epoch().count();
+                std::array<char, Network::HeaderSize> header = {};
+                header[0] = Network::DataId;
+                const int32_t packageId = round;
+                const uint32_t size = sizeof(now);
+                std::memcpy(header.data() + 1, &packageId, sizeof(packageId));
+                std::memcpy(header.data() + 5, &size, sizeof(size));
+                c->sendData(header.data(), Network::HeaderSize, &now, sizeof(now));
+            }
+
+            {
+                std::unique_lock lock(mutex);
+                cond.wait(lock, [&]() { return nReceived == (round + 1) * nClients; });
+            }
+
+            // Let all threads go back to sleep so that every round measures a wake up
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const double cpuEnd = processCpuTime();
+
+        for (const std::unique_ptr<Network>& c : clients) {
+            c->initShutdown();
+        }
+        for (const std::unique_ptr<Network>& s : servers) {
+            s->initShutdown();
+        }
+        clients.clear();
+        servers.clear();
+        reactor = nullptr;
+
+        std::sort(latencies.begin(), latencies.end());
+        Result res;
+        for (double l : latencies) {
+            res.meanLatency += l;
+        }
+        res.meanLatency /= static_cast<double>(latencies.size());
+        res.medianLatency = latencies[latencies.size() / 2];
+        res.p99Latency = latencies[latencies.size() * 99 / 100];
+        res.cpuPerRound = (cpuEnd - cpuBegin) / NumberOfRounds;
+        return res;
+    }
+} // namespace
+
+int main() {
+#ifdef WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        std::cerr << "Winsock 2.2 startup failed\n";
+        return EXIT_FAILURE;
+    }
+#endif // WIN32
+
+    sgct::Log::instance().setNotifyLevel(sgct::Log::Level::Warning);
+
+    std::cout << "clients  receiver           mean us  median us  p99 us  CPU ms/round\n";
+    for (int nClients : NumberOfClients) {
+        for (bool useReactor : { false, true }) {
+            const Result res = benchmark(nClients, useReactor);
+            std::cout << std::format(
+                "{:>7}  {:<17}  {:>7.1f}  {:>9.1f}  {:>6.1f}  {:>12.3f}\n",
+                nClients,
+                useReactor ? "reactor" : "thread/connection",
+                res.meanLatency,
+                res.medianLatency,
+                res.p99Latency,
+                res.cpuPerRound
+            );
+        }
+    }
+
+#ifdef WIN32
+    WSACleanup();
+#endif // WIN32
+    return EXIT_SUCCESS;
+}
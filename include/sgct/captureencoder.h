@@ -0,0 +1,144 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CAPTUREENCODER__H__
+#define __SGCT__CAPTUREENCODER__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/image.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * A fixed set of long-lived threads that save the screenshots of all windows to disc.
+ * The images are taken from the queue in the order in which they were submitted, but
+ * with more than one thread they might finish saving out of order. If the queue is full,
+ * the Policy determines whether the caller waits, the image is dropped, or the queue
+ * grows beyond its capacity.
+ */
+class SGCT_EXPORT CaptureEncoder {
+public:
+    /// What happens to an image that is submitted while the queue is full
+    enum class Policy {
+        /// The submitting thread waits until one of the queued images has been taken by
+        /// an encoder thread
+        Block,
+        /// The image is not saved
+        Drop,
+        /// The image is queued anyway, so the queue can hold any number of images
+        Grow
+    };
+
+    /// Called with the image after it has been saved or dropped so that its memory can
+    /// be reused for the next screenshot
+    using DoneFunction = std::function<void(std::unique_ptr<Image>)>;
+
+    /// Writes the image to its destination. Called on one of the encoder threads
+    using EncodeFunction = std::function<void(const Image&)>;
+
+    struct Statistics {
+        /// The number of images that are currently waiting to be saved
+        int queueDepth = 0;
+        /// The largest number of images that were waiting at the same time
+        int maxQueueDepth = 0;
+        /// The number of images that have been saved
+        uint64_t nEncoded = 0;
+        /// The number of images that were dropped because the queue was full
+        uint64_t nDropped = 0;
+        /// The time in seconds it took to save the most recent image
+        double lastEncodeTime = 0.0;
+        /// The average time in seconds it took to save an image
+        double averageEncodeTime = 0.0;
+    };
+
+    /**
+     * Starts the encoder threads.
+     *
+     * \param nThreads The number of images that are saved at the same time. The cores
+     *        are split between them, so that an image in the `ParallelPng` format only
+     *        uses its share of the cores
+     * \param capacity The number of images that can wait to be saved before the
+     *        \p policy is applied
+     * \param policy What happens to images that are submitted while the queue is full
+     */
+    CaptureEncoder(int nThreads, int capacity, Policy policy);
+
+    /**
+     * Saves all images that are still queued and stops the encoder threads.
+     */
+    ~CaptureEncoder();
+
+    /**
+     * Queues the \p image to be saved as \p filename in the provided \p format on one of
+     * the encoder threads. The \p done function is called on the encoder thread after
+     * the image has been saved, or on the calling thread if the image was dropped.
+     *
+     * \return `true` if the image was queued, `false` if it was dropped
+     */
+    bool submit(std::string filename, Image::Format format, std::unique_ptr<Image> image,
+        DoneFunction done);
+
+    /**
+     * Queues the \p image to be passed to the \p encode function on one of the encoder
+     * threads, for example to append it to a SequenceWriter. The \p name is only used
+     * for logging. The \p done function is called in the same way as for the other
+     * overload.
+     *
+     * \return `true` if the image was queued, `false` if it was dropped
+     */
+    bool submit(std::string name, EncodeFunction encode, std::unique_ptr<Image> image,
+        DoneFunction done);
+
+    /// \return A snapshot of the current state of the queue and the encoder threads
+    Statistics statistics() const;
+
+private:
+    CaptureEncoder(const CaptureEncoder&) = delete;
+    CaptureEncoder(CaptureEncoder&&) = delete;
+    CaptureEncoder& operator=(const CaptureEncoder&) = delete;
+    CaptureEncoder& operator=(CaptureEncoder&&) = delete;
+
+    struct Job {
+        std::string name;
+        EncodeFunction encode;
+        std::unique_ptr<Image> image;
+        DoneFunction done;
+    };
+
+    void worker();
+
+    const size_t _capacity;
+    const Policy _policy;
+    /// The number of threads that each encoder thread may use to save a single image
+    int _nThreadsPerImage = 1;
+
+    mutable std::mutex _mutex;
+    /// Signalled when a job was queued or when the encoder threads should terminate
+    std::condition_variable _jobCond;
+    /// Signalled when an encoder thread has taken a job from the queue
+    std::condition_variable _spaceCond;
+    std::deque<Job> _jobs;
+    bool _shouldTerminate = false;
+    Statistics _statistics;
+    double _totalEncodeTime = 0.0;
+
+    std::vector<std::thread> _threads;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__CAPTUREENCODER__H__
@@ -22,6 +22,7 @@ struct SGCT_EXPORT Configuration {
     std::optional<std::string> configFilename;
     std::optional<bool> isServer;
     std::optional<Log::Level> logLevel;
+    std::optional<std::filesystem::path> logFile;
     std::optional<bool> showHelpText;
     std::optional<int> nodeId;
     std::optional<bool> firmSync;
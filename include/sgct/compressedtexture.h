@@ -0,0 +1,125 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__COMPRESSEDTEXTURE__H__
+#define __SGCT__COMPRESSEDTEXTURE__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <cstdio>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace sgct {
+
+class Image;
+
+/**
+ * A texture whose pixels are stored in one of the block-compressed formats that the GPU
+ * can sample from directly, together with all of its mipmap levels. These textures are
+ * loaded from and saved to KTX2 and DDS files and can be created from an Image with the
+ * BC1 and BC4 encoders.
+ *
+ * The rows are stored bottom to top, the same as in Image and OpenGL. KTX2 files whose
+ * KTXorientation says that they store the rows top to bottom and all DDS files, which
+ * always store them top to bottom, are flipped while loading and DDS files are flipped
+ * while saving. Flipping is only possible for BC1 and BC4 textures whose heights are
+ * multiples of 4 or smaller than 4, so other textures are loaded and saved as they are
+ * and appear vertically flipped.
+ */
+class SGCT_EXPORT CompressedTexture {
+public:
+    enum class Format {
+        /// 4 bits per pixel for RGB colors
+        BC1,
+        /// 4 bits per pixel for a single channel, for example a blend mask
+        BC4,
+        /// 8 bits per pixel for RGBA colors in higher quality than BC1. Can only be
+        /// loaded, not encoded
+        BC7
+    };
+
+    struct Level {
+        ivec2 size = ivec2{ 0, 0 };
+        /// The offset of the level's blocks from the start of the data
+        size_t offset = 0;
+        /// The number of bytes of the level's blocks
+        size_t nBytes = 0;
+    };
+
+    /// \return The name of the \p format
+    static std::string_view name(Format format);
+
+    /// \return The number of bytes in each 4x4 block of pixels in the \p format
+    static size_t blockSize(Format format);
+
+    /**
+     * \return `true` if the \p filename has an extension for which #load is used instead
+     *         of Image::load, that is `.ktx2` or `.dds`
+     */
+    static bool isCompressedFile(const std::filesystem::path& filename);
+
+    /**
+     * Loads the texture from a KTX2 or DDS file depending on the suffix of the
+     * \p filename. Only 2D textures without supercompression are supported.
+     *
+     * \throw Error If the file cannot be read, uses an unsupported format, or has a
+     *        KTXorientation other than `rd` or `ru`
+     */
+    void load(const std::filesystem::path& filename);
+
+    /**
+     * Saves the texture to a KTX2 or DDS file depending on the suffix of the
+     * \p filename. Files with any other suffix are saved as KTX2.
+     */
+    void save(const std::filesystem::path& filename) const;
+
+    /**
+     * Compresses the \p image into the \p format. The mipmap levels are created by
+     * averaging 2x2 pixels of the previous level.
+     *
+     * \param image The image with 8 or 16 bits per channel. BC4 uses its first channel
+     *        in RGB order
+     * \param format The format, which has to be BC1 or BC4
+     * \param nLevels The number of mipmap levels. 0 creates all levels down to 1x1
+     */
+    void compress(const Image& image, Format format, int nLevels = 0);
+
+    Format format() const;
+
+    /// \return `true` if the colors are sRGB encoded and are converted to linear values
+    ///         when sampling the texture
+    bool isSrgb() const;
+
+    /// \return `true` if the BC1 blocks can contain transparent pixels. BC7 always has an
+    ///         alpha channel and BC4 never has one
+    bool hasAlpha() const;
+
+    ivec2 size() const;
+    const std::vector<Level>& levels() const;
+    const unsigned char* data() const;
+    size_t dataSize() const;
+
+private:
+    void loadKtx2(FILE* file, const std::filesystem::path& filename);
+    void loadDds(FILE* file, const std::filesystem::path& filename);
+    void saveKtx2(FILE* file) const;
+    void saveDds(FILE* file) const;
+    void setLevels(ivec2 size, int nLevels);
+
+    Format _format = Format::BC1;
+    bool _isSrgb = false;
+    bool _hasAlpha = false;
+    std::vector<Level> _levels;
+    std::vector<unsigned char> _data;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__COMPRESSEDTEXTURE__H__
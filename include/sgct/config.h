@@ -21,8 +21,12 @@ namespace sgct::config {
 
 struct SGCT_EXPORT User {
     struct Tracking {
+        enum class Prediction { None, Velocity, Acceleration };
+
         std::string tracker;
         std::string device;
+        std::optional<Prediction> prediction;
+        std::optional<float> latency;
 
         auto operator<=>(const Tracking&) const noexcept = default;
     };
@@ -40,6 +44,9 @@ SGCT_EXPORT void validateUser(const User& user);
 
 
 struct SGCT_EXPORT Capture {
+    enum class Format { Png, FastPng, ParallelPng, Tga, Raw, Qoi };
+    enum class Sequence { Raw, Deflate };
+
     struct ScreenShotRange {
         int first = -1; // inclusive
         int last = -1;  // exclusive
@@ -49,6 +56,8 @@ struct SGCT_EXPORT Capture {
 
     std::optional<std::filesystem::path> path;
     std::optional<ScreenShotRange> range;
+    std::optional<Format> format;
+    std::optional<Sequence> sequence;
 
     auto operator<=>(const Capture&) const noexcept = default;
 };
@@ -77,11 +86,37 @@ struct SGCT_EXPORT Settings {
         auto operator<=>(const Display&) const noexcept = default;
     };
 
+    struct Compression {
+        std::optional<int> level;
+        std::optional<int> threshold;
+
+        auto operator<=>(const Compression&) const noexcept = default;
+    };
+
+    struct DeltaEncoding {
+        std::optional<int> keyframeInterval;
+
+        auto operator<=>(const DeltaEncoding&) const noexcept = default;
+    };
+
+    struct Telemetry {
+        std::optional<std::filesystem::path> path;
+        std::optional<int> capacity;
+        std::optional<float> window;
+
+        auto operator<=>(const Telemetry&) const noexcept = default;
+    };
+
     std::optional<bool> useDepthTexture;
     std::optional<bool> useNormalTexture;
     std::optional<bool> usePositionTexture;
+    std::optional<bool> useMeshCache;
+    std::optional<bool> packCorrectionMeshes;
     std::optional<BufferFloatPrecision> bufferFloatPrecision;
     std::optional<Display> display;
+    std::optional<Compression> compression;
+    std::optional<DeltaEncoding> deltaEncoding;
+    std::optional<Telemetry> telemetry;
 
     auto operator<=>(const Settings&) const noexcept = default;
 };
@@ -299,6 +334,9 @@ struct SGCT_EXPORT Viewport {
     std::optional<std::filesystem::path> blendMaskTexture;
     std::optional<std::filesystem::path> blackLevelMaskTexture;
     std::optional<std::filesystem::path> correctionMeshTexture;
+    /// The largest error in pixels that the simplification of the correction mesh may
+    /// introduce. If it is not set, the correction mesh is not simplified
+    std::optional<float> correctionMeshTolerance;
     std::optional<bool> isTracked;
     std::optional<Eye> eye;
     std::optional<std::string> user;
@@ -441,6 +479,15 @@ struct SGCT_EXPORT Meta {
 
 
 struct SGCT_EXPORT Cluster {
+    struct Multicast {
+        std::string address;
+        int port = 0;
+        std::optional<int> ttl;
+        std::optional<std::string> interfaceAddress;
+
+        auto operator<=>(const Multicast&) const noexcept = default;
+    };
+
     bool success = false;
 
     std::string masterAddress;
@@ -453,6 +500,7 @@ struct SGCT_EXPORT Cluster {
     std::optional<Capture> capture;
     std::vector<Tracker> trackers;
     std::optional<Settings> settings;
+    std::optional<Multicast> multicast;
 
     std::optional<GeneratorVersion> generator;
     std::optional<Meta> meta;
@@ -10,6 +10,8 @@
 #define __SGCT__BUFFER__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <optional>
 #include <vector>
 
 namespace sgct::correction {
@@ -29,9 +31,41 @@ struct SGCT_EXPORT Buffer {
         float a = 0.f;
     };
 
+    /**
+     * The changes to the viewport that some formats store in addition to the geometry.
+     * They are applied by CorrectionMesh::loadMesh, so that they are restored from the
+     * mesh cache as well.
+     */
+    struct View {
+        struct Frustum {
+            /// The field of view in degrees
+            float up = 0.f;
+            float down = 0.f;
+            float left = 0.f;
+            float right = 0.f;
+            quat orientation;
+        };
+
+        std::optional<vec3> userPosition;
+        std::optional<Frustum> frustum;
+        std::optional<vec3> planeOffset;
+    };
+
+    /**
+     * The layout of meshes that are a regular grid of vertices. The first
+     * `nColumns * nRows` vertices are stored row by row, which allows the mesh to be
+     * simplified without searching for neighboring vertices.
+     */
+    struct Grid {
+        unsigned int nColumns = 0;
+        unsigned int nRows = 0;
+    };
+
     std::vector<Vertex> vertices;
     std::vector<unsigned int> indices;
     unsigned int geometryType = 0x0004; // = GL_TRIANGLES
+    View view;
+    std::optional<Grid> grid;
 };
 
 } // namespace sgct::correction
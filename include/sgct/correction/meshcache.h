@@ -0,0 +1,95 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CORRECTION_MESHCACHE__H__
+#define __SGCT__CORRECTION_MESHCACHE__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/mappedfile.h>
+#include <sgct/correction/buffer.h>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+
+namespace sgct::correction {
+
+/**
+ * The mesh cache is stored in the cache directory of the current user, which is
+ * `%LOCALAPPDATA%` on Windows, `~/Library/Caches` on macOS, and `$XDG_CACHE_HOME` or
+ * `~/.cache` otherwise. The directory is only accessible to its owner.
+ *
+ * \return The directory in which the mesh cache files are stored or an empty path if
+ *         the current user has no cache directory, in which case no cache is used
+ */
+SGCT_EXPORT std::filesystem::path meshCacheDirectory();
+
+/**
+ * Computes the key that identifies the cached Buffer for the mesh at \p path. A change
+ * to the contents of the file or to any of the \p parameters results in a new key, so
+ * that the mesh is parsed again.
+ *
+ * \param path The path to the mesh file whose contents are hashed
+ * \param parameters All values besides the file that influence the generated Buffer
+ * \return The key or `std::nullopt` if the file could not be read
+ */
+SGCT_EXPORT std::optional<uint64_t> meshCacheKey(const std::filesystem::path& path,
+    std::span<const float> parameters);
+
+/// \return The path of the cache file for the mesh at \p path with the \p key
+SGCT_EXPORT std::filesystem::path meshCachePath(const std::filesystem::path& path,
+    uint64_t key);
+
+/**
+ * Writes the \p buffer into the cache file at \p cachePath. The file is written under a
+ * temporary name first and then renamed, so that other processes that load the same
+ * mesh never see a partially written file.
+ *
+ * \throw Error If the file could not be written
+ */
+SGCT_EXPORT void saveMeshCache(const std::filesystem::path& cachePath, uint64_t key,
+    const Buffer& buffer);
+
+/**
+ * A Buffer that was loaded from a cache file. The cache files contain the final vertices
+ * and indices of a correction mesh, so that the text formats only have to be parsed
+ * once. The vertices and indices point directly into the mapped file, from where they
+ * are uploaded to the GPU, and are valid for the lifetime of this object.
+ */
+class SGCT_EXPORT CachedMesh {
+public:
+    /**
+     * Maps the cache file at \p cachePath into memory.
+     *
+     * \return The mesh or `nullptr` if the file does not exist, was written for a
+     *         different key or by a different version, or its size does not match the
+     *         number of vertices and indices in its header. The values of the indices
+     *         are not checked
+     */
+    static std::unique_ptr<CachedMesh> open(const std::filesystem::path& cachePath,
+        uint64_t key);
+
+    std::span<const Buffer::Vertex> vertices() const;
+    std::span<const unsigned int> indices() const;
+    unsigned int geometryType() const;
+    const Buffer::View& view() const;
+
+private:
+    explicit CachedMesh(const std::filesystem::path& cachePath);
+
+    MappedFile _file;
+    std::span<const Buffer::Vertex> _vertices;
+    std::span<const unsigned int> _indices;
+    unsigned int _geometryType = 0;
+    Buffer::View _view;
+};
+
+} // namespace sgct::correction
+
+#endif // __SGCT__CORRECTION_MESHCACHE__H__
@@ -0,0 +1,125 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CORRECTION_MESHOPTIMIZER__H__
+#define __SGCT__CORRECTION_MESHOPTIMIZER__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <sgct/correction/buffer.h>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace sgct::correction {
+
+/**
+ * A Buffer::Vertex in 12 instead of 32 bytes. The position is stored as a 16 bit signed
+ * normalized integer, the texture coordinates as 16 bit unsigned normalized integers,
+ * and the color as 8 bit unsigned normalized integers. OpenGL converts them back to
+ * floating point values when the vertices are fetched, so the same shaders are used for
+ * both vertex formats.
+ */
+struct PackedVertex {
+    int16_t x = 0;
+    int16_t y = 0;
+    uint16_t s = 0;
+    uint16_t t = 0;
+    uint8_t r = 0;
+    uint8_t g = 0;
+    uint8_t b = 0;
+    uint8_t a = 0;
+};
+static_assert(sizeof(PackedVertex) == 12);
+
+/**
+ * Converts the \p vertices into the packed format. This only works if all positions are
+ * in [-1, 1] and all texture coordinates and colors in [0, 1], which is the case for
+ * almost all correction meshes. The positions are quantized to 1/32767 of half the
+ * screen and the texture coordinates to 1/65535 of the texture, both far below a pixel.
+ *
+ * \return The packed vertices or `std::nullopt` if any of the values is out of range
+ */
+SGCT_EXPORT std::optional<std::vector<PackedVertex>> packVertices(
+    std::span<const Buffer::Vertex> vertices);
+
+/**
+ * Reorders the triangles in the \p indices so that vertices are reused while they are
+ * still in the post-transform vertex cache of the GPU. This uses the algorithm described
+ * by Tom Forsyth in "Linear-Speed Vertex Cache Optimisation". The winding order of each
+ * triangle is kept.
+ *
+ * \param indices The indices of a triangle list that are reordered in place
+ * \param nVertices The number of vertices that the \p indices refer to
+ * \throw std::out_of_range If any of the \p indices is not smaller than \p nVertices. The
+ *        \p indices are unchanged in that case
+ */
+SGCT_EXPORT void optimizeVertexCache(std::span<unsigned int> indices, size_t nVertices);
+
+/**
+ * Simulates a first-in-first-out vertex cache with \p cacheSize entries and returns the
+ * average number of vertices that have to be fetched and transformed per triangle. This
+ * is 3 for a mesh without any reuse and approaches 0.5 for a perfectly ordered regular
+ * grid.
+ *
+ * \param indices The indices of a triangle list
+ * \param cacheSize The number of vertices that are kept in the cache
+ */
+SGCT_EXPORT float averageCacheMissRatio(std::span<const unsigned int> indices,
+    int cacheSize = 32);
+
+/**
+ * The largest difference that simplifyGrid may introduce between the original vertices
+ * and the simplified mesh at their grid position. All values are in the units of the
+ * Buffer::Vertex, so the position is in normalized device coordinates.
+ */
+struct SimplificationTolerance {
+    vec2 position = vec2{ 0.f, 0.f };
+    vec2 textureCoordinate = vec2{ 0.f, 0.f };
+    float color = 0.f;
+};
+
+/**
+ * The result of simplifyGrid. The errors are the largest differences that were measured
+ * between any of the original vertices and the simplified mesh and are never larger than
+ * the SimplificationTolerance that was requested.
+ */
+struct SimplificationReport {
+    size_t nVerticesBefore = 0;
+    size_t nVerticesAfter = 0;
+    size_t nTrianglesBefore = 0;
+    size_t nTrianglesAfter = 0;
+
+    vec2 positionError = vec2{ 0.f, 0.f };
+    vec2 textureCoordinateError = vec2{ 0.f, 0.f };
+    float colorError = 0.f;
+};
+
+/**
+ * Replaces regions of the Buffer::grid in which the vertices can be interpolated within
+ * the \p tolerance by larger triangles. The grid is subdivided as a quadtree and each
+ * leaf is drawn as a fan around its center vertex that includes all vertices on its
+ * border that are used by neighboring leaves, so the simplified mesh has no cracks. Every
+ * original vertex is compared against the simplified mesh and leaves that exceed the
+ * tolerance are subdivided further, so the limits hold for all vertices and not only for
+ * an estimate. Grid cells that are not covered by exactly two triangles, for example the
+ * holes of a SkySkan mesh, are kept as they are.
+ *
+ * Afterwards the \p buffer contains an indexed triangle list of the vertices that are
+ * still used and no longer has a grid.
+ *
+ * \return The vertex and triangle counts and the errors of the simplification, or
+ *         `std::nullopt` if the \p buffer does not have a grid
+ */
+SGCT_EXPORT std::optional<SimplificationReport> simplifyGrid(Buffer& buffer,
+    const SimplificationTolerance& tolerance);
+
+} // namespace sgct::correction
+
+#endif // __SGCT__CORRECTION_MESHOPTIMIZER__H__
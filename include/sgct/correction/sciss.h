@@ -18,7 +18,7 @@ namespace sgct { class BaseViewport; }
 namespace sgct::correction {
 
 SGCT_EXPORT Buffer generateScissMesh(const std::filesystem::path& path,
-    BaseViewport& parent);
+    const BaseViewport& parent);
 
 } // namespace sgct::correction
 
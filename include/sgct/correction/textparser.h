@@ -0,0 +1,138 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__CORRECTION_TEXTPARSER__H__
+#define __SGCT__CORRECTION_TEXTPARSER__H__
+
+#include <sgct/sgctexports.h>
+#include <algorithm>
+#include <exception>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/*
+ * The functions in this file are shared by the parsers of the text-based mesh formats.
+ * The files are mapped into memory (see MappedFile) and parsed in place, so no line or
+ * number is copied into a temporary string. All functions that parse a value remove it
+ * from the beginning of the std::string_view they are passed.
+ */
+
+namespace sgct::correction {
+
+/**
+ * Removes the first line from the \p text and returns it without its line ending. Both
+ * `\n` and `\r\n` line endings are supported.
+ */
+SGCT_EXPORT std::string_view nextLine(std::string_view& text);
+
+/// Removes the spaces and tabs at the beginning of the \p text
+SGCT_EXPORT void skipSpaces(std::string_view& text);
+
+/**
+ * Removes the word at the beginning of the \p text, after skipping spaces, and returns
+ * it. A word ends at the next space or tab.
+ */
+SGCT_EXPORT std::string_view parseWord(std::string_view& text);
+
+/**
+ * Removes the character \p c from the beginning of the \p text, after skipping spaces.
+ *
+ * \return `true` if the \p text started with \p c
+ */
+SGCT_EXPORT bool parseCharacter(std::string_view& text, char c);
+
+/**
+ * Parses the number at the beginning of the \p text, after skipping spaces, and removes
+ * it from the \p text. Numbers can start with a `+` sign, as is accepted by `std::stof`.
+ *
+ * \return `true` if a number was parsed into \p value
+ */
+SGCT_EXPORT bool parseNumber(std::string_view& text, float& value);
+SGCT_EXPORT bool parseNumber(std::string_view& text, int& value);
+SGCT_EXPORT bool parseNumber(std::string_view& text, unsigned int& value);
+
+/**
+ * \return `true` if the \p line starts with a number after skipping spaces, which is how
+ *         vertex lines are told apart from keywords in most formats
+ */
+SGCT_EXPORT bool startsWithNumber(std::string_view line);
+
+/**
+ * Splits the \p text into chunks at line boundaries and calls \p parse for each chunk
+ * on its own thread. Files that are too small to benefit are parsed as a single chunk
+ * on the calling thread. If \p parse throws for any of the chunks, the first exception
+ * is rethrown after all threads have finished.
+ *
+ * \param text The text that is split into chunks
+ * \param parse The function that is called with each chunk and returns its result
+ * \return The results of all chunks in the order in which they appear in the \p text
+ */
+template <typename F>
+auto parseInParallel(std::string_view text, F parse)
+    -> std::vector<std::invoke_result_t<F, std::string_view>>
+{
+    // Chunks below this size finish faster than a thread is started
+    constexpr size_t MinimumChunkSize = 256 * 1024;
+
+    const size_t nThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    const size_t nChunks = std::clamp<size_t>(
+        text.size() / MinimumChunkSize,
+        1,
+        nThreads
+    );
+
+    std::vector<std::string_view> chunks;
+    chunks.reserve(nChunks);
+    size_t begin = 0;
+    for (size_t i = 1; i <= nChunks && begin < text.size(); i++) {
+        size_t end = text.size();
+        if (i < nChunks) {
+            end = text.find('\n', std::max(begin, i * text.size() / nChunks));
+            end = end == std::string_view::npos ? text.size() : end + 1;
+        }
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    if (chunks.empty()) {
+        chunks.push_back(text);
+    }
+
+    std::vector<std::invoke_result_t<F, std::string_view>> results(chunks.size());
+    std::vector<std::exception_ptr> exceptions(chunks.size());
+    auto parseChunk = [&](size_t i) {
+        try {
+            results[i] = parse(chunks[i]);
+        }
+        catch (...) {
+            exceptions[i] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunks.size() - 1);
+    for (size_t i = 1; i < chunks.size(); i++) {
+        threads.emplace_back(parseChunk, i);
+    }
+    parseChunk(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (const std::exception_ptr& e : exceptions) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+    return results;
+}
+
+} // namespace sgct::correction
+
+#endif // __SGCT__CORRECTION_TEXTPARSER__H__
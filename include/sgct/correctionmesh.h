@@ -10,16 +10,16 @@
 #define __SGCT__CORRECTION_MESH__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/correction/buffer.h>
 #include <filesystem>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace sgct {
 
 class BaseViewport;
 
-namespace correction { struct Buffer; }
-
 /**
  * Helper class for reading and rendering a correction mesh. A correction mesh is used for
  * warping and edge-blending.
@@ -27,17 +27,28 @@ namespace correction { struct Buffer; }
 class SGCT_EXPORT CorrectionMesh {
 public:
     /**
-     * This function finds a suitable parser for warping meshes and loads them.
+     * This function finds a suitable parser for warping meshes and loads them. The
+     * parsed mesh is stored in the mesh cache (see correction::CachedMesh) and later
+     * calls with the same file and viewport load it from there instead, unless the
+     * cache is disabled with Engine::Settings::useMeshCache or there is no cache
+     * directory for the current user. A cache file whose indices do not fit its
+     * vertices is ignored and replaced.
      *
      * \param path The path to the mesh data
      * \param parent The pointer to parent viewport
      * \param needsMaskGeometry If `true`, a separate geometry to applying blend masks is
      *        loaded
+     * \param textureRenderMode If `true`, the mesh is used for a TextureMappedProjection
+     * \param tolerance The largest error in pixels that the simplification of meshes
+     *        with a regular grid may introduce in the positions and texture coordinates
+     *        (see correction::simplifyGrid). The blend colors always stay within half a
+     *        step of an 8 bit color. If it is `std::nullopt`, the mesh is not simplified
      *
      * \throw std::runtime_error if mesh was not loaded successfully
      */
     void loadMesh(const std::filesystem::path& path, BaseViewport& parent,
-        bool needsMaskGeometry = false, bool textureRenderMode = false);
+        bool needsMaskGeometry = false, bool textureRenderMode = false,
+        std::optional<float> tolerance = std::nullopt);
 
     /**
      * Render the final mesh where for mapping the frame buffer to the screen.
@@ -55,8 +66,16 @@ public:
     void renderMaskMesh() const;
 
 private:
+    /**
+     * The geometry is uploaded as correction::PackedVertex and with 16 bit indices
+     * whenever the mesh allows it, which reduces the memory that is read for every frame
+     * to less than half. The packed vertices can be disabled with
+     * Engine::Settings::packCorrectionMeshes.
+     */
     struct CorrectionMeshGeometry {
         CorrectionMeshGeometry(const correction::Buffer& buffer);
+        CorrectionMeshGeometry(std::span<const correction::Buffer::Vertex> vertices,
+            std::span<const unsigned int> indices, unsigned int geometryType);
         CorrectionMeshGeometry(CorrectionMeshGeometry&&) noexcept;
         ~CorrectionMeshGeometry();
 
@@ -70,6 +89,9 @@ private:
         unsigned int nVertices = 0;
         unsigned int nIndices = 0;
         unsigned int type = 0x0005; // = GL_TRIANGLE_STRIP;
+        unsigned int indexType = 0x1405; // = GL_UNSIGNED_INT
+        /// The number of bytes of the vertex and index buffers on the GPU
+        size_t nBytes = 0;
     };
 
     std::optional<CorrectionMeshGeometry> _quadGeometry;
@@ -12,18 +12,25 @@
 #include <sgct/sgctexports.h>
 #include <sgct/actions.h>
 #include <sgct/callbackdata.h>
+#include <sgct/captureencoder.h>
 #include <sgct/config.h>
 #include <sgct/definitions.h>
+#include <sgct/frametelemetry.h>
+#include <sgct/gputimer.h>
+#include <sgct/image.h>
 #include <sgct/joystick.h>
 #include <sgct/keys.h>
 #include <sgct/modifiers.h>
 #include <sgct/mouse.h>
+#include <sgct/sequencefile.h>
 #include <sgct/window.h>
 #include <array>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <thread>
+#include <vector>
 
 namespace sgct {
 
@@ -79,9 +86,18 @@ public:
         /// The times that contain the entire time spending processing the frames
         std::array<double, HistoryLength> frametimes = {};
 
-        /// The amount of time spend rendering the 2D and 3D components of the frame
+        /// The amount of time the GPU spent rendering the 2D and 3D components of the
+        /// frame. The values are measured without waiting for the GPU, so they are added
+        /// GpuTimer::Latency frames after the frame they belong to
         std::array<double, HistoryLength> drawTimes = {};
 
+        /// The time that the GPU spent on the sections of the most recent frame that
+        /// could be read back, such as the windows, viewports, cube map faces, the
+        /// warping and blending, and FXAA. The zones of the shared context come first,
+        /// followed by the zones of each window. They are only measured while the
+        /// statistics are rendered
+        std::vector<GpuTimer::Zone> gpuZones;
+
         /// The amount of time spend synchronizing the state between master and clients
         std::array<double, HistoryLength> syncTimes = {};
 
@@ -91,6 +107,53 @@ public:
         /// The highest time recorded for network communication between master and clients
         std::array<double, HistoryLength> loopTimeMax = {};
 
+        /// The times that a client reported for its most recent complete frame
+        struct NodeTiming {
+            /// The index of the client in the cluster configuration
+            int nodeIndex = -1;
+
+            /// The frame number of the client that the times belong to
+            unsigned int frameNumber = 0;
+
+            /// The time in seconds the client spent drawing, without the GPU time
+            double drawTime = 0.0;
+
+            /// The time in seconds the client waited for the frame lock
+            double syncTime = 0.0;
+
+            /// The time in seconds it took the client to swap its buffers
+            double swapTime = 0.0;
+
+            /// The total number of dropped frames on the client, see #nDroppedFrames
+            uint64_t nDroppedFrames = 0;
+        };
+
+        /// The times that the clients sent along with their acknowledgement of the last
+        /// frame, sorted by the index of the node. This vector is empty on clients and
+        /// only contains the clients that have sent their times
+        std::vector<NodeTiming> nodeTimings;
+
+        /// The number of frames on this node that took more than 1.5 times as long as
+        /// the median frame over the window of the FrameTelemetry
+        uint64_t nDroppedFrames = 0;
+
+        /// The time it took the master to send the sync data to each client in the last
+        /// frame. The index corresponds to the sync connection and clients that were not
+        /// sent any data have a value of 0. This vector is empty on clients
+        std::vector<double> syncSendTimes;
+
+        /// The number of screenshots that were waiting to be saved at the end of each
+        /// frame
+        std::array<double, HistoryLength> captureQueueDepths = {};
+
+        /// The time in seconds it took to save the most recently finished screenshot
+        std::array<double, HistoryLength> captureEncodeTimes = {};
+
+        /// The total number of screenshots that were not saved because too many of them
+        /// were waiting already. Screenshots are only dropped with the
+        /// CaptureEncoder::Policy::Drop policy
+        uint64_t nDroppedCaptures = 0;
+
         /**
          * \return The frame time (delta time) in seconds
          */
@@ -138,6 +201,15 @@ public:
         bool useNormalTexture = false;
         bool usePositionTexture = false;
 
+        /// If this is true, parsed correction meshes are stored in a per-user cache
+        /// directory and loaded from there on the next start if the mesh has not changed
+        bool useMeshCache = true;
+
+        /// If this is true, the vertices of correction meshes are stored on the GPU as
+        /// normalized 16 and 8 bit integers instead of floating point values whenever
+        /// all of their values are in range, which reduces their precision
+        bool packCorrectionMeshes = true;
+
         /// The number of seconds that SGCT will wait for the master or clients to connect
         /// before aborting
         float syncTimeout = 60.f;
@@ -149,6 +221,22 @@ public:
             // The number of capture threads
             int nCaptureThreads = std::max(std::thread::hardware_concurrency() / 2, 1u);
 
+            /// The number of screenshots that can wait to be saved before the
+            /// `queuePolicy` is applied
+            int queueSize = 8;
+
+            /// What happens when a screenshot is taken while `queueSize` screenshots are
+            /// already waiting to be saved
+            CaptureEncoder::Policy queuePolicy = CaptureEncoder::Policy::Block;
+
+            /// The file format in which the screenshots are saved
+            Image::Format format = Image::Format::Png;
+
+            /// If this value is set, the screenshots of each window and eye are appended
+            /// to a single sequence file with this compression instead of being saved as
+            /// separate files in the `format`
+            std::optional<SequenceWriter::Compression> sequence;
+
             /// If set to true, the node name is added to screenshots
             bool addNodeName = false;
 
@@ -228,6 +316,22 @@ public:
         /// This function is called when data is successfully sent.
         void (*dataTransferAcknowledge)(int, int) = nullptr;
 
+        /// This function is called for every chunk of a streamed data transfer that is
+        /// received with the chunk, its length, its offset in the stream, the total size
+        /// of the stream, the package id, and the client index. If it is not set, the
+        /// stream is assembled in memory and passed to dataTransferDecode instead.
+        void (*dataTransferChunk)(const char*, int, int64_t, int64_t, int, int) = nullptr;
+
+        /// This function is called when a streamed data transfer starts with the package
+        /// id and the total size. It returns the number of bytes of the stream that are
+        /// already available, for example from an earlier transfer that was interrupted.
+        int64_t (*dataTransferResume)(int, int64_t) = nullptr;
+
+        /// This function is called on the sender when a receiver has acknowledged more of
+        /// a streamed data transfer with the package id, the number of acknowledged
+        /// bytes, the total size, and the client index.
+        void (*dataTransferProgress)(int, int64_t, int64_t, int) = nullptr;
+
         /// This function sets the keyboard callback (GLFW wrapper) for all windows.
         void (*keyboard)(Key, Modifier, Action, int, Window*) = nullptr;
 
@@ -308,6 +412,19 @@ public:
      */
     const Statistics& statistics() const;
 
+    /**
+     * Returns the encoder that saves the screenshots of all windows. The reference is
+     * valid until the Engine::destroy function is called.
+     */
+    CaptureEncoder& captureEncoder();
+
+    /**
+     * Returns the durations of the phases of the frames on this node over a longer time
+     * than the Statistics. Unlike the Statistics, these are always collected. The
+     * reference is valid until the Engine::destroy function is called.
+     */
+    const FrameTelemetry& telemetry() const;
+
     /**
      * Returns the distance to the near clipping plane in meters.
      *
@@ -475,6 +592,12 @@ public:
 
     StatisticsRenderer* statisticsRenderer();
 
+    /**
+     * \return The timer that measures the GPU time of the rendering that is done in the
+     *         shared OpenGL context. It only records while the statistics are rendered
+     */
+    GpuTimer& gpuTimer();
+
     const Settings& settings() const;
 
 private:
@@ -531,6 +654,19 @@ private:
      */
     void frameLockPostStage();
 
+    /**
+     * Copies the GPU zones of the shared context and all windows into the Statistics and
+     * adds the duration of the whole frame to the draw times.
+     */
+    void collectGpuZones();
+
+    /**
+     * Counts the \p sample as dropped frame if necessary. On the master, the timing of
+     * the clients is copied into the Statistics, while the clients pass the timing of
+     * the \p sample to the network to append it to the next acknowledgement.
+     */
+    void updateNodeTiming(const FrameTelemetry::Sample& sample);
+
     /**
      * This function waits for all windows to be created on the whole cluster in order to
      * set the barrier (hardware swap-lock). Under some Nvidia drivers the stability is
@@ -577,10 +713,23 @@ private:
     /// Stores the previous frametime so that a delta frametime can be calculated
     double _statsPrevTimestamp = 0.0;
 
+    /// The median frame time that is used to detect dropped frames. It is only updated
+    /// occasionally as it is computed from the whole FrameTelemetry window
+    double _medianFrameTime = 0.0;
+
     /// The class that renders the on-screen representation of the Statistics data. If
     /// this pointer is `nullptr` then no rendering is performed
     std::unique_ptr<StatisticsRenderer> _statisticsRenderer;
 
+    /// Measures the GPU time of the frame in the shared OpenGL context
+    GpuTimer _gpuTimer;
+
+    /// The threads that save the screenshots of all windows
+    std::unique_ptr<CaptureEncoder> _captureEncoder;
+
+    /// Collects the durations of the phases of every frame
+    std::unique_ptr<FrameTelemetry> _telemetry;
+
     /// Whether SGCT should take a screenshot in the next frame
     bool _shouldTakeScreenshot = false;
 
@@ -593,8 +742,6 @@ private:
 
     Settings _settings;
 
-    std::unique_ptr<std::thread> _thread;
-
     unsigned int _frameCounter = 0;
     unsigned int _shotCounter = 0;
 };
@@ -0,0 +1,179 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__FRAMETELEMETRY__H__
+#define __SGCT__FRAMETELEMETRY__H__
+
+#include <sgct/sgctexports.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Collects the CPU time that each phase of every frame takes and provides percentiles of
+ * these times over a rolling window of time. The window is divided into #NumberOfSlices
+ * slices and each slice keeps a histogram with logarithmically spaced buckets per phase,
+ * so the memory use does not depend on the length of the window or the frame rate. The
+ * percentiles are accurate to about 3% of their value.
+ *
+ * The samples have to be added from a single thread, but the percentiles can be read
+ * from any thread at any time. All counters are atomic values that are only written by
+ * that thread, so adding a sample never waits for a lock or for a reader. A reader that
+ * runs while a slice is recycled ignores that slice.
+ *
+ * Optionally, all samples are also recorded into a ring file that always contains the
+ * most recent samples. The file is written by a separate thread that receives the
+ * samples through a lock-free queue. The file has a fixed size and can be left recording
+ * indefinitely. All values are stored in little endian.
+ *
+ *   Header:  "SGCTTEL\0" (8 bytes), version (uint32), number of phases (uint32),
+ *            record size (uint32), node index (uint32), capacity (uint64),
+ *            number of records written (uint64)
+ *   Records: frame number (uint64), timestamp (float64), the duration of each phase
+ *            (float32 each)
+ *
+ * The timestamps are the seconds since the Unix epoch at the beginning of the frame and
+ * the durations are in seconds in the order of the Phase enum. Record `i` is stored at
+ * the offset `header size + (i % capacity) * record size`, so once more than `capacity`
+ * records have been written, the oldest record is the one following the newest. The
+ * number of records in the header is updated after the records have been flushed, so it
+ * never counts a record that was not written completely.
+ */
+class SGCT_EXPORT FrameTelemetry {
+public:
+    /// The parts of a frame whose durations are measured
+    enum class Phase {
+        /// The preSync callback
+        PreSync = 0,
+        /// Encoding the shared data on the master
+        Encode,
+        /// Waiting for the other nodes in the frame lock before and after drawing
+        NetworkWait,
+        /// Drawing all windows, which does not include the time the GPU takes
+        Draw,
+        /// The postDraw callback
+        PostDraw,
+        /// Swapping the buffers of all windows
+        Swap,
+        /// The entire frame from the beginning of one frame to the next
+        Frame
+    };
+    static constexpr int NumberOfPhases = 7;
+
+    /// The number of slices that make up the window of the percentiles
+    static constexpr int NumberOfSlices = 10;
+
+    /// The measured durations of a single frame
+    struct Sample {
+        uint64_t frameNumber = 0;
+
+        /// The time in seconds since the Unix epoch at which the frame started
+        double timestamp = 0.0;
+
+        /// The duration of each phase in seconds, indexed by the Phase
+        std::array<double, NumberOfPhases> durations = {};
+    };
+
+    /// The distribution of the durations of one phase within the window
+    struct Percentiles {
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+
+        /// The number of frames that the percentiles are based on
+        uint64_t nFrames = 0;
+    };
+
+    /// The contents of a telemetry ring file
+    struct Recording {
+        uint32_t nodeIndex = 0;
+
+        /// The samples in the file, oldest first
+        std::vector<Sample> samples;
+    };
+
+    /**
+     * \param window The length of the rolling window in seconds over which the
+     *        percentiles are computed
+     */
+    explicit FrameTelemetry(double window = 60.0);
+
+    /**
+     * Stops the recording after all samples have been written to the file.
+     */
+    ~FrameTelemetry();
+
+    /**
+     * Starts recording all samples that are added from now on into a ring file at
+     * \p path, overwriting an existing file. This function must not be called while
+     * samples are added from another thread.
+     *
+     * \param path The path to the ring file
+     * \param capacity The number of samples that the ring file keeps
+     * \param nodeIndex The index of the node in the cluster, which is stored in the
+     *        header of the file
+     * \throw Error If the file could not be created
+     */
+    void startRecording(const std::filesystem::path& path, uint64_t capacity,
+        uint32_t nodeIndex);
+
+    /**
+     * Adds the durations of a frame. The samples have to be added in the order of their
+     * timestamps and always from the same thread.
+     */
+    void add(const Sample& sample);
+
+    /**
+     * Computes the percentiles of the durations of the \p phase during the window that
+     * ends with the most recently added sample. This function can be called from any
+     * thread.
+     */
+    Percentiles percentiles(Phase phase) const;
+
+    /// \return The number of samples that were not recorded into the ring file because
+    ///         the thread writing the file fell behind
+    uint64_t nDroppedSamples() const;
+
+    /// \return A human-readable name of the \p phase
+    static std::string_view name(Phase phase);
+
+    /**
+     * Reads all samples that are stored in a ring file written by a FrameTelemetry.
+     *
+     * \throw Error If the file could not be read or is not a telemetry file
+     */
+    static Recording readRecording(const std::filesystem::path& path);
+
+private:
+    FrameTelemetry(const FrameTelemetry&) = delete;
+    FrameTelemetry(FrameTelemetry&&) = delete;
+    FrameTelemetry& operator=(const FrameTelemetry&) = delete;
+    FrameTelemetry& operator=(FrameTelemetry&&) = delete;
+
+    struct Slice;
+    class Recorder;
+
+    const double _sliceLength;
+    std::unique_ptr<Slice[]> _slices;
+
+    /// The index of the slice, counted from the Unix epoch, of the newest sample
+    std::atomic<int64_t> _currentSlice = -1;
+
+    std::unique_ptr<Recorder> _recorder;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__FRAMETELEMETRY__H__
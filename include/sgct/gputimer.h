@@ -0,0 +1,149 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__GPUTIMER__H__
+#define __SGCT__GPUTIMER__H__
+
+#include <sgct/sgctexports.h>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Measures how long the GPU takes for named sections (zones) of a frame using pairs of
+ * timestamp queries. The queries of a frame are only read back when their slot in the
+ * ring of #Latency frames is reused, by which time the GPU has almost always finished
+ * them, so the CPU never waits for the GPU. If the results are not available yet, that
+ * frame is skipped instead of waiting for it.
+ *
+ * Query objects are not shared between OpenGL contexts, so each context that is
+ * measured needs its own GpuTimer and all functions have to be called while that context
+ * is current. The queries are created the first time they are needed.
+ */
+class SGCT_EXPORT GpuTimer {
+public:
+    /// The number of frames after which the results of a frame are read back
+    static constexpr int Latency = 4;
+
+    /// The measured duration of one of the zones of a frame
+    struct Zone {
+        std::string name;
+
+        /// The number of zones that this zone is nested in
+        int depth = 0;
+
+        /// The time in seconds the GPU took from the beginning to the end of the zone
+        double duration = 0.0;
+    };
+
+    /**
+     * Measures the zone from the construction to the destruction of this object if the
+     * timer is recording.
+     */
+    class SGCT_EXPORT Scope {
+    public:
+        /**
+         * \param timer The timer that records the zone
+         * \param name The name of the zone, which has to outlive the timer
+         * \param index If this is not negative, it is appended to the name of the zone
+         */
+        Scope(GpuTimer& timer, const char* name, int index = -1);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        GpuTimer& _timer;
+    };
+
+    GpuTimer() = default;
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    /**
+     * Starts recording a new frame. The results of the frame that was recorded #Latency
+     * frames earlier are read back first if the GPU has finished it.
+     *
+     * \return `true` if the results of an earlier frame were read and #zones has changed
+     */
+    bool beginFrame();
+
+    /**
+     * Stops recording the current frame. All zones have to be closed at this point.
+     */
+    void endFrame();
+
+    /// \return `true` between #beginFrame and #endFrame
+    bool isRecording() const;
+
+    /**
+     * Starts a new zone that is nested in all zones that are currently open. Nothing
+     * happens if the timer is not recording.
+     *
+     * \param name The name of the zone, which has to outlive the timer
+     * \param index If this is not negative, it is appended to the name of the zone
+     */
+    void begin(const char* name, int index = -1);
+
+    /**
+     * Ends the zone that was started last. Nothing happens if the timer is not
+     * recording.
+     */
+    void end();
+
+    /**
+     * \return The zones of the most recent frame that was read back in the order in which
+     *         they were started
+     */
+    const std::vector<Zone>& zones() const;
+
+    /// \return The number of frames whose results were not available when their slot was
+    ///         reused
+    uint64_t nSkippedFrames() const;
+
+    /**
+     * Deletes the query objects. This has to be called before the OpenGL context of this
+     * timer is destroyed.
+     */
+    void deleteQueries();
+
+private:
+    struct Query {
+        const char* name = nullptr;
+        int index = -1;
+        int depth = 0;
+        unsigned int begin = 0;
+        unsigned int end = 0;
+    };
+
+    struct Frame {
+        /// The query objects are kept when the slot is reused, only nQueries are in use
+        std::vector<Query> queries;
+        size_t nQueries = 0;
+        /// The query that was issued last, which finishes after all others
+        unsigned int lastQuery = 0;
+    };
+
+    std::array<Frame, Latency> _frames;
+    int _currentFrame = 0;
+    bool _isRecording = false;
+
+    /// The indices of the queries in the current frame whose zones are still open
+    std::vector<size_t> _openZones;
+
+    std::vector<Zone> _zones;
+    uint64_t _nSkippedFrames = 0;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__GPUTIMER__H__
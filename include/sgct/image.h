@@ -12,11 +12,39 @@
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
 #include <filesystem>
+#include <string_view>
 
 namespace sgct {
 
 class SGCT_EXPORT Image {
 public:
+    /// The file formats in which an image can be saved
+    enum class Format {
+        /// PNG with zlib's default compression level
+        Png,
+        /// PNG with the fastest compression level and a run-length encoding strategy. The
+        /// files are larger than with `Png`, but they are written several times faster
+        FastPng,
+        /// PNG with zlib's default compression level whose rows are split into stripes
+        /// that are compressed on multiple threads at the same time. The files are
+        /// slightly larger than with `Png`
+        ParallelPng,
+        /// Uncompressed TGA. Only supports 8 bit images with 1, 3, or 4 channels
+        Tga,
+        /// The pixel data without any header, exactly as it is stored in memory, that is
+        /// with the rows stored bottom to top and the color channels in BGR(A) order
+        Raw,
+        /// The lossless "Quite OK Image" format. Only supports 8 bit images with 3 or 4
+        /// channels
+        Qoi
+    };
+
+    /**
+     * \return The file extension, without the leading period, that is used for images
+     *         saved in the provided \p format
+     */
+    static std::string_view extension(Format format);
+
     Image() = default;
     ~Image();
 
@@ -25,9 +53,23 @@ public:
     void load(unsigned char* data, int length);
 
     /**
-     * Save the buffer to file. Type is automatically set by filename suffix.
+     * Save the buffer to file. Type is automatically set by filename suffix, files with
+     * an unknown suffix are saved as PNG.
+     */
+    void save(const std::filesystem::path& filename) const;
+
+    /**
+     * Save the buffer to file in the provided \p format regardless of the suffix of the
+     * \p filename.
+     *
+     * \param filename The file to which the image is written
+     * \param format The format in which the image is written
+     * \param nThreads The largest number of threads, including the calling thread, on
+     *        which an image in the `ParallelPng` format is compressed. If it is `0`, all
+     *        available cores are used
      */
-    void save(const std::filesystem::path& filename);
+    void save(const std::filesystem::path& filename, Format format,
+        int nThreads = 0) const;
 
     unsigned char* data();
     const unsigned char* data() const;
@@ -10,14 +10,28 @@
 #define __SGCT__LOGGER__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/format.h>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
 #include <functional>
-#include <mutex>
-#include <string>
+#include <memory>
 #include <string_view>
-#include <vector>
 
 namespace sgct {
 
+/**
+ * The log messages are passed from the threads that create them to a separate thread
+ * that writes them to the console, the log file, and the log callback. The messages are
+ * stored in a bounded lock-free queue, so logging never waits for a lock, the console,
+ * or the disk. If the writing thread falls behind and the queue is full, new messages are
+ * dropped and the number of dropped messages is reported once there is room again. Error
+ * messages are the exception as the calling thread waits until they have been written.
+ *
+ * The functions that take a format string and arguments check the notify level before
+ * the message is formatted, so a message with a level that is disabled costs no more
+ * than a comparison. These should be preferred over passing the result of `std::format`.
+ */
 class SGCT_EXPORT Log {
 public:
     /**
@@ -25,7 +39,17 @@ public:
      */
     enum class Level { Error = 3, Warning = 2, Info = 1, Debug = 0 };
 
+    /// The default size in bytes at which the log file is rotated
+    static constexpr uint64_t DefaultMaxFileSize = 10 * 1024 * 1024;
+
+    /// The default number of rotated log files that are kept
+    static constexpr int DefaultNumberOfBackups = 3;
+
     static Log& instance();
+
+    /**
+     * Writes all pending messages and stops the thread that writes them.
+     */
     static void destroy();
 
     static void Debug(std::string_view message);
@@ -33,6 +57,48 @@ public:
     static void Info(std::string_view message);
     static void Error(std::string_view message);
 
+    template <typename Arg, typename... Args>
+    static void Debug(std::format_string<Arg, Args...> format, Arg&& arg,
+                      Args&&... args)
+    {
+        if (isEnabled(Level::Debug)) {
+            log(Level::Debug, format.get(), std::make_format_args(arg, args...));
+        }
+    }
+
+    template <typename Arg, typename... Args>
+    static void Warning(std::format_string<Arg, Args...> format, Arg&& arg,
+                        Args&&... args)
+    {
+        if (isEnabled(Level::Warning)) {
+            log(Level::Warning, format.get(), std::make_format_args(arg, args...));
+        }
+    }
+
+    template <typename Arg, typename... Args>
+    static void Info(std::format_string<Arg, Args...> format, Arg&& arg,
+                     Args&&... args)
+    {
+        if (isEnabled(Level::Info)) {
+            log(Level::Info, format.get(), std::make_format_args(arg, args...));
+        }
+    }
+
+    template <typename Arg, typename... Args>
+    static void Error(std::format_string<Arg, Args...> format, Arg&& arg,
+                      Args&&... args)
+    {
+        if (isEnabled(Level::Error)) {
+            log(Level::Error, format.get(), std::make_format_args(arg, args...));
+        }
+    }
+
+    /// \return `true` if messages of the \p level are logged with the current notify
+    ///         level. This can be called from any thread
+    static bool isEnabled(Level level) {
+        return level >= _notifyLevel.load(std::memory_order_relaxed);
+    }
+
     /**
      * Set the notify level for displaying messages.
      */
@@ -53,33 +119,54 @@ public:
      */
     void setLogToConsole(bool state);
 
+    /**
+     * Sets the file that all messages are appended to. Once the file grows larger than
+     * \p maxSize, it is renamed to `<path>.1`, the existing `<path>.1` is renamed to
+     * `<path>.2`, and so on, keeping at most \p nBackups of these old files. Passing an
+     * empty path stops logging to a file.
+     *
+     * \param path The path to the log file
+     * \param maxSize The size in bytes at which the file is rotated. If this is 0, the
+     *        file is never rotated
+     * \param nBackups The number of rotated files that are kept
+     */
+    void setLogFile(std::filesystem::path path, uint64_t maxSize = DefaultMaxFileSize,
+        int nBackups = DefaultNumberOfBackups);
+
     /**
      * Set the callback that gets invoked for each log. If you want to disable logging to
-     * the callback, pass a null function as a parameter.
+     * the callback, pass a null function as a parameter. The callback is invoked on the
+     * thread that writes the messages and must not call any of the functions of this
+     * class other than the logging functions.
      */
     void setLogCallback(std::function<void(Level, std::string_view)> fn);
 
+    /**
+     * Waits until all messages that were logged before this call have been written. This
+     * must not be called from the log callback.
+     */
+    void flush();
+
+    /// \return The number of messages that were dropped because the queue was full
+    uint64_t nDroppedMessages() const;
+
 private:
     Log();
+    ~Log();
     Log(const Log&) = delete;
     Log(Log&&) = delete;
     Log& operator=(const Log&) = delete;
     Log& operator=(Log&&) = delete;
 
-    void printv(Level level, std::string message);
+    static void log(Level level, std::string_view format, std::format_args args);
+    void push(Level level, std::string_view message);
 
-    static Log* _instance;
-
-    std::vector<char> _parseBuffer;
+    class Writer;
 
-    Level _level = Level::Info;
-    bool _showTime = false;
-    bool _showLevel = true;
-    bool _logToConsole = true;
-
-    std::mutex _mutex;
+    static Log* _instance;
+    static std::atomic<Level> _notifyLevel;
 
-    std::function<void(Level, std::string_view)> _messageCallback;
+    std::unique_ptr<Writer> _writer;
 };
 
 } // namespace sgct
@@ -0,0 +1,52 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__MAPPEDFILE__H__
+#define __SGCT__MAPPEDFILE__H__
+
+#include <sgct/sgctexports.h>
+#include <filesystem>
+
+namespace sgct {
+
+/**
+ * A file that is mapped into memory for reading. The pages are only read from the disk
+ * when they are accessed and are shared with the operating system's file cache, so the
+ * contents are never copied.
+ */
+class SGCT_EXPORT MappedFile {
+public:
+    /**
+     * Maps the file at \p path into memory. If the file does not exist, cannot be
+     * opened, or is empty, #data returns `nullptr`.
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    /// \return The contents of the file or `nullptr` if it could not be mapped
+    const unsigned char* data() const;
+
+    /// \return The number of bytes in the file
+    size_t size() const;
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    const unsigned char* _data = nullptr;
+    size_t _size = 0;
+#ifdef WIN32
+    void* _mapping = nullptr;
+#endif // WIN32
+};
+
+} // namespace sgct
+
+#endif // __SGCT__MAPPEDFILE__H__
@@ -0,0 +1,172 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__MULTICAST__H__
+#define __SGCT__MULTICAST__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/network.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Sends messages to all members of a UDP multicast group, or to a broadcast address, at
+ * once. Every message is split into datagrams that carry the message's sequence number
+ * so that the receivers can reassemble it. The most recent messages are kept so that a
+ * receiver that missed one of them can have it sent again through its TCP connection.
+ */
+class SGCT_EXPORT MulticastSender {
+public:
+    /// The number of most recent messages that are kept for retransmission
+    static constexpr int HistorySize = 16;
+
+    /**
+     * \param address The IPv4 multicast group or broadcast address
+     * \param port The UDP port to which the datagrams are sent
+     * \param ttl The number of routers that the multicast datagrams are allowed to pass
+     * \param interfaceAddress The IPv4 address of the local interface that sends the
+     *        datagrams or an empty string to let the operating system decide
+     * \throw Error If the socket could not be created or configured
+     */
+    MulticastSender(const std::string& address, int port, int ttl,
+        const std::string& interfaceAddress);
+    ~MulticastSender();
+
+    /**
+     * Sends the concatenation of all \p buffers as a single message.
+     *
+     * \return The sequence number of the message
+     * \throw Error If the message is too large to be split into datagrams
+     */
+    uint32_t send(std::span<const Network::Buffer> buffers);
+
+    /**
+     * Copies the message with the \p sequence number into \p message if it is one of
+     * the #HistorySize most recent messages. This function can be called from any
+     * thread.
+     *
+     * \return `true` if the message was still available
+     */
+    bool message(uint32_t sequence, std::vector<char>& message) const;
+
+private:
+    MulticastSender(const MulticastSender&) = delete;
+    MulticastSender& operator=(const MulticastSender&) = delete;
+
+    SGCT_SOCKET _socket;
+    uint32_t _address = 0;
+    uint16_t _port = 0;
+
+    uint32_t _nextSequence = 0;
+    std::vector<char> _datagram;
+
+    struct Message {
+        std::optional<uint32_t> sequence;
+        std::vector<char> data;
+    };
+    mutable std::mutex _historyMutex;
+    std::array<Message, HistorySize> _history;
+};
+
+/**
+ * Receives the messages of a MulticastSender on a separate thread and reassembles them
+ * from their datagrams. Requests for messages are answered through callbacks, so the
+ * thread that requests a message never waits for its datagrams.
+ */
+class SGCT_EXPORT MulticastReceiver {
+public:
+    /// Called with the sequence number and the complete message, or with `nullptr` if the
+    /// message was not received in time
+    using Callback = std::function<void(uint32_t sequence, std::vector<char>* message)>;
+
+    /**
+     * \param address The IPv4 multicast group or broadcast address
+     * \param port The UDP port on which the datagrams are received
+     * \param interfaceAddress The IPv4 address of the local interface that joins the
+     *        multicast group or an empty string to let the operating system decide
+     * \throw Error If the socket could not be created, bound, or could not join the
+     *        multicast group
+     */
+    MulticastReceiver(const std::string& address, int port,
+        const std::string& interfaceAddress);
+    ~MulticastReceiver();
+
+    /**
+     * Calls the \p callback once the message with the \p sequence number has been
+     * received completely, or with `nullptr` if that has not happened within the
+     * \p timeout. This function does not wait for the message. The callback is called on
+     * one of the threads of the receiver, or on the calling thread if the message is
+     * already complete. The message and all older ones that are not requested are
+     * forgotten once the callback has been called. The callback must not call any other
+     * function of the receiver.
+     */
+    void takeAsync(uint32_t sequence, std::chrono::milliseconds timeout,
+        Callback callback);
+
+    /**
+     * Forgets all requests whose callbacks have not been called yet. If a callback is
+     * running, this function waits until it has returned, so the callbacks are never
+     * called after this function returns. It must not be called from a callback.
+     */
+    void cancel();
+
+private:
+    MulticastReceiver(const MulticastReceiver&) = delete;
+    MulticastReceiver& operator=(const MulticastReceiver&) = delete;
+
+    struct PartialMessage {
+        std::vector<char> data;
+        std::vector<bool> hasFragment;
+        int nMissingFragments = 0;
+    };
+
+    struct Request {
+        std::chrono::steady_clock::time_point deadline;
+        Callback callback;
+    };
+
+    void run();
+    void runTimer();
+    void forget(uint32_t sequence);
+    /// Must be called while holding #_callbackMutex, which has to be locked before the
+    /// callback's request is released from #_mutex
+    void call(const Callback& callback, uint32_t sequence, std::vector<char>* message);
+
+    SGCT_SOCKET _socket;
+    std::atomic_bool _shouldTerminate = false;
+    std::thread _thread;
+
+    /// Calls the callbacks of the requests whose timeout has passed
+    std::thread _timerThread;
+    std::condition_variable _timerCond;
+
+    std::mutex _mutex;
+    std::map<uint32_t, PartialMessage> _messages;
+    std::map<uint32_t, Request> _requests;
+    std::optional<uint32_t> _lastTaken;
+
+    /// Held while a callback is running so that #cancel can wait for it
+    std::mutex _callbackMutex;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__MULTICAST__H__
@@ -10,11 +10,16 @@
 #define __SGCT__NETWORK__H__
 
 #include <sgct/sgctexports.h>
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <string>
 #include <thread>
 #include <vector>
@@ -27,27 +32,149 @@ using SGCT_SOCKET = int;
 
 namespace sgct {
 
+class MulticastReceiver;
+class MulticastSender;
+class NetworkReactor;
+
 /**
  * Network manages peer-to-peer tcp connections.
  */
 class SGCT_EXPORT Network {
 public:
-    // ASCII device control chars = 17, 18, 19 & 20
+    // The message ids start at the ASCII device control chars = 17, 18, 19 & 20 and
+    // continue upwards for the messages that were added later
     static constexpr char DefaultId = 0;
     static constexpr char Ack = 6;
     static constexpr char DataId = 17;
     static constexpr char ConnectedId = 18;
     static constexpr char DisconnectId = 19;
+    static constexpr char CapabilityId = 20;
+    static constexpr char SyncDeltaId = 21;
+    static constexpr char StreamBeginId = 22;
+    static constexpr char StreamChunkId = 23;
+    static constexpr char StreamAckId = 24;
+    static constexpr char MulticastSyncId = 25;
+    static constexpr char MulticastNackId = 26;
+    static constexpr char MulticastRepairId = 27;
+
+    /// Capability flag that is announced to the peer if this node can decompress zlib
+    /// compressed payloads
+    static constexpr uint32_t CapabilityCompression = 1 << 0;
+
+    /// Capability flag that is announced by a client if it can reconstruct sync messages
+    /// that only contain the differences to the previous sync message, and by a server
+    /// if it sends such messages
+    static constexpr uint32_t CapabilityDelta = 1 << 1;
+
+    /// Capability flag that is announced to the peer if this node receives the payload
+    /// of the sync messages through UDP multicast
+    static constexpr uint32_t CapabilityMulticast = 1 << 2;
+
+    /// Capability flag that is announced to the peer if this node collects the
+    /// FrameTiming that clients append to their acknowledgements of the sync messages
+    static constexpr uint32_t CapabilityFrameTiming = 1 << 3;
 
     enum class ConnectionType { SyncConnection, DataTransfer };
 
     static constexpr size_t HeaderSize = 13;
 
+    /// The size in bytes of the chunks into which a streamed data transfer is split
+    static constexpr int StreamChunkSize = 1024 * 1024;
+
+    /// The receiver of a streamed data transfer acknowledges every this many chunks
+    static constexpr int StreamAckInterval = 4;
+
+    /**
+     * The timing of the most recent complete frame of a client, which it appends to the
+     * acknowledgement of a sync message. The server only receives these if it has
+     * announced CapabilityFrameTiming.
+     */
+    struct FrameTiming {
+        /// The index of the client in the cluster configuration
+        uint32_t nodeIndex = 0;
+
+        /// The frame number of the client that the times belong to
+        uint32_t frameNumber = 0;
+
+        /// The time in seconds the client spent drawing the frame, not including the
+        /// time the GPU needs to finish it
+        float drawTime = 0.f;
+
+        /// The time in seconds the client waited for the frame lock
+        float syncTime = 0.f;
+
+        /// The time in seconds it took to swap the buffers of all windows
+        float swapTime = 0.f;
+
+        /// The total number of frames on the client that took much longer than usual
+        uint32_t nDroppedFrames = 0;
+    };
+
+    /// The number of bytes of a FrameTiming in an acknowledgement message
+    static constexpr uint32_t FrameTimingSize = 6 * sizeof(uint32_t);
+
+    /// A non-owning view of one part of a message that is sent as a whole
+    struct Buffer {
+        const void* data = nullptr;
+        int length = 0;
+    };
+
     /**
      * \return The last error code
      */
     static int lastError();
 
+    /**
+     * Compresses the \p data using zlib with the provided compression \p level and
+     * stores the result at the beginning of the \p buffer. The \p buffer is only ever
+     * grown so that it can be reused between calls without reallocating.
+     *
+     * \return The number of compressed bytes in the \p buffer or 0 if the compressed
+     *         data would not be smaller than the input and should be sent as-is instead
+     */
+    static int compressData(const void* data, int length, std::vector<char>& buffer,
+        int level);
+
+    /**
+     * Compresses the concatenation of all \p buffers without concatenating them first.
+     * The result is identical to calling the other overload with the concatenated data.
+     */
+    static int compressData(std::span<const Buffer> buffers, std::vector<char>& buffer,
+        int level);
+
+    /**
+     * Decompresses the zlib compressed \p data into the \p destination which must be
+     * able to hold \p uncompressedLength bytes.
+     *
+     * \throw Error If the \p data could not be decompressed into exactly
+     *        \p uncompressedLength bytes
+     */
+    static void uncompressData(const void* data, int length, void* destination,
+        int uncompressedLength);
+
+    /**
+     * Encodes the byte ranges in which \p data differs from the \p previous data into
+     * the beginning of the \p buffer. The encoded delta starts with the total length of
+     * the \p data and the number of runs, followed by the list of (offset, length, bytes)
+     * runs. Unchanged stretches that are shorter than a run header are merged into the
+     * surrounding runs. The \p buffer is only ever grown so that it can be reused between
+     * calls without reallocating.
+     *
+     * \return The number of bytes of the delta in the \p buffer or 0 if the delta would
+     *         not be smaller than the \p data and the data should be sent as-is instead
+     */
+    static int encodeDelta(const void* previous, int previousLength, const void* data,
+        int length, std::vector<char>& buffer);
+
+    /**
+     * Applies a \p delta that was created by #encodeDelta to the \p data, which has to
+     * contain the same bytes as the `previous` data that was used to create the delta.
+     * The \p data is left unchanged if the \p delta is malformed.
+     *
+     * \throw Error If the \p delta is malformed, for example truncated
+     */
+    static void applyDelta(const void* delta, int length, std::vector<char>& data);
+
     /**
      * \param port The network port (TCP)
      * \param address The hostname, IPv4 address or ip6 address
@@ -61,20 +188,133 @@ public:
     void closeNetwork(bool forced);
     void initShutdown();
 
+    /**
+     * Hands the receiving of messages over to the \p reactor once the connection is
+     * established instead of blocking a separate thread per connection. Has to be called
+     * before #initialize. If no reactor is set, each connection uses its own thread.
+     */
+    void setReactor(NetworkReactor* reactor);
+
+    /**
+     * Reads all data that is currently available on the socket without blocking and
+     * handles every message that is completed by it. Partially received messages are
+     * kept until the rest of the data arrives. This function is called by the
+     * NetworkReactor whenever the socket becomes readable.
+     *
+     * \return `false` if the connection was closed or terminated by the remote end
+     */
+    bool receiveAvailable();
+
+    /**
+     * Releases the resources of a connection that was closed and notifies the update
+     * function. This is called by the NetworkReactor after #receiveAvailable returned
+     * `false`.
+     */
+    void finishConnection();
+
+    /**
+     * Receives the payload of the sync messages through the \p receiver instead of this
+     * connection, which then only carries the frame number and the sequence number of
+     * each message. Messages that do not arrive through the \p receiver in time are
+     * requested again through this connection. Has to be called before #initialize and
+     * is only used by client sync connections.
+     */
+    void setMulticastReceiver(MulticastReceiver* receiver);
+
+    /**
+     * Sets the \p sender whose messages are sent again through this connection whenever
+     * the remote end reports that it did not receive one of them. Has to be called
+     * before #initialize and is only used by server sync connections.
+     */
+    void setMulticastSender(const MulticastSender* sender);
+
+    /**
+     * Announces to the remote end that the sync messages on this connection might be
+     * delta encoded, so that the remote end keeps the copy of the previous message that
+     * the deltas are applied to. Has to be called before #initialize and is only used by
+     * server sync connections.
+     */
+    void setDeltaEncoding(bool enabled);
+
     void setDecodeFunction(std::function<void(const char*, int)> fn);
     void setPackageDecodeFunction(std::function<void(void*, int, int, int)> fn);
     void setUpdateFunction(std::function<void(Network&)> fn);
     void setConnectedFunction(std::function<void (void)> fn);
     void setAcknowledgeFunction(std::function<void(int, int)> fn);
 
+    /**
+     * Sets the function that is called for every chunk of a streamed data transfer that
+     * is received. The parameters are the chunk, its length, its offset in the stream,
+     * the total size of the stream, the package id, and the id of this connection. If no
+     * function is set, the stream is assembled in memory and passed to the package
+     * decode function when it is complete.
+     */
+    void setStreamDecodeFunction(
+        std::function<void(const char*, int, int64_t, int64_t, int, int)> fn);
+
+    /**
+     * Sets the function that is called when a streamed data transfer starts that is not
+     * already in progress on this connection. It is called with the package id and the
+     * total size of the stream and returns the number of bytes of the stream that are
+     * already available, for example from an earlier transfer that was interrupted.
+     * Only these many bytes are skipped by the sender.
+     */
+    void setStreamResumeFunction(std::function<int64_t(int, int64_t)> fn);
+
     void setConnectedStatus(bool state);
     void closeSocket(SGCT_SOCKET lSocket);
 
+    /// \return The socket of the currently established connection
+    SGCT_SOCKET nativeSocket() const;
+
     ConnectionType type() const;
     int id() const;
     bool isServer() const;
     bool isConnected() const;
 
+    /**
+     * \return `true` if the remote end of this connection has announced that it can
+     *         decompress compressed payloads
+     */
+    bool acceptsCompression() const;
+
+    /**
+     * \return `true` if the remote end of this connection has announced that it can
+     *         reconstruct delta encoded sync messages or, on a client, that the server
+     *         sends them
+     */
+    bool acceptsDelta() const;
+
+    /**
+     * \return `true` if the remote end of this connection has announced that it receives
+     *         the payload of the sync messages through UDP multicast
+     */
+    bool acceptsMulticast() const;
+
+    /**
+     * \return `true` if the remote end of this connection has announced that it collects
+     *         the FrameTiming of its clients
+     */
+    bool acceptsFrameTiming() const;
+
+    /**
+     * \return The most recent FrameTiming that the client on the remote end of this
+     *         connection has sent, or `std::nullopt` if it has not sent any since it
+     *         connected
+     */
+    std::optional<FrameTiming> frameTiming() const;
+
+    /**
+     * Clears the flag that marks this connection as needing a keyframe. The flag is set
+     * when the connection is established or when a multicast repair was sent, both of
+     * which can happen on another thread, so it is read and cleared in one step.
+     *
+     * \return `true` if no complete sync message has been sent on this connection since
+     *         it was established or repaired, meaning that a delta encoded message can
+     *         not be applied by the remote end
+     */
+    bool exchangeNeedsKeyframe();
+
     int sendFrameCurrent() const;
     int recvFrameCurrent() const;
     int recvFramePrevious() const;
@@ -93,17 +333,80 @@ public:
      * \return `true` if updates has been received
      */
     bool isUpdated() const;
+
+    /**
+     * Blocks until #isUpdated returns `true`, the connection is lost, or the \p deadline
+     * has passed. Only messages that are received on this connection wake up the caller.
+     *
+     * \return The value of #isUpdated after the wait
+     */
+    bool waitForUpdate(std::chrono::steady_clock::time_point deadline) const;
+
     void sendData(const void* data, int length) const;
 
+    /**
+     * Sends the \p header immediately followed by the \p data as a single gathered write
+     * without concatenating them into an intermediate buffer first.
+     *
+     * \param header The message header, usually #HeaderSize bytes long
+     * \param headerLength The number of bytes in the \p header
+     * \param data The payload that follows the header
+     * \param length The number of bytes in the \p data
+     */
+    void sendData(const void* header, int headerLength, const void* data,
+        int length) const;
+
+    /**
+     * Sends the \p header immediately followed by all of the \p buffers in order as a
+     * single gathered write without concatenating them into an intermediate buffer.
+     *
+     * \param header The message header, usually #HeaderSize bytes long
+     * \param headerLength The number of bytes in the \p header
+     * \param buffers The parts of the payload that follow the header
+     */
+    void sendData(const void* header, int headerLength,
+        std::span<const Buffer> buffers) const;
+
+    /**
+     * Announces a streamed data transfer with the provided \p packageId and
+     * \p totalSize to the remote end, which answers with an acknowledgement of the
+     * number of bytes that it already has. Any previous acknowledgement that was
+     * received on this connection is forgotten.
+     */
+    void sendStreamBegin(int packageId, int64_t totalSize);
+
+    /**
+     * Sends the chunk at the byte \p offset of the streamed data transfer with the
+     * \p packageId. If the \p data is compressed, \p uncompressedLength is its
+     * uncompressed size, otherwise it must be 0. The receiver ignores the chunk unless
+     * the \p offset is exactly the number of bytes that it has received so far, so
+     * chunks and acknowledgements that are still in flight when a stream is resumed
+     * cannot corrupt it.
+     */
+    void sendStreamChunk(int packageId, int64_t offset, const void* data, int length,
+        int uncompressedLength) const;
+
+    /**
+     * Waits until the remote end has acknowledged more than \p bytes of the streamed data
+     * transfer with the \p packageId.
+     *
+     * \return The number of acknowledged bytes or `std::nullopt` if the connection was
+     *         lost or if nothing new was acknowledged within the \p timeout
+     */
+    std::optional<int64_t> waitForStreamAck(int packageId, int64_t bytes,
+        std::chrono::milliseconds timeout);
+
     /**
      * Iterates the send frame number and returns the new frame number.
      */
     int iterateFrameCounter();
 
     /**
-     * The client sends ack message to server + console messages.
+     * The client sends the acknowledgement of the current sync frame to the server. If
+     * the server has announced that it collects the FrameTiming of its clients, the
+     * \p timing is appended to the message.
      */
-    void pushClientMessage();
+    void pushClientMessage(const std::optional<FrameTiming>& timing = std::nullopt);
 
     /**
      * \return The port of this connection
@@ -119,12 +422,37 @@ private:
     Network& operator=(Network&&) = delete;
 
     void setRecvFrame(int i);
+    void notifyUpdate();
     void updateBuffer(std::vector<char>& buffer, uint32_t reqSize, uint32_t& currSize);
     int readSyncMessage(char* header, int32_t& syncFrame, uint32_t& dataSize,
         uint32_t& uncompressedDataSize);
     int readDataTransferMessage(char* header, int32_t& packageId, uint32_t& dataSize,
         uint32_t& uncompressedDataSize);
     int readExternalMessage();
+    void parseHeader(const char* header, int32_t& packageId, uint32_t& dataSize,
+        uint32_t& uncompressedDataSize);
+    bool hasPayload(int32_t packageId, uint32_t dataSize) const;
+    bool handleMessage(const char* header, int32_t packageId, uint32_t dataSize,
+        uint32_t uncompressedDataSize);
+    void sendCapabilities() const;
+    void sendAcknowledge(int packageId) const;
+    void sendStreamAck(int packageId, int64_t bytes) const;
+    char* uncompressedPayload(uint32_t dataSize, uint32_t uncompressedDataSize);
+    bool decodeSyncMessage(char id, const char* data, uint32_t dataSize,
+        uint32_t uncompressedDataSize);
+
+    void receiveMulticastSync(int32_t frame, uint32_t sequence);
+    void completeMulticast(uint32_t sequence, std::vector<char>* message);
+    void receiveMulticastRepair(uint32_t sequence, uint32_t dataSize);
+    void decodePendingMulticasts();
+    bool decodeMulticastMessage(const char* message, uint32_t length);
+    void sendMulticastNack(uint32_t sequence) const;
+    void sendMulticastRepair(uint32_t sequence);
+
+    void beginStream(int packageId, int64_t totalSize);
+    void receiveStreamChunk(int packageId, int64_t offset, const char* data,
+        int length);
+    void setStreamAck(int packageId, int64_t bytes);
 
     /// function to decode messages
     void communicationHandler();
@@ -137,6 +465,11 @@ private:
     std::atomic_bool _isServer;
     std::atomic_bool _isConnected = false;
     std::atomic_bool _isUpdated = false;
+    std::atomic_bool _acceptsCompression = false;
+    std::atomic_bool _acceptsDelta = false;
+    std::atomic_bool _acceptsMulticast = false;
+    std::atomic_bool _acceptsFrameTiming = false;
+    std::atomic_bool _needsKeyframe = true;
     std::atomic<int32_t> _currentSendFrame = 0;
     std::atomic<int32_t> _previousSendFrame = 0;
     std::atomic<int32_t> _currentRecvFrame = 0;
@@ -144,9 +477,16 @@ private:
     std::atomic_bool _shouldTerminate = false; // set to true upon exit
 
     mutable std::mutex _connectionMutex;
+    // Serializes the messages that are sent from the I/O threads with the ones that are
+    // sent from the render thread
+    mutable std::mutex _sendMutex;
     std::unique_ptr<std::thread> _commThread;
     std::unique_ptr<std::thread> _mainThread;
 
+    // The most recent timing that the client on the remote end sent to this server
+    mutable std::mutex _frameTimingMutex;
+    std::optional<FrameTiming> _frameTiming;
+
     double _timeStampSend = 0.0;
     std::atomic<double> _timeStampTotal = 0.0;
     int _id;
@@ -157,15 +497,71 @@ private:
 
     std::vector<char> _recvBuffer;
     std::vector<char> _uncompressBuffer;
+    /// The last complete sync message on which the next delta encoded message is based
+    std::vector<char> _syncBaseline;
+    /// Set if a delta encoded sync message could not be applied because the message
+    /// before it was lost. All deltas are skipped until the next complete message
+    bool _hasLostSyncBaseline = false;
     char _headerId = 0;
 
     std::condition_variable _startConnectionCond;
 
+    // Signalled whenever a message was handled or the connection status changed
+    mutable std::mutex _updateMutex;
+    mutable std::condition_variable _updateCond;
+
+    NetworkReactor* _reactor = nullptr;
+
+    MulticastReceiver* _multicastReceiver = nullptr;
+    const MulticastSender* _multicastSender = nullptr;
+    bool _sendsDelta = false;
+
+    // The sync messages that are received through multicast in the order in which they
+    // have to be decoded. The MulticastReceiver waits for their datagrams on its own
+    // threads and the ones that do not arrive in time are requested through this
+    // connection, so they can be completed in any order
+    struct PendingMulticast {
+        enum class State { Waiting, Requested, Received, Lost };
+
+        int32_t frame = -1;
+        uint32_t sequence = 0;
+        State state = State::Waiting;
+        std::vector<char> message;
+    };
+    std::mutex _multicastMutex;
+    std::deque<PendingMulticast> _pendingMulticasts;
+
+    // The message that is currently being received through the reactor. Either the
+    // header or, once the header is complete, the payload is partially read
+    std::array<char, HeaderSize> _pendingHeader = {};
+    bool _isReadingPayload = false;
+    uint32_t _nPendingBytes = 0;
+    int32_t _pendingPackageId = -1;
+    uint32_t _pendingDataSize = 0;
+    uint32_t _pendingUncompressedDataSize = 0;
+
+    // State of the streamed data transfer that is currently being received. It is kept
+    // across reconnects so that an interrupted stream can be resumed
+    int _streamPackageId = -1;
+    int64_t _streamTotalSize = 0;
+    int64_t _streamReceived = 0;
+    int _nStreamChunksSinceAck = 0;
+    std::vector<char> _streamBuffer;
+
+    // The last acknowledgement of a streamed data transfer that was sent by us
+    std::mutex _streamAckMutex;
+    std::condition_variable _streamAckCond;
+    int _streamAckPackageId = -1;
+    int64_t _streamAckBytes = -1;
+
     std::function<void(const char*, int)> decoderCallback;
     std::function<void(void*, int, int, int)> _packageDecoderCallback;
     std::function<void(Network&)> _updateCallback;
     std::function<void(void)> _connectedCallback;
     std::function<void(int, int)> _acknowledgeCallback;
+    std::function<void(const char*, int, int64_t, int64_t, int, int)>
+        _streamDecoderCallback;
+    std::function<int64_t(int, int64_t)> _streamResumeCallback;
 };
 
 } // namespace sgct
@@ -12,16 +12,24 @@
 #include <sgct/sgctexports.h>
 #include <sgct/network.h>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <filesystem>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
 
 namespace sgct {
 
+class MulticastReceiver;
+class MulticastSender;
 class Network;
+class NetworkReactor;
+class SyncFanOut;
 
 /**
  * The network manager manages all network connections for SGCT.
@@ -31,6 +39,33 @@ public:
     enum class SyncMode { SendDataToClients = 0, Acknowledge };
     enum class NetworkMode { Remote = 0, LocalServer, LocalClient };
 
+    /// Determines whether and how payloads are compressed before they are sent
+    struct Compression {
+        /// The zlib compression level between 0 (none) and 9 (smallest)
+        int level = 1;
+        /// Payloads smaller than this number of bytes are always sent uncompressed
+        int threshold = 4096;
+    };
+
+    /// Determines how often the complete sync data is sent when delta encoding is used
+    struct DeltaEncoding {
+        /// The number of frames after which all clients receive the complete data again
+        int keyframeInterval = 100;
+    };
+
+    /// Determines where the server sends the payload of the sync messages through UDP
+    struct Multicast {
+        /// The IPv4 multicast group or broadcast address
+        std::string address;
+        /// The UDP port to which the messages are sent
+        int port = 0;
+        /// The number of routers that the multicast datagrams are allowed to pass
+        int ttl = 1;
+        /// The IPv4 address of the local network interface that is used for multicast or
+        /// an empty string to let the operating system decide
+        std::string interfaceAddress;
+    };
+
     static NetworkManager& instance();
     static void create(NetworkMode nm,
         std::function<void(void*, int, int, int)> dataTransferDecode,
@@ -38,20 +73,94 @@ public:
         std::function<void(int, int)> dataTransferAcknowledge);
     static void destroy();
 
-    static std::condition_variable cond;
-
     ~NetworkManager();
 
     void initialize();
     void clearCallbacks();
 
     /**
+     * Enables or disables the compression of sync data and data transfers. Even if
+     * compression is enabled, payloads are only compressed for connections whose remote
+     * end has announced that it is able to decompress them, so mixing nodes with and
+     * without compression support in a cluster is safe.
+     *
+     * \param compression The compression settings or `std::nullopt` to disable it
+     */
+    void setCompression(std::optional<Compression> compression);
+
+    /**
+     * Enables or disables the delta encoding of the sync data. If enabled, clients only
+     * receive the byte ranges of the shared data that have changed since the previous
+     * frame. Clients that have just connected or that have not announced that they can
+     * apply the differences receive the complete data instead, as do all clients every
+     * `keyframeInterval` frames.
+     *
+     * \param deltaEncoding The delta encoding settings or `std::nullopt` to disable it
+     */
+    void setDeltaEncoding(std::optional<DeltaEncoding> deltaEncoding);
+
+    /**
+     * Enables or disables sending the sync data to all clients at once through UDP
+     * multicast. Each client's TCP connection then only carries the frame number and
+     * the sequence number of the multicast message, and messages that a client did not
+     * receive are sent to it again through the TCP connection. The acknowledgements for
+     * the frame lock are not affected. Clients that do not announce that they receive
+     * the multicast messages are sent the sync data through TCP. If the multicast
+     * sockets can not be set up, all sync data is sent through TCP. This has to be set
+     * before the call to #initialize.
+     *
+     * \param multicast The multicast settings or `std::nullopt` to disable it
+     */
+    void setMulticast(std::optional<Multicast> multicast);
+
+    /**
+     * Sets the functions that are used for streamed data transfers. These have to be set
+     * before the call to #initialize. The \p chunk and \p resume functions, as well as
+     * the data transfer decode function, are called on the receiving thread of the data
+     * transfer connection, which never delays the sync messages of the cluster.
+     *
+     * \param chunk Called on the receiver for every chunk of a stream with the chunk, its
+     *        length, its offset in the stream, the total size of the stream, the package
+     *        id, and the connection id. If it is not set, the stream is assembled in
+     *        memory and passed to the data transfer decode function instead
+     * \param resume Called on the receiver when a stream starts with the package id and
+     *        the total size and returns how many bytes of the stream are already
+     *        available from an earlier, interrupted transfer
+     * \param progress Called on the sender whenever a receiver has acknowledged more of a
+     *        stream with the package id, the number of acknowledged bytes, the total
+     *        size, and the connection id. It is called from the threads that send the
+     *        stream, of which there can be several at the same time
+     */
+    void setDataTransferStreamFunctions(
+        std::function<void(const char*, int, int64_t, int64_t, int, int)> chunk,
+        std::function<int64_t(int, int64_t)> resume,
+        std::function<void(int, int64_t, int64_t, int)> progress);
+
+    /**
+     * If there is more than one client connected, the sync data is sent to all clients
+     * in parallel so that a single slow connection does not delay the remaining ones.
+     *
      * \param sm If this application is server/master in cluster then set to true
      * \return The min-max pair of the looping time to all connections if data was sent to
      *         the clients. If it was the acknowledge data call or no connections are
      *         available, a `nullopt` is returned
      */
-    std::optional<std::pair<double, double>> sync(SyncMode sm) const;
+    std::optional<std::pair<double, double>> sync(SyncMode sm);
+
+    /**
+     * Returns the time in seconds that it took to send the sync data to each of the
+     * clients in the last call to #sync. The index corresponds to the index of the sync
+     * connection and connections that were not sent any data have a value of 0.
+     *
+     * \return The per-connection send times of the last frame
+     */
+    const std::vector<double>& syncSendTimes() const;
+
+    /**
+     * Sets the timing of the most recent complete frame of this client. It is appended
+     * to the acknowledgements that are sent in #sync to servers that collect it.
+     */
+    void setFrameTiming(const Network::FrameTiming& timing);
 
     /**
      * Compare if the last frame and current frames are different -> data update and if
@@ -59,6 +168,15 @@ public:
      */
     bool isSyncComplete() const;
 
+    /**
+     * Blocks until #isSyncComplete would return `true` or until the \p deadline has
+     * passed. The calling thread is only woken up by messages on connections that have
+     * not been updated yet and returns as soon as the last of them arrives.
+     *
+     * \return `true` if the sync is complete, `false` if the \p deadline has passed
+     */
+    bool waitForSyncComplete(std::chrono::steady_clock::time_point deadline) const;
+
     bool matchesAddress(std::string_view address) const;
 
     /**
@@ -71,6 +189,54 @@ public:
     void transferData(const void* data, int length, int packageId,
         const Network& connection) const;
 
+    /**
+     * Sends the concatenation of all \p buffers as a single package to all data transfer
+     * connections. The buffers are handed to the socket as they are, so a multi-part
+     * asset does not have to be concatenated into a single block of memory first.
+     *
+     * \param buffers The parts of the package in the order in which they are sent
+     * \param packageId The identifier of the package that is passed to the receiver
+     */
+    void transferData(std::span<const Network::Buffer> buffers, int packageId) const;
+
+    /**
+     * Sends the concatenation of all \p buffers as a single package to the
+     * \p connection.
+     *
+     * \param buffers The parts of the package in the order in which they are sent
+     * \param packageId The identifier of the package that is passed to the receiver
+     * \param connection The data transfer connection that receives the package
+     */
+    void transferData(std::span<const Network::Buffer> buffers, int packageId,
+        const Network& connection) const;
+
+    /**
+     * Streams \p totalSize bytes to all data transfer connections in chunks of
+     * Network::StreamChunkSize bytes. Each receiver has to acknowledge the chunks before
+     * more than a small window of chunks are in flight, so neither side ever holds more
+     * than a few chunks in memory. If a connection is lost during the transfer, the
+     * stream is resumed from the last byte the receiver has when it reconnects. This
+     * function blocks until all connections have received the complete stream or have
+     * given up on it.
+     *
+     * \param packageId The identifier of the stream that is passed to the receiver
+     * \param totalSize The total number of bytes in the stream
+     * \param source Called to fill the provided buffer with the number of bytes starting
+     *        at the offset in the stream. It is called concurrently for different
+     *        connections
+     * \throw Error If a connection was lost and did not come back in time to resume
+     */
+    void transferStream(int packageId, int64_t totalSize,
+        const std::function<void(char*, int64_t, int)>& source);
+
+    /**
+     * Streams the file at \p path to all data transfer connections.
+     *
+     * \throw Error If the file could not be opened
+     * \see transferStream
+     */
+    void transferFile(const std::filesystem::path& path, int packageId);
+
     unsigned int activeConnectionsCount() const;
     int connectionsCount() const;
     int syncConnectionsCount() const;
@@ -93,11 +259,28 @@ private:
     void addConnection(int port, std::string address,
         Network::ConnectionType connectionType = Network::ConnectionType::SyncConnection);
     void updateConnectionStatus(Network& connection);
+    void setDataTransferFunctions(Network& connection);
+    void streamToConnection(Network& connection, int packageId, int64_t totalSize,
+        const std::function<void(char*, int64_t, int)>& source);
     void setAllNodesConnected();
 
     std::function<void(void*, int, int, int)> _dataTransferDecodeFn;
     std::function<void(bool, int)> _dataTransferStatusFn;
     std::function<void(int, int)> _dataTransferAcknowledgeFn;
+    std::function<void(const char*, int, int64_t, int64_t, int, int)>
+        _dataTransferChunkFn;
+    std::function<int64_t(int, int64_t)> _dataTransferResumeFn;
+    std::function<void(int, int64_t, int64_t, int)> _dataTransferProgressFn;
+
+    /// Receives the messages of all established connections. Declared before the
+    /// connections as it has to outlive them
+    std::unique_ptr<NetworkReactor> _reactor;
+
+    /// Only one of these exists, depending on whether this is the server or a client.
+    /// Declared before the connections as they have to outlive them
+    std::optional<Multicast> _multicast;
+    std::unique_ptr<MulticastSender> _multicastSender;
+    std::unique_ptr<MulticastReceiver> _multicastReceiver;
 
     // This could be a std::vector<Network>, but Network is not move-constructible
     // because of the std::condition_variable in it
@@ -107,6 +290,19 @@ private:
 
     std::vector<std::string> _localAddresses;
 
+    std::unique_ptr<SyncFanOut> _syncFanOut;
+    std::vector<double> _syncSendTimes;
+    std::optional<Network::FrameTiming> _frameTiming;
+
+    std::optional<Compression> _compression;
+    std::vector<char> _compressBuffer;
+
+    std::optional<DeltaEncoding> _deltaEncoding;
+    std::vector<char> _previousSyncPayload;
+    std::vector<char> _deltaBuffer;
+    std::vector<char> _compressDeltaBuffer;
+    int _nFramesSinceKeyframe = 0;
+
     bool _isServer = true;
     bool _isRunning = true;
     bool _allNodesConnected = false;
@@ -0,0 +1,99 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__NETWORKREACTOR__H__
+#define __SGCT__NETWORKREACTOR__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/network.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * The NetworkReactor receives the messages of any number of established connections on a
+ * small, fixed number of I/O threads instead of blocking one thread per connection in a
+ * `recv` call. It waits for incoming data on all registered sockets at once (using epoll
+ * on Linux and poll on all other platforms) and lets the Network that owns a readable
+ * socket consume whatever has arrived so far without blocking.
+ *
+ * The NetworkManager only registers the sync connections, so their decode, acknowledge,
+ * and connected functions are called on the I/O threads and have to return quickly.
+ * Data transfer connections are not registered and receive their messages on a thread
+ * of their own instead, as user code that handles large payloads would otherwise keep
+ * the I/O threads from reading the sync messages.
+ */
+class SGCT_EXPORT NetworkReactor {
+public:
+    /// The number of I/O threads that are used if epoll is available. Only a single
+    /// thread is used on other platforms
+    static constexpr int DefaultNumberOfThreads = 2;
+
+    /**
+     * Creates the reactor and starts its I/O threads.
+     *
+     * \throw Error If the operating system's event notification could not be set up
+     */
+    explicit NetworkReactor(int nThreads = DefaultNumberOfThreads);
+    ~NetworkReactor();
+
+    /**
+     * Starts receiving the messages of the established \p connection on one of the I/O
+     * threads. This continues until the remote end closes the connection, in which case
+     * Network::finishConnection is called on the I/O thread, or until #remove is called.
+     */
+    void add(Network& connection);
+
+    /**
+     * Stops receiving the messages of the \p connection. If a message of the connection
+     * is currently being handled, this function waits until that has finished. Calling
+     * this function for a connection that is not registered does nothing.
+     */
+    void remove(Network& connection);
+
+private:
+    NetworkReactor(const NetworkReactor&) = delete;
+    NetworkReactor(NetworkReactor&&) = delete;
+    NetworkReactor& operator=(const NetworkReactor&) = delete;
+    NetworkReactor& operator=(NetworkReactor&&) = delete;
+
+    struct Entry {
+        Network* connection = nullptr;
+        SGCT_SOCKET socket;
+        /// Set while one of the I/O threads is handling the connection's data
+        bool isBusy = false;
+    };
+
+    void run();
+    void handle(uint64_t key);
+
+    std::mutex _mutex;
+    std::condition_variable _idleCond;
+    /// The registered connections. The key is unique for every registration so that a
+    /// late event for a socket that has been reused can not be mistaken for a new one
+    std::unordered_map<uint64_t, Entry> _entries;
+    uint64_t _nextKey = 1;
+
+    std::atomic_bool _shouldTerminate = false;
+    std::vector<std::thread> _threads;
+
+#ifdef __linux__
+    int _epoll = -1;
+    int _wakeUpEvent = -1;
+#endif // __linux__
+};
+
+} // namespace sgct
+
+#endif // __SGCT__NETWORKREACTOR__H__
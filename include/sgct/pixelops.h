@@ -0,0 +1,76 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__PIXELOPS__H__
+#define __SGCT__PIXELOPS__H__
+
+#include <sgct/sgctexports.h>
+#include <cstddef>
+
+/**
+ * Conversions between the pixel layouts that are used by the GPU, the image libraries,
+ * and the file formats. The functions use the widest instruction set that is supported by
+ * the CPU, which is determined once at startup.
+ */
+namespace sgct::pixelops {
+    enum class InstructionSet { Scalar, SSSE3, AVX2 };
+
+    /// \return The instruction set that is currently used by all functions
+    SGCT_EXPORT InstructionSet instructionSet();
+
+    /**
+     * Restricts the functions to the provided instruction set \p set, or to the widest
+     * instruction set supported by the CPU if that is narrower. This is only meant for
+     * testing and benchmarking the different implementations.
+     *
+     * \return The instruction set that is used from now on
+     */
+    SGCT_EXPORT InstructionSet setInstructionSet(InstructionSet set);
+
+    /// \return The widest instruction set that is supported by the CPU
+    SGCT_EXPORT InstructionSet supportedInstructionSet();
+
+    /**
+     * Swaps the first and third channel of \p nPixels 8 bit pixels with \p nChannels (3
+     * or 4) channels, converting RGB(A) into BGR(A) and vice versa. The \p src and \p dst
+     * can be the same to convert the pixels in place.
+     */
+    SGCT_EXPORT void swapRedBlue(const unsigned char* src, unsigned char* dst,
+        size_t nPixels, int nChannels);
+
+    /**
+     * Swaps the two bytes of each of the \p nValues 16 bit values, converting between
+     * little and big endian. The \p src and \p dst can be the same to convert the values
+     * in place.
+     */
+    SGCT_EXPORT void swapBytes16(const unsigned char* src, unsigned char* dst,
+        size_t nValues);
+
+    /**
+     * Reverses the order of the \p nRows rows of \p rowSize bytes each in place.
+     */
+    SGCT_EXPORT void flipVertically(unsigned char* data, size_t rowSize, size_t nRows);
+
+    /**
+     * Expands \p nPixels 8 bit pixels with 3 channels from \p src into 4 channel pixels
+     * in \p dst, setting the fourth channel to \p alpha. The \p src and \p dst must not
+     * overlap.
+     */
+    SGCT_EXPORT void expandToFourChannels(const unsigned char* src, unsigned char* dst,
+        size_t nPixels, unsigned char alpha = 255);
+
+    /**
+     * Removes the fourth channel of \p nPixels 8 bit pixels with 4 channels from \p src
+     * and writes the resulting 3 channel pixels into \p dst. The \p src and \p dst can be
+     * the same to convert the pixels in place.
+     */
+    SGCT_EXPORT void removeFourthChannel(const unsigned char* src, unsigned char* dst,
+        size_t nPixels);
+} // namespace sgct::pixelops
+
+#endif // __SGCT__PIXELOPS__H__
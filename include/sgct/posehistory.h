@@ -0,0 +1,102 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__POSEHISTORY__H__
+#define __SGCT__POSEHISTORY__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+
+namespace sgct {
+
+/**
+ * Keeps the most recent timestamped poses of a tracked sensor and provides the pose at an
+ * arbitrary point in time. Between two samples, the position is interpolated linearly and
+ * the rotation spherically. After the newest sample, the pose is extrapolated, which is
+ * used to predict where the sensor will be once a frame is displayed rather than where
+ * it was when the frame started.
+ *
+ * The samples have to be added from a single thread, but the poses can be queried from
+ * any number of threads at the same time. The samples are stored in a ring of #Capacity
+ * slots that each carry a sequence number that is odd while the slot is written, so
+ * neither side ever waits for a lock. A query that overlaps with a slot being overwritten
+ * ignores that slot, which only affects samples that are #Capacity samples old.
+ */
+class SGCT_EXPORT PoseHistory {
+public:
+    /// The number of samples that are kept
+    static constexpr int Capacity = 64;
+
+    /// The shortest time in seconds over which velocities are estimated. Estimating them
+    /// from two adjacent samples of a fast tracking system would amplify its jitter
+    static constexpr double VelocityWindow = 0.01;
+
+    /// How the pose is extrapolated after the newest sample
+    enum class Prediction {
+        /// The newest sample is used as-is
+        None,
+        /// The position and rotation continue with their current velocities
+        Velocity,
+        /// The position continues with its current velocity and acceleration, and the
+        /// rotation with its current angular velocity
+        Acceleration
+    };
+
+    struct Sample {
+        /// The time in seconds, as returned by sgct::time, at which the pose was measured
+        double time = 0.0;
+        vec3 position = vec3{ 0.f, 0.f, 0.f };
+        quat rotation = quat{ 0.f, 0.f, 0.f, 1.f };
+    };
+
+    /**
+     * Adds a new sample. Samples that are not newer than the previous sample are ignored.
+     * This function must always be called from the same thread.
+     */
+    void add(const Sample& sample);
+
+    /**
+     * Computes the pose at the provided \p time. This function can be called from any
+     * thread.
+     *
+     * \param time The time in seconds for which the pose is requested. Times before the
+     *        oldest sample return the oldest sample
+     * \param prediction How the pose is extrapolated if \p time is after the newest
+     *        sample
+     * \param maxPrediction The longest time in seconds that the pose is extrapolated
+     *        past the newest sample. If the newest sample is older than that, for example
+     *        because the tracking system stopped sending, the pose stops moving
+     * \return The pose, or `std::nullopt` if no sample has been added yet
+     */
+    std::optional<Sample> pose(double time, Prediction prediction = Prediction::Velocity,
+        double maxPrediction = 0.1) const;
+
+    /// \return The number of samples that have been added so far
+    uint64_t nSamples() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> sequence = 0;
+        std::array<std::atomic<double>, 8> values;
+    };
+
+    std::array<Slot, Capacity> _slots;
+    std::atomic<uint64_t> _nSamples = 0;
+
+    /// Only accessed by the thread that adds the samples
+    double _newestTime = -std::numeric_limits<double>::infinity();
+};
+
+} // namespace sgct
+
+#endif // __SGCT__POSEHISTORY__H__
@@ -11,18 +11,26 @@
 
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
-#include <functional>
+#include <sgct/opengl.h>
+#include <array>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
-#include <thread>
 #include <vector>
 
 namespace sgct {
 
 class Image;
+class SequenceWriter;
+class Window;
 
 /**
- * This class is used internally by SGCT and is called when taking screenshots.
+ * This class is used internally by SGCT and is called when taking screenshots. The
+ * pixels are downloaded asynchronously into a ring of pixel buffer objects and are only
+ * read back once the GPU has finished writing them, so taking a screenshot does not stall
+ * the rendering. The images are then saved by the Engine's CaptureEncoder, either as
+ * separate files or appended to a single sequence file.
  */
 class SGCT_EXPORT ScreenCapture {
 public:
@@ -32,27 +40,28 @@ public:
     enum class CaptureSource { Texture, BackBuffer, LeftBackBuffer, RightBackBuffer };
     enum class EyeIndex { Mono, StereoLeft, StereoRight };
 
-    struct ScreenCaptureThreadInfo {
-        std::string filename;
-        std::unique_ptr<Image> frameBufferImage;
-        std::unique_ptr<std::thread> captureThread;
-        std::mutex* mutex = nullptr;
-        bool isRunning = false; // needed for test if running without join
-    };
+    /// The number of pixel buffer objects that the downloads cycle through. The download
+    /// of a frame has to be finished at the latest when its buffer is reused this many
+    /// captures later
+    static constexpr int NumberOfBuffers = 3;
 
     ScreenCapture(const Window& window, ScreenCapture::EyeIndex ei, int bytesPerColor,
         unsigned int colorDataType, bool addAlpha);
     ~ScreenCapture();
 
     /**
-     * Initializes the PBO or re-sizes it if the frame buffer size have changed.
+     * Initializes the PBOs or re-sizes them if the frame buffer size have changed. All
+     * captures that are still in progress are finished first.
      *
      * \param resolution The pixel resolution of the frame buffer
      */
     void resize(ivec2 resolution);
 
     /**
-     * This function saves the images to disc.
+     * Starts the download of the next image into one of the PBOs. The image is saved to
+     * disc after the download has finished on the GPU, which is detected in a later call
+     * to this function or to #update. This function only waits for the GPU if the
+     * downloads into all of the PBOs are still in progress.
      *
      * \param textureId The texture that will be streamed from the GPU if frame buffer
      *        objects are used in the rendering
@@ -61,21 +70,57 @@ public:
     void saveScreenCapture(unsigned int textureId,
         CaptureSource capSrc = CaptureSource::Texture);
 
+    /**
+     * Hands all images whose downloads have finished on the GPU to the CaptureEncoder
+     * without waiting for the remaining ones. This has to be called once per frame,
+     * regardless of whether a screenshot was taken in that frame.
+     */
+    void update();
+
 private:
-    std::string createFilename(uint64_t frameNumber);
-    int availableCaptureThread();
-    Image* prepareImage(int index, std::string file);
+    struct Download {
+        unsigned int pbo = 0;
+        GLsync fence = nullptr;
+        std::string filename;
+        uint64_t frameNumber = 0;
+    };
+
+    std::string createFilePrefix() const;
+    std::string createFilename(uint64_t frameNumber) const;
+    void finishDownload(Download& download);
+    void finishDownloads();
+    std::unique_ptr<Image> acquireImage();
+    void releaseImage(std::unique_ptr<Image> image);
+    void waitForImages();
+
+    /// The downloads in the order in which the PBOs are used. The one at
+    /// `_nextDownload` is the oldest one
+    std::array<Download, NumberOfBuffers> _downloads;
+    int _nextDownload = 0;
 
     std::mutex _mutex;
-    std::vector<ScreenCaptureThreadInfo> _captureInfos;
+    /// Signalled when the CaptureEncoder has finished with one of our images
+    std::condition_variable _imageCond;
+    std::vector<std::unique_ptr<Image>> _freeImages;
+    /// The number of images that currently exist, whether they are free, queued, or are
+    /// being saved
+    int _nImages = 0;
 
-    const unsigned int _nThreads;
-    unsigned int _pbo = 0;
     const unsigned int _downloadType;
+    /// The size of the resulting images
     int _dataSize = 0;
+    /// The size of the data downloaded into each PBO
+    int _downloadSize = 0;
     ivec2 _resolution = ivec2{ 0, 0 };
     const int _bytesPerColor;
     const bool _addAlpha;
+    /// Reading back 3 channel 8 bit pixels is slow on most drivers, so those are
+    /// downloaded with 4 channels and the fourth channel is removed on the CPU instead
+    const bool _removeAlpha;
+
+    /// Receives all screenshots if the Engine's capture settings ask for a sequence file.
+    /// Created with the first screenshot
+    std::unique_ptr<SequenceWriter> _sequence;
 
     const EyeIndex _eyeIndex;
     const Window& _window;
@@ -0,0 +1,146 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__SEQUENCEFILE__H__
+#define __SGCT__SEQUENCEFILE__H__
+
+#include <sgct/sgctexports.h>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+namespace sgct {
+
+class Image;
+
+/**
+ * A sequence file contains all screenshots of a single window and eye, which avoids
+ * creating one file per frame. All values are stored in little endian.
+ *
+ *   Header:  "SGCTSEQ\0" (8 bytes), version (uint32), compression (uint32)
+ *   Frames:  "FRAM" (4 bytes), frame number (uint64), width (uint32), height (uint32),
+ *            channels (uint32), bytes per channel (uint32), data size (uint64), data
+ *   Index:   For each frame: frame number (uint64), file offset of the frame (uint64)
+ *   Footer:  file offset of the index (uint64), number of frames (uint64),
+ *            "SGCTIDX\0" (8 bytes)
+ *
+ * The pixel data of each frame is stored in the same layout as in the Image class, that
+ * is with the rows stored bottom to top and the color channels in BGR(A) order. If the
+ * footer is missing, for example because the application crashed, the frames can still
+ * be recovered by reading them one after another from the beginning of the file.
+ */
+class SGCT_EXPORT SequenceWriter {
+public:
+    enum class Compression {
+        /// The pixel data is stored as it is
+        None = 0,
+        /// The pixel data of every frame is compressed separately with zlib
+        Deflate = 1
+    };
+
+    /**
+     * Creates the file at \p path, overwriting an existing file, and writes the header.
+     *
+     * \throw Error If the file could not be created
+     */
+    SequenceWriter(const std::filesystem::path& path, Compression compression);
+
+    /**
+     * Writes the index and the footer and closes the file. The index is left out if a
+     * failed write could not be undone, in which case the SequenceReader searches for
+     * the frames instead.
+     */
+    ~SequenceWriter();
+
+    /**
+     * Appends the \p image to the end of the file. This function can be called from
+     * multiple threads at the same time; the compression happens on the calling thread
+     * and only the writing is serialized. The frames do not have to be appended in the
+     * order of their \p frameNumber.
+     *
+     * If writing the frame fails, the part of it that was written is removed from the
+     * file. If that is not possible either, all following calls fail.
+     *
+     * \throw Error If the frame could not be compressed or written
+     */
+    void append(uint64_t frameNumber, const Image& image);
+
+private:
+    SequenceWriter(const SequenceWriter&) = delete;
+    SequenceWriter(SequenceWriter&&) = delete;
+    SequenceWriter& operator=(const SequenceWriter&) = delete;
+    SequenceWriter& operator=(SequenceWriter&&) = delete;
+
+    struct IndexEntry {
+        uint64_t frameNumber = 0;
+        uint64_t offset = 0;
+    };
+
+    const Compression _compression;
+
+    std::mutex _mutex;
+    FILE* _file = nullptr;
+    uint64_t _offset = 0;
+    std::vector<IndexEntry> _index;
+    /// Set when a failed write left an incomplete frame at the end of the file
+    bool _hasFailed = false;
+};
+
+/**
+ * Reads the frames of a sequence file that was written by the SequenceWriter.
+ */
+class SGCT_EXPORT SequenceReader {
+public:
+    /**
+     * Opens the file at \p path and reads its index. If the file has no index, the
+     * frames are found by reading through the whole file.
+     *
+     * \throw Error If the file could not be opened or is not a sequence file
+     */
+    explicit SequenceReader(const std::filesystem::path& path);
+    ~SequenceReader();
+
+    /// \return The number of frames in the file
+    size_t numberOfFrames() const;
+
+    /// \return The frame number of the \p i-th frame in the file, sorted by frame number
+    uint64_t frameNumber(size_t i) const;
+
+    /**
+     * Reads the \p i-th frame, sorted by frame number, into the \p image. The size,
+     * number of channels, and bytes per channel of the \p image are adjusted to the
+     * frame.
+     *
+     * \throw Error If the frame could not be read or decompressed
+     */
+    void read(size_t i, Image& image);
+
+private:
+    SequenceReader(const SequenceReader&) = delete;
+    SequenceReader(SequenceReader&&) = delete;
+    SequenceReader& operator=(const SequenceReader&) = delete;
+    SequenceReader& operator=(SequenceReader&&) = delete;
+
+    struct IndexEntry {
+        uint64_t frameNumber = 0;
+        uint64_t offset = 0;
+    };
+
+    void rebuildIndex();
+
+    FILE* _file = nullptr;
+    SequenceWriter::Compression _compression = SequenceWriter::Compression::None;
+    std::vector<IndexEntry> _index;
+    std::vector<unsigned char> _buffer;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__SEQUENCEFILE__H__
@@ -0,0 +1,92 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#ifndef __SGCT__SYNCFANOUT__H__
+#define __SGCT__SYNCFANOUT__H__
+
+#include <sgct/sgctexports.h>
+#include <sgct/network.h>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sgct {
+
+/**
+ * Sends the per-frame sync data to multiple clients concurrently. Each job sends its own
+ * header followed by a payload that can be shared between all jobs, so a slow client only
+ * delays its own send instead of all of the ones that come after it.
+ */
+class SGCT_EXPORT SyncFanOut {
+public:
+    struct Job {
+        Network* connection = nullptr;
+        /// The index of the connection in the list of sync connections
+        int index = -1;
+        std::array<char, Network::HeaderSize> header = {};
+        bool isDelta = false;
+        bool isMulticast = false;
+        const char* payload = nullptr;
+        int length = 0;
+        /// The time in seconds that sending the header and payload took
+        double sendTime = 0.0;
+        /// The exception that sending the header and payload threw, if any
+        std::exception_ptr error;
+    };
+
+    /**
+     * Starts \p nThreads threads that take part in sending in addition to the thread that
+     * calls #run.
+     */
+    explicit SyncFanOut(int nThreads);
+    ~SyncFanOut();
+
+    /**
+     * Sends each of the jobs' header and payload to the jobs' connections and returns
+     * after all sends have finished. The calling thread takes part in sending. A send
+     * that fails stores its exception in the job and does not affect the other jobs.
+     */
+    void run(std::vector<Job>& jobs);
+
+    /// Sends the header and payload of a single \p job on the calling thread
+    static void send(Job& job);
+
+    /// The job list that is reused between frames to not allocate it every frame
+    std::vector<Job> jobs;
+
+private:
+    SyncFanOut(const SyncFanOut&) = delete;
+    SyncFanOut(SyncFanOut&&) = delete;
+    SyncFanOut& operator=(const SyncFanOut&) = delete;
+    SyncFanOut& operator=(SyncFanOut&&) = delete;
+
+    void processJobs();
+    void worker();
+
+    std::vector<std::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _startCond;
+    std::condition_variable _doneCond;
+    bool _shouldTerminate = false;
+    uint64_t _generation = 0;
+    int _nBusyWorkers = 0;
+    size_t _nRemainingJobs = 0;
+    std::atomic<size_t> _nextJob = 0;
+
+    std::vector<Job>* _jobs = nullptr;
+};
+
+} // namespace sgct
+
+#endif // __SGCT__SYNCFANOUT__H__
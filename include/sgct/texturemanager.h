@@ -10,19 +10,71 @@
 #define __SGCT__TEXTUREMANAGER__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/math.h>
+#include <sgct/opengl.h>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 namespace sgct {
 
+class CompressedTexture;
 class Image;
 
 /**
  * The TextureManager loads and handles textures. It is a singleton and can be accessed
- * anywhere using its static instance. Currently only PNG textures are supported.
+ * anywhere using its static instance. Files with the `.ktx2` and `.dds` extensions are
+ * loaded as block-compressed textures with their precomputed mipmap levels (see
+ * CompressedTexture), all other files are loaded as an Image. If OpenGL 4.2 is
+ * available, all textures use immutable storage.
+ *
+ * Textures can also be loaded asynchronously. Their images are decoded on a small pool
+ * of worker threads and uploaded through a ring of pixel buffer objects. The textures
+ * only become available in the #update function that the Engine calls at the beginning
+ * of each frame, once the GPU has finished the upload.
  */
 class SGCT_EXPORT TextureManager {
 public:
+    struct Statistics {
+        /// The number of textures that are waiting to be decoded or uploaded
+        int nPending = 0;
+        /// The number of bytes of decoded images that are waiting to be uploaded or that
+        /// are currently being uploaded
+        size_t bytesInFlight = 0;
+        /// The number of textures that have been loaded asynchronously
+        uint64_t nLoaded = 0;
+        /// The time in seconds between the start and the end of the upload of the most
+        /// recent texture
+        double lastUploadLatency = 0.0;
+        /// The average time in seconds between the start and the end of an upload
+        double averageUploadLatency = 0.0;
+        /// The time in seconds between the call to #loadTextureAsync and the texture
+        /// becoming available for the most recent texture
+        double lastTotalLatency = 0.0;
+    };
+
+    struct TextureInfo {
+        unsigned int id = 0;
+        /// The file from which the texture was loaded, empty for textures that were
+        /// created from an Image or CompressedTexture directly
+        std::filesystem::path filename;
+        ivec2 size = ivec2{ 0, 0 };
+        int nLevels = 1;
+        /// The name of the format in which the texture is stored on the GPU
+        std::string_view format;
+        /// The estimated number of bytes used on the GPU, including all mipmap levels
+        size_t nBytes = 0;
+    };
+
     static TextureManager& instance();
     static void destroy();
 
@@ -54,6 +106,47 @@ public:
     unsigned int loadTexture(const Image& img, bool interpolate = true,
         float anisotropicFilterSize = 1.f, int mipmapLevels = 8);
 
+    /**
+     * Loads a block-compressed texture to the TextureManager. The blocks are uploaded
+     * without any conversion and the texture uses the mipmap levels that are stored in
+     * the \p texture instead of generating them.
+     *
+     * \param texture The texture with the compressed data
+     * \param interpolate Set to true for using interpolation (bi-linear filtering)
+     * \param anisotropicFilterSize The filter size that is used for the anisotropic
+     *        filtering. If this value is 1.f, only bilinear filtering is used
+     * \return The OpenGL name for the texture that was loaded
+     */
+    unsigned int loadTexture(const CompressedTexture& texture, bool interpolate = true,
+        float anisotropicFilterSize = 1.f);
+
+    /**
+     * Loads a texture to the TextureManager without blocking the calling thread. The
+     * returned future becomes ready in a later call to #update and contains the OpenGL
+     * name of the texture, or the exception that was raised while loading the image.
+     *
+     * \param filename The path to the texture
+     * \param interpolate Set to true for using interpolation (bi-linear filtering)
+     * \param anisotropicFilterSize The filter size that is used for the anisotropic
+     *        filtering. If this value is 1.f, only bilinear filtering is used
+     * \param mipmapLevels The number of mipmap levels that will be generated, setting
+     *        this value to 1 or less disables mipmaps
+     * \return The future that will contain the OpenGL name of the texture
+     */
+    std::future<unsigned int> loadTextureAsync(std::filesystem::path filename,
+        bool interpolate = true, float anisotropicFilterSize = 1.f,
+        int mipmapLevels = 8);
+
+    /**
+     * Publishes the asynchronously loaded textures whose uploads have finished and
+     * starts the uploads of newly decoded images. This is called by the Engine at the
+     * beginning of each frame while the shared OpenGL context is current.
+     */
+    void update();
+
+    /// \return A snapshot of the state of the asynchronous texture loading
+    Statistics statistics() const;
+
     /**
      * Removes a previously generated OpenGL texture.
      *
@@ -62,10 +155,51 @@ public:
      */
     void removeTexture(unsigned int textureId);
 
+    /// \return The information about all textures that are currently loaded
+    const std::vector<TextureInfo>& textures() const;
+
+    /// Logs the size, format, and memory usage of each loaded texture and their total
+    void logMemoryUsage() const;
+
 private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request;
+
+    struct Upload {
+        unsigned int pbo = 0;
+        size_t capacity = 0;
+        GLsync fence = nullptr;
+        TextureInfo texture;
+        Clock::time_point start;
+        std::unique_ptr<Request> request;
+    };
+
+    /// The number of pixel buffer objects that the uploads cycle through, which limits
+    /// the number of textures that are uploaded at the same time
+    static constexpr int NumberOfUploadBuffers = 4;
+
     ~TextureManager();
+    void worker();
+    void startUpload(Upload& upload, std::unique_ptr<Request> request);
+    void finishUpload(Upload& upload);
+
     static TextureManager* _instance;
-    std::vector<unsigned int> _textures;
+    std::vector<TextureInfo> _textures;
+
+    mutable std::mutex _mutex;
+    /// Signalled when a texture was requested or the decode threads should terminate
+    std::condition_variable _requestCond;
+    std::deque<std::unique_ptr<Request>> _decodeQueue;
+    std::deque<std::unique_ptr<Request>> _uploadQueue;
+    bool _shouldTerminate = false;
+    Statistics _statistics;
+    double _totalUploadLatency = 0.0;
+    /// The decode threads are only started with the first asynchronous request
+    std::vector<std::thread> _threads;
+
+    /// Only accessed from the thread that calls #update
+    std::array<Upload, NumberOfUploadBuffers> _uploads;
 };
 
 } // namespace sgct
@@ -11,6 +11,7 @@
 
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
+#include <sgct/posehistory.h>
 #include <string>
 #include <vector>
 
@@ -45,7 +46,13 @@ public:
      * Set the number of analog axes.
      */
     void setNumberOfAxes(int numOfAxes);
-    void setSensorTransform(vec3 vec, quat rot);
+
+    /**
+     * Set the transform of the sensor that was measured at \p time, in seconds as
+     * returned by sgct::time.
+     */
+    void setSensorTransform(vec3 vec, quat rot, double time);
+
     void setButtonValue(bool val, int index);
     void setAnalogValue(const double* array, int size);
 
@@ -143,6 +150,24 @@ public:
      */
     mat4 worldTransformPrevious() const;
 
+    /**
+     * Computes the sensor's transform matrix in world coordinates at a point in time
+     * from the recent samples of the sensor. Times in the past are interpolated between
+     * the samples and times in the future are predicted from them.
+     *
+     * \param time The time, as returned by sgct::time, for which the transform is needed
+     * \param prediction How the pose is extrapolated past the newest sample
+     * \param maxPrediction The longest time in seconds that the pose is extrapolated
+     * \return The transform matrix, or #worldTransform if no sample has been received
+     */
+    mat4 worldTransform(double time, PoseHistory::Prediction prediction,
+        double maxPrediction = 0.1) const;
+
+    /**
+     * \return The most recent raw sensor poses with the time at which they were received
+     */
+    const PoseHistory& poseHistory() const;
+
     /**
      * \return The raw sensor rotation quaternion
      */
@@ -177,7 +202,7 @@ public:
 
 private:
     void calculateTransform();
-    void setTrackerTimeStamp();
+    void setTrackerTimeStamp(double timeStamp);
     void setAnalogTimeStamp();
     void setButtonTimeStamp(int index);
 
@@ -195,6 +220,10 @@ private:
     mat4 _worldTransform = mat4(1.f);
     mat4 _worldTransformPrevious = mat4(1.f);
 
+    /// The transform of the parent tracker when the newest sample was received
+    mat4 _parentTransform = mat4(1.f);
+    PoseHistory _poseHistory;
+
     quat _sensorRotation = quat{ 0.f, 0.f, 0.f, 0.f };
     quat _sensorRotationPrevious = quat{ 0.f, 0.f, 0.f, 0.f };
 
@@ -42,8 +42,12 @@ public:
 
     /**
      * Update the user position if headtracking is used. The engine calls this function.
+     *
+     * \param displayTime The time at which the frame that is about to be rendered is
+     *        expected to be shown. The head pose is predicted for this time plus the
+     *        tracking latency of the user
      */
-    void updateTrackingDevices();
+    void updateTrackingDevices(double displayTime);
     void addTracker(std::string name);
 
     TrackingDevice* headDevice() const;
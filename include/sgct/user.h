@@ -11,10 +11,13 @@
 
 #include <sgct/sgctexports.h>
 #include <sgct/math.h>
+#include <sgct/posehistory.h>
 #include <string>
 
 namespace sgct {
 
+namespace config { struct User; }
+
 /**
  * Helper class for setting user variables.
  */
@@ -77,6 +80,19 @@ public:
     const std::string& headTrackerName() const;
     const std::string& headTrackerDeviceName() const;
 
+    /**
+     * \return How the head pose is predicted for the time at which a frame is displayed.
+     *         Unless the configuration asks for a prediction, the most recent pose is
+     *         used as-is
+     */
+    PoseHistory::Prediction headTrackerPrediction() const;
+
+    /**
+     * \return The time in seconds that is added to the expected duration of a frame when
+     *         predicting the head pose
+     */
+    double headTrackerLatency() const;
+
     /**
      * \return `true` if user is tracked
      */
@@ -106,6 +122,8 @@ private:
 
     std::string _headTrackerDeviceName;
     std::string _headTrackerName;
+    PoseHistory::Prediction _headTrackerPrediction = PoseHistory::Prediction::None;
+    double _headTrackerLatency = 0.0;
 };
 
 } // namespace sgct
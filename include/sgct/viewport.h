@@ -14,6 +14,7 @@
 #include <sgct/correctionmesh.h>
 #include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -56,6 +57,7 @@ private:
     std::filesystem::path _blendMaskFilename;
     std::filesystem::path _blackLevelMaskFilename;
     std::filesystem::path _meshFilename;
+    std::optional<float> _meshTolerance;
     bool _isTracked;
     bool _useTextureMappedProjection = false;
     unsigned int _overlayTextureIndex = 0;
@@ -10,6 +10,7 @@
 #define __SGCT__WINDOW__H__
 
 #include <sgct/sgctexports.h>
+#include <sgct/gputimer.h>
 #include <sgct/shaderprogram.h>
 #include <sgct/viewport.h>
 #include <filesystem>
@@ -157,6 +158,12 @@ public:
      */
     ivec2 framebufferResolution() const;
 
+    /**
+     * \return The timer that measures the GPU time of the warping and blending in this
+     *         window's OpenGL context
+     */
+    const GpuTimer& gpuTimer() const;
+
     /**
      * \return `true` if this window is resized
      */
@@ -439,6 +446,11 @@ private:
     };
     std::optional<FXAAShader> _fxaa;
 
+    /// Measures the rendering in this window's context, which is where the warping and
+    /// blending happens. The rendering into the framebuffers happens in the shared
+    /// context and is measured by Engine::gpuTimer
+    GpuTimer _gpuTimer;
+
     std::vector<std::unique_ptr<Viewport>> _viewports;
     std::unique_ptr<OffScreenBuffer> _finalFBO;
 
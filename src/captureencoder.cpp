@@ -0,0 +1,148 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/captureencoder.h>
+
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <chrono>
+
+namespace sgct {
+
+CaptureEncoder::CaptureEncoder(int nThreads, int capacity, Policy policy)
+    : _capacity(static_cast<size_t>(std::max(capacity, 1)))
+    , _policy(policy)
+{
+    nThreads = std::max(nThreads, 1);
+    // The encoder threads are saving images at the same time, so an image that is
+    // compressed on multiple threads would otherwise oversubscribe the cores
+    _nThreadsPerImage = std::max(
+        static_cast<int>(std::thread::hardware_concurrency()) / nThreads,
+        1
+    );
+    _threads.reserve(nThreads);
+    for (int i = 0; i < nThreads; i++) {
+        _threads.emplace_back([this]() { worker(); });
+    }
+    Log::Debug("Number of screencapture threads is set to {}", nThreads);
+}
+
+CaptureEncoder::~CaptureEncoder() {
+    {
+        const std::unique_lock lock(_mutex);
+        _shouldTerminate = true;
+    }
+    _jobCond.notify_all();
+    for (std::thread& thread : _threads) {
+        thread.join();
+    }
+}
+
+bool CaptureEncoder::submit(std::string filename, Image::Format format,
+                            std::unique_ptr<Image> image, DoneFunction done)
+{
+    EncodeFunction encode = [filename, format, n = _nThreadsPerImage](const Image& img) {
+        img.save(filename, format, n);
+    };
+    return submit(
+        std::move(filename),
+        std::move(encode),
+        std::move(image),
+        std::move(done)
+    );
+}
+
+bool CaptureEncoder::submit(std::string name, EncodeFunction encode,
+                            std::unique_ptr<Image> image, DoneFunction done)
+{
+    ZoneScoped;
+
+    std::unique_lock lock(_mutex);
+    if (_jobs.size() >= _capacity) {
+        switch (_policy) {
+            case Policy::Block:
+            {
+                ZoneScopedN("Wait for encoder");
+                _spaceCond.wait(lock, [this]() { return _jobs.size() < _capacity; });
+                break;
+            }
+            case Policy::Drop:
+                _statistics.nDropped++;
+                lock.unlock();
+                Log::Warning("Dropping screenshot {}", name);
+                done(std::move(image));
+                return false;
+            case Policy::Grow:
+                break;
+            default:
+                throw std::logic_error("Unhandled case label");
+        }
+    }
+
+    _jobs.push_back({
+        std::move(name),
+        std::move(encode),
+        std::move(image),
+        std::move(done)
+    });
+    _statistics.queueDepth = static_cast<int>(_jobs.size());
+    _statistics.maxQueueDepth =
+        std::max(_statistics.maxQueueDepth, _statistics.queueDepth);
+    lock.unlock();
+
+    _jobCond.notify_one();
+    return true;
+}
+
+CaptureEncoder::Statistics CaptureEncoder::statistics() const {
+    const std::unique_lock lock(_mutex);
+    return _statistics;
+}
+
+void CaptureEncoder::worker() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(_mutex);
+            _jobCond.wait(lock, [this]() { return _shouldTerminate || !_jobs.empty(); });
+            if (_jobs.empty()) {
+                // Only terminate once all queued images have been saved
+                return;
+            }
+            job = std::move(_jobs.front());
+            _jobs.pop_front();
+            _statistics.queueDepth = static_cast<int>(_jobs.size());
+        }
+        _spaceCond.notify_one();
+
+        ZoneScopedN("Save screenshot");
+        const auto t0 = std::chrono::steady_clock::now();
+        try {
+            job.encode(*job.image);
+        }
+        catch (const std::runtime_error& e) {
+            Log::Error(e.what());
+        }
+        const std::chrono::duration<double> dt = std::chrono::steady_clock::now() - t0;
+
+        {
+            const std::unique_lock lock(_mutex);
+            _statistics.nEncoded++;
+            _statistics.lastEncodeTime = dt.count();
+            _totalEncodeTime += dt.count();
+            _statistics.averageEncodeTime =
+                _totalEncodeTime / static_cast<double>(_statistics.nEncoded);
+        }
+
+        job.done(std::move(job.image));
+    }
+}
+
+} // namespace sgct
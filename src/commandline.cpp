@@ -38,6 +38,10 @@ Configuration parseArguments(std::vector<std::string>& arg) {
             config.nodeId = std::stoi(arg[i + 1]);
             arg.erase(arg.begin() + i, arg.begin() + i + 2);
         }
+        else if (arg[i] == "--log-file" && arg.size() > (i + 1)) {
+            config.logFile = arg[i + 1];
+            arg.erase(arg.begin() + i, arg.begin() + i + 2);
+        }
         else if (arg[i] == "--notify" && arg.size() > (i + 1)) {
             const Log::Level level = [](std::string_view l) {
                 if (l == "error")        { return Log::Level::Error; }
@@ -123,6 +127,8 @@ Parameters:
     Disable frame sync
 --notify <"error", "warning", "info", or "debug">
     Set the notify level used in the Log
+--log-file <filename>
+    Appends all log messages to this file, which is rotated when it grows too large
 --capture-jpg
     Use jpg images for screen capture
 --capture-tga
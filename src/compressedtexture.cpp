@@ -0,0 +1,983 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/compressedtexture.h>
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/image.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#define Err(code, msg) Error(Error::Component::Image, code, msg)
+
+namespace sgct {
+
+namespace {
+    constexpr std::array<unsigned char, 12> Ktx2Identifier = {
+        0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'
+    };
+    constexpr size_t Ktx2HeaderSize = Ktx2Identifier.size() + 9 * sizeof(uint32_t) +
+        4 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+    constexpr size_t Ktx2LevelIndexSize = 3 * sizeof(uint64_t);
+
+    // The subset of the Vulkan formats that can be stored in KTX2 files that we support
+    constexpr uint32_t VkFormatBC1RgbUnorm = 131;
+    constexpr uint32_t VkFormatBC1RgbSrgb = 132;
+    constexpr uint32_t VkFormatBC1RgbaUnorm = 133;
+    constexpr uint32_t VkFormatBC1RgbaSrgb = 134;
+    constexpr uint32_t VkFormatBC4Unorm = 139;
+    constexpr uint32_t VkFormatBC7Unorm = 145;
+    constexpr uint32_t VkFormatBC7Srgb = 146;
+
+    // The color models of the Khronos data format descriptor
+    constexpr uint32_t DfModelBC1A = 128;
+    constexpr uint32_t DfModelBC4 = 131;
+    constexpr uint32_t DfModelBC7 = 135;
+
+    constexpr std::string_view DdsMagic = "DDS ";
+    constexpr size_t DdsHeaderSize = 124;
+    constexpr size_t DdsHeader10Size = 20;
+
+    // The subset of the DXGI formats that can be stored in DDS files that we support
+    constexpr uint32_t DxgiFormatBC1Unorm = 71;
+    constexpr uint32_t DxgiFormatBC1Srgb = 72;
+    constexpr uint32_t DxgiFormatBC4Unorm = 80;
+    constexpr uint32_t DxgiFormatBC7Unorm = 98;
+    constexpr uint32_t DxgiFormatBC7Srgb = 99;
+
+    constexpr uint32_t fourCC(std::string_view code) {
+        return static_cast<uint32_t>(code[0]) | static_cast<uint32_t>(code[1]) << 8 |
+            static_cast<uint32_t>(code[2]) << 16 | static_cast<uint32_t>(code[3]) << 24;
+    }
+
+    template <typename T>
+    void put(unsigned char*& p, T value) {
+        std::memcpy(p, &value, sizeof(T));
+        p += sizeof(T);
+    }
+
+    template <typename T>
+    void append(std::vector<unsigned char>& buffer, T value) {
+        const size_t offset = buffer.size();
+        buffer.resize(offset + sizeof(T));
+        std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    }
+
+    template <typename T>
+    T get(const unsigned char*& p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return value;
+    }
+
+    bool seek(FILE* file, uint64_t offset) {
+#ifdef WIN32
+        return _fseeki64(file, static_cast<int64_t>(offset), SEEK_SET) == 0;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif // WIN32
+    }
+
+    size_t alignTo(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    int maxLevels(ivec2 size) {
+        int nLevels = 1;
+        int s = std::max(size.x, size.y);
+        while (s > 1) {
+            s /= 2;
+            nLevels++;
+        }
+        return nLevels;
+    }
+
+    using Pixel = std::array<uint8_t, 4>;
+    using Block = std::array<Pixel, 16>;
+
+    /// \return The pixels of the \p image with 4 channels in RGBA order
+    std::vector<Pixel> toRgba(const Image& image) {
+        const int nChannels = image.channels();
+        const int bpc = image.bytesPerChannel();
+        const size_t nPixels = static_cast<size_t>(image.size().x) * image.size().y;
+
+        std::vector<Pixel> res(nPixels);
+        for (size_t i = 0; i < nPixels; i++) {
+            // For 16 bit images we use the most significant byte of each little endian
+            // value
+            auto channel = [&](int c) -> uint8_t {
+                return image.data()[(i * nChannels + c) * bpc + bpc - 1];
+            };
+
+            switch (nChannels) {
+                case 1:
+                    res[i] = { channel(0), channel(0), channel(0), 255 };
+                    break;
+                case 2:
+                    res[i] = { channel(0), channel(1), 0, 255 };
+                    break;
+                case 3:
+                    res[i] = { channel(2), channel(1), channel(0), 255 };
+                    break;
+                case 4:
+                    res[i] = { channel(2), channel(1), channel(0), channel(3) };
+                    break;
+                default:
+                    throw std::logic_error("Unhandled case label");
+            }
+        }
+        return res;
+    }
+
+    /// Averages each 2x2 pixels of the \p pixels, repeating the last row and column for
+    /// odd sizes, and updates the \p size to the size of the result
+    std::vector<Pixel> downsample(const std::vector<Pixel>& pixels, ivec2& size) {
+        const ivec2 res = ivec2{ std::max(size.x / 2, 1), std::max(size.y / 2, 1) };
+
+        std::vector<Pixel> dst(static_cast<size_t>(res.x) * res.y);
+        for (int y = 0; y < res.y; y++) {
+            const int y0 = std::min(2 * y, size.y - 1);
+            const int y1 = std::min(2 * y + 1, size.y - 1);
+            for (int x = 0; x < res.x; x++) {
+                const int x0 = std::min(2 * x, size.x - 1);
+                const int x1 = std::min(2 * x + 1, size.x - 1);
+                const Pixel& p00 = pixels[static_cast<size_t>(y0) * size.x + x0];
+                const Pixel& p01 = pixels[static_cast<size_t>(y0) * size.x + x1];
+                const Pixel& p10 = pixels[static_cast<size_t>(y1) * size.x + x0];
+                const Pixel& p11 = pixels[static_cast<size_t>(y1) * size.x + x1];
+
+                Pixel& p = dst[static_cast<size_t>(y) * res.x + x];
+                for (int c = 0; c < 4; c++) {
+                    const int sum = p00[c] + p01[c] + p10[c] + p11[c];
+                    p[c] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+        size = res;
+        return dst;
+    }
+
+    /// \return The 4x4 pixels starting at \p x, \p y, repeating the last row and column
+    ///         for blocks that extend beyond the image
+    Block extractBlock(const std::vector<Pixel>& pixels, ivec2 size, int x, int y) {
+        Block block;
+        for (int j = 0; j < 4; j++) {
+            const int py = std::min(y + j, size.y - 1);
+            for (int i = 0; i < 4; i++) {
+                const int px = std::min(x + i, size.x - 1);
+                block[j * 4 + i] = pixels[static_cast<size_t>(py) * size.x + px];
+            }
+        }
+        return block;
+    }
+
+    uint16_t to565(int r, int g, int b) {
+        const int r5 = (r * 31 + 127) / 255;
+        const int g6 = (g * 63 + 127) / 255;
+        const int b5 = (b * 31 + 127) / 255;
+        return static_cast<uint16_t>(r5 << 11 | g6 << 5 | b5);
+    }
+
+    std::array<int, 3> from565(uint16_t c) {
+        const int r5 = (c >> 11) & 0x1F;
+        const int g6 = (c >> 5) & 0x3F;
+        const int b5 = c & 0x1F;
+        return { r5 << 3 | r5 >> 2, g6 << 2 | g6 >> 4, b5 << 3 | b5 >> 2 };
+    }
+
+    void encodeBC1(const Block& block, unsigned char* dst) {
+        // The endpoints are the corners of the bounding box of the colors, moved inwards
+        // slightly as the outermost colors are rare and the other colors would otherwise
+        // be quantized too coarsely
+        std::array<int, 3> lo = { 255, 255, 255 };
+        std::array<int, 3> hi = { 0, 0, 0 };
+        std::array<int, 3> mean = { 0, 0, 0 };
+        for (const Pixel& p : block) {
+            for (int c = 0; c < 3; c++) {
+                lo[c] = std::min<int>(lo[c], p[c]);
+                hi[c] = std::max<int>(hi[c], p[c]);
+                mean[c] += p[c];
+            }
+        }
+        for (int c = 0; c < 3; c++) {
+            mean[c] /= 16;
+            const int inset = (hi[c] - lo[c]) / 16;
+            lo[c] += inset;
+            hi[c] -= inset;
+        }
+
+        // Choose the diagonal of the bounding box along which the colors are spread by
+        // looking at the signs of the covariances of red and blue with green
+        int covRG = 0;
+        int covBG = 0;
+        for (const Pixel& p : block) {
+            covRG += (p[0] - mean[0]) * (p[1] - mean[1]);
+            covBG += (p[2] - mean[2]) * (p[1] - mean[1]);
+        }
+        if (covRG < 0) {
+            std::swap(lo[0], hi[0]);
+        }
+        if (covBG < 0) {
+            std::swap(lo[2], hi[2]);
+        }
+
+        uint16_t c0 = to565(hi[0], hi[1], hi[2]);
+        uint16_t c1 = to565(lo[0], lo[1], lo[2]);
+        // The first endpoint has to be larger to select the mode with 4 colors
+        if (c0 < c1) {
+            std::swap(c0, c1);
+        }
+
+        uint32_t indices = 0;
+        if (c0 != c1) {
+            const std::array<int, 3> e0 = from565(c0);
+            const std::array<int, 3> e1 = from565(c1);
+            std::array<std::array<int, 3>, 4> palette;
+            palette[0] = e0;
+            palette[1] = e1;
+            for (int c = 0; c < 3; c++) {
+                palette[2][c] = (2 * e0[c] + e1[c]) / 3;
+                palette[3][c] = (e0[c] + 2 * e1[c]) / 3;
+            }
+
+            for (int i = 0; i < 16; i++) {
+                int best = 0;
+                int bestDistance = std::numeric_limits<int>::max();
+                for (int j = 0; j < 4; j++) {
+                    int distance = 0;
+                    for (int c = 0; c < 3; c++) {
+                        const int d = block[i][c] - palette[j][c];
+                        distance += d * d;
+                    }
+                    if (distance < bestDistance) {
+                        best = j;
+                        bestDistance = distance;
+                    }
+                }
+                indices |= static_cast<uint32_t>(best) << (2 * i);
+            }
+        }
+
+        put(dst, c0);
+        put(dst, c1);
+        put(dst, indices);
+    }
+
+    void encodeBC4(const Block& block, unsigned char* dst) {
+        int lo = 255;
+        int hi = 0;
+        for (const Pixel& p : block) {
+            lo = std::min<int>(lo, p[0]);
+            hi = std::max<int>(hi, p[0]);
+        }
+
+        // With the first endpoint being larger, the remaining 6 values are interpolated
+        // between the endpoints
+        std::array<int, 8> palette;
+        palette[0] = hi;
+        palette[1] = lo;
+        for (int i = 2; i < 8; i++) {
+            palette[i] = ((8 - i) * hi + (i - 1) * lo) / 7;
+        }
+
+        uint64_t indices = 0;
+        if (hi != lo) {
+            for (int i = 0; i < 16; i++) {
+                int best = 0;
+                int bestDistance = std::numeric_limits<int>::max();
+                for (int j = 0; j < 8; j++) {
+                    const int distance = std::abs(block[i][0] - palette[j]);
+                    if (distance < bestDistance) {
+                        best = j;
+                        bestDistance = distance;
+                    }
+                }
+                indices |= static_cast<uint64_t>(best) << (3 * i);
+            }
+        }
+
+        dst[0] = static_cast<unsigned char>(hi);
+        dst[1] = static_cast<unsigned char>(lo);
+        for (int i = 0; i < 6; i++) {
+            dst[2 + i] = static_cast<unsigned char>(indices >> (8 * i));
+        }
+    }
+
+    /**
+     * Reverses the order of the rows of the BC1 or BC4 blocks in \p data that contain a
+     * level of the \p size. The height has to be a multiple of 4 or be smaller than 4, as
+     * the rows could otherwise not be moved between the blocks.
+     */
+    void flipBlocks(unsigned char* data, CompressedTexture::Format format, ivec2 size) {
+        const size_t blockSize = CompressedTexture::blockSize(format);
+        const size_t rowSize = static_cast<size_t>((size.x + 3) / 4) * blockSize;
+        const size_t nBlockRows = static_cast<size_t>((size.y + 3) / 4);
+        const size_t nRows = static_cast<size_t>(std::min(size.y, 4));
+
+        for (size_t i = 0; i < nBlockRows / 2; i++) {
+            std::swap_ranges(
+                data + i * rowSize,
+                data + (i + 1) * rowSize,
+                data + (nBlockRows - i - 1) * rowSize
+            );
+        }
+
+        for (unsigned char* b = data; b < data + nBlockRows * rowSize; b += blockSize) {
+            if (format == CompressedTexture::Format::BC1) {
+                // The 2 bit indices of each row are stored in one byte after the colors
+                std::reverse(b + 4, b + 4 + nRows);
+            }
+            else {
+                // The 3 bit indices of each row are 12 bits after the two endpoints
+                uint64_t indices = 0;
+                for (int j = 0; j < 6; j++) {
+                    indices |= static_cast<uint64_t>(b[2 + j]) << (8 * j);
+                }
+                std::array<uint64_t, 4> rows;
+                for (size_t j = 0; j < 4; j++) {
+                    rows[j] = (indices >> (12 * j)) & 0xFFF;
+                }
+                std::reverse(rows.begin(), rows.begin() + nRows);
+                indices = 0;
+                for (size_t j = 0; j < 4; j++) {
+                    indices |= rows[j] << (12 * j);
+                }
+                for (int j = 0; j < 6; j++) {
+                    b[2 + j] = static_cast<unsigned char>(indices >> (8 * j));
+                }
+            }
+        }
+    }
+
+    /**
+     * \return `true` if all \p levels can be flipped with #flipBlocks, which is only
+     *         possible for BC1 and BC4 levels whose heights are multiples of 4 or smaller
+     *         than 4
+     */
+    bool canFlipLevels(CompressedTexture::Format format,
+                       const std::vector<CompressedTexture::Level>& levels)
+    {
+        return format != CompressedTexture::Format::BC7 && std::ranges::all_of(
+            levels,
+            [](const CompressedTexture::Level& level) {
+                return level.size.y % 4 == 0 || level.size.y < 4;
+            }
+        );
+    }
+
+    struct FileCloser {
+        void operator()(FILE* file) const { fclose(file); }
+    };
+} // namespace
+
+std::string_view CompressedTexture::name(Format format) {
+    switch (format) {
+        case Format::BC1: return "BC1";
+        case Format::BC4: return "BC4";
+        case Format::BC7: return "BC7";
+        default:          throw std::logic_error("Unhandled case label");
+    }
+}
+
+size_t CompressedTexture::blockSize(Format format) {
+    switch (format) {
+        case Format::BC1: return 8;
+        case Format::BC4: return 8;
+        case Format::BC7: return 16;
+        default:          throw std::logic_error("Unhandled case label");
+    }
+}
+
+bool CompressedTexture::isCompressedFile(const std::filesystem::path& filename) {
+    std::string ext = filename.extension().string();
+    std::transform(
+        ext.begin(),
+        ext.end(),
+        ext.begin(),
+        [](char c) { return static_cast<char>(::tolower(c)); }
+    );
+    return ext == ".ktx2" || ext == ".dds";
+}
+
+void CompressedTexture::load(const std::filesystem::path& filename) {
+    ZoneScoped;
+
+    const std::string f = filename.string();
+    std::unique_ptr<FILE, FileCloser> file(fopen(f.c_str(), "rb"));
+    if (!file) {
+        throw Err(
+            9030, std::format("Could not open file '{}' for loading texture", filename)
+        );
+    }
+
+    std::string ext = filename.extension().string();
+    if (ext == ".dds" || ext == ".DDS") {
+        loadDds(file.get(), filename);
+    }
+    else {
+        loadKtx2(file.get(), filename);
+    }
+}
+
+void CompressedTexture::save(const std::filesystem::path& filename) const {
+    ZoneScoped;
+
+    const std::string f = filename.string();
+    std::unique_ptr<FILE, FileCloser> file(fopen(f.c_str(), "wb"));
+    if (!file) {
+        throw Err(
+            9030, std::format("Could not open file '{}' for saving texture", filename)
+        );
+    }
+
+    std::string ext = filename.extension().string();
+    if (ext == ".dds" || ext == ".DDS") {
+        saveDds(file.get());
+    }
+    else {
+        saveKtx2(file.get());
+    }
+}
+
+void CompressedTexture::compress(const Image& image, Format format, int nLevels) {
+    ZoneScoped;
+
+    if (format == Format::BC7) {
+        throw Err(9036, "Encoding textures as BC7 is not supported");
+    }
+    if (image.data() == nullptr || image.size().x <= 0 || image.size().y <= 0) {
+        throw Err(9037, "Cannot compress an empty image");
+    }
+
+    _format = format;
+    _isSrgb = false;
+    _hasAlpha = false;
+    setLevels(image.size(), nLevels > 0 ? nLevels : maxLevels(image.size()));
+
+    ivec2 size = image.size();
+    std::vector<Pixel> pixels = toRgba(image);
+    for (size_t i = 0; i < _levels.size(); i++) {
+        if (i > 0) {
+            pixels = downsample(pixels, size);
+        }
+
+        unsigned char* dst = _data.data() + _levels[i].offset;
+        for (int y = 0; y < size.y; y += 4) {
+            for (int x = 0; x < size.x; x += 4) {
+                const Block block = extractBlock(pixels, size, x, y);
+                if (format == Format::BC1) {
+                    encodeBC1(block, dst);
+                }
+                else {
+                    encodeBC4(block, dst);
+                }
+                dst += blockSize(format);
+            }
+        }
+    }
+}
+
+CompressedTexture::Format CompressedTexture::format() const {
+    return _format;
+}
+
+bool CompressedTexture::isSrgb() const {
+    return _isSrgb;
+}
+
+bool CompressedTexture::hasAlpha() const {
+    return _hasAlpha;
+}
+
+ivec2 CompressedTexture::size() const {
+    return _levels.empty() ? ivec2{ 0, 0 } : _levels.front().size;
+}
+
+const std::vector<CompressedTexture::Level>& CompressedTexture::levels() const {
+    return _levels;
+}
+
+const unsigned char* CompressedTexture::data() const {
+    return _data.data();
+}
+
+size_t CompressedTexture::dataSize() const {
+    return _data.size();
+}
+
+void CompressedTexture::setLevels(ivec2 size, int nLevels) {
+    // The levels are stored largest first without any padding, which is the same layout
+    // that DDS files use
+    _levels.resize(std::min(nLevels, maxLevels(size)));
+    size_t offset = 0;
+    for (Level& level : _levels) {
+        const size_t nBlocks =
+            static_cast<size_t>((size.x + 3) / 4) * static_cast<size_t>((size.y + 3) / 4);
+        level.size = size;
+        level.offset = offset;
+        level.nBytes = nBlocks * blockSize(_format);
+        offset += level.nBytes;
+
+        size = ivec2{ std::max(size.x / 2, 1), std::max(size.y / 2, 1) };
+    }
+    _data.resize(offset);
+}
+
+void CompressedTexture::loadKtx2(FILE* file, const std::filesystem::path& filename) {
+    std::array<unsigned char, Ktx2HeaderSize> header;
+    if (fread(header.data(), 1, header.size(), file) != header.size() ||
+        std::memcmp(header.data(), Ktx2Identifier.data(), Ktx2Identifier.size()) != 0)
+    {
+        throw Err(9031, std::format("'{}' is not a KTX2 file", filename));
+    }
+
+    const unsigned char* p = header.data() + Ktx2Identifier.size();
+    const uint32_t vkFormat = get<uint32_t>(p);
+    get<uint32_t>(p); // typeSize
+    const uint32_t width = get<uint32_t>(p);
+    const uint32_t height = get<uint32_t>(p);
+    const uint32_t depth = get<uint32_t>(p);
+    const uint32_t nLayers = get<uint32_t>(p);
+    const uint32_t nFaces = get<uint32_t>(p);
+    const uint32_t nLevels = get<uint32_t>(p);
+    const uint32_t supercompression = get<uint32_t>(p);
+    get<uint32_t>(p); // dfdByteOffset
+    get<uint32_t>(p); // dfdByteLength
+    const uint32_t kvdOffset = get<uint32_t>(p);
+    const uint32_t kvdLength = get<uint32_t>(p);
+
+    if (supercompression != 0) {
+        throw Err(
+            9032,
+            std::format("Supercompression in KTX2 file '{}' is not supported", filename)
+        );
+    }
+    if (width == 0 || height == 0 || depth > 1 || nLayers > 1 || nFaces != 1) {
+        throw Err(
+            9033, std::format("KTX2 file '{}' does not contain a 2D texture", filename)
+        );
+    }
+
+    _isSrgb = vkFormat == VkFormatBC1RgbSrgb || vkFormat == VkFormatBC1RgbaSrgb ||
+        vkFormat == VkFormatBC7Srgb;
+    _hasAlpha = vkFormat == VkFormatBC1RgbaUnorm || vkFormat == VkFormatBC1RgbaSrgb;
+    switch (vkFormat) {
+        case VkFormatBC1RgbUnorm:
+        case VkFormatBC1RgbSrgb:
+        case VkFormatBC1RgbaUnorm:
+        case VkFormatBC1RgbaSrgb:
+            _format = Format::BC1;
+            break;
+        case VkFormatBC4Unorm:
+            _format = Format::BC4;
+            break;
+        case VkFormatBC7Unorm:
+        case VkFormatBC7Srgb:
+            _format = Format::BC7;
+            break;
+        default:
+            throw Err(
+                9034,
+                std::format("Unsupported format {} in KTX2 file '{}'", vkFormat, filename)
+            );
+    }
+
+    // A level count of 0 asks the loader to generate the mipmaps, which we leave to the
+    // TextureManager
+    setLevels(
+        ivec2{ static_cast<int>(width), static_cast<int>(height) },
+        std::max(static_cast<int>(nLevels), 1)
+    );
+
+    std::vector<unsigned char> index(_levels.size() * Ktx2LevelIndexSize);
+    if (fread(index.data(), 1, index.size(), file) != index.size()) {
+        throw Err(9035, std::format("Failed to read levels of '{}'", filename));
+    }
+    p = index.data();
+    for (Level& level : _levels) {
+        const uint64_t offset = get<uint64_t>(p);
+        const uint64_t length = get<uint64_t>(p);
+        get<uint64_t>(p); // uncompressedByteLength
+
+        if (length != level.nBytes || !seek(file, offset) ||
+            fread(_data.data() + level.offset, 1, level.nBytes, file) != level.nBytes)
+        {
+            throw Err(9035, std::format("Failed to read levels of '{}'", filename));
+        }
+    }
+
+    // The orientation is the direction in which the x and y coordinates increase, where
+    // files without it store the rows top to bottom
+    std::vector<unsigned char> kvd(kvdLength);
+    if (!seek(file, kvdOffset) || fread(kvd.data(), 1, kvd.size(), file) != kvd.size()) {
+        throw Err(9035, std::format("Failed to read key/value data of '{}'", filename));
+    }
+    std::string_view orientation = "rd";
+    p = kvd.data();
+    while (p + sizeof(uint32_t) <= kvd.data() + kvd.size()) {
+        const uint32_t length = get<uint32_t>(p);
+        if (length > static_cast<size_t>(kvd.data() + kvd.size() - p)) {
+            break;
+        }
+        const std::string_view keyValue(reinterpret_cast<const char*>(p), length);
+        const size_t separator = keyValue.find('\0');
+        if (separator != std::string_view::npos &&
+            keyValue.substr(0, separator) == "KTXorientation")
+        {
+            const std::string_view value = keyValue.substr(separator + 1);
+            orientation = value.substr(0, value.find('\0'));
+        }
+        p += alignTo(length, 4);
+    }
+
+    if (orientation.size() < 2 || orientation[0] != 'r' ||
+        (orientation[1] != 'u' && orientation[1] != 'd'))
+    {
+        throw Err(
+            9039,
+            std::format(
+                "Unsupported orientation '{}' in KTX2 file '{}'", orientation, filename
+            )
+        );
+    }
+    if (orientation[1] == 'u') {
+        return;
+    }
+    if (!canFlipLevels(_format, _levels)) {
+        Log::Warning(
+            "KTX2 file '{}' can not be flipped to store its rows bottom to top, which is "
+            "only possible for BC1 and BC4 textures with heights of multiples of 4. The "
+            "texture will appear vertically flipped",
+            filename
+        );
+        return;
+    }
+    for (const Level& level : _levels) {
+        flipBlocks(_data.data() + level.offset, _format, level.size);
+    }
+}
+
+void CompressedTexture::loadDds(FILE* file, const std::filesystem::path& filename) {
+    std::array<unsigned char, 4 + DdsHeaderSize> header;
+    if (fread(header.data(), 1, header.size(), file) != header.size() ||
+        std::memcmp(header.data(), DdsMagic.data(), DdsMagic.size()) != 0)
+    {
+        throw Err(9031, std::format("'{}' is not a DDS file", filename));
+    }
+
+    const unsigned char* p = header.data() + DdsMagic.size();
+    const uint32_t size = get<uint32_t>(p);
+    get<uint32_t>(p); // flags
+    const uint32_t height = get<uint32_t>(p);
+    const uint32_t width = get<uint32_t>(p);
+    get<uint32_t>(p); // pitchOrLinearSize
+    const uint32_t depth = get<uint32_t>(p);
+    const uint32_t nLevels = get<uint32_t>(p);
+    p += 11 * sizeof(uint32_t); // reserved
+    get<uint32_t>(p); // pixel format size
+    get<uint32_t>(p); // pixel format flags
+    const uint32_t code = get<uint32_t>(p);
+
+    if (size != DdsHeaderSize) {
+        throw Err(9031, std::format("'{}' is not a DDS file", filename));
+    }
+    if (width == 0 || height == 0 || depth > 1) {
+        throw Err(
+            9033, std::format("DDS file '{}' does not contain a 2D texture", filename)
+        );
+    }
+
+    _isSrgb = false;
+    _hasAlpha = false;
+    if (code == fourCC("DXT1")) {
+        _format = Format::BC1;
+    }
+    else if (code == fourCC("ATI1") || code == fourCC("BC4U")) {
+        _format = Format::BC4;
+    }
+    else if (code == fourCC("DX10")) {
+        std::array<unsigned char, DdsHeader10Size> header10;
+        if (fread(header10.data(), 1, header10.size(), file) != header10.size()) {
+            throw Err(9031, std::format("'{}' is not a DDS file", filename));
+        }
+        p = header10.data();
+        const uint32_t dxgiFormat = get<uint32_t>(p);
+        get<uint32_t>(p); // resourceDimension
+        get<uint32_t>(p); // miscFlag
+        const uint32_t arraySize = get<uint32_t>(p);
+        if (arraySize > 1) {
+            throw Err(
+                9033, std::format("DDS file '{}' does not contain a 2D texture", filename)
+            );
+        }
+
+        _isSrgb = dxgiFormat == DxgiFormatBC1Srgb || dxgiFormat == DxgiFormatBC7Srgb;
+        switch (dxgiFormat) {
+            case DxgiFormatBC1Unorm:
+            case DxgiFormatBC1Srgb:
+                _format = Format::BC1;
+                break;
+            case DxgiFormatBC4Unorm:
+                _format = Format::BC4;
+                break;
+            case DxgiFormatBC7Unorm:
+            case DxgiFormatBC7Srgb:
+                _format = Format::BC7;
+                break;
+            default:
+                throw Err(
+                    9034,
+                    std::format(
+                        "Unsupported format {} in DDS file '{}'", dxgiFormat, filename
+                    )
+                );
+        }
+    }
+    else {
+        throw Err(9034, std::format("Unsupported format in DDS file '{}'", filename));
+    }
+
+    setLevels(
+        ivec2{ static_cast<int>(width), static_cast<int>(height) },
+        std::max(static_cast<int>(nLevels), 1)
+    );
+    if (fread(_data.data(), 1, _data.size(), file) != _data.size()) {
+        throw Err(9035, std::format("Failed to read levels of '{}'", filename));
+    }
+
+    // DDS files store the rows top to bottom
+    if (!canFlipLevels(_format, _levels)) {
+        Log::Warning(
+            "DDS file '{}' can not be flipped to store its rows bottom to top, which is "
+            "only possible for BC1 and BC4 textures with heights of multiples of 4. The "
+            "texture will appear vertically flipped",
+            filename
+        );
+        return;
+    }
+    for (const Level& level : _levels) {
+        flipBlocks(_data.data() + level.offset, _format, level.size);
+    }
+}
+
+void CompressedTexture::saveKtx2(FILE* file) const {
+    const size_t nLevels = _levels.size();
+    const size_t dfdOffset = Ktx2HeaderSize + nLevels * Ktx2LevelIndexSize;
+
+    // Data format descriptor with a single sample that covers the entire block
+    std::vector<unsigned char> dfd;
+    {
+        using Pair = std::pair<uint32_t, uint32_t>;
+        const auto [model, bitLength] = [](Format format) -> Pair {
+            switch (format) {
+                case Format::BC1: return { DfModelBC1A, 64 };
+                case Format::BC4: return { DfModelBC4, 64 };
+                case Format::BC7: return { DfModelBC7, 128 };
+                default:          throw std::logic_error("Unhandled case label");
+            }
+        }(_format);
+        constexpr uint32_t BlockSize = 24 + 16;
+        append<uint32_t>(dfd, 4 + BlockSize);
+        // Vendor and descriptor type
+        append<uint32_t>(dfd, 0);
+        // Version and descriptor block size
+        append<uint32_t>(dfd, 2 | BlockSize << 16);
+        // Color model, BT.709 primaries, and linear or sRGB transfer function
+        append<uint32_t>(dfd, model | 1 << 8 | (_isSrgb ? 2 : 1) << 16);
+        // 4x4 texel blocks
+        append<uint32_t>(dfd, 3 | 3 << 8);
+        // Bytes per plane
+        append<uint32_t>(dfd, static_cast<uint32_t>(blockSize(_format)));
+        append<uint32_t>(dfd, 0);
+        // The sample: bit offset and length, position, lower and upper values
+        append<uint32_t>(dfd, (bitLength - 1) << 16);
+        append<uint32_t>(dfd, 0);
+        append<uint32_t>(dfd, 0);
+        append<uint32_t>(dfd, std::numeric_limits<uint32_t>::max());
+    }
+
+    // Key/value data. The orientation tells other tools that the rows are bottom to top
+    std::vector<unsigned char> kvd;
+    auto appendKeyValue = [&kvd](std::string_view key, std::string_view value) {
+        append(kvd, static_cast<uint32_t>(key.size() + value.size() + 2));
+        kvd.insert(kvd.end(), key.begin(), key.end());
+        kvd.push_back('\0');
+        kvd.insert(kvd.end(), value.begin(), value.end());
+        kvd.push_back('\0');
+        kvd.resize(alignTo(kvd.size(), 4));
+    };
+    appendKeyValue("KTXorientation", "ru");
+    appendKeyValue("KTXwriter", "SGCT");
+    const size_t kvdOffset = dfdOffset + dfd.size();
+
+    // The levels are stored smallest first, each aligned to the block size
+    std::vector<uint64_t> offsets(nLevels);
+    size_t offset = kvdOffset + kvd.size();
+    for (size_t i = nLevels; i > 0; i--) {
+        offset = alignTo(offset, blockSize(_format));
+        offsets[i - 1] = offset;
+        offset += _levels[i - 1].nBytes;
+    }
+
+    std::vector<unsigned char> buffer(offset, 0);
+    unsigned char* p = buffer.data();
+    std::memcpy(p, Ktx2Identifier.data(), Ktx2Identifier.size());
+    p += Ktx2Identifier.size();
+    const uint32_t vkFormat = [this]() {
+        switch (_format) {
+            case Format::BC1:
+                if (_hasAlpha) {
+                    return _isSrgb ? VkFormatBC1RgbaSrgb : VkFormatBC1RgbaUnorm;
+                }
+                return _isSrgb ? VkFormatBC1RgbSrgb : VkFormatBC1RgbUnorm;
+            case Format::BC4:
+                return VkFormatBC4Unorm;
+            case Format::BC7:
+                return _isSrgb ? VkFormatBC7Srgb : VkFormatBC7Unorm;
+            default:
+                throw std::logic_error("Unhandled case label");
+        }
+    }();
+    put(p, vkFormat);
+    put<uint32_t>(p, 1); // typeSize
+    put(p, static_cast<uint32_t>(size().x));
+    put(p, static_cast<uint32_t>(size().y));
+    put<uint32_t>(p, 0); // depth
+    put<uint32_t>(p, 0); // layers
+    put<uint32_t>(p, 1); // faces
+    put(p, static_cast<uint32_t>(nLevels));
+    put<uint32_t>(p, 0); // supercompression
+    put(p, static_cast<uint32_t>(dfdOffset));
+    put(p, static_cast<uint32_t>(dfd.size()));
+    put(p, static_cast<uint32_t>(kvdOffset));
+    put(p, static_cast<uint32_t>(kvd.size()));
+    put<uint64_t>(p, 0); // sgdByteOffset
+    put<uint64_t>(p, 0); // sgdByteLength
+    for (size_t i = 0; i < nLevels; i++) {
+        put(p, offsets[i]);
+        put(p, static_cast<uint64_t>(_levels[i].nBytes));
+        put(p, static_cast<uint64_t>(_levels[i].nBytes));
+    }
+    std::copy(dfd.begin(), dfd.end(), buffer.begin() + dfdOffset);
+    std::copy(kvd.begin(), kvd.end(), buffer.begin() + kvdOffset);
+    for (size_t i = 0; i < nLevels; i++) {
+        std::memcpy(
+            buffer.data() + offsets[i],
+            _data.data() + _levels[i].offset,
+            _levels[i].nBytes
+        );
+    }
+
+    if (fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+        throw Err(9038, "Failed to write KTX2 data");
+    }
+}
+
+void CompressedTexture::saveDds(FILE* file) const {
+    constexpr uint32_t FlagCaps = 0x1;
+    constexpr uint32_t FlagHeight = 0x2;
+    constexpr uint32_t FlagWidth = 0x4;
+    constexpr uint32_t FlagPixelFormat = 0x1000;
+    constexpr uint32_t FlagMipmapCount = 0x20000;
+    constexpr uint32_t FlagLinearSize = 0x80000;
+    constexpr uint32_t PixelFormatFourCC = 0x4;
+    constexpr uint32_t CapsComplex = 0x8;
+    constexpr uint32_t CapsTexture = 0x1000;
+    constexpr uint32_t CapsMipmap = 0x400000;
+
+    // The DXT1 code has no sRGB variant, so those textures need the DXGI format as well
+    const bool hasHeader10 =
+        _format == Format::BC7 || (_format == Format::BC1 && _isSrgb);
+    std::vector<unsigned char> header(
+        DdsMagic.size() + DdsHeaderSize + (hasHeader10 ? DdsHeader10Size : 0),
+        0
+    );
+    unsigned char* p = header.data();
+    std::memcpy(p, DdsMagic.data(), DdsMagic.size());
+    p += DdsMagic.size();
+    put(p, static_cast<uint32_t>(DdsHeaderSize));
+    put(
+        p,
+        FlagCaps | FlagHeight | FlagWidth | FlagPixelFormat | FlagMipmapCount |
+        FlagLinearSize
+    );
+    put(p, static_cast<uint32_t>(size().y));
+    put(p, static_cast<uint32_t>(size().x));
+    put(p, static_cast<uint32_t>(_levels.front().nBytes));
+    put<uint32_t>(p, 0); // depth
+    put(p, static_cast<uint32_t>(_levels.size()));
+    p += 11 * sizeof(uint32_t); // reserved
+    put<uint32_t>(p, 32); // pixel format size
+    put(p, PixelFormatFourCC);
+    const uint32_t code = [hasHeader10](Format format) {
+        if (hasHeader10) {
+            return fourCC("DX10");
+        }
+        switch (format) {
+            case Format::BC1: return fourCC("DXT1");
+            case Format::BC4: return fourCC("ATI1");
+            case Format::BC7: return fourCC("DX10");
+            default:          throw std::logic_error("Unhandled case label");
+        }
+    }(_format);
+    put(p, code);
+    p += 5 * sizeof(uint32_t); // bit count and masks
+    const bool hasMipmaps = _levels.size() > 1;
+    put(p, CapsTexture | (hasMipmaps ? CapsComplex | CapsMipmap : 0));
+    p += 4 * sizeof(uint32_t); // caps2, caps3, caps4, reserved
+
+    if (hasHeader10) {
+        if (_format == Format::BC1) {
+            put(p, DxgiFormatBC1Srgb);
+        }
+        else {
+            put(p, _isSrgb ? DxgiFormatBC7Srgb : DxgiFormatBC7Unorm);
+        }
+        put<uint32_t>(p, 3); // D3D10_RESOURCE_DIMENSION_TEXTURE2D
+        put<uint32_t>(p, 0); // miscFlag
+        put<uint32_t>(p, 1); // arraySize
+        put<uint32_t>(p, 0); // miscFlags2
+    }
+
+    // DDS files store the rows top to bottom
+    std::vector<unsigned char> data = _data;
+    if (canFlipLevels(_format, _levels)) {
+        for (const Level& level : _levels) {
+            flipBlocks(data.data() + level.offset, _format, level.size);
+        }
+    }
+    else {
+        Log::Warning(
+            "{} texture of {}x{} pixels can not be flipped to store its rows top to "
+            "bottom and will appear vertically flipped in other tools",
+            name(_format), size().x, size().y
+        );
+    }
+
+    if (fwrite(header.data(), 1, header.size(), file) != header.size() ||
+        fwrite(data.data(), 1, data.size(), file) != data.size())
+    {
+        throw Err(9038, "Failed to write DDS data");
+    }
+}
+
+} // namespace sgct
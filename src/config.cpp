@@ -110,6 +110,9 @@ void validateUser(const User& u) {
     if (u.name && *u.name == "default") {
         throw Error(1003, "Name 'default' is not permitted for a user");
     }
+    if (u.tracking && u.tracking->latency && *u.tracking->latency < 0.f) {
+        throw Error(1005, "Tracking latency must be zero or a positive number");
+    }
 }
 
 void validateCapture(const Capture& c) {
@@ -133,6 +136,25 @@ void validateSettings(const Settings& s) {
     if (s.display && s.display->refreshRate && *s.display->refreshRate < 0) {
         throw Error(1021, "Refresh rate must not be negative");
     }
+    if (s.compression && s.compression->level &&
+        (*s.compression->level < 0 || *s.compression->level > 9))
+    {
+        throw Error(1022, "Compression level must be between 0 and 9");
+    }
+    if (s.compression && s.compression->threshold && *s.compression->threshold < 0) {
+        throw Error(1023, "Compression threshold must not be negative");
+    }
+    if (s.deltaEncoding && s.deltaEncoding->keyframeInterval &&
+        *s.deltaEncoding->keyframeInterval < 1)
+    {
+        throw Error(1024, "Delta encoding keyframe interval must be positive");
+    }
+    if (s.telemetry && s.telemetry->capacity && *s.telemetry->capacity < 1) {
+        throw Error(1025, "Telemetry capacity must be positive");
+    }
+    if (s.telemetry && s.telemetry->window && *s.telemetry->window <= 0.f) {
+        throw Error(1026, "Telemetry window must be positive");
+    }
 }
 
 void validateTracker(const Tracker& t) {
@@ -246,6 +268,9 @@ void validateViewport(const Viewport& v) {
     if (v.correctionMeshTexture && v.correctionMeshTexture->empty()) {
         throw Error(1094, "Correction mesh texture path must not be empty");
     }
+    if (v.correctionMeshTolerance && *v.correctionMeshTolerance < 0.f) {
+        throw Error(1095, "Correction mesh tolerance must not be negative");
+    }
 
     std::visit([](const auto& p) { validateProjection(p); }, v.projection);
 }
@@ -343,6 +368,20 @@ void validateCluster(const Cluster& c) {
     if (c.settings) {
         validateSettings(*c.settings);
     }
+    if (c.multicast) {
+        if (c.multicast->address.empty()) {
+            throw Error(1128, "Multicast address must not be empty");
+        }
+        if (c.multicast->port <= 0 || c.multicast->port > 65535) {
+            throw Error(1129, "Multicast port must be between 1 and 65535");
+        }
+        if (c.multicast->ttl && (*c.multicast->ttl < 0 || *c.multicast->ttl > 255)) {
+            throw Error(1130, "Multicast time-to-live must be between 0 and 255");
+        }
+        if (c.multicast->interfaceAddress && c.multicast->interfaceAddress->empty()) {
+            throw Error(1131, "Multicast interface address must not be empty");
+        }
+    }
 
     if (c.users.empty()) {
         throw Error(1122, "There must be at least one user in the cluster");
@@ -517,6 +556,65 @@ namespace {
         }
     }
 
+    sgct::config::Capture::Format parseCaptureFormat(std::string_view format) {
+        using F = sgct::config::Capture::Format;
+        if (format == "png") { return F::Png; }
+        if (format == "fastpng") { return F::FastPng; }
+        if (format == "parallelpng") { return F::ParallelPng; }
+        if (format == "tga") { return F::Tga; }
+        if (format == "raw") { return F::Raw; }
+        if (format == "qoi") { return F::Qoi; }
+
+        throw Err(6092, std::format("Unknown capture format {}", format));
+    }
+
+    std::string_view toString(sgct::config::Capture::Format format) {
+        switch (format) {
+            case sgct::config::Capture::Format::Png: return "png";
+            case sgct::config::Capture::Format::FastPng: return "fastpng";
+            case sgct::config::Capture::Format::ParallelPng: return "parallelpng";
+            case sgct::config::Capture::Format::Tga: return "tga";
+            case sgct::config::Capture::Format::Raw: return "raw";
+            case sgct::config::Capture::Format::Qoi: return "qoi";
+            default: throw std::logic_error("Missing case exception");
+        }
+    }
+
+    sgct::config::User::Tracking::Prediction parseTrackingPrediction(std::string_view p) {
+        using P = sgct::config::User::Tracking::Prediction;
+        if (p == "none") { return P::None; }
+        if (p == "velocity") { return P::Velocity; }
+        if (p == "acceleration") { return P::Acceleration; }
+
+        throw Err(6094, std::format("Unknown tracking prediction {}", p));
+    }
+
+    std::string_view toString(sgct::config::User::Tracking::Prediction prediction) {
+        switch (prediction) {
+            case sgct::config::User::Tracking::Prediction::None: return "none";
+            case sgct::config::User::Tracking::Prediction::Velocity: return "velocity";
+            case sgct::config::User::Tracking::Prediction::Acceleration:
+                return "acceleration";
+            default: throw std::logic_error("Missing case exception");
+        }
+    }
+
+    sgct::config::Capture::Sequence parseCaptureSequence(std::string_view sequence) {
+        using S = sgct::config::Capture::Sequence;
+        if (sequence == "raw") { return S::Raw; }
+        if (sequence == "deflate") { return S::Deflate; }
+
+        throw Err(6093, std::format("Unknown capture sequence {}", sequence));
+    }
+
+    std::string_view toString(sgct::config::Capture::Sequence sequence) {
+        switch (sequence) {
+            case sgct::config::Capture::Sequence::Raw: return "raw";
+            case sgct::config::Capture::Sequence::Deflate: return "deflate";
+            default: throw std::logic_error("Missing case exception");
+        }
+    }
+
     sgct::config::Window::ColorBitDepth parseBufferColorBitDepth(std::string_view type) {
         if (type == "8") { return sgct::config::Window::ColorBitDepth::Depth8; }
         if (type == "16") { return sgct::config::Window::ColorBitDepth::Depth16; }
@@ -788,6 +886,11 @@ static void from_json(const nlohmann::json& j, User& u) {
 
         trackerIt->get_to(tracking.tracker);
         deviceIt->get_to(tracking.device);
+        if (auto predictionIt = it->find("prediction");  predictionIt != it->end()) {
+            tracking.prediction =
+                parseTrackingPrediction(predictionIt->get<std::string>());
+        }
+        parseValue(*it, "latency", tracking.latency);
         u.tracking = tracking;
     }
 }
@@ -815,6 +918,12 @@ static void to_json(nlohmann::json& j, const User& u) {
         nlohmann::json tracking = nlohmann::json::object();
         tracking["tracker"] = u.tracking->tracker;
         tracking["device"] = u.tracking->device;
+        if (u.tracking->prediction.has_value()) {
+            tracking["prediction"] = toString(*u.tracking->prediction);
+        }
+        if (u.tracking->latency.has_value()) {
+            tracking["latency"] = *u.tracking->latency;
+        }
         j["tracking"] = tracking;
     }
 }
@@ -823,6 +932,8 @@ static void from_json(const nlohmann::json& j, Settings& s) {
     parseValue(j, "depthbuffertexture", s.useDepthTexture);
     parseValue(j, "normaltexture", s.useNormalTexture);
     parseValue(j, "positiontexture", s.usePositionTexture);
+    parseValue(j, "meshcache", s.useMeshCache);
+    parseValue(j, "packcorrectionmeshes", s.packCorrectionMeshes);
 
     if (auto it = j.find("precision");  it != j.end()) {
         float precision = it->get<float>();
@@ -843,6 +954,27 @@ static void from_json(const nlohmann::json& j, Settings& s) {
         parseValue(*it, "refreshrate", display.refreshRate);
         s.display = display;
     }
+
+    if (auto it = j.find("compression");  it != j.end()) {
+        Settings::Compression compression;
+        parseValue(*it, "level", compression.level);
+        parseValue(*it, "threshold", compression.threshold);
+        s.compression = compression;
+    }
+
+    if (auto it = j.find("deltaencoding");  it != j.end()) {
+        Settings::DeltaEncoding deltaEncoding;
+        parseValue(*it, "keyframeinterval", deltaEncoding.keyframeInterval);
+        s.deltaEncoding = deltaEncoding;
+    }
+
+    if (auto it = j.find("telemetry");  it != j.end()) {
+        Settings::Telemetry telemetry;
+        parseValue(*it, "path", telemetry.path);
+        parseValue(*it, "capacity", telemetry.capacity);
+        parseValue(*it, "window", telemetry.window);
+        s.telemetry = telemetry;
+    }
 }
 
 static void to_json(nlohmann::json& j, const Settings& s) {
@@ -860,6 +992,14 @@ static void to_json(nlohmann::json& j, const Settings& s) {
         j["positiontexture"] = *s.usePositionTexture;
     }
 
+    if (s.useMeshCache.has_value()) {
+        j["meshcache"] = *s.useMeshCache;
+    }
+
+    if (s.packCorrectionMeshes.has_value()) {
+        j["packcorrectionmeshes"] = *s.packCorrectionMeshes;
+    }
+
     if (s.bufferFloatPrecision.has_value()) {
         switch (*s.bufferFloatPrecision) {
             case Settings::BufferFloatPrecision::Float16Bit:
@@ -881,6 +1021,39 @@ static void to_json(nlohmann::json& j, const Settings& s) {
         }
         j["display"] = display;
     }
+
+    if (s.compression.has_value()) {
+        nlohmann::json compression = nlohmann::json::object();
+        if (s.compression->level.has_value()) {
+            compression["level"] = *s.compression->level;
+        }
+        if (s.compression->threshold.has_value()) {
+            compression["threshold"] = *s.compression->threshold;
+        }
+        j["compression"] = compression;
+    }
+
+    if (s.deltaEncoding.has_value()) {
+        nlohmann::json deltaEncoding = nlohmann::json::object();
+        if (s.deltaEncoding->keyframeInterval.has_value()) {
+            deltaEncoding["keyframeinterval"] = *s.deltaEncoding->keyframeInterval;
+        }
+        j["deltaencoding"] = deltaEncoding;
+    }
+
+    if (s.telemetry.has_value()) {
+        nlohmann::json telemetry = nlohmann::json::object();
+        if (s.telemetry->path.has_value()) {
+            telemetry["path"] = *s.telemetry->path;
+        }
+        if (s.telemetry->capacity.has_value()) {
+            telemetry["capacity"] = *s.telemetry->capacity;
+        }
+        if (s.telemetry->window.has_value()) {
+            telemetry["window"] = *s.telemetry->window;
+        }
+        j["telemetry"] = telemetry;
+    }
 }
 
 static void from_json(const nlohmann::json& j, Capture& c) {
@@ -905,6 +1078,14 @@ static void from_json(const nlohmann::json& j, Capture& c) {
     if (rangeBeg && rangeEnd && *rangeBeg > *rangeEnd) {
         throw Err(6051, "End of range must be greater than beginning of range");
     }
+
+    if (auto it = j.find("format");  it != j.end()) {
+        c.format = parseCaptureFormat(it->get<std::string>());
+    }
+
+    if (auto it = j.find("sequence");  it != j.end()) {
+        c.sequence = parseCaptureSequence(it->get<std::string>());
+    }
 }
 
 static void to_json(nlohmann::json& j, const Capture& c) {
@@ -918,6 +1099,14 @@ static void to_json(nlohmann::json& j, const Capture& c) {
         j["rangebegin"] = c.range->first;
         j["rangeend"] = c.range->last;
     }
+
+    if (c.format.has_value()) {
+        j["format"] = toString(*c.format);
+    }
+
+    if (c.sequence.has_value()) {
+        j["sequence"] = toString(*c.sequence);
+    }
 }
 
 static void from_json(const nlohmann::json& j, Tracker::Device::Sensor& s) {
@@ -1452,6 +1641,7 @@ static void from_json(const nlohmann::json& j, Viewport& v) {
         v.correctionMeshTexture =
             std::filesystem::absolute(it->get<std::string>());
     }
+    parseValue(j, "meshtolerance", v.correctionMeshTolerance);
 
     parseValue(j, "tracked", v.isTracked);
 
@@ -1528,6 +1718,10 @@ static void to_json(nlohmann::json& j, const Viewport& v) {
         j["mesh"] = *v.correctionMeshTexture;
     }
 
+    if (v.correctionMeshTolerance.has_value()) {
+        j["meshtolerance"] = *v.correctionMeshTolerance;
+    }
+
     if (v.isTracked.has_value()) {
         j["tracked"] = *v.isTracked;
     }
@@ -1951,6 +2145,25 @@ static void from_json(const nlohmann::json& j, Cluster& c) {
     parseValue(j, "settings", c.settings);
     parseValue(j, "capture", c.capture);
 
+    if (auto it = j.find("multicast");  it != j.end()) {
+        Cluster::Multicast multicast;
+        if (auto jt = it->find("address");  jt != it->end()) {
+            jt->get_to(multicast.address);
+        }
+        else {
+            throw Err(6090, "Missing field address in multicast");
+        }
+        if (auto jt = it->find("port");  jt != it->end()) {
+            jt->get_to(multicast.port);
+        }
+        else {
+            throw Err(6091, "Missing field port in multicast");
+        }
+        parseValue(*it, "ttl", multicast.ttl);
+        parseValue(*it, "interface", multicast.interfaceAddress);
+        c.multicast = multicast;
+    }
+
     parseValue(j, "trackers", c.trackers);
     parseValue(j, "nodes", c.nodes);
 
@@ -1989,6 +2202,19 @@ static void to_json(nlohmann::json& j, const Cluster& c) {
         j["capture"] = *c.capture;
     }
 
+    if (c.multicast.has_value()) {
+        nlohmann::json multicast = nlohmann::json::object();
+        multicast["address"] = c.multicast->address;
+        multicast["port"] = c.multicast->port;
+        if (c.multicast->ttl.has_value()) {
+            multicast["ttl"] = *c.multicast->ttl;
+        }
+        if (c.multicast->interfaceAddress.has_value()) {
+            multicast["interface"] = *c.multicast->interfaceAddress;
+        }
+        j["multicast"] = multicast;
+    }
+
     if (!c.trackers.empty()) {
         j["trackers"] = c.trackers;
     }
@@ -2136,7 +2362,7 @@ std::string validateConfigAgainstSchema(std::string_view configuration,
                 loadPath = loadPath.substr(0, strEnd + 1);
             }
             if (std::filesystem::exists(loadPath)) {
-                Log::Debug(std::format("Loading schema file '{}'", loadPath));
+                Log::Debug("Loading schema file '{}'", loadPath);
                 const std::string newSchema = stringifyJsonFile(loadPath);
                 value = json::parse(newSchema);
             }
@@ -11,12 +11,22 @@
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
+#include <sgct/mappedfile.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
-#include <glm/glm.hpp>
-#include <scn/scan.h>
+#include <sgct/correction/textparser.h>
 #include <algorithm>
-#include <fstream>
+#include <utility>
+
+namespace {
+    struct Chunk {
+        std::vector<sgct::correction::Buffer::Vertex> vertices;
+        // The column and row of each of the vertices
+        std::vector<std::pair<unsigned int, unsigned int>> positions;
+        unsigned int nCols = 0;
+        unsigned int nRows = 0;
+    };
+} // namespace
 
 namespace sgct::correction {
 
@@ -25,62 +35,104 @@ Buffer generateDomeProjectionMesh(const std::filesystem::path& path, const vec2&
 {
     ZoneScoped;
 
-    Log::Info(std::format("Reading DomeProjection mesh data from '{}'", path));
+    Log::Info("Reading DomeProjection mesh data from '{}'", path);
 
-    std::ifstream meshFile = std::ifstream(path);
-    if (!meshFile.good()) {
+    const MappedFile file = MappedFile(path);
+    if (!file.data()) {
         throw Error(
             Error::Component::DomeProjection, 2010,
             std::format("Failed to open '{}'", path)
         );
     }
+    const std::string_view text = std::string_view(
+        reinterpret_cast<const char*>(file.data()),
+        file.size()
+    );
+
+    std::vector<Chunk> chunks = parseInParallel(
+        text,
+        [&pos, &size](std::string_view chunk) {
+            Chunk res;
+            // Each line has about 40 characters
+            res.vertices.reserve(chunk.size() / 40);
+            res.positions.reserve(chunk.size() / 40);
+            while (!chunk.empty()) {
+                std::string_view line = nextLine(chunk);
+                float x = 0.f;
+                float y = 0.f;
+                float u = 0.f;
+                float v = 0.f;
+                unsigned int col = 0;
+                unsigned int row = 0;
+                const bool isVertex =
+                    parseNumber(line, x) && parseCharacter(line, ';') &&
+                    parseNumber(line, y) && parseCharacter(line, ';') &&
+                    parseNumber(line, u) && parseCharacter(line, ';') &&
+                    parseNumber(line, v) && parseCharacter(line, ';') &&
+                    parseNumber(line, col) && parseCharacter(line, ';') &&
+                    parseNumber(line, row);
+                if (!isVertex) {
+                    continue;
+                }
+
+                // init to max intensity (opaque white)
+                Buffer::Vertex vertex;
+                vertex.r = 1.f;
+                vertex.g = 1.f;
+                vertex.b = 1.f;
+                vertex.a = 1.f;
+
+                // find dimensions of meshdata
+                res.nCols = std::max(res.nCols, col);
+                res.nRows = std::max(res.nRows, row);
+
+                x = std::clamp(x, 0.f, 1.f);
+                y = std::clamp(y, 0.f, 1.f);
+
+                // convert to [-1, 1]
+                vertex.x = 2.f * (pos.x + x * size.x) - 1.f;
+
+                // (abock, 2019-08-30); I'm not sure why the y inversion happens
+                // here. It seems like a mistake, but who knows
+                vertex.y = 2.f * (pos.y + (1.f - y) * size.y) - 1.f;
+
+                // scale to viewport coordinates
+                vertex.s = pos.x + u * size.x;
+                vertex.t = pos.y + (1.f - v) * size.y;
+
+                res.vertices.push_back(vertex);
+                res.positions.emplace_back(col, row);
+            }
+            return res;
+        }
+    );
 
     Buffer buf;
 
+    // The file stores the largest column and row index, so one is added to get the
+    // dimensions of the grid
     unsigned int nCols = 0;
     unsigned int nRows = 0;
-    std::string line;
-    while (std::getline(meshFile, line)) {
-        auto r = scn::scan<float, float, float, float, unsigned int, unsigned int>(
-            line, "{};{};{};{};{};{}"
-        );
-        if (r) {
-            auto [x, y, u, v, col, row] = r->values();
-
-            // init to max intensity (opaque white)
-            Buffer::Vertex vertex;
-            vertex.r = 1.f;
-            vertex.g = 1.f;
-            vertex.b = 1.f;
-            vertex.a = 1.f;
-
-            // find dimensions of meshdata
-            nCols = std::max(nCols, col);
-            nRows = std::max(nRows, row);
-
-            x = std::clamp(x, 0.f, 1.f);
-            y = std::clamp(y, 0.f, 1.f);
-
-            // convert to [-1, 1]
-            vertex.x = 2.f * (pos.x + x * size.x) - 1.f;
-
-            // (abock, 2019-08-30); I'm not sure why the y inversion happens
-            // here. It seems like a mistake, but who knows
-            vertex.y = 2.f * (pos.y + (1.f - y) * size.y) - 1.f;
-
-            // scale to viewport coordinates
-            vertex.s = pos.x + u * size.x;
-            vertex.t = pos.y + (1.f - v) * size.y;
-
-            buf.vertices.push_back(std::move(vertex));
+    for (const Chunk& chunk : chunks) {
+        if (!chunk.vertices.empty()) {
+            nCols = std::max(nCols, chunk.nCols + 1);
+            nRows = std::max(nRows, chunk.nRows + 1);
         }
     }
 
-    nCols++;
-    nRows++;
+    // The vertices are placed by their column and row, so the grid does not depend on
+    // the order of the lines in the file
+    buf.vertices.resize(static_cast<size_t>(nCols) * nRows);
+    for (const Chunk& chunk : chunks) {
+        for (size_t i = 0; i < chunk.vertices.size(); i++) {
+            const auto [col, row] = chunk.positions[i];
+            buf.vertices[static_cast<size_t>(row) * nCols + col] = chunk.vertices[i];
+        }
+    }
 
-    for (unsigned int c = 0; c < nCols; ++c) {
-        for (unsigned int r = 0; r < nRows; ++r) {
+    buf.indices.reserve(static_cast<size_t>(nCols) * nRows * 6);
+    for (unsigned int c = 0; c + 1 < nCols; ++c) {
+        for (unsigned int r = 0; r + 1 < nRows; ++r) {
             // 3      2
             //  x____x
             //  |   /|
@@ -90,11 +142,10 @@ Buffer generateDomeProjectionMesh(const std::filesystem::path& path, const vec2&
             //  x----x
             // 0      1
 
-            // add one to actually store the dimensions instead of the largest index
-            const unsigned int i0 = r * (nCols + 1)+ c;
-            const unsigned int i1 = r * (nCols + 1) + (c + 1);
-            const unsigned int i2 = (r + 1) * (nCols + 1) + (c + 1);
-            const unsigned int i3 = (r + 1) * (nCols + 1) + c;
+            const unsigned int i0 = r * nCols + c;
+            const unsigned int i1 = r * nCols + (c + 1);
+            const unsigned int i2 = (r + 1) * nCols + (c + 1);
+            const unsigned int i3 = (r + 1) * nCols + c;
 
             buf.indices.push_back(i0);
             buf.indices.push_back(i1);
@@ -106,6 +157,7 @@ Buffer generateDomeProjectionMesh(const std::filesystem::path& path, const vec2&
         }
     }
 
+    buf.grid = Buffer::Grid{ nCols, nRows };
     buf.geometryType = GL_TRIANGLES;
     return buf;
 }
@@ -0,0 +1,307 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/correction/meshcache.h>
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/profiling.h>
+#include <array>
+#include <bit>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <system_error>
+
+#define Error(code, msg) sgct::Error(sgct::Error::Component::CorrectionMesh, code, msg)
+
+namespace {
+    // Has to be increased whenever the layout of the file or of Buffer::Vertex changes,
+    // or when a parser or the simplification is changed in a way that produces different
+    // vertices or indices
+    constexpr uint32_t Version = 3;
+
+    constexpr std::array<char, 8> Magic = { 'S', 'G', 'C', 'T', 'M', 'E', 'S', 'H' };
+
+    enum Flags : uint32_t {
+        HasUserPosition = 1 << 0,
+        HasFrustum = 1 << 1,
+        HasPlaneOffset = 1 << 2
+    };
+
+    struct Header {
+        std::array<char, 8> magic = Magic;
+        uint32_t version = Version;
+        uint32_t geometryType = 0;
+        uint64_t key = 0;
+        uint64_t nVertices = 0;
+        uint64_t nIndices = 0;
+        uint32_t flags = 0;
+        std::array<float, 3> userPosition = {};
+        std::array<float, 4> fov = {};
+        std::array<float, 4> orientation = {};
+        std::array<float, 3> planeOffset = {};
+        uint32_t padding = 0;
+    };
+    // The vertices follow the header directly, so their alignment has to be kept
+    static_assert(sizeof(Header) % alignof(sgct::correction::Buffer::Vertex) == 0);
+    static_assert(sizeof(sgct::correction::Buffer::Vertex) == 8 * sizeof(float));
+
+    constexpr uint64_t Prime1 = 0x9E3779B185EBCA87;
+    constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4F;
+
+    uint64_t mix(uint64_t hash, uint64_t value) {
+        return std::rotl(hash + value * Prime2, 31) * Prime1;
+    }
+
+    uint64_t hashBytes(const unsigned char* data, size_t size) {
+        // Four independent lanes keep the multiplications from waiting on each other.
+        // This hashes several GB/s, so checking the cache costs a small fraction of
+        // parsing the text
+        std::array<uint64_t, 4> lanes = { Prime1, Prime2, ~Prime1, ~Prime2 };
+        size_t i = 0;
+        for (; i + 32 <= size; i += 32) {
+            for (size_t l = 0; l < lanes.size(); l++) {
+                uint64_t v = 0;
+                std::memcpy(&v, data + i + l * 8, sizeof(uint64_t));
+                lanes[l] = mix(lanes[l], v);
+            }
+        }
+
+        uint64_t hash = size;
+        for (uint64_t lane : lanes) {
+            hash = mix(hash, lane);
+        }
+        for (; i < size; i++) {
+            hash = mix(hash, data[i]);
+        }
+
+        // Spread the last bits over the whole key
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        return hash;
+    }
+} // namespace
+
+namespace sgct::correction {
+
+std::filesystem::path meshCacheDirectory() {
+    // The cache files are mapped and uploaded to the GPU without parsing them again, so
+    // they must not be stored in a shared location like the temporary directory where
+    // other users could place their own files
+    std::filesystem::path base;
+#ifdef WIN32
+    if (const char* appData = std::getenv("LOCALAPPDATA");  appData && *appData) {
+        base = appData;
+    }
+#elif defined(__APPLE__)
+    if (const char* home = std::getenv("HOME");  home && *home == '/') {
+        base = std::filesystem::path(home) / "Library" / "Caches";
+    }
+#else // !WIN32 && !__APPLE__
+    if (const char* cache = std::getenv("XDG_CACHE_HOME");  cache && *cache == '/') {
+        base = cache;
+    }
+    else if (const char* home = std::getenv("HOME");  home && *home == '/') {
+        base = std::filesystem::path(home) / ".cache";
+    }
+#endif // WIN32
+    return base.empty() ? base : base / "sgct" / "meshcache";
+}
+
+std::optional<uint64_t> meshCacheKey(const std::filesystem::path& path,
+                                     std::span<const float> parameters)
+{
+    ZoneScoped;
+
+    const MappedFile file = MappedFile(path);
+    if (!file.data()) {
+        return std::nullopt;
+    }
+
+    uint64_t key = hashBytes(file.data(), file.size());
+    key = mix(key, Version);
+    // The extension decides which parser is used for the same contents
+    const std::string ext = path.extension().string();
+    key = mix(
+        key,
+        hashBytes(reinterpret_cast<const unsigned char*>(ext.data()), ext.size())
+    );
+    for (float parameter : parameters) {
+        key = mix(key, std::bit_cast<uint32_t>(parameter));
+    }
+    return key;
+}
+
+std::filesystem::path meshCachePath(const std::filesystem::path& path, uint64_t key) {
+    return meshCacheDirectory() /
+        std::format("{}-{:016x}.sgctmesh", path.filename().string(), key);
+}
+
+void saveMeshCache(const std::filesystem::path& cachePath, uint64_t key,
+                   const Buffer& buffer)
+{
+    ZoneScoped;
+
+    Header header;
+    header.geometryType = buffer.geometryType;
+    header.key = key;
+    header.nVertices = buffer.vertices.size();
+    header.nIndices = buffer.indices.size();
+    if (buffer.view.userPosition) {
+        header.flags |= HasUserPosition;
+        const vec3& p = *buffer.view.userPosition;
+        header.userPosition = { p.x, p.y, p.z };
+    }
+    if (buffer.view.frustum) {
+        header.flags |= HasFrustum;
+        const Buffer::View::Frustum& f = *buffer.view.frustum;
+        header.fov = { f.up, f.down, f.left, f.right };
+        header.orientation = {
+            f.orientation.x, f.orientation.y, f.orientation.z, f.orientation.w
+        };
+    }
+    if (buffer.view.planeOffset) {
+        header.flags |= HasPlaneOffset;
+        const vec3& o = *buffer.view.planeOffset;
+        header.planeOffset = { o.x, o.y, o.z };
+    }
+
+    // Only the current user can read or write the cache files
+    const std::filesystem::path directory = cachePath.parent_path();
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    std::filesystem::permissions(directory, std::filesystem::perms::owner_all, ec);
+
+    // Multiple nodes on the same machine might write the same cache file at once, so
+    // each writes to its own file first
+    std::filesystem::path tmp = cachePath;
+    tmp += std::format(".{:08x}.tmp", std::random_device()());
+    {
+        std::ofstream file = std::ofstream(tmp, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        file.write(
+            reinterpret_cast<const char*>(buffer.vertices.data()),
+            buffer.vertices.size() * sizeof(Buffer::Vertex)
+        );
+        file.write(
+            reinterpret_cast<const char*>(buffer.indices.data()),
+            buffer.indices.size() * sizeof(unsigned int)
+        );
+        if (!file.good()) {
+            file.close();
+            std::filesystem::remove(tmp, ec);
+            throw Error(2003, std::format("Could not write mesh cache '{}'", tmp));
+        }
+    }
+
+    std::filesystem::rename(tmp, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        throw Error(
+            2004,
+            std::format("Could not move mesh cache to '{}': {}", cachePath, ec.message())
+        );
+    }
+}
+
+std::unique_ptr<CachedMesh> CachedMesh::open(const std::filesystem::path& cachePath,
+                                             uint64_t key)
+{
+    ZoneScoped;
+
+    // The constructor is private, so std::make_unique cannot be used
+    std::unique_ptr<CachedMesh> mesh = std::unique_ptr<CachedMesh>(
+        new CachedMesh(cachePath)
+    );
+    const unsigned char* data = mesh->_file.data();
+    const size_t size = mesh->_file.size();
+    if (!data || size < sizeof(Header)) {
+        return nullptr;
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    if (header.magic != Magic || header.version != Version || header.key != key) {
+        return nullptr;
+    }
+    // The counts are checked against the remaining size before they are multiplied, so
+    // that a damaged header cannot overflow the computed sizes
+    const uint64_t nBytes = size - sizeof(Header);
+    if (header.nVertices > nBytes / sizeof(Buffer::Vertex)) {
+        return nullptr;
+    }
+    const uint64_t nVertexBytes = header.nVertices * sizeof(Buffer::Vertex);
+    if (header.nIndices > (nBytes - nVertexBytes) / sizeof(unsigned int)) {
+        return nullptr;
+    }
+    const uint64_t nIndexBytes = header.nIndices * sizeof(unsigned int);
+    if (nVertexBytes + nIndexBytes != nBytes) {
+        return nullptr;
+    }
+
+    mesh->_vertices = std::span<const Buffer::Vertex>(
+        reinterpret_cast<const Buffer::Vertex*>(data + sizeof(Header)),
+        header.nVertices
+    );
+    mesh->_indices = std::span<const unsigned int>(
+        reinterpret_cast<const unsigned int*>(data + sizeof(Header) + nVertexBytes),
+        header.nIndices
+    );
+    mesh->_geometryType = header.geometryType;
+    if (header.flags & HasUserPosition) {
+        mesh->_view.userPosition = vec3{
+            header.userPosition[0], header.userPosition[1], header.userPosition[2]
+        };
+    }
+    if (header.flags & HasFrustum) {
+        mesh->_view.frustum = Buffer::View::Frustum{
+            .up = header.fov[0],
+            .down = header.fov[1],
+            .left = header.fov[2],
+            .right = header.fov[3],
+            .orientation = quat(
+                header.orientation[0],
+                header.orientation[1],
+                header.orientation[2],
+                header.orientation[3]
+            )
+        };
+    }
+    if (header.flags & HasPlaneOffset) {
+        mesh->_view.planeOffset = vec3{
+            header.planeOffset[0], header.planeOffset[1], header.planeOffset[2]
+        };
+    }
+    return mesh;
+}
+
+CachedMesh::CachedMesh(const std::filesystem::path& cachePath)
+    : _file(cachePath)
+{}
+
+std::span<const Buffer::Vertex> CachedMesh::vertices() const {
+    return _vertices;
+}
+
+std::span<const unsigned int> CachedMesh::indices() const {
+    return _indices;
+}
+
+unsigned int CachedMesh::geometryType() const {
+    return _geometryType;
+}
+
+const Buffer::View& CachedMesh::view() const {
+    return _view;
+}
+
+} // namespace sgct::correction
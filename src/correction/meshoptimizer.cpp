@@ -0,0 +1,742 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/correction/meshoptimizer.h>
+
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    // The parameters from Tom Forsyth's article
+    constexpr int CacheSize = 32;
+    constexpr float CacheDecayPower = 1.5f;
+    constexpr float LastTriangleScore = 0.75f;
+    constexpr float ValenceBoostScale = 2.f;
+    constexpr float ValenceBoostPower = 0.5f;
+
+    float vertexScore(int cachePosition, int nRemainingTriangles) {
+        if (nRemainingTriangles == 0) {
+            // The vertex is not used by any triangle that is left
+            return -1.f;
+        }
+
+        float score = 0.f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // The vertex was used in the last triangle. A fixed score is used so
+                // that it does not matter in which order its vertices were added
+                score = LastTriangleScore;
+            }
+            else {
+                const float scaler = 1.f / (CacheSize - 3);
+                score = 1.f - (cachePosition - 3) * scaler;
+                score = std::pow(score, CacheDecayPower);
+            }
+        }
+
+        // Vertices with only a few triangles left are preferred, so that they can leave
+        // the cache for good
+        const float valenceBoost = std::pow(
+            static_cast<float>(nRemainingTriangles),
+            -ValenceBoostPower
+        );
+        return score + ValenceBoostScale * valenceBoost;
+    }
+
+    uint8_t toUnorm8(float v) {
+        return static_cast<uint8_t>(std::lround(v * 255.f));
+    }
+
+    uint16_t toUnorm16(float v) {
+        return static_cast<uint16_t>(std::lround(v * 65535.f));
+    }
+
+    int16_t toSnorm16(float v) {
+        return static_cast<int16_t>(std::lround(v * 32767.f));
+    }
+
+    using Triangle = std::array<unsigned int, 3>;
+    using sgct::correction::Buffer;
+    using sgct::correction::SimplificationReport;
+    using sgct::correction::SimplificationTolerance;
+
+    /// A square region of `size` x `size` grid cells with its lower left corner at x, y
+    struct Block {
+        unsigned int x = 0;
+        unsigned int y = 0;
+        unsigned int size = 0;
+    };
+
+    /// \return The non-degenerate triangles of the \p buffer as a triangle list
+    std::vector<Triangle> triangleList(const Buffer& buffer) {
+        const std::vector<unsigned int>& ids = buffer.indices;
+        std::vector<Triangle> res;
+        if (buffer.geometryType == GL_TRIANGLES) {
+            res.reserve(ids.size() / 3);
+            for (size_t i = 0; i + 2 < ids.size(); i += 3) {
+                res.push_back({ ids[i], ids[i + 1], ids[i + 2] });
+            }
+        }
+        else {
+            // Every other triangle of a strip has its first two vertices swapped to keep
+            // the winding order
+            assert(buffer.geometryType == GL_TRIANGLE_STRIP);
+            res.reserve(ids.size());
+            for (size_t i = 0; i + 2 < ids.size(); i++) {
+                if (i % 2 == 0) {
+                    res.push_back({ ids[i], ids[i + 1], ids[i + 2] });
+                }
+                else {
+                    res.push_back({ ids[i + 1], ids[i], ids[i + 2] });
+                }
+            }
+        }
+        std::erase_if(
+            res,
+            [](const Triangle& t) { return t[0] == t[1] || t[1] == t[2] || t[0] == t[2]; }
+        );
+        return res;
+    }
+
+    /**
+     * Compares the vertices of the grid that lie inside the triangle \p p0, \p p1,
+     * \p p2 (in grid positions) with the values that the triangle interpolates for them
+     * and adds the differences to the \p errors.
+     *
+     * \return `false` if any of the differences is larger than the \p tolerance
+     */
+    bool checkTriangle(const std::vector<Buffer::Vertex>& vertices, unsigned int nColumns,
+                       sgct::ivec2 p0, sgct::ivec2 p1, sgct::ivec2 p2,
+                       const SimplificationTolerance& tolerance,
+                       SimplificationReport& errors)
+    {
+        const Buffer::Vertex& v0 = vertices[p0.y * nColumns + p0.x];
+        const Buffer::Vertex& v1 = vertices[p1.y * nColumns + p1.x];
+        const Buffer::Vertex& v2 = vertices[p2.y * nColumns + p2.x];
+
+        // The barycentric coordinates are computed with integers, so that points on the
+        // edges are classified exactly. The factors are flipped for clockwise triangles,
+        // so that the weights of points inside are always positive
+        int64_t a0 = p1.y - p2.y;
+        int64_t b0 = p2.x - p1.x;
+        int64_t a1 = p2.y - p0.y;
+        int64_t b1 = p0.x - p2.x;
+        int64_t d = a0 * (p0.x - p2.x) + b0 * (p0.y - p2.y);
+        assert(d != 0);
+        if (d < 0) {
+            a0 = -a0;
+            b0 = -b0;
+            a1 = -a1;
+            b1 = -b1;
+            d = -d;
+        }
+
+        const int minX = std::min({ p0.x, p1.x, p2.x });
+        const int maxX = std::max({ p0.x, p1.x, p2.x });
+        const int minY = std::min({ p0.y, p1.y, p2.y });
+        const int maxY = std::max({ p0.y, p1.y, p2.y });
+        for (int y = minY; y <= maxY; y++) {
+            for (int x = minX; x <= maxX; x++) {
+                const int64_t w0 = a0 * (x - p2.x) + b0 * (y - p2.y);
+                const int64_t w1 = a1 * (x - p2.x) + b1 * (y - p2.y);
+                const int64_t w2 = d - w0 - w1;
+                if (w0 < 0 || w1 < 0 || w2 < 0) {
+                    continue;
+                }
+
+                const float a = static_cast<float>(w0) / static_cast<float>(d);
+                const float b = static_cast<float>(w1) / static_cast<float>(d);
+                const float c = 1.f - a - b;
+                auto error = [&](float Buffer::Vertex::* member, float original) {
+                    return std::abs(a * v0.*member + b * v1.*member + c * v2.*member -
+                        original);
+                };
+
+                const Buffer::Vertex& v = vertices[y * nColumns + x];
+                const sgct::vec2 position = sgct::vec2(
+                    error(&Buffer::Vertex::x, v.x),
+                    error(&Buffer::Vertex::y, v.y)
+                );
+                const sgct::vec2 texture = sgct::vec2(
+                    error(&Buffer::Vertex::s, v.s),
+                    error(&Buffer::Vertex::t, v.t)
+                );
+                const float color = std::max({
+                    error(&Buffer::Vertex::r, v.r),
+                    error(&Buffer::Vertex::g, v.g),
+                    error(&Buffer::Vertex::b, v.b),
+                    error(&Buffer::Vertex::a, v.a)
+                });
+                if (position.x > tolerance.position.x ||
+                    position.y > tolerance.position.y ||
+                    texture.x > tolerance.textureCoordinate.x ||
+                    texture.y > tolerance.textureCoordinate.y ||
+                    color > tolerance.color)
+                {
+                    return false;
+                }
+                errors.positionError.x = std::max(errors.positionError.x, position.x);
+                errors.positionError.y = std::max(errors.positionError.y, position.y);
+                errors.textureCoordinateError.x =
+                    std::max(errors.textureCoordinateError.x, texture.x);
+                errors.textureCoordinateError.y =
+                    std::max(errors.textureCoordinateError.y, texture.y);
+                errors.colorError = std::max(errors.colorError, color);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Collects the grid positions on the border of the \p block in counter-clockwise
+     * order, starting at its lower left corner. The corners are always included, all
+     * other positions only if they are marked in \p isUsed. If \p isUsed is empty, only
+     * the corners are collected.
+     */
+    void collectBorder(const Block& block, const std::vector<uint8_t>& isUsed,
+                       unsigned int nColumns, std::vector<sgct::ivec2>& border)
+    {
+        border.clear();
+        const int x0 = static_cast<int>(block.x);
+        const int y0 = static_cast<int>(block.y);
+        const int s = static_cast<int>(block.size);
+        auto add = [&](int x, int y) {
+            if (isUsed.empty()) {
+                return;
+            }
+            if (isUsed[static_cast<size_t>(y) * nColumns + x]) {
+                border.emplace_back(x, y);
+            }
+        };
+
+        border.emplace_back(x0, y0);
+        for (int i = 1; i < s; i++) {
+            add(x0 + i, y0);
+        }
+        border.emplace_back(x0 + s, y0);
+        for (int i = 1; i < s; i++) {
+            add(x0 + s, y0 + i);
+        }
+        border.emplace_back(x0 + s, y0 + s);
+        for (int i = s - 1; i > 0; i--) {
+            add(x0 + i, y0 + s);
+        }
+        border.emplace_back(x0, y0 + s);
+        for (int i = s - 1; i > 0; i--) {
+            add(x0, y0 + i);
+        }
+    }
+
+    /// \return `true` if the fan from the center of \p block to the \p border is
+    ///         within the \p tolerance for all vertices of the block
+    bool checkFan(const std::vector<Buffer::Vertex>& vertices, unsigned int nColumns,
+                  const Block& block, const std::vector<sgct::ivec2>& border,
+                  const SimplificationTolerance& tolerance, SimplificationReport& errors)
+    {
+        const int half = static_cast<int>(block.size / 2);
+        const sgct::ivec2 center = sgct::ivec2(
+            static_cast<int>(block.x) + half,
+            static_cast<int>(block.y) + half
+        );
+        for (size_t i = 0; i < border.size(); i++) {
+            const sgct::ivec2 p1 = border[i];
+            const sgct::ivec2 p2 = border[(i + 1) % border.size()];
+            if (!checkTriangle(vertices, nColumns, center, p1, p2, tolerance, errors)) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+namespace sgct::correction {
+
+std::optional<std::vector<PackedVertex>> packVertices(
+                                                 std::span<const Buffer::Vertex> vertices)
+{
+    ZoneScoped;
+
+    auto isUnit = [](float v) { return v >= 0.f && v <= 1.f; };
+    auto isSignedUnit = [](float v) { return v >= -1.f && v <= 1.f; };
+
+    std::vector<PackedVertex> res;
+    res.reserve(vertices.size());
+    for (const Buffer::Vertex& v : vertices) {
+        const bool inRange =
+            isSignedUnit(v.x) && isSignedUnit(v.y) && isUnit(v.s) && isUnit(v.t) &&
+            isUnit(v.r) && isUnit(v.g) && isUnit(v.b) && isUnit(v.a);
+        if (!inRange) {
+            return std::nullopt;
+        }
+
+        PackedVertex p;
+        p.x = toSnorm16(v.x);
+        p.y = toSnorm16(v.y);
+        p.s = toUnorm16(v.s);
+        p.t = toUnorm16(v.t);
+        p.r = toUnorm8(v.r);
+        p.g = toUnorm8(v.g);
+        p.b = toUnorm8(v.b);
+        p.a = toUnorm8(v.a);
+        res.push_back(p);
+    }
+    return res;
+}
+
+void optimizeVertexCache(std::span<unsigned int> indices, size_t nVertices) {
+    ZoneScoped;
+
+    assert(indices.size() % 3 == 0);
+    const size_t nTriangles = indices.size() / 3;
+
+    struct Vertex {
+        // The offset of the triangles of this vertex in triangleLists
+        size_t firstTriangle = 0;
+        int nTriangles = 0;
+        int nRemainingTriangles = 0;
+        int cachePosition = -1;
+        float score = 0.f;
+    };
+    std::vector<Vertex> vertices(nVertices);
+    for (unsigned int index : indices) {
+        if (index >= nVertices) {
+            throw std::out_of_range("Index of the triangle list is out of range");
+        }
+        vertices[index].nTriangles++;
+    }
+    if (nTriangles < 2) {
+        return;
+    }
+    size_t offset = 0;
+    for (Vertex& v : vertices) {
+        v.firstTriangle = offset;
+        offset += v.nTriangles;
+        v.nRemainingTriangles = v.nTriangles;
+    }
+
+    // The triangles that use each vertex. Triangles that have been added are moved
+    // behind the remaining ones, so that only the first nRemainingTriangles are visited
+    std::vector<unsigned int> triangleLists(indices.size());
+    {
+        std::vector<int> fill(nVertices, 0);
+        for (size_t i = 0; i < indices.size(); i++) {
+            const unsigned int index = indices[i];
+            Vertex& v = vertices[index];
+            const unsigned int triangle = static_cast<unsigned int>(i / 3);
+            triangleLists[v.firstTriangle + fill[index]] = triangle;
+            fill[index]++;
+        }
+    }
+
+    for (Vertex& v : vertices) {
+        v.score = vertexScore(v.cachePosition, v.nRemainingTriangles);
+    }
+
+    std::vector<float> triangleScores(nTriangles);
+    std::vector<bool> isAdded(nTriangles, false);
+    for (size_t t = 0; t < nTriangles; t++) {
+        triangleScores[t] = vertices[indices[t * 3]].score +
+            vertices[indices[t * 3 + 1]].score + vertices[indices[t * 3 + 2]].score;
+    }
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+
+    // The cache has room for the three vertices of the new triangle in front of the
+    // vertices that were in the cache before
+    std::array<unsigned int, CacheSize + 3> cache;
+    int cacheEntries = 0;
+
+    size_t bestTriangle = 0;
+    for (size_t t = 1; t < nTriangles; t++) {
+        if (triangleScores[t] > triangleScores[bestTriangle]) {
+            bestTriangle = t;
+        }
+    }
+    // Triangles before this one have all been added, which keeps the search for a new
+    // start triangle linear when the cache runs dry
+    size_t firstRemaining = 0;
+
+    while (result.size() < indices.size()) {
+        const unsigned int* tri = &indices[bestTriangle * 3];
+        result.insert(result.end(), tri, tri + 3);
+        isAdded[bestTriangle] = true;
+
+        // Remove the triangle from the lists of its vertices
+        for (int i = 0; i < 3; i++) {
+            Vertex& v = vertices[tri[i]];
+            unsigned int* list = &triangleLists[v.firstTriangle];
+            unsigned int* end = list + v.nRemainingTriangles;
+            unsigned int* it =
+                std::find(list, end, static_cast<unsigned int>(bestTriangle));
+            assert(it != end);
+            std::swap(*it, *(end - 1));
+            v.nRemainingTriangles--;
+        }
+
+        // Move the vertices of the triangle to the front of the cache
+        std::array<unsigned int, CacheSize + 3> newCache;
+        int newEntries = 0;
+        for (int i = 0; i < 3; i++) {
+            newCache[newEntries] = tri[i];
+            newEntries++;
+        }
+        for (int i = 0; i < cacheEntries; i++) {
+            const unsigned int index = cache[i];
+            if (index != tri[0] && index != tri[1] && index != tri[2]) {
+                newCache[newEntries] = index;
+                newEntries++;
+            }
+        }
+
+        // Update the scores of all vertices whose cache position changed, including
+        // the ones that dropped out of the cache
+        for (int i = 0; i < newEntries; i++) {
+            Vertex& v = vertices[newCache[i]];
+            v.cachePosition = i < CacheSize ? i : -1;
+            v.score = vertexScore(v.cachePosition, v.nRemainingTriangles);
+        }
+        cache = newCache;
+        cacheEntries = std::min(newEntries, CacheSize);
+
+        // Rescore the triangles of the vertices in the cache and pick the best one
+        float bestScore = -1.f;
+        bool hasBest = false;
+        for (int i = 0; i < cacheEntries; i++) {
+            const Vertex& v = vertices[cache[i]];
+            for (int j = 0; j < v.nRemainingTriangles; j++) {
+                const unsigned int t = triangleLists[v.firstTriangle + j];
+                const float score = vertices[indices[t * 3]].score +
+                    vertices[indices[t * 3 + 1]].score +
+                    vertices[indices[t * 3 + 2]].score;
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = t;
+                    hasBest = true;
+                }
+            }
+        }
+
+        if (!hasBest && result.size() < indices.size()) {
+            // None of the cached vertices have triangles left, so the mesh continues
+            // with the next triangle in the original order
+            while (isAdded[firstRemaining]) {
+                firstRemaining++;
+            }
+            bestTriangle = firstRemaining;
+        }
+    }
+
+    std::copy(result.begin(), result.end(), indices.begin());
+}
+
+float averageCacheMissRatio(std::span<const unsigned int> indices, int cacheSize) {
+    if (indices.size() < 3) {
+        return 0.f;
+    }
+
+    // A vertex is still in the cache if it is one of the last cacheSize vertices that
+    // were added, so the cache does not have to be searched
+    constexpr size_t NotCached = std::numeric_limits<size_t>::max();
+    const unsigned int maxIndex = *std::max_element(indices.begin(), indices.end());
+    std::vector<size_t> addedAt(static_cast<size_t>(maxIndex) + 1, NotCached);
+    size_t nMisses = 0;
+    for (unsigned int index : indices) {
+        const size_t added = addedAt[index];
+        if (added != NotCached && nMisses - added <= static_cast<size_t>(cacheSize)) {
+            continue;
+        }
+        addedAt[index] = nMisses;
+        nMisses++;
+    }
+    return static_cast<float>(nMisses) / static_cast<float>(indices.size() / 3);
+}
+
+std::optional<SimplificationReport> simplifyGrid(Buffer& buffer,
+                                                 const SimplificationTolerance& tolerance)
+{
+    ZoneScoped;
+
+    if (!buffer.grid.has_value()) {
+        return std::nullopt;
+    }
+    const bool isTriangles = buffer.geometryType == GL_TRIANGLES ||
+        buffer.geometryType == GL_TRIANGLE_STRIP;
+    const unsigned int nColumns = buffer.grid->nColumns;
+    const unsigned int nRows = buffer.grid->nRows;
+    const size_t nGridVertices = static_cast<size_t>(nColumns) * nRows;
+    if (!isTriangles || nColumns < 2 || nRows < 2 ||
+        buffer.vertices.size() < nGridVertices)
+    {
+        return std::nullopt;
+    }
+    const unsigned int nCellsX = nColumns - 1;
+    const unsigned int nCellsY = nRows - 1;
+
+    const std::vector<Triangle> triangles = triangleList(buffer);
+    for (const Triangle& t : triangles) {
+        for (unsigned int index : t) {
+            if (index >= buffer.vertices.size()) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    SimplificationReport report;
+    report.nTrianglesBefore = triangles.size();
+    {
+        std::vector<uint8_t> isReferenced(buffer.vertices.size(), 0);
+        for (const Triangle& t : triangles) {
+            for (unsigned int index : t) {
+                isReferenced[index] = 1;
+            }
+        }
+        report.nVerticesBefore = std::count(isReferenced.begin(), isReferenced.end(), 1);
+    }
+
+    // Find the grid cell of each triangle and which corners of the cell are covered.
+    // Cells whose triangles cover all four corners can be simplified, all others and
+    // triangles that do not belong to a single cell are kept unchanged
+    constexpr unsigned int NoCell = std::numeric_limits<unsigned int>::max();
+    std::vector<unsigned int> cellOfTriangle(triangles.size(), NoCell);
+    std::vector<uint8_t> corners(static_cast<size_t>(nCellsX) * nCellsY, 0);
+    // The winding order of the grid triangles, which the new triangles have to match
+    int64_t winding = 0;
+    for (size_t i = 0; i < triangles.size(); i++) {
+        const Triangle& t = triangles[i];
+        if (t[0] >= nGridVertices || t[1] >= nGridVertices || t[2] >= nGridVertices) {
+            continue;
+        }
+        std::array<ivec2, 3> p;
+        for (int j = 0; j < 3; j++) {
+            p[j] = ivec2(
+                static_cast<int>(t[j] % nColumns),
+                static_cast<int>(t[j] / nColumns)
+            );
+        }
+        const int minX = std::min({ p[0].x, p[1].x, p[2].x });
+        const int minY = std::min({ p[0].y, p[1].y, p[2].y });
+        const int maxX = std::max({ p[0].x, p[1].x, p[2].x });
+        const int maxY = std::max({ p[0].y, p[1].y, p[2].y });
+        if (maxX - minX != 1 || maxY - minY != 1) {
+            continue;
+        }
+
+        const int64_t area =
+            static_cast<int64_t>(p[1].x - p[0].x) * (p[2].y - p[0].y) -
+            static_cast<int64_t>(p[1].y - p[0].y) * (p[2].x - p[0].x);
+        if (winding == 0) {
+            winding = area;
+        }
+
+        const unsigned int cell = minY * nCellsX + minX;
+        cellOfTriangle[i] = cell;
+        for (const ivec2& q : p) {
+            corners[cell] |= 1 << ((q.x - minX) + 2 * (q.y - minY));
+        }
+    }
+
+    // The number of full cells below and to the left of each grid position, so that the
+    // number of full cells in a block can be looked up directly
+    std::vector<unsigned int> nFull(nGridVertices, 0);
+    for (unsigned int y = 0; y < nCellsY; y++) {
+        for (unsigned int x = 0; x < nCellsX; x++) {
+            const bool isFull = corners[y * nCellsX + x] == 0b1111;
+            nFull[(y + 1) * nColumns + x + 1] = (isFull ? 1 : 0) +
+                nFull[y * nColumns + x + 1] + nFull[(y + 1) * nColumns + x] -
+                nFull[y * nColumns + x];
+        }
+    }
+    auto isFullBlock = [&](const Block& b) {
+        if (b.x + b.size > nCellsX || b.y + b.size > nCellsY) {
+            return false;
+        }
+        const unsigned int x1 = b.x + b.size;
+        const unsigned int y1 = b.y + b.size;
+        const unsigned int n = nFull[y1 * nColumns + x1] - nFull[b.y * nColumns + x1] -
+            nFull[y1 * nColumns + b.x] + nFull[b.y * nColumns + b.x];
+        return n == b.size * b.size;
+    };
+
+    // Build the quadtree from the top. A block becomes a leaf if the fan to its four
+    // corners is within the tolerance, which is only an estimate as the neighbors can add
+    // vertices to its border
+    std::vector<Block> leaves;
+    std::vector<ivec2> border;
+    {
+        unsigned int rootSize = 1;
+        while (rootSize < std::max(nCellsX, nCellsY)) {
+            rootSize *= 2;
+        }
+        std::vector<Block> blocks = { Block{ 0, 0, rootSize } };
+        const std::vector<uint8_t> cornersOnly;
+        while (!blocks.empty()) {
+            const Block b = blocks.back();
+            blocks.pop_back();
+            if (b.x >= nCellsX || b.y >= nCellsY) {
+                continue;
+            }
+
+            if (isFullBlock(b)) {
+                if (b.size == 1) {
+                    leaves.push_back(b);
+                    continue;
+                }
+                SimplificationReport errors;
+                collectBorder(b, cornersOnly, nColumns, border);
+                const bool fits = checkFan(
+                    buffer.vertices, nColumns, b, border, tolerance, errors
+                );
+                if (fits) {
+                    leaves.push_back(b);
+                    continue;
+                }
+            }
+
+            if (b.size > 1) {
+                const unsigned int h = b.size / 2;
+                blocks.push_back(Block{ b.x, b.y, h });
+                blocks.push_back(Block{ b.x + h, b.y, h });
+                blocks.push_back(Block{ b.x, b.y + h, h });
+                blocks.push_back(Block{ b.x + h, b.y + h, h });
+            }
+        }
+    }
+
+    // Vertices on the border of a leaf that are used by a smaller neighbor are included
+    // in the fan of the leaf, which avoids T-junctions. This changes the triangles of the
+    // leaf, so all leaves are verified against every vertex and the ones that exceed the
+    // tolerance are split until all of them pass. Leaves of a single cell keep their
+    // original triangles and are always exact at the vertices
+    std::vector<uint8_t> isUsed(nGridVertices, 0);
+    std::vector<uint8_t> isKeptCell(corners.size(), 0);
+    while (true) {
+        std::fill(isUsed.begin(), isUsed.end(), uint8_t(0));
+        for (const Block& b : leaves) {
+            const unsigned int i0 = b.y * nColumns + b.x;
+            const unsigned int i1 = (b.y + b.size) * nColumns + b.x;
+            isUsed[i0] = 1;
+            isUsed[i0 + b.size] = 1;
+            isUsed[i1] = 1;
+            isUsed[i1 + b.size] = 1;
+        }
+        for (size_t i = 0; i < triangles.size(); i++) {
+            const unsigned int cell = cellOfTriangle[i];
+            if (cell != NoCell && corners[cell] == 0b1111) {
+                continue;
+            }
+            for (unsigned int index : triangles[i]) {
+                if (index < nGridVertices) {
+                    isUsed[index] = 1;
+                }
+            }
+        }
+
+        SimplificationReport errors;
+        std::vector<Block> next;
+        next.reserve(leaves.size());
+        for (const Block& b : leaves) {
+            if (b.size == 1) {
+                next.push_back(b);
+                continue;
+            }
+            collectBorder(b, isUsed, nColumns, border);
+            if (checkFan(buffer.vertices, nColumns, b, border, tolerance, errors)) {
+                next.push_back(b);
+            }
+            else {
+                const unsigned int h = b.size / 2;
+                next.push_back(Block{ b.x, b.y, h });
+                next.push_back(Block{ b.x + h, b.y, h });
+                next.push_back(Block{ b.x, b.y + h, h });
+                next.push_back(Block{ b.x + h, b.y + h, h });
+            }
+        }
+
+        if (next.size() == leaves.size()) {
+            report.positionError = errors.positionError;
+            report.textureCoordinateError = errors.textureCoordinateError;
+            report.colorError = errors.colorError;
+            break;
+        }
+        leaves = std::move(next);
+    }
+
+    // Create the new triangle list from the fans of the leaves and the triangles that
+    // were kept
+    std::vector<unsigned int> indices;
+    auto addTriangle = [&](unsigned int i0, unsigned int i1, unsigned int i2) {
+        indices.push_back(i0);
+        indices.push_back(i1);
+        indices.push_back(i2);
+    };
+    for (const Block& b : leaves) {
+        if (b.size == 1) {
+            isKeptCell[b.y * nCellsX + b.x] = 1;
+            continue;
+        }
+        collectBorder(b, isUsed, nColumns, border);
+        const unsigned int half = b.size / 2;
+        const unsigned int center = (b.y + half) * nColumns + b.x + half;
+        for (size_t i = 0; i < border.size(); i++) {
+            const ivec2 p1 = border[i];
+            const ivec2 p2 = border[(i + 1) % border.size()];
+            const unsigned int i1 = p1.y * nColumns + p1.x;
+            const unsigned int i2 = p2.y * nColumns + p2.x;
+            // The border is counter-clockwise in grid positions
+            if (winding >= 0) {
+                addTriangle(center, i1, i2);
+            }
+            else {
+                addTriangle(center, i2, i1);
+            }
+        }
+    }
+    for (size_t i = 0; i < triangles.size(); i++) {
+        const unsigned int cell = cellOfTriangle[i];
+        if (cell == NoCell || corners[cell] != 0b1111 || isKeptCell[cell]) {
+            const Triangle& t = triangles[i];
+            addTriangle(t[0], t[1], t[2]);
+        }
+    }
+
+    // Remove the vertices that are no longer used, keeping the order of the others
+    constexpr unsigned int Unused = std::numeric_limits<unsigned int>::max();
+    std::vector<unsigned int> newIndex(buffer.vertices.size(), Unused);
+    for (unsigned int index : indices) {
+        newIndex[index] = 0;
+    }
+    std::vector<Buffer::Vertex> vertices;
+    for (size_t i = 0; i < buffer.vertices.size(); i++) {
+        if (newIndex[i] != Unused) {
+            newIndex[i] = static_cast<unsigned int>(vertices.size());
+            vertices.push_back(buffer.vertices[i]);
+        }
+    }
+    for (unsigned int& index : indices) {
+        index = newIndex[index];
+    }
+
+    report.nVerticesAfter = vertices.size();
+    report.nTrianglesAfter = indices.size() / 3;
+
+    buffer.vertices = std::move(vertices);
+    buffer.indices = std::move(indices);
+    buffer.geometryType = GL_TRIANGLES;
+    buffer.grid = std::nullopt;
+    return report;
+}
+
+} // namespace sgct::correction
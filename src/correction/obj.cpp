@@ -11,10 +11,14 @@
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
+#include <sgct/mappedfile.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
+#include <sgct/correction/textparser.h>
+#include <algorithm>
+#include <array>
 #include <cassert>
-#include <fstream>
+#include <iterator>
 
 namespace {
     struct Position {
@@ -30,198 +34,177 @@ namespace {
         int f2 = 0;
         int f3 = 0;
     };
-} // namespace
-
-namespace sgct::correction {
 
-Buffer generateOBJMesh(const std::filesystem::path& path) {
-    ZoneScoped;
+    struct Chunk {
+        std::vector<Position> positions;
+        std::vector<Texture> texCoords;
+        std::vector<Face> faces;
+        /// The keywords that are not supported, in the order of their first occurrence
+        std::vector<std::string_view> ignored;
+        bool hasZ = false;
+    };
 
-    Log::Info(std::format("Reading Wavefront OBJ mesh data from '{}'", path));
+    // The OBJ elements that are ignored and what they contain
+    struct IgnoredElement {
+        std::string_view keyword;
+        std::string_view description;
+    };
+    constexpr std::array<IgnoredElement, 8> Ignored = {
+        IgnoredElement{ "vn", "normals" },
+        IgnoredElement{ "vp", "parameter space values" },
+        IgnoredElement{ "l", "line elements" },
+        IgnoredElement{ "mtllib", "material library" },
+        IgnoredElement{ "usemtl", "material specification" },
+        IgnoredElement{ "o", "object specification" },
+        IgnoredElement{ "g", "object group specification" },
+        IgnoredElement{ "s", "shading specification" }
+    };
 
-    std::ifstream file = std::ifstream(path);
-    if (!file.good()) {
-        throw Error(
-            Error::Component::OBJ, 2030, std::format("Failed to open '{}'", path)
-        );
+    /// Parses the vertex index of a face element, ignoring the texture and normal index
+    bool parseFaceIndex(std::string_view& line, int& index) {
+        std::string_view element = sgct::correction::parseWord(line);
+        return sgct::correction::parseNumber(element, index);
     }
 
-    std::vector<Position> positions;
-    std::vector<Texture> texCoords;
-    std::vector<Face> faces;
+    Chunk parseChunk(std::string_view chunk, const std::filesystem::path& path) {
+        using namespace sgct;
+        using namespace sgct::correction;
 
-    std::vector<std::string> reported;
+        Chunk res;
+        // Most lines have about 30 characters and the vertex positions, texture
+        // coordinates, and faces appear in about equal numbers
+        const size_t nElements = chunk.size() / 30 / 3;
+        res.positions.reserve(nElements);
+        res.texCoords.reserve(nElements);
+        res.faces.reserve(nElements);
 
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty()) {
-            continue;
-        }
-        else if (line.back() == '\r') {
-            line.pop_back();
-        }
-
-        const std::string_view v = line;
-        const size_t separator = v.find(' ');
-        std::string_view first = v.substr(0, separator);
-        std::string_view rest = v.substr(separator + 1);
-
-        if (first == "v") {
-            size_t sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                throw Error(
-                    Error::Component::OBJ, 2034,
-                    std::format(
-                        "Illegal vertex format in OBJ file '{}' in line {}", path, line
-                    )
-                );
+        while (!chunk.empty()) {
+            const std::string_view line = nextLine(chunk);
+            std::string_view rest = line;
+            const std::string_view first = parseWord(rest);
+            if (first.empty() || first.front() == '#') {
+                continue;
             }
-            const std::string_view v1 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
 
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                throw Error(
-                    Error::Component::OBJ, 2034,
-                    std::format(
-                        "Illegal vertex format in OBJ file '{}' in line {}", path, line
-                    )
-                );
+            if (first == "v") {
+                Position p;
+                float z = 0.f;
+                const bool valid = parseNumber(rest, p.x) && parseNumber(rest, p.y) &&
+                    parseNumber(rest, z);
+                if (!valid) {
+                    throw Error(
+                        Error::Component::OBJ, 2034,
+                        std::format(
+                            "Illegal vertex format in OBJ file '{}' in line {}",
+                            path, line
+                        )
+                    );
+                }
+                res.hasZ |= z != 0.f;
+                res.positions.push_back(p);
             }
-            const std::string_view v2 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            const std::string_view v3 = rest;
-            const float z = std::stof(std::string(v3));
-            if (z != 0.f) {
-                Log::Warning(std::format(
-                    "Vertex in '{}' was using z coordinate which is not supported", path
-                ));
+            else if (first == "vt") {
+                Texture t;
+                if (!parseNumber(rest, t.s) || !parseNumber(rest, t.t)) {
+                    throw Error(
+                        Error::Component::OBJ, 2034,
+                        std::format(
+                            "Illegal texture coordinate format in OBJ file '{}' in "
+                            "line {}", path, line
+                        )
+                    );
+                }
+                res.texCoords.push_back(t);
+            }
+            else if (first == "f") {
+                Face f;
+                const bool valid = parseFaceIndex(rest, f.f1) &&
+                    parseFaceIndex(rest, f.f2) && parseFaceIndex(rest, f.f3);
+                if (!valid) {
+                    throw Error(
+                        Error::Component::OBJ, 2035,
+                        std::format(
+                            "Illegal face format in OBJ file '{}' in line {}", path, line
+                        )
+                    );
+                }
+                res.faces.push_back(f);
+            }
+            else if (std::ranges::find(res.ignored, first) == res.ignored.end()) {
+                res.ignored.push_back(first);
             }
-
-            Position p;
-            p.x = std::stof(std::string(v1));
-            p.y = std::stof(std::string(v2));
-            positions.push_back(p);
         }
-        else if (first == "vt") {
-            size_t sep = rest.find(' ');
-            const std::string_view v1 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
+        return res;
+    }
+} // namespace
 
-            sep = rest.find(' ');
-            const std::string_view v2 = rest.substr(0, sep);
+namespace sgct::correction {
 
-            Texture t;
-            t.s = std::stof(std::string(v1));
-            t.t = std::stof(std::string(v2));
-            texCoords.push_back(t);
-        }
-        else if (first == "f") {
-            size_t sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                throw Error(
-                    Error::Component::OBJ, 2035,
-                    std::format(
-                        "Illegal face format in OBJ file '{}' in line {}", path, line
-                    )
-                );
-            }
-            const std::string_view f1 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
+Buffer generateOBJMesh(const std::filesystem::path& path) {
+    ZoneScoped;
 
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                throw Error(
-                    Error::Component::OBJ, 2035,
-                    std::format(
-                        "Illegal face format in OBJ file '{}' in line {}", path, line
-                    )
-                );
-            }
-            const std::string_view f2 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
+    Log::Info("Reading Wavefront OBJ mesh data from '{}'", path);
 
-            sep = rest.find(' ');
-            const std::string_view f3 =
-                sep == std::string_view::npos ?
-                rest :
-                rest.substr(0, sep);
+    const MappedFile file = MappedFile(path);
+    if (!file.data()) {
+        throw Error(
+            Error::Component::OBJ, 2030, std::format("Failed to open '{}'", path)
+        );
+    }
+    const std::string_view text = std::string_view(
+        reinterpret_cast<const char*>(file.data()),
+        file.size()
+    );
 
-            // The face description might just consist of a single value, in which case
-            // the f.find method will return npos, which tells substr to "extract" the
-            // entire string -> et voila; it still works
-            Face f;
-            f.f1 = std::stoi(std::string(f1.substr(0, f1.find('/'))));
-            f.f2 = std::stoi(std::string(f2.substr(0, f2.find('/'))));
-            f.f3 = std::stoi(std::string(f3.substr(0, f3.find('/'))));
-            faces.emplace_back(f);
-        }
-        else if (first == "vn") {
-            if (std::find(reported.begin(), reported.end(), "vn") == reported.end()) {
-                Log::Warning(std::format("Ignoring normals in mesh '{}'", path));
-                reported.emplace_back("vn");
-            }
-        }
-        else if (first == "vp") {
-            if (std::find(reported.begin(), reported.end(), "vp") == reported.end()) {
-                Log::Warning(
-                    std::format("Ignoring parameter space values in mesh '{}'", path)
-                );
-                reported.emplace_back("vp");
-            }
-        }
-        else if (first == "l") {
-            if (std::find(reported.begin(), reported.end(), "l") == reported.end()) {
-                Log::Warning(std::format("Ignoring line elements in mesh '{}'", path));
-                reported.emplace_back("l");
-            }
-        }
-        else if (first == "mtllib") {
-            if (std::find(reported.begin(), reported.end(), "mtllib") == reported.end()) {
-                Log::Warning(std::format("Ignoring material library in mesh '{}'", path));
-                reported.emplace_back("mtllib");
-            }
-        }
-        else if (first == "usemtl") {
-            if (std::find(reported.begin(), reported.end(), "usemtl") == reported.end()) {
-                Log::Warning(
-                    std::format("Ignoring material specification in mesh '{}'", path)
-                );
-                reported.emplace_back("usemtl");
-            }
-        }
-        else if (first == "o") {
-            if (std::find(reported.begin(), reported.end(), "o") == reported.end()) {
-                Log::Warning(
-                    std::format("Ignoring object specification in mesh '{}'", path)
-                );
-                reported.emplace_back("o");
-            }
+    const std::vector<Chunk> chunks = parseInParallel(
+        text,
+        [&path](std::string_view chunk) { return parseChunk(chunk, path); }
+    );
+
+    std::vector<Position> positions;
+    std::vector<Texture> texCoords;
+    std::vector<Face> faces;
+    std::vector<std::string_view> ignored;
+    bool hasZ = false;
+    {
+        size_t nPositions = 0;
+        size_t nTexCoords = 0;
+        size_t nFaces = 0;
+        for (const Chunk& chunk : chunks) {
+            nPositions += chunk.positions.size();
+            nTexCoords += chunk.texCoords.size();
+            nFaces += chunk.faces.size();
         }
-        else if (first == "g") {
-            if (std::find(reported.begin(), reported.end(), "g") == reported.end()) {
-                Log::Warning(
-                    std::format("Ignoring object group specification in mesh '{}'", path)
-                );
-                reported.emplace_back("g");
+        positions.reserve(nPositions);
+        texCoords.reserve(nTexCoords);
+        faces.reserve(nFaces);
+    }
+    for (const Chunk& chunk : chunks) {
+        std::ranges::copy(chunk.positions, std::back_inserter(positions));
+        std::ranges::copy(chunk.texCoords, std::back_inserter(texCoords));
+        std::ranges::copy(chunk.faces, std::back_inserter(faces));
+        for (std::string_view key : chunk.ignored) {
+            if (std::ranges::find(ignored, key) == ignored.end()) {
+                ignored.push_back(key);
             }
         }
-        else if (first == "s") {
-            if (std::find(reported.begin(), reported.end(), "s") == reported.end()) {
-                Log::Warning(
-                    std::format("Ignoring shading specification in mesh '{}'", path)
-                );
-                reported.emplace_back("s");
-            }
+        hasZ |= chunk.hasZ;
+    }
+
+    if (hasZ) {
+        Log::Warning(
+            "Vertices in '{}' were using z coordinate which is not supported", path
+        );
+    }
+    for (std::string_view key : ignored) {
+        auto it = std::ranges::find(Ignored, key, &IgnoredElement::keyword);
+        if (it != Ignored.end()) {
+            Log::Warning("Ignoring {} in mesh '{}'", it->description, path);
         }
         else {
-            if (std::find(reported.begin(), reported.end(), first) == reported.end()) {
-                Log::Warning(std::format(
-                    "Encounted unsupported value type '{}' in mesh '{}'", first, path
-                ));
-                reported.emplace_back(first);
-            }
+            Log::Warning(
+                "Encounted unsupported value type '{}' in mesh '{}'", key, path
+            );
         }
     }
 
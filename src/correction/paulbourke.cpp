@@ -8,16 +8,15 @@
 
 #include <sgct/correction/paulbourke.h>
 
-#include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
+#include <sgct/mappedfile.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
-#include <sgct/window.h>
-#include <glm/glm.hpp>
-#include <scn/scan.h>
-#include <fstream>
+#include <sgct/correction/textparser.h>
+#include <algorithm>
+#include <iterator>
 
 namespace sgct::correction {
 
@@ -28,72 +27,103 @@ Buffer generatePaulBourkeMesh(const std::filesystem::path& path, const vec2& pos
 
     Buffer buf;
 
-    Log::Info(std::format("Reading Paul Bourke spherical mirror mesh from '{}'", path));
+    Log::Info("Reading Paul Bourke spherical mirror mesh from '{}'", path);
 
-    std::ifstream meshFile = std::ifstream(path);
-    if (!meshFile.good()) {
+    const MappedFile file = MappedFile(path);
+    if (!file.data()) {
         throw Error(
             Error::Component::PaulBourke, 2040,
             std::format("Failed to open '{}'", path)
         );
     }
-
-    std::string line;
+    std::string_view text = std::string_view(
+        reinterpret_cast<const char*>(file.data()),
+        file.size()
+    );
 
     // get the first line containing the mapping type _id
-    if (std::getline(meshFile, line)) {
-        auto r = scn::scan_value<int>(line);
-        if (!r) {
-            throw Error(
-                Error::Component::PaulBourke, 2041,
-                std::format("Error reading mapping type in file '{}'", path)
-            );
-        }
+    std::string_view line = nextLine(text);
+    if (int mappingType = 0; !parseNumber(line, mappingType)) {
+        throw Error(
+            Error::Component::PaulBourke, 2041,
+            std::format("Error reading mapping type in file '{}'", path)
+        );
     }
 
     // get the mesh dimensions
-    std::optional<glm::ivec2> meshSize;
-    if (std::getline(meshFile, line)) {
-        auto r = scn::scan<int, int>(line, "{} {}");
-        if (!r) {
-            throw Error(
-                Error::Component::PaulBourke, 2042,
-                std::format("Invalid data in file '{}'", path)
-            );
-        }
-        const auto& [valX, valY] = r->values();
-        buf.vertices.reserve(static_cast<size_t>(valX) * static_cast<size_t>(valY));
-        meshSize = glm::ivec2(valX, valY);
+    line = nextLine(text);
+    int meshWidth = 0;
+    int meshHeight = 0;
+    const bool validSize = parseNumber(line, meshWidth) &&
+        parseNumber(line, meshHeight) && meshWidth > 0 && meshHeight > 0;
+    if (!validSize) {
+        throw Error(
+            Error::Component::PaulBourke, 2042,
+            std::format("Invalid data in file '{}'", path)
+        );
     }
 
     // get all data
-    while (std::getline(meshFile, line)) {
-        auto r = scn::scan<float, float, float, float, float>(line, "{} {} {} {} {}");
-        if (r) {
-            const auto& [x, y, s, t, intensity] = r->values();
-
-            Buffer::Vertex vertex;
-            vertex.x = x;
-            vertex.y = y;
-            vertex.s = s;
-            vertex.t = t;
-
-            vertex.r = intensity;
-            vertex.g = intensity;
-            vertex.b = intensity;
-            vertex.a = 1.f;
-
-            buf.vertices.push_back(vertex);
+    const float aspect = aspectRatio * (size.x / size.y);
+    std::vector<std::vector<Buffer::Vertex>> chunks = parseInParallel(
+        text,
+        [&pos, &size, aspect](std::string_view chunk) {
+            std::vector<Buffer::Vertex> vertices;
+            // Each line has about 50 characters
+            vertices.reserve(chunk.size() / 50);
+            while (!chunk.empty()) {
+                std::string_view l = nextLine(chunk);
+                float x = 0.f;
+                float y = 0.f;
+                float s = 0.f;
+                float t = 0.f;
+                float intensity = 0.f;
+                const bool isVertex =
+                    parseNumber(l, x) && parseNumber(l, y) && parseNumber(l, s) &&
+                    parseNumber(l, t) && parseNumber(l, intensity);
+                if (!isVertex) {
+                    continue;
+                }
+
+                Buffer::Vertex vertex;
+
+                // convert to [0, 1] (normalize)
+                x /= aspect;
+                x = (x + 1.f) / 2.f;
+                y = (y + 1.f) / 2.f;
+
+                // scale, re-position and convert to [-1, 1]
+                vertex.x = (x * size.x + pos.x) * 2.f - 1.f;
+                vertex.y = (y * size.y + pos.y) * 2.f - 1.f;
+
+                // convert to viewport coordinates
+                vertex.s = s * size.x + pos.x;
+                vertex.t = t * size.y + pos.y;
+
+                vertex.r = intensity;
+                vertex.g = intensity;
+                vertex.b = intensity;
+                vertex.a = 1.f;
+
+                vertices.push_back(vertex);
+            }
+            return vertices;
         }
+    );
+
+    buf.vertices.reserve(static_cast<size_t>(meshWidth) * meshHeight);
+    for (const std::vector<Buffer::Vertex>& chunk : chunks) {
+        std::ranges::copy(chunk, std::back_inserter(buf.vertices));
     }
 
     // generate indices
-    for (int c = 0; c < (meshSize->x - 1); c++) {
-        for (int r = 0; r < (meshSize->y - 1); r++) {
-            const int i0 = r * meshSize->x + c;
-            const int i1 = r * meshSize->x + (c + 1);
-            const int i2 = (r + 1) * meshSize->x + (c + 1);
-            const int i3 = (r + 1) * meshSize->x + c;
+    buf.indices.reserve(static_cast<size_t>(meshWidth - 1) * (meshHeight - 1) * 6);
+    for (int c = 0; c < (meshWidth - 1); c++) {
+        for (int r = 0; r < (meshHeight - 1); r++) {
+            const int i0 = r * meshWidth + c;
+            const int i1 = r * meshWidth + (c + 1);
+            const int i2 = (r + 1) * meshWidth + (c + 1);
+            const int i3 = (r + 1) * meshWidth + c;
 
             // triangle 1
             buf.indices.push_back(i0);
@@ -107,23 +137,11 @@ Buffer generatePaulBourkeMesh(const std::filesystem::path& path, const vec2& pos
         }
     }
 
-    const float aspect = aspectRatio * (size.x / size.y);
-    for (Buffer::Vertex& vertex : buf.vertices) {
-        // convert to [0, 1] (normalize)
-        vertex.x /= aspect;
-        vertex.x = (vertex.x + 1.f) / 2.f;
-        vertex.y = (vertex.y + 1.f) / 2.f;
-
-        // scale, re-position and convert to [-1, 1]
-        vertex.x = (vertex.x * size.x + pos.x) * 2.f - 1.f;
-        vertex.y = (vertex.y * size.y + pos.y) * 2.f - 1.f;
-
-        // convert to viewport coordinates
-        vertex.s = vertex.s * size.x + pos.x;
-        vertex.t = vertex.t * size.y + pos.y;
-    }
-
     buf.geometryType = GL_TRIANGLES;
+    buf.grid = Buffer::Grid{
+        static_cast<unsigned int>(meshWidth),
+        static_cast<unsigned int>(meshHeight)
+    };
     return buf;
 }
 
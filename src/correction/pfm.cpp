@@ -26,7 +26,7 @@ Buffer generatePerEyeMeshFromPFMImage(const std::filesystem::path& path, const v
 
     Buffer buf;
 
-    Log::Info(std::format("Reading 3D/stereo mesh data (in PFM image) from '{}'", path));
+    Log::Info("Reading 3D/stereo mesh data (in PFM image) from '{}'", path);
 
     std::ifstream meshFile = std::ifstream(path, std::ifstream::binary);
     if (!meshFile.good()) {
@@ -166,6 +166,8 @@ Buffer generatePerEyeMeshFromPFMImage(const std::filesystem::path& path, const v
     }
 
     buf.geometryType = GL_TRIANGLE_STRIP;
+    // Only the grid of the first eye is used by the indices
+    buf.grid = Buffer::Grid{ nCols, nRows };
     return buf;
 }
 
@@ -8,18 +8,18 @@
 
 #include <sgct/correction/scalable.h>
 
-#include <sgct/baseviewport.h>
-#include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
+#include <sgct/mappedfile.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
-#include <sgct/user.h>
+#include <sgct/correction/textparser.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include <fstream>
+#include <algorithm>
+#include <iterator>
 
 namespace {
     struct Data {
@@ -92,340 +92,325 @@ namespace {
         bool applyBlackLevel = false;
         bool applyColor = false;
     };
+
+    struct Chunk {
+        std::vector<Data::Vertex> vertices;
+        std::vector<Data::Face> faces;
+        // All lines that are neither a vertex nor a face are processed after the chunks
+        // are merged, as they might modify state that is shared between chunks
+        std::vector<std::string_view> keywords;
+    };
+
+    Chunk parseChunk(std::string_view text, const std::filesystem::path& path) {
+        using namespace sgct::correction;
+
+        Chunk chunk;
+        while (!text.empty()) {
+            const std::string_view line = nextLine(text);
+            std::string_view rest = line;
+            skipSpaces(rest);
+            if (rest.empty()) {
+                continue;
+            }
+
+            if (parseCharacter(rest, '[')) {
+                Data::Face f;
+                if (!parseNumber(rest, f.f1) || !parseNumber(rest, f.f2) ||
+                    !parseNumber(rest, f.f3))
+                {
+                    throw sgct::Error(
+                        sgct::Error::Component::Scalable, 2035,
+                        std::format(
+                            "Illegal formatting of face in file '{}' in line {}",
+                            path, line
+                        )
+                    );
+                }
+                chunk.faces.push_back(f);
+            }
+            else if (startsWithNumber(rest)) {
+                Data::Vertex v;
+                // The intensity is parsed as a floating point value as some files store
+                // it with a fractional part
+                float intensity = 0.f;
+                if (!parseNumber(rest, v.x) || !parseNumber(rest, v.y) ||
+                    !parseNumber(rest, intensity) || !parseNumber(rest, v.s) ||
+                    !parseNumber(rest, v.t))
+                {
+                    throw sgct::Error(
+                        sgct::Error::Component::Scalable, 2036,
+                        std::format(
+                            "Illegal formatting of vertex in file '{}' in line {}",
+                            path, line
+                        )
+                    );
+                }
+                v.intensity = static_cast<int>(intensity);
+                chunk.vertices.push_back(v);
+            }
+            else {
+                chunk.keywords.push_back(rest);
+            }
+        }
+        return chunk;
+    }
+
+    float toFloat(std::string_view text, const std::filesystem::path& path) {
+        float value = 0.f;
+        if (!sgct::correction::parseNumber(text, value)) {
+            throw sgct::Error(
+                sgct::Error::Component::Scalable, 2062,
+                std::format("Invalid value '{}' in mesh '{}'", text, path)
+            );
+        }
+        return value;
+    }
+
+    int toInt(std::string_view text, const std::filesystem::path& path) {
+        int value = 0;
+        if (!sgct::correction::parseNumber(text, value)) {
+            throw sgct::Error(
+                sgct::Error::Component::Scalable, 2062,
+                std::format("Invalid value '{}' in mesh '{}'", text, path)
+            );
+        }
+        return value;
+    }
 } // namespace
 
 namespace sgct::correction {
 
-Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& parent) {
+Buffer generateScalableMesh(const std::filesystem::path& path, const vec2& pos,
+                            const vec2& size)
+{
     ZoneScoped;
 
-    Log::Info(std::format("Reading scalable mesh data from '{}'", path));
+    Log::Info("Reading scalable mesh data from '{}'", path);
 
-    std::ifstream file = std::ifstream(path);
-    if (!file.good()) {
+    const MappedFile file = MappedFile(path);
+    if (!file.data()) {
         throw Error(
             Error::Component::Scalable, 2060, std::format("Failed to open '{}'", path)
         );
     }
+    const std::string_view text = std::string_view(
+        reinterpret_cast<const char*>(file.data()),
+        file.size()
+    );
+
+    const std::vector<Chunk> chunks = parseInParallel(
+        text,
+        [&path](std::string_view chunk) { return parseChunk(chunk, path); }
+    );
 
     Data data;
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.empty()) {
-            continue;
-        }
-        else if (line.back() == '\r') {
-            line.pop_back();
-        }
+    std::vector<std::string_view> keywords;
+    {
+        size_t nVertices = 0;
+        size_t nFaces = 0;
+        for (const Chunk& chunk : chunks) {
+            nVertices += chunk.vertices.size();
+            nFaces += chunk.faces.size();
+        }
+        data.vertices.reserve(nVertices);
+        data.faces.reserve(nFaces);
+    }
+    for (const Chunk& chunk : chunks) {
+        std::ranges::copy(chunk.vertices, std::back_inserter(data.vertices));
+        std::ranges::copy(chunk.faces, std::back_inserter(data.faces));
+        std::ranges::copy(chunk.keywords, std::back_inserter(keywords));
+    }
 
-        const std::string_view v = line;
-        const size_t separator = v.find(' ');
-        std::string_view first = v.substr(0, separator);
-        std::string_view rest = v.substr(separator + 1);
+    for (std::string_view rest : keywords) {
+        const std::string_view first = parseWord(rest);
+        skipSpaces(rest);
 
         if (first == "OPENMESH") {
             if (rest != "Version 1.1") {
-                Log::Warning(std::format(
+                Log::Warning(
                     "Found {} in mesh '{}' but expected Version 1.1 so the loading might "
                     "misbehave", rest, path
-                ));
+                );
             }
         }
         else if (first == "VERTICES") {
-            data.nVertices = std::stoi(std::string(rest));
-            data.vertices.reserve(data.nVertices);
+            data.nVertices = toInt(rest, path);
         }
         else if (first == "FACES") {
-            data.nFaces = std::stoi(std::string(rest));
-            data.faces.reserve(data.nFaces);
+            data.nFaces = toInt(rest, path);
         }
         else if (first == "MAPPING") {
             if (rest != "NORMALIZED") {
-                Log::Warning(std::format(
+                Log::Warning(
                     "Found mapping '{}' in mesh '{}' but only 'NORMALIZED' is supported",
                     rest, path
-                ));
+                );
             }
         }
         else if (first == "SAMPLING") {
             if (rest != "LINEAR") {
-                Log::Warning(std::format(
+                Log::Warning(
                     "Found sampling '{}' in mesh '{}' but only 'LINEAR' is supported",
                     rest, path
-                ));
+                );
             }
         }
         else if (first == "PROJECTION") {
             if (rest != "PERSPECTIVE") {
-                Log::Warning(std::format(
+                Log::Warning(
                     "Found projection '{}' in mesh '{}' but only 'PERSPECTIVE' is "
                     "supported", rest, path
-                ));
+                );
             }
         }
         else if (first == "ORTHO_LEFT") {
-            data.ortho.left = std::stof(std::string(rest));
+            data.ortho.left = toFloat(rest, path);
         }
         else if (first == "ORTHO_RIGHT") {
-            data.ortho.right = std::stof(std::string(rest));
+            data.ortho.right = toFloat(rest, path);
         }
         else if (first == "ORTHO_TOP") {
-            data.ortho.top = std::stof(std::string(rest));
+            data.ortho.top = toFloat(rest, path);
         }
         else if (first == "ORTHO_BOTTOM") {
-            data.ortho.bottom = std::stof(std::string(rest));
+            data.ortho.bottom = toFloat(rest, path);
         }
         else if (first == "PERSPECTIVE_XOFFSET") {
-            data.perspective.offset.x = std::stof(std::string(rest));
+            data.perspective.offset.x = toFloat(rest, path);
             data.perspective.hasOffset = true;
         }
         else if (first == "PERSPECTIVE_YOFFSET") {
-            data.perspective.offset.y = std::stof(std::string(rest));
+            data.perspective.offset.y = toFloat(rest, path);
             data.perspective.hasOffset = true;
         }
         else if (first == "PERSPECTIVE_ZOFFSET") {
-            data.perspective.offset.z = std::stof(std::string(rest));
+            data.perspective.offset.z = toFloat(rest, path);
             data.perspective.hasOffset = true;
         }
         else if (first == "PERSPECTIVE_ROLL") {
-            data.perspective.direction.roll = std::stof(std::string(rest));
+            data.perspective.direction.roll = toFloat(rest, path);
         }
         else if (first == "PERSPECTIVE_PITCH") {
-            data.perspective.direction.pitch = std::stof(std::string(rest));
+            data.perspective.direction.pitch = toFloat(rest, path);
         }
         else if (first == "PERSPECTIVE_YAW") {
-            data.perspective.direction.yaw = std::stof(std::string(rest));
+            data.perspective.direction.yaw = toFloat(rest, path);
         }
         else if (first == "PERSPECTIVE_LEFT") {
-            data.perspective.fov.left = std::stof(std::string(rest));
+            data.perspective.fov.left = toFloat(rest, path);
             data.perspective.hasFov = true;
         }
         else if (first == "PERSPECTIVE_RIGHT") {
-            data.perspective.fov.right = std::stof(std::string(rest));
+            data.perspective.fov.right = toFloat(rest, path);
             data.perspective.hasFov = true;
         }
         else if (first == "PERSPECTIVE_TOP") {
-            data.perspective.fov.top = std::stof(std::string(rest));
+            data.perspective.fov.top = toFloat(rest, path);
             data.perspective.hasFov = true;
         }
         else if (first == "PERSPECTIVE_BOTTOM") {
-            data.perspective.fov.bottom = std::stof(std::string(rest));
+            data.perspective.fov.bottom = toFloat(rest, path);
             data.perspective.hasFov = true;
         }
         else if (first == "NATIVEXRES") {
-            data.resolution.x = std::stoi(std::string(rest));
+            data.resolution.x = toInt(rest, path);
         }
         else if (first == "NATIVEYRES") {
-            data.resolution.y = std::stoi(std::string(rest));
+            data.resolution.y = toInt(rest, path);
         }
         else if (first == "SUBVERSION") {
-            const int version = std::stoi(std::string(rest));
+            const int version = toInt(rest, path);
             if (version != 5) {
-                Log::Warning(std::format(
+                Log::Warning(
                     "Found subversion {} in mesh '{}' but only version 5 is tested",
                     version, path
-                ));
+                );
             }
         }
         else if (first == "GAMMA") {
-            const float gamma = std::stof(std::string(rest));
+            const float gamma = toFloat(rest, path);
             if (gamma != data.gamma) {
                 data.gamma = gamma;
-                Log::Warning(std::format(
+                Log::Warning(
                     "Found GAMMA value of {} in mesh '{}' we do not support per-viewport "
                     "gamma values", data.gamma, path
-                ));
+                );
             }
         }
         else if (first == "DO_NO_WARP") {
-            data.doNotWarp = std::stoi(std::string(rest)) != 0;
+            data.doNotWarp = toInt(rest, path) != 0;
         }
         else if (first == "USE_SPHERE_SAMPLE_COORDINATE_SYSTEM") {
-            const bool useSphereSampling = std::stoi(std::string(rest)) != 0;
+            const bool useSphereSampling = toInt(rest, path) != 0;
             if (useSphereSampling) {
-                Log::Warning(std::format(
+                Log::Warning(
                     "Found request to use Sphere Sample Coordinate System in mesh {} "
                     "but we do not support this", path
-                ));
+                );
             }
         }
         else if (first == "FRUSTUM_EULER_ANGLES") {
-            data.frustumEulerAngles.useAngles = std::stoi(std::string(rest)) != 0;
+            data.frustumEulerAngles.useAngles = toInt(rest, path) != 0;
             if (data.frustumEulerAngles.useAngles) {
-                Log::Warning(std::format(
+                Log::Warning(
                     "Enabled frustum euler angles in mesh '{}' but we do not know how "
                     "these work, yet", path
-                ));
+                );
             }
         }
         else if (first == "FRUSTUM_EULER_YAW") {
-            data.frustumEulerAngles.yaw = std::stof(std::string(rest));
+            data.frustumEulerAngles.yaw = toFloat(rest, path);
         }
         else if (first == "FRUSTUM_EULER_PITCH") {
-            data.frustumEulerAngles.pitch = std::stof(std::string(rest));
+            data.frustumEulerAngles.pitch = toFloat(rest, path);
         }
         else if (first == "FRUSTUM_EULER_ROLL") {
-            data.frustumEulerAngles.roll = std::stof(std::string(rest));
+            data.frustumEulerAngles.roll = toFloat(rest, path);
         }
         else if (first == "LABEL") {
             data.label = std::string(rest);
         }
         else if (first == "APPLY_MASK") {
-            data.applyMask = std::stoi(std::string(rest)) != 0;
+            data.applyMask = toInt(rest, path) != 0;
             if (data.applyMask) {
-                Log::Warning(std::format(
+                Log::Warning(
                     "Mesh '{}' requested to apply a mask. Currently this is handled "
                     "outside the mesh by specifying a 'mask' attribute on the 'Viewport' "
                     "instead", path
-                ));
+                );
             }
         }
         else if (first == "APPLY_BLACK_LEVEL") {
-            data.applyBlackLevel = std::stoi(std::string(rest)) != 0;
+            data.applyBlackLevel = toInt(rest, path) != 0;
             if (data.applyBlackLevel) {
-                Log::Warning(std::format(
+                Log::Warning(
                     "Mesh '{}' requested to apply a blacklevel image. Currently this is "
                     "handled outside the mesh by specifying a 'BlackLevelMask' attribute "
                     "on the 'Viewport' instead", path
-                ));
+                );
             }
         }
         else if (first == "APPLY_COLOR") {
-            data.applyColor = std::stoi(std::string(rest)) != 0;
+            data.applyColor = toInt(rest, path) != 0;
             if (data.applyBlackLevel) {
-                Log::Warning(std::format(
+                Log::Warning(
                     "Mesh '{}' requested to apply an overlay image. Currently this is "
                     "handled outside the mesh by specifying an 'overlay' attribute on "
                     "the 'Viewport' instead", path
-                ));
-            }
-        }
-        else if (first == "[") {
-            // Face
-            size_t sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                throw Error(
-                    Error::Component::Scalable, 2035,
-                    std::format(
-                        "Illegal formatting of face in file '{}' in line {}",
-                        path, line
-                    )
-                );
-            }
-            const std::string_view f1 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                throw Error(
-                    Error::Component::Scalable, 2035,
-                    std::format(
-                        "Illegal formatting of face in file '{}' in line {}",
-                        path, line
-                    )
-                );
-            }
-            const std::string_view f2 = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                throw Error(
-                    Error::Component::Scalable, 2035,
-                    std::format(
-                        "Illegal formatting of face in file '{}' in line {}",
-                        path, line
-                    )
                 );
             }
-            const std::string_view f3 = rest.substr(0, sep);
-
-            Data::Face f;
-            f.f1 = static_cast<unsigned int>(std::stoi(std::string(f1)));
-            f.f2 = static_cast<unsigned int>(std::stoi(std::string(f2)));
-            f.f3 = static_cast<unsigned int>(std::stoi(std::string(f3)));
-            data.faces.push_back(f);
         }
         else {
-            // Nothing matched previously, so it has to be a vertex or an unknown key now
-            try {
-                // We try to convert the first value into a float.  If it succeeds, we
-                // have reached the vertices.  Otherwise we have found an unknown key
-                [[maybe_unused]] const float dummy = std::stof(std::string(first));
-            }
-            catch (const std::invalid_argument&) {
-                Log::Warning(std::format(
-                    "Unknown key {} found in scalable mesh '{}'. Please report usage of "
-                    "this key, preferably with an example, to the SGCT developers",
-                    first, path
-                ));
-                continue;
-            }
-
-
-            const std::string_view x = first;
-
-            size_t sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                throw Error(
-                    Error::Component::Scalable, 2036,
-                    std::format(
-                        "Illegal formatting of vertex in file '{}' in line {}",
-                        path, line
-                    )
-                );
-            }
-            const std::string_view y = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                throw Error(
-                    Error::Component::Scalable, 2036,
-                    std::format(
-                        "Illegal formatting of vertex in file '{}' in line {}",
-                        path, line
-                    )
-                );
-            }
-            const std::string_view intensity = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                throw Error(
-                    Error::Component::Scalable, 2036,
-                    std::format(
-                        "Illegal formatting of vertex in file '{}' in line {}",
-                        path, line
-                    )
-                );
-            }
-            const std::string_view s = rest.substr(0, sep);
-            rest = rest.substr(sep + 1);
-            sep = rest.find(' ');
-            if (sep == std::string_view::npos) {
-                throw Error(
-                    Error::Component::Scalable, 2036,
-                    std::format(
-                        "Illegal formatting of vertex in file '{}' in line {}",
-                        path, line
-                    )
-                );
-            }
-            const std::string_view t = rest.substr(0, sep);
-
-            Data::Vertex vertex;
-            vertex.x = std::stof(std::string(x));
-            vertex.y = std::stof(std::string(y));
-            vertex.intensity = std::stoi(std::string(intensity));
-            vertex.s = std::stof(std::string(s));
-            vertex.t = std::stof(std::string(t));
-            data.vertices.push_back(vertex);
+            Log::Warning(
+                "Unknown key {} found in scalable mesh '{}'. Please report usage of "
+                "this key, preferably with an example, to the SGCT developers",
+                first, path
+            );
         }
     }
 
 
+    Buffer buf;
     if (data.perspective.hasFov) {
         // pitch, yaw, roll.  degrees -> radians
         // if we don't have a direction, all these values will be 0 anyway
@@ -435,23 +420,20 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
             glm::radians(data.perspective.direction.roll)
         ));
 
-        parent.setViewPlaneCoordsUsingFOVs(
-            data.perspective.fov.top,
-            data.perspective.fov.bottom,
-            data.perspective.fov.left,
-            data.perspective.fov.right,
-            quat(q.x, q.y, q.z, q.w)
-        );
-        Engine::instance().updateFrustums();
+        buf.view.frustum = Buffer::View::Frustum{
+            .up = data.perspective.fov.top,
+            .down = data.perspective.fov.bottom,
+            .left = data.perspective.fov.left,
+            .right = data.perspective.fov.right,
+            .orientation = quat(q.x, q.y, q.z, q.w)
+        };
     }
     if (data.perspective.hasOffset) {
-        parent.projectionPlane().offset(
-            vec3{
-                data.perspective.offset.x,
-                data.perspective.offset.y,
-                data.perspective.offset.z
-            }
-        );
+        buf.view.planeOffset = vec3{
+            data.perspective.offset.x,
+            data.perspective.offset.y,
+            data.perspective.offset.z
+        };
     }
     if (data.nVertices != static_cast<int>(data.vertices.size()) ||
         data.nFaces != static_cast<int>(data.faces.size()))
@@ -462,15 +444,14 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
         );
     }
 
-    Buffer buf;
     buf.geometryType = GL_TRIANGLES;
     buf.vertices.reserve(data.vertices.size());
     for (const Data::Vertex& vertex : data.vertices) {
         Buffer::Vertex v;
         const float x =
-            (vertex.x / data.resolution.x) * parent.size().x + parent.position().x;
+            (vertex.x / data.resolution.x) * size.x + pos.x;
         const float y =
-            (vertex.y / data.resolution.y) * parent.size().y + parent.position().y;
+            (vertex.y / data.resolution.y) * size.y + pos.y;
 
         // Normalize vertices between 0 and 1
         const float x2 = (x - data.ortho.left) / (data.ortho.right - data.ortho.left);
@@ -484,10 +465,10 @@ Buffer generateScalableMesh(const std::filesystem::path& path, BaseViewport& par
         v.g = vertex.intensity / 255.f;
         v.b = vertex.intensity / 255.f;
         v.a = 1.f;
-        //v.s = (1.f - vertex.s) * parent.size().x + parent.position().x;
-        v.s = (1.f - vertex.t) * parent.size().x + parent.position().x;
-        //v.t = (1.f - vertex.t) * parent.size().x + parent.position().x;
-        v.t = (1.f - vertex.s) * parent.size().x + parent.position().x;
+        //v.s = (1.f - vertex.s) * size.x + pos.x;
+        v.s = (1.f - vertex.t) * size.x + pos.x;
+        //v.t = (1.f - vertex.t) * size.x + pos.x;
+        v.t = (1.f - vertex.s) * size.x + pos.x;
 
         buf.vertices.push_back(v);
     }
@@ -8,14 +8,12 @@
 
 #include <sgct/correction/sciss.h>
 
-#include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
 #include <sgct/viewport.h>
-#include <sgct/user.h>
 #include <glm/glm.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/euler_angles.hpp>
@@ -54,12 +52,12 @@ namespace {
 
 namespace sgct::correction {
 
-Buffer generateScissMesh(const std::filesystem::path& path, BaseViewport& parent) {
+Buffer generateScissMesh(const std::filesystem::path& path, const BaseViewport& parent) {
     ZoneScoped;
 
     Buffer buf;
 
-    Log::Info(std::format("Reading SCISS mesh data from '{}'", path));
+    Log::Info("Reading SCISS mesh data from '{}'", path);
 
     
     std::ifstream file = std::ifstream(path, std::ifstream::binary);
@@ -82,7 +80,7 @@ Buffer generateScissMesh(const std::filesystem::path& path, BaseViewport& parent
         throw Error(2072, std::format("Error parsing file version from file '{}'", path));
     }
 
-    Log::Debug(std::format("SCISS file version '{}'", fileVersion));
+    Log::Debug("SCISS file version '{}'", fileVersion);
 
     // read mapping type
     unsigned int type = 0;
@@ -91,8 +89,8 @@ Buffer generateScissMesh(const std::filesystem::path& path, BaseViewport& parent
         throw Error(2073, std::format("Error parsing type from file '{}'", path));
     }
 
-    Log::Debug(std::format(
-        "Mapping type: {} ({})", type == 0 ? "planar" : "cube", type)
+    Log::Debug(
+        "Mapping type: {} ({})", type == 0 ? "planar" : "cube", type
     );
 
     // read viewdata
@@ -114,17 +112,17 @@ Buffer generateScissMesh(const std::filesystem::path& path, BaseViewport& parent
     const double pitch = angles.y;
     const double roll = -angles.z;
 
-    Log::Debug(std::format(
+    Log::Debug(
         "Rotation quat = [{} {} {} {}]. yaw = {}, pitch = {}, roll = {}",
-        viewData.qx, viewData.qy, viewData.qz, viewData.qw, yaw, pitch, roll)
+        viewData.qx, viewData.qy, viewData.qz, viewData.qw, yaw, pitch, roll
     );
 
-    Log::Debug(std::format("Position: {} {} {}", viewData.x, viewData.y, viewData.z));
+    Log::Debug("Position: {} {} {}", viewData.x, viewData.y, viewData.z);
 
-    Log::Debug(std::format(
+    Log::Debug(
         "FOV: (up {}) (down {}) (left {}) (right {})",
         viewData.fovUp, viewData.fovDown, viewData.fovLeft, viewData.fovRight
-    ));
+    );
 
     // read number of vertices
     unsigned int size[2];
@@ -136,13 +134,13 @@ Buffer generateScissMesh(const std::filesystem::path& path, BaseViewport& parent
     unsigned int nVertices = 0;
     if (fileVersion == 2) {
         nVertices = size[1];
-        Log::Debug(std::format("Number of vertices: {}", nVertices));
+        Log::Debug("Number of vertices: {}", nVertices);
     }
     else {
         nVertices = size[0] * size[1];
-        Log::Debug(std::format(
+        Log::Debug(
             "Number of vertices: {} ({}x{})", nVertices, size[0], size[1]
-        ));
+        );
     }
     // read vertices
     std::vector<SCISSTexturedVertex> texturedVertexList(nVertices);
@@ -160,7 +158,7 @@ Buffer generateScissMesh(const std::filesystem::path& path, BaseViewport& parent
     if (!file.good()) {
         throw Error(2077, std::format("Error parsing indices from file '{}'", path));
     }
-    Log::Debug(std::format("Number of indices: {}", nIndices));
+    Log::Debug("Number of indices: {}", nIndices);
 
     // read faces
     if (nIndices > 0) {
@@ -174,16 +172,14 @@ Buffer generateScissMesh(const std::filesystem::path& path, BaseViewport& parent
         }
     }
 
-    parent.user().setPos(vec3{ viewData.x, viewData.y, viewData.z });
-    parent.setViewPlaneCoordsUsingFOVs(
-        viewData.fovUp,
-        viewData.fovDown,
-        viewData.fovLeft,
-        viewData.fovRight,
-        quat{ viewData.qx, viewData.qy, viewData.qz, viewData.qw }
-    );
-
-    Engine::instance().updateFrustums();
+    buf.view.userPosition = vec3{ viewData.x, viewData.y, viewData.z };
+    buf.view.frustum = Buffer::View::Frustum{
+        .up = viewData.fovUp,
+        .down = viewData.fovDown,
+        .left = viewData.fovLeft,
+        .right = viewData.fovRight,
+        .orientation = quat{ viewData.qx, viewData.qy, viewData.qz, viewData.qw }
+    };
 
     buf.vertices.resize(nVertices);
     for (unsigned int i = 0; i < nVertices; i++) {
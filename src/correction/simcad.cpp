@@ -15,20 +15,32 @@
 #include <sgct/profiling.h>
 #include <sgct/tinyxml.h>
 #include <sgct/viewport.h>
+#include <sgct/correction/textparser.h>
 #include <glm/glm.hpp>
-#include <sstream>
 
 #define Error(code, msg) Error(Error::Component::SimCAD, code, msg)
 
 namespace {
-    std::vector<std::string> split(std::string str, char delimiter) {
-        std::vector<std::string> res;
-        std::stringstream ss(std::move(str));
-        std::string part;
-        while (std::getline(ss, part, delimiter)) {
-            res.push_back(part);
+    // Parses the whitespace-separated values of a FlatParameters element in place and
+    // returns false if any of them is not a number
+    bool parseCorrections(const char* text, float range, std::vector<float>& res) {
+        std::string_view values = text ? text : "";
+        // Each value is about 8 characters with its separator
+        res.reserve(res.size() + values.size() / 8);
+        while (true) {
+            const size_t begin = values.find_first_not_of(" \t\r\n");
+            if (begin == std::string_view::npos) {
+                break;
+            }
+            values.remove_prefix(begin);
+
+            float value = 0.f;
+            if (!sgct::correction::parseNumber(values, value)) {
+                return false;
+            }
+            res.push_back(value / range);
         }
-        return res;
+        return true;
     }
 } // namespace
 
@@ -45,7 +57,7 @@ Buffer generateSimCADMesh(const std::filesystem::path& path, const vec2& pos,
 
     Buffer buf;
 
-    Log::Info(std::format("Reading simcad warp data from '{}'", path));
+    Log::Info("Reading simcad warp data from '{}'", path);
 
     tinyxml2::XMLDocument xmlDoc;
     const std::string p = path.string();
@@ -81,20 +93,22 @@ Buffer generateSimCADMesh(const std::filesystem::path& path, const vec2& pos,
         if (childVal == "X-FlatParameters") {
             float xrange = 1.f;
             if (child->QueryFloatAttribute("range", &xrange) == XML_SUCCESS) {
-                const std::string xcoordstr(child->GetText());
-                const std::vector<std::string> xcoords = split(xcoordstr, ' ');
-                for (const std::string& x : xcoords) {
-                    xcorrections.push_back(std::stof(x) / xrange);
+                if (!parseCorrections(child->GetText(), xrange, xcorrections)) {
+                    throw Error(
+                        2085,
+                        std::format("Invalid value in '{}' in file '{}'", childVal, path)
+                    );
                 }
             }
         }
         else if (childVal == "Y-FlatParameters") {
             float yrange = 1.f;
             if (child->QueryFloatAttribute("range", &yrange) == XML_SUCCESS) {
-                const std::string ycoordstr(child->GetText());
-                const std::vector<std::string> ycoords = split(ycoordstr, ' ');
-                for (const std::string& y : ycoords) {
-                    ycorrections.push_back(std::stof(y) / yrange);
+                if (!parseCorrections(child->GetText(), yrange, ycorrections)) {
+                    throw Error(
+                        2085,
+                        std::format("Invalid value in '{}' in file '{}'", childVal, path)
+                    );
                 }
             }
         }
@@ -123,6 +137,7 @@ Buffer generateSimCADMesh(const std::filesystem::path& path, const vec2& pos,
     vertex.b = 1.f;
     vertex.a = 1.f;
 
+    buf.vertices.reserve(nRows * nCols);
     size_t i = 0;
     for (size_t r = 0; r < nRows; r++) {
         for (size_t c = 0; c < nCols; c++) {
@@ -170,6 +185,10 @@ Buffer generateSimCADMesh(const std::filesystem::path& path, const vec2& pos,
     }
 
     buf.geometryType = GL_TRIANGLE_STRIP;
+    buf.grid = Buffer::Grid{
+        static_cast<unsigned int>(nCols),
+        static_cast<unsigned int>(nRows)
+    };
     return buf;
 }
 
@@ -8,36 +8,110 @@
 
 #include <sgct/correction/skyskan.h>
 
-#include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
+#include <sgct/mappedfile.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
-#include <sgct/viewport.h>
-#include <sgct/user.h>
+#include <sgct/correction/textparser.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
-#include <scn/scan.h>
-#include <fstream>
+#include <array>
 #include <optional>
+#include <utility>
 
 #define Error(code, msg) sgct::Error(sgct::Error::Component::SkySkan, code, msg)
 
+namespace {
+    struct Chunk {
+        struct Vertex {
+            float x = 0.f;
+            float y = 0.f;
+            float u = 0.f;
+            float v = 0.f;
+        };
+        std::vector<Vertex> vertices;
+
+        // The first line with two integers in the chunk and the number of vertices that
+        // came before it, which are ignored if the dimensions were not set before
+        std::optional<std::pair<unsigned int, unsigned int>> dimensions;
+        size_t nVerticesBeforeDimensions = 0;
+
+        std::vector<std::pair<std::string_view, float>> keys;
+    };
+
+    Chunk parseChunk(std::string_view text) {
+        using namespace sgct::correction;
+
+        Chunk chunk;
+        while (!text.empty()) {
+            const std::string_view line = nextLine(text);
+
+            const size_t separator = line.find('=');
+            if (separator != std::string_view::npos) {
+                std::string_view value = line.substr(separator + 1);
+                float v = 0.f;
+                if (parseNumber(value, v)) {
+                    chunk.keys.emplace_back(line.substr(0, separator), v);
+                }
+                continue;
+            }
+
+            std::string_view rest = line;
+            std::array<float, 4> values = {};
+            size_t nValues = 0;
+            while (nValues < values.size() && parseNumber(rest, values[nValues])) {
+                nValues++;
+            }
+            skipSpaces(rest);
+            if (!rest.empty()) {
+                continue;
+            }
+
+            if (nValues == 2 && !chunk.dimensions) {
+                // The dimensions are integers, so we parse them again as such
+                rest = line;
+                unsigned int x = 0;
+                unsigned int y = 0;
+                if (parseNumber(rest, x) && parseNumber(rest, y)) {
+                    skipSpaces(rest);
+                    if (rest.empty()) {
+                        chunk.dimensions = std::pair(x, y);
+                        chunk.nVerticesBeforeDimensions = chunk.vertices.size();
+                    }
+                }
+            }
+            else if (nValues == 4) {
+                chunk.vertices.push_back({ values[0], values[1], values[2], values[3] });
+            }
+        }
+        return chunk;
+    }
+} // namespace
+
 namespace sgct::correction {
 
-Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& parent) {
+Buffer generateSkySkanMesh(const std::filesystem::path& path, const vec2& pos,
+                           const vec2& size)
+{
     ZoneScoped;
 
     Buffer buf;
 
-    Log::Info(std::format("Reading SkySkan mesh data from '{}'", path));
+    Log::Info("Reading SkySkan mesh data from '{}'", path);
 
-    std::ifstream meshFile = std::ifstream(path);
-    if (!meshFile.good()) {
+    const MappedFile file = MappedFile(path);
+    if (!file.data()) {
         throw Error(2090, std::format("Failed to open file '{}'", path));
     }
+    const std::string_view text = std::string_view(
+        reinterpret_cast<const char*>(file.data()),
+        file.size()
+    );
+
+    const std::vector<Chunk> chunks = parseInParallel(text, parseChunk);
 
     std::optional<float> azimuth;
     std::optional<float> elevation;
@@ -45,58 +119,60 @@ Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& pare
     std::optional<float> vFov;
     vec2 fovTweaks{ 1.f, 1.f };
     vec2 uvTweaks{ 1.f, 1.f };
-    bool areDimsSet = false;
+    for (const Chunk& chunk : chunks) {
+        for (const auto& [key, value] : chunk.keys) {
+            if (key == "Dome Azimuth") {
+                azimuth = value;
+            }
+            else if (key == "Dome Elevation") {
+                elevation = value;
+            }
+            else if (key == "Horizontal FOV") {
+                hFov = value;
+            }
+            else if (key == "Vertical FOV") {
+                vFov = value;
+            }
+            else if (key == "Horizontal Tweak") {
+                fovTweaks.x = value;
+            }
+            else if (key == "Vertical Tweak") {
+                fovTweaks.y = value;
+            }
+            else if (key == "U Tweak") {
+                uvTweaks.x = value;
+            }
+            else if (key == "V Tweak") {
+                uvTweaks.y = value;
+            }
+        }
+    }
 
+    bool areDimsSet = false;
     unsigned int sizeX = 0;
     unsigned int sizeY = 0;
-    unsigned int counter = 0;
-
-    std::string line;
-    while (std::getline(meshFile, line)) {
-        if (auto r = scn::scan<float>(line, "Dome Azimuth={}");  r) {
-            azimuth = r->value();
-            break;
-        }
-        if (auto r = scn::scan<float>(line, "Dome Elevation={}");  r) {
-            elevation = r->value();
-            break;
-        }
-        if (auto r = scn::scan<float>(line, "Horizontal FOV={}");  r) {
-            hFov = r->value();
-            break;
-        }
-        if (auto r = scn::scan<float>(line, "Vertical FOV={}");  r) {
-            vFov = r->value();
-            break;
-        }
-        if (auto r = scn::scan<float>(line, "Horizontal Tweak={}");  r) {
-            fovTweaks.x = r->value();
-            break;
-        }
-        if (auto r = scn::scan<float>(line, "Vertical Tweak={}");  r) {
-            fovTweaks.y = r->value();
-            break;
-        }
-        if (auto r = scn::scan<float>(line, "U Tweak={}");  r) {
-            uvTweaks.x = r->value();
-            break;
-        }
-        if (auto r = scn::scan<float>(line, "V Tweak={}");  r) {
-            uvTweaks.y = r->value();
-            break;
-        }
-        if (auto r = scn::scan<unsigned int, unsigned int>(line, "{} {}");
-            r && !areDimsSet)
-        {
+    size_t counter = 0;
+    for (const Chunk& chunk : chunks) {
+        size_t first = 0;
+        if (!areDimsSet) {
+            if (!chunk.dimensions) {
+                continue;
+            }
             areDimsSet = true;
-            std::tie(sizeX, sizeY) = r->values();
+            std::tie(sizeX, sizeY) = *chunk.dimensions;
             buf.vertices.resize(static_cast<size_t>(sizeX) * static_cast<size_t>(sizeY));
-            break;
+            first = chunk.nVerticesBeforeDimensions;
+        }
+
+        if (counter + chunk.vertices.size() - first > buf.vertices.size()) {
+            throw Error(
+                2091,
+                std::format("More vertices than {}x{} in file '{}'", sizeX, sizeY, path)
+            );
         }
-        if (auto r = scn::scan<float, float, float, float>(line, "{} {} {} {}");
-            r && areDimsSet)
-        {
-            auto& [x, y, u, v] = r->values();
+        for (size_t i = first; i < chunk.vertices.size(); i++) {
+            float u = chunk.vertices[i].u;
+            float v = chunk.vertices[i].v;
             if (uvTweaks.x > -1.f) {
                 u *= uvTweaks.x;
             }
@@ -105,8 +181,8 @@ Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& pare
                 v *= uvTweaks.y;
             }
 
-            buf.vertices[counter].x = x;
-            buf.vertices[counter].y = y;
+            buf.vertices[counter].x = chunk.vertices[i].x;
+            buf.vertices[counter].y = chunk.vertices[i].y;
             buf.vertices[counter].s = u;
             buf.vertices[counter].t = 1.f - v;
 
@@ -115,7 +191,6 @@ Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& pare
             buf.vertices[counter].b = 1.f;
             buf.vertices[counter].a = 1.f;
             counter++;
-            break;
         }
     }
 
@@ -133,7 +208,7 @@ Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& pare
         const float hh = (1200.f / 2048.f) * hw;
         vFov = 2.f * glm::degrees<float>(std::atan(hh));
 
-        Log::Info(std::format("HFOV: {} VFOV: {}", *hFov, *vFov));
+        Log::Info("HFOV: {} VFOV: {}", *hFov, *vFov);
     }
 
     if (fovTweaks.x > 0.f) {
@@ -147,17 +222,16 @@ Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& pare
     rotQuat = glm::rotate(rotQuat, glm::radians(-*azimuth), glm::vec3(0.f, 1.f, 0.f));
     rotQuat = glm::rotate(rotQuat, glm::radians(*elevation), glm::vec3(1.f, 0.f, 0.f));
 
-    parent.user().setPos(vec3{ 0.f, 0.f, 0.f });
+    buf.view.userPosition = vec3{ 0.f, 0.f, 0.f };
     const float vHalf = *vFov / 2.f;
     const float hHalf = *hFov / 2.f;
-    parent.setViewPlaneCoordsUsingFOVs(
-        vHalf,
-        -vHalf,
-        -hHalf,
-        hHalf,
-        quat(rotQuat.x, rotQuat.y, rotQuat.z, rotQuat.w)
-    );
-    Engine::instance().updateFrustums();
+    buf.view.frustum = Buffer::View::Frustum{
+        .up = vHalf,
+        .down = -vHalf,
+        .left = -hHalf,
+        .right = hHalf,
+        .orientation = quat(rotQuat.x, rotQuat.y, rotQuat.z, rotQuat.w)
+    };
 
     for (unsigned int c = 0; c < (sizeX - 1); c++) {
         for (unsigned int r = 0; r < (sizeY - 1); r++) {
@@ -189,18 +263,16 @@ Buffer generateSkySkanMesh(const std::filesystem::path& path, BaseViewport& pare
     }
 
     for (Buffer::Vertex& vertex : buf.vertices) {
-        const vec2& s = parent.size();
-        const vec2& p = parent.position();
-
         // convert to [-1, 1]
-        vertex.x = 2.f * (vertex.x * s.x + p.x) - 1.f;
-        vertex.y = 2.f * ((1.f - vertex.y) * s.y + p.y) - 1.f;
+        vertex.x = 2.f * (vertex.x * size.x + pos.x) - 1.f;
+        vertex.y = 2.f * ((1.f - vertex.y) * size.y + pos.y) - 1.f;
 
-        vertex.s = vertex.s * s.x + p.x;
-        vertex.t = vertex.t * s.y + p.y;
+        vertex.s = vertex.s * size.x + pos.x;
+        vertex.t = vertex.t * size.y + pos.y;
     }
 
     buf.geometryType = GL_TRIANGLES;
+    buf.grid = Buffer::Grid{ sizeX, sizeY };
     return buf;
 }
 
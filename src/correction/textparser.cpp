@@ -0,0 +1,124 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/correction/textparser.h>
+
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+    // Some standard libraries do not implement std::from_chars for floating point
+    // numbers yet, in which case std::strtof is used instead
+#ifdef __cpp_lib_to_chars
+    constexpr bool HasFloatingPointFromChars = true;
+#else // ^^^^ __cpp_lib_to_chars // !__cpp_lib_to_chars vvvv
+    constexpr bool HasFloatingPointFromChars = false;
+#endif // __cpp_lib_to_chars
+
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t';
+    }
+
+    template <typename T>
+    bool parseValue(std::string_view& text, T& value) {
+        sgct::correction::skipSpaces(text);
+        if (!text.empty() && text.front() == '+') {
+            text.remove_prefix(1);
+        }
+
+        if constexpr (std::is_floating_point_v<T> && !HasFloatingPointFromChars) {
+            // The number is copied into a terminated buffer for std::strtof as the text
+            // continues after the end of the number
+            char buffer[64];
+            const size_t n = std::min(text.size(), sizeof(buffer) - 1);
+            std::memcpy(buffer, text.data(), n);
+            buffer[n] = '\0';
+            char* end = nullptr;
+            value = std::strtof(buffer, &end);
+            if (end == buffer) {
+                return false;
+            }
+            text.remove_prefix(end - buffer);
+            return true;
+        }
+        else {
+            const char* end = text.data() + text.size();
+            const std::from_chars_result res = std::from_chars(text.data(), end, value);
+            if (res.ec != std::errc()) {
+                return false;
+            }
+            text.remove_prefix(res.ptr - text.data());
+            return true;
+        }
+    }
+} // namespace
+
+namespace sgct::correction {
+
+std::string_view nextLine(std::string_view& text) {
+    const size_t end = text.find('\n');
+    std::string_view line = text.substr(0, end);
+    text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    return line;
+}
+
+void skipSpaces(std::string_view& text) {
+    size_t i = 0;
+    while (i < text.size() && isSpace(text[i])) {
+        i++;
+    }
+    text.remove_prefix(i);
+}
+
+std::string_view parseWord(std::string_view& text) {
+    skipSpaces(text);
+    size_t i = 0;
+    while (i < text.size() && !isSpace(text[i])) {
+        i++;
+    }
+    const std::string_view word = text.substr(0, i);
+    text.remove_prefix(i);
+    return word;
+}
+
+bool parseCharacter(std::string_view& text, char c) {
+    skipSpaces(text);
+    if (text.empty() || text.front() != c) {
+        return false;
+    }
+    text.remove_prefix(1);
+    return true;
+}
+
+bool parseNumber(std::string_view& text, float& value) {
+    return parseValue(text, value);
+}
+
+bool parseNumber(std::string_view& text, int& value) {
+    return parseValue(text, value);
+}
+
+bool parseNumber(std::string_view& text, unsigned int& value) {
+    return parseValue(text, value);
+}
+
+bool startsWithNumber(std::string_view line) {
+    skipSpaces(line);
+    if (line.empty()) {
+        return false;
+    }
+    const char c = line.front();
+    return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
+}
+
+} // namespace sgct::correction
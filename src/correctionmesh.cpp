@@ -8,15 +8,19 @@
 
 #include <sgct/correctionmesh.h>
 
+#include <sgct/engine.h>
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
 #include <sgct/math.h>
 #include <sgct/opengl.h>
 #include <sgct/profiling.h>
+#include <sgct/user.h>
 #include <sgct/viewport.h>
 #include <sgct/window.h>
 #include <sgct/correction/domeprojection.h>
+#include <sgct/correction/meshcache.h>
+#include <sgct/correction/meshoptimizer.h>
 #include <sgct/correction/obj.h>
 #include <sgct/correction/paulbourke.h>
 #include <sgct/correction/pfm.h>
@@ -26,8 +30,11 @@
 #include <sgct/correction/skyskan.h>
 #include <sgct/projection/fisheye.h>
 #include <algorithm>
+#include <array>
 #include <fstream>
 #include <iomanip>
+#include <limits>
+#include <memory>
 
 #define Error(c, msg) sgct::Error(sgct::Error::Component::CorrectionMesh, c, msg)
 
@@ -93,10 +100,75 @@ correction::Buffer setupSimpleMesh(const vec2& pos, const vec2& size) {
     return buff;
 }
 
+correction::Buffer generateMesh(const std::filesystem::path& path,
+                                const BaseViewport& parent, bool textureRenderMode)
+{
+    using namespace correction;
+    const vec2& parentPos = parent.position();
+    const vec2& parentSize = parent.size();
+
+    // find a suitable format
+    if (path.extension() == ".sgc") {
+        return generateScissMesh(path, parent);
+    }
+    else if (path.extension() == ".ol") {
+        return generateScalableMesh(path, parentPos, parentSize);
+    }
+    else if (path.extension() == ".skyskan") {
+        return generateSkySkanMesh(path, parentPos, parentSize);
+    }
+    else if (path.extension() == ".txt") {
+        return generateSkySkanMesh(path, parentPos, parentSize);
+    }
+    else if (path.extension() == ".csv") {
+        return generateDomeProjectionMesh(path, parentPos, parentSize);
+    }
+    else if (path.extension() == ".data") {
+        const float aspectRatio = parent.window().aspectRatio();
+        return generatePaulBourkeMesh(path, parentPos, parentSize, aspectRatio);
+    }
+    else if (path.extension() == ".obj") {
+        return generateOBJMesh(path);
+    }
+    else if (path.extension() == ".pfm") {
+        return generatePerEyeMeshFromPFMImage(
+            path,
+            parentPos,
+            parentSize,
+            textureRenderMode
+        );
+    }
+    else if (path.extension() == ".simcad") {
+        return generateSimCADMesh(path, parentPos, parentSize);
+    }
+    else {
+        throw Error(2002, "Could not determine format for warping mesh");
+    }
+}
+
+/// \return The first of the \p indices that is not smaller than \p nVertices, which
+///         would be read outside of the buffers, or `std::nullopt` if all are valid
+std::optional<unsigned int> invalidIndex(std::span<const unsigned int> indices,
+                                         size_t nVertices)
+{
+    const auto it = std::ranges::find_if(
+        indices,
+        [nVertices](unsigned int i) { return i >= nVertices; }
+    );
+    return it != indices.end() ? std::optional(*it) : std::nullopt;
+}
+
 } // namespace
 
 CorrectionMesh::CorrectionMeshGeometry::CorrectionMeshGeometry(
                                                          const correction::Buffer& buffer)
+    : CorrectionMeshGeometry(buffer.vertices, buffer.indices, buffer.geometryType)
+{}
+
+CorrectionMesh::CorrectionMeshGeometry::CorrectionMeshGeometry(
+                                     std::span<const correction::Buffer::Vertex> vertices,
+                                                    std::span<const unsigned int> indices,
+                                                                unsigned int geometryType)
 {
     ZoneScoped;
     TracyGpuZone("createMesh");
@@ -106,36 +178,59 @@ CorrectionMesh::CorrectionMeshGeometry::CorrectionMeshGeometry(
 
     glGenBuffers(1, &vbo);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    constexpr int s = sizeof(correction::Buffer::Vertex);
-    glBufferData(
-        GL_ARRAY_BUFFER,
-        buffer.vertices.size() * s,
-        buffer.vertices.data(),
-        GL_STATIC_DRAW
-    );
-
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, s, nullptr);
-
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, s, reinterpret_cast<void*>(8));
-
     glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, s, reinterpret_cast<void*>(16));
+    const std::optional<std::vector<correction::PackedVertex>> packed =
+        Engine::instance().settings().packCorrectionMeshes ?
+        correction::packVertices(vertices) :
+        std::nullopt;
+    if (packed) {
+        // The normalized integers are converted back to floating point values when they
+        // are fetched, so the shaders are the same as for the unpacked vertices
+        constexpr int s = sizeof(correction::PackedVertex);
+        const size_t size = packed->size() * s;
+        glBufferData(GL_ARRAY_BUFFER, size, packed->data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_SHORT, GL_TRUE, s, nullptr);
+        glVertexAttribPointer(
+            1, 2, GL_UNSIGNED_SHORT, GL_TRUE, s, reinterpret_cast<void*>(4)
+        );
+        glVertexAttribPointer(
+            2, 4, GL_UNSIGNED_BYTE, GL_TRUE, s, reinterpret_cast<void*>(8)
+        );
+        nBytes = size;
+    }
+    else {
+        constexpr int s = sizeof(correction::Buffer::Vertex);
+        const size_t size = vertices.size() * s;
+        glBufferData(GL_ARRAY_BUFFER, size, vertices.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, s, nullptr);
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, s, reinterpret_cast<void*>(8));
+        glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, s, reinterpret_cast<void*>(16));
+        nBytes = size;
+    }
 
     glGenBuffers(1, &ibo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-    glBufferData(
-        GL_ELEMENT_ARRAY_BUFFER,
-        buffer.indices.size() * sizeof(unsigned int),
-        buffer.indices.data(),
-        GL_STATIC_DRAW
-    );
+    if (vertices.size() <= std::numeric_limits<uint16_t>::max()) {
+        const std::vector<uint16_t> shortIndices =
+            std::vector<uint16_t>(indices.begin(), indices.end());
+        const size_t size = shortIndices.size() * sizeof(uint16_t);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, shortIndices.data(), GL_STATIC_DRAW);
+        indexType = GL_UNSIGNED_SHORT;
+        nBytes += size;
+    }
+    else {
+        const size_t size = indices.size() * sizeof(unsigned int);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices.data(), GL_STATIC_DRAW);
+        indexType = GL_UNSIGNED_INT;
+        nBytes += size;
+    }
     glBindVertexArray(0);
 
-    nVertices = static_cast<int>(buffer.vertices.size());
-    nIndices = static_cast<int>(buffer.indices.size());
-    type = buffer.geometryType;
+    nVertices = static_cast<int>(vertices.size());
+    nIndices = static_cast<int>(indices.size());
+    type = geometryType;
 }
 
 CorrectionMesh::CorrectionMeshGeometry::CorrectionMeshGeometry(
@@ -146,6 +241,8 @@ CorrectionMesh::CorrectionMeshGeometry::CorrectionMeshGeometry(
     , nVertices(rhs.nVertices)
     , nIndices(rhs.nIndices)
     , type(rhs.type)
+    , indexType(rhs.indexType)
+    , nBytes(rhs.nBytes)
 {
     // We need to prevent a double-free of the OpenGL resource in the destructor
     rhs.vao = 0;
@@ -172,7 +269,8 @@ CorrectionMesh::CorrectionMeshGeometry::~CorrectionMeshGeometry() {
 }
 
 void CorrectionMesh::loadMesh(const std::filesystem::path& path, BaseViewport& parent,
-                              bool needsMaskGeometry, bool textureRenderMode)
+                              bool needsMaskGeometry, bool textureRenderMode,
+                              std::optional<float> tolerance)
 {
     ZoneScoped;
 
@@ -203,28 +301,140 @@ void CorrectionMesh::loadMesh(const std::filesystem::path& path, BaseViewport& p
         return;
     }
 
-    Buffer buf;
+    // The simplification tolerance is given in pixels of the window
+    const ivec2 resolution = parent.window().framebufferResolution();
+
+    // The parameters of the viewport that the parsers use besides the file
+    const std::array<float, 9> parameters = {
+        parentPos.x,
+        parentPos.y,
+        parentSize.x,
+        parentSize.y,
+        path.extension() == ".data" ? parent.window().aspectRatio() : 0.f,
+        textureRenderMode ? 1.f : 0.f,
+        tolerance.value_or(-1.f),
+        tolerance ? static_cast<float>(resolution.x) : 0.f,
+        tolerance ? static_cast<float>(resolution.y) : 0.f
+    };
+    const bool useCache =
+        Engine::instance().settings().useMeshCache && !meshCacheDirectory().empty();
+    const std::optional<uint64_t> key =
+        useCache ? meshCacheKey(path, parameters) : std::nullopt;
+    std::unique_ptr<CachedMesh> cached =
+        key ? CachedMesh::open(meshCachePath(path, *key), *key) : nullptr;
+    if (cached) {
+        const std::optional<unsigned int> index =
+            invalidIndex(cached->indices(), cached->vertices().size());
+        if (index) {
+            // The mesh is parsed again, which replaces the damaged cache file
+            Log::Warning(
+                "Ignoring the cache of correction mesh '{}' that uses vertex {} but "
+                "only has {} vertices", path, *index, cached->vertices().size()
+            );
+            cached = nullptr;
+        }
+    }
 
-    // find a suitable format
-    if (path.extension() == ".sgc") {
-        buf = generateScissMesh(path, parent);
+    Buffer::View view;
+    if (cached) {
+        Log::Info("Loading correction mesh '{}' from cache", path);
+        _warpGeometry = CorrectionMeshGeometry(
+            cached->vertices(),
+            cached->indices(),
+            cached->geometryType()
+        );
+        view = cached->view();
     }
-    else if (path.extension() == ".ol") {
-        buf = generateScalableMesh(path, parent);
+    else {
+        Buffer buf = generateMesh(path, parent, textureRenderMode);
+
+        const std::optional<unsigned int> index =
+            invalidIndex(buf.indices, buf.vertices.size());
+        if (index) {
+            throw Error(
+                2005,
+                std::format(
+                    "Correction mesh '{}' uses vertex {} but only has {} vertices",
+                    path, *index, buf.vertices.size()
+                )
+            );
+        }
+
+        if (tolerance && buf.grid) {
+            // The positions cover [-1, 1] across the window and the texture coordinates
+            // [0, 1]. The pixel tolerance says nothing about the blend colors, which may
+            // only change by less than an 8 bit step so that the blending looks the same
+            const vec2 res = vec2(
+                static_cast<float>(std::max(resolution.x, 1)),
+                static_cast<float>(std::max(resolution.y, 1))
+            );
+            const SimplificationTolerance tol = {
+                .position = vec2(*tolerance * 2.f / res.x, *tolerance * 2.f / res.y),
+                .textureCoordinate = vec2(*tolerance / res.x, *tolerance / res.y),
+                .color = 0.5f / 255.f
+            };
+            const std::optional<SimplificationReport> report = simplifyGrid(buf, tol);
+            if (report) {
+                Log::Info(
+                    "Simplified correction mesh '{}'. Vertices: {} -> {}, triangles: "
+                    "{} -> {}, largest error in pixels: position {:.3f}, texture {:.3f}, "
+                    "color {:.3f}",
+                    path, report->nVerticesBefore, report->nVerticesAfter,
+                    report->nTrianglesBefore, report->nTrianglesAfter,
+                    std::max(
+                        report->positionError.x * res.x,
+                        report->positionError.y * res.y
+                    ) / 2.f,
+                    std::max(
+                        report->textureCoordinateError.x * res.x,
+                        report->textureCoordinateError.y * res.y
+                    ),
+                    report->colorError * 255.f
+                );
+            }
+        }
+        if (buf.geometryType == GL_TRIANGLES) {
+            // The reordered indices are stored in the cache, so this is only done once
+            const float before = averageCacheMissRatio(buf.indices);
+            optimizeVertexCache(buf.indices, buf.vertices.size());
+            const float after = averageCacheMissRatio(buf.indices);
+            Log::Info(
+                "Reordered correction mesh '{}' for the vertex cache. Vertices fetched "
+                "per triangle: {:.2f} -> {:.2f}", path, before, after
+            );
+        }
+        _warpGeometry = CorrectionMeshGeometry(buf);
+        view = buf.view;
+
+        if (key) {
+            try {
+                saveMeshCache(meshCachePath(path, *key), *key, buf);
+            }
+            catch (const std::runtime_error& e) {
+                // The cache only saves time on the next start, so a failure is not fatal
+                Log::Warning(e.what());
+            }
+        }
     }
-    else if (path.extension() == ".skyskan") {
-        buf = generateSkySkanMesh(path, parent);
+
+    if (view.userPosition) {
+        parent.user().setPos(*view.userPosition);
     }
-    else if (path.extension() == ".txt") {
-        buf = generateSkySkanMesh(path, parent);
+    if (view.frustum) {
+        parent.setViewPlaneCoordsUsingFOVs(
+            view.frustum->up,
+            view.frustum->down,
+            view.frustum->left,
+            view.frustum->right,
+            view.frustum->orientation
+        );
+        Engine::instance().updateFrustums();
     }
-    else if (path.extension() == ".csv") {
-        buf = generateDomeProjectionMesh(path, parentPos, parentSize);
+    if (view.planeOffset) {
+        parent.projectionPlane().offset(*view.planeOffset);
     }
-    else if (path.extension() == ".data") {
-        const float aspectRatio = parent.window().aspectRatio();
-        buf = generatePaulBourkeMesh(path, parentPos, parentSize, aspectRatio);
 
+    if (path.extension() == ".data") {
         // force regeneration of dome render quad
         if (Viewport* vp = dynamic_cast<Viewport*>(&parent); vp) {
             auto fishPrj = dynamic_cast<FisheyeProjection*>(vp->nonLinearProjection());
@@ -234,35 +444,22 @@ void CorrectionMesh::loadMesh(const std::filesystem::path& path, BaseViewport& p
             }
         }
     }
-    else if (path.extension() == ".obj") {
-        buf = generateOBJMesh(path);
-    }
-    else if (path.extension() == ".pfm") {
-        buf = generatePerEyeMeshFromPFMImage(
-            path,
-            parentPos,
-            parentSize,
-            textureRenderMode
-        );
-    }
-    else if (path.extension() == ".simcad") {
-        buf = generateSimCADMesh(path, parentPos, parentSize);
-    }
-    else {
-        throw Error(2002, "Could not determine format for warping mesh");
-    }
 
-    _warpGeometry = CorrectionMeshGeometry(buf);
-
-    Log::Debug(std::format(
-        "CorrectionMesh read successfully. Vertices={}, Indices={}",
-        buf.vertices.size(), buf.indices.size()
-    ));
+    // The size that the mesh would have with floating point vertices and 32 bit indices
+    const size_t nUnpackedBytes =
+        _warpGeometry->nVertices * sizeof(Buffer::Vertex) +
+        _warpGeometry->nIndices * sizeof(unsigned int);
+    Log::Debug(
+        "CorrectionMesh read successfully. Vertices={}, Indices={}, {:.2f} MB instead "
+        "of {:.2f} MB",
+        _warpGeometry->nVertices, _warpGeometry->nIndices,
+        _warpGeometry->nBytes / (1024.0 * 1024.0), nUnpackedBytes / (1024.0 * 1024.0)
+    );
 }
 
 void CorrectionMesh::CorrectionMeshGeometry::render() const {
     glBindVertexArray(vao);
-    glDrawElements(type, nIndices, GL_UNSIGNED_INT, nullptr);
+    glDrawElements(type, nIndices, indexType, nullptr);
     glBindVertexArray(0);
 }
 
@@ -26,9 +26,9 @@
 #endif // SGCT_HAS_VRPN
 #include <sgct/version.h>
 #include <sgct/projection/nonlinearprojection.h>
+#include <chrono>
 #include <iostream>
 #include <numeric>
-#include <mutex>
 
 #ifdef WIN32
 #include <glad/glad_wgl.h>
@@ -48,11 +48,14 @@
 namespace sgct {
 
 namespace {
-    constexpr bool RunFrameLockCheckThread = true;
+    // The frame lock waits for at most this long before checking whether it should print
+    // a message about the nodes it is waiting for
     constexpr std::chrono::milliseconds FrameLockTimeout(100);
 
-    bool sRunUpdateFrameLockLoop = true;
-    std::mutex FrameSync;
+    // The frame telemetry is kept for one hour at 60 Hz in the file, and the percentiles
+    // are computed over one minute, unless the configuration says otherwise
+    constexpr int DefaultTelemetryCapacity = 60 * 60 * 60;
+    constexpr float DefaultTelemetryWindow = 60.f;
 
     // Callback wrappers for GLFW
     std::function<void(Key, Modifier, Action, int, Window*)> gKeyboardCallback = nullptr;
@@ -63,20 +66,6 @@ namespace {
     std::function<void(double, double, Window*)> gMouseScrollCallback = nullptr;
     std::function<void(std::vector<std::string_view>)> gDropCallback = nullptr;
 
-    // For feedback: breaks a frame lock wait condition every time interval
-    // (FrameLockTimeout) in order to print waiting message.
-    void updateFrameLockLoop(void*) {
-        bool run = true;
-
-        while (run) {
-            FrameSync.lock();
-            run = sRunUpdateFrameLockLoop;
-            FrameSync.unlock();
-            NetworkManager::cond.notify_all();
-            std::this_thread::sleep_for(FrameLockTimeout);
-        }
-    }
-
     void addValue(std::array<double, Engine::Statistics::HistoryLength>& a, double v) {
         std::rotate(std::rbegin(a), std::rbegin(a) + 1, std::rend(a));
         a[0] = v;
@@ -109,6 +98,10 @@ namespace {
                 cluster.settings->useNormalTexture.value_or(res.useNormalTexture);
             res.usePositionTexture =
                 cluster.settings->usePositionTexture.value_or(res.usePositionTexture);
+            res.useMeshCache = cluster.settings->useMeshCache.value_or(res.useMeshCache);
+            res.packCorrectionMeshes = cluster.settings->packCorrectionMeshes.value_or(
+                res.packCorrectionMeshes
+            );
         }
         if (cluster.capture) {
             res.capture.capturePath =
@@ -120,6 +113,34 @@ namespace {
                     static_cast<uint64_t>(cluster.capture->range->last)
                 };
             }
+
+            if (cluster.capture->format) {
+                res.capture.format = [](config::Capture::Format format) {
+                    switch (format) {
+                        case config::Capture::Format::Png:
+                            return Image::Format::Png;
+                        case config::Capture::Format::FastPng:
+                            return Image::Format::FastPng;
+                        case config::Capture::Format::ParallelPng:
+                            return Image::Format::ParallelPng;
+                        case config::Capture::Format::Tga:
+                            return Image::Format::Tga;
+                        case config::Capture::Format::Raw:
+                            return Image::Format::Raw;
+                        case config::Capture::Format::Qoi:
+                            return Image::Format::Qoi;
+                        default:
+                            throw std::logic_error("Unhandled case label");
+                    }
+                }(*cluster.capture->format);
+            }
+
+            if (cluster.capture->sequence) {
+                res.capture.sequence =
+                    *cluster.capture->sequence == config::Capture::Sequence::Deflate ?
+                    SequenceWriter::Compression::Deflate :
+                    SequenceWriter::Compression::None;
+            }
         }
 
         return res;
@@ -193,17 +214,17 @@ config::Cluster loadCluster(std::optional<std::filesystem::path> path) {
     if (path) {
         assert(std::filesystem::exists(*path) && std::filesystem::is_regular_file(*path));
         try {
-            Log::Debug(std::format("Parsing config '{}'", *path));
+            Log::Debug("Parsing config '{}'", *path);
             config::Cluster cluster = readConfig(*path);
 
             Log::Debug("Config file read successfully");
-            Log::Info(std::format("Number of nodes: {}", cluster.nodes.size()));
+            Log::Info("Number of nodes: {}", cluster.nodes.size());
 
             for (size_t i = 0; i < cluster.nodes.size(); i++) {
                 const config::Node& node = cluster.nodes[i];
-                Log::Info(std::format(
+                Log::Info(
                     "\tNode ({}) address: {} [{}]", i, node.address, node.port
-                ));
+                );
             }
             return cluster;
         }
@@ -249,6 +270,12 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
     gMouseScrollCallback = std::move(callbacks.mouseScroll);
     gDropCallback = std::move(callbacks.drop);
 
+    _captureEncoder = std::make_unique<CaptureEncoder>(
+        _settings.capture.nCaptureThreads,
+        _settings.capture.queueSize,
+        _settings.capture.queuePolicy
+    );
+
     NetworkManager::NetworkMode netMode = NetworkManager::NetworkMode::Remote;
     if (config.isServer) {
         netMode = *config.isServer ?
@@ -258,6 +285,9 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
     if (config.logLevel) {
         Log::instance().setNotifyLevel(*config.logLevel);
     }
+    if (config.logFile) {
+        Log::instance().setLogFile(*config.logFile);
+    }
     if (config.showHelpText) {
         std::cout << helpMessage() << '\n';
         std::exit(0);
@@ -287,7 +317,7 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
         }
     }
 
-    Log::Info(std::format("SGCT version: {}", Version));
+    Log::Info("SGCT version: {}", Version);
 
     Log::Debug("Validating cluster configuration");
     config::validateCluster(cluster);
@@ -298,6 +328,34 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
         std::move(callbacks.dataTransferStatus),
         std::move(callbacks.dataTransferAcknowledge)
     );
+    NetworkManager::instance().setDataTransferStreamFunctions(
+        callbacks.dataTransferChunk,
+        callbacks.dataTransferResume,
+        callbacks.dataTransferProgress
+    );
+    if (cluster.settings && cluster.settings->compression) {
+        const config::Settings::Compression& c = *cluster.settings->compression;
+        NetworkManager::Compression compression;
+        compression.level = c.level.value_or(compression.level);
+        compression.threshold = c.threshold.value_or(compression.threshold);
+        NetworkManager::instance().setCompression(compression);
+    }
+    if (cluster.settings && cluster.settings->deltaEncoding) {
+        const config::Settings::DeltaEncoding& d = *cluster.settings->deltaEncoding;
+        NetworkManager::DeltaEncoding deltaEncoding;
+        deltaEncoding.keyframeInterval =
+            d.keyframeInterval.value_or(deltaEncoding.keyframeInterval);
+        NetworkManager::instance().setDeltaEncoding(deltaEncoding);
+    }
+    if (cluster.multicast) {
+        const config::Cluster::Multicast& m = *cluster.multicast;
+        NetworkManager::Multicast multicast;
+        multicast.address = m.address;
+        multicast.port = m.port;
+        multicast.ttl = m.ttl.value_or(multicast.ttl);
+        multicast.interfaceAddress = m.interfaceAddress.value_or("");
+        NetworkManager::instance().setMulticast(multicast);
+    }
 #ifdef SGCT_HAS_VRPN
     for (const config::Tracker& tracker : cluster.trackers) {
         TrackingManager::instance().applyTracker(tracker);
@@ -311,7 +369,7 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
         for (size_t i = 0; i < cluster.nodes.size(); i++) {
             if (NetworkManager::instance().matchesAddress(cluster.nodes[i].address)) {
                 clusterId = static_cast<int>(i);
-                Log::Debug(std::format("Running in cluster mode as node {}", i));
+                Log::Debug("Running in cluster mode as node {}", i);
                 break;
             }
         }
@@ -325,7 +383,7 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
                 );
             }
             clusterId = *config.nodeId;
-            Log::Debug(std::format("Running locally as node {}", clusterId));
+            Log::Debug("Running locally as node {}", clusterId);
         }
         else {
             throw Err(3002, "When running locally, a node ID needs to be specified");
@@ -342,6 +400,35 @@ Engine::Engine(config::Cluster cluster, Callbacks callbacks, const Configuration
         ClusterManager::instance().setUseIgnoreSync(*config.ignoreSync);
     }
 
+    config::Settings::Telemetry telemetry;
+    if (cluster.settings && cluster.settings->telemetry) {
+        telemetry = *cluster.settings->telemetry;
+    }
+    _telemetry = std::make_unique<FrameTelemetry>(
+        telemetry.window.value_or(DefaultTelemetryWindow)
+    );
+    if (telemetry.path) {
+        std::filesystem::path path = *telemetry.path;
+        if (cluster.nodes.size() > 1) {
+            // The nodes might share the configuration file and the file system
+            path.replace_filename(std::format(
+                "{}_node{}{}",
+                path.stem().string(), clusterId, path.extension().string()
+            ));
+        }
+        try {
+            _telemetry->startRecording(
+                path,
+                telemetry.capacity.value_or(DefaultTelemetryCapacity),
+                static_cast<uint32_t>(clusterId)
+            );
+        }
+        catch (const Error& e) {
+            // The recording is only diagnostic and should never prevent the rendering
+            Log::Error("Failed to record frame telemetry: {}", e.message);
+        }
+    }
+
     NetworkManager::instance().initialize();
 }
 
@@ -373,7 +460,7 @@ void Engine::initialize() {
         glfwDestroyWindow(offscreen);
         glfwWindowHint(GLFW_VISIBLE, GL_TRUE);
     }
-    Log::Info(std::format("Detected OpenGL version: {}.{}", major, minor));
+    Log::Info("Detected OpenGL version: {}.{}", major, minor);
 
     initWindows(major, minor);
 
@@ -472,12 +559,12 @@ void Engine::initialize() {
         glfwGetWindowAttrib(winHandle, GLFW_CONTEXT_VERSION_MINOR),
         glfwGetWindowAttrib(winHandle, GLFW_CONTEXT_REVISION)
     };
-    Log::Info(std::format("OpenGL version {}.{}.{} core profile", v[0], v[1], v[2]));
+    Log::Info("OpenGL version {}.{}.{} core profile", v[0], v[1], v[2]);
 
     std::string vendor = reinterpret_cast<const char*>(glGetString(GL_VENDOR));
-    Log::Info(std::format("Vendor: {}", vendor));
+    Log::Info("Vendor: {}", vendor);
     std::string renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
-    Log::Info(std::format("Renderer: {}", renderer));
+    Log::Info("Renderer: {}", renderer);
 
     Window::makeSharedContextCurrent();
 
@@ -554,19 +641,6 @@ Engine::~Engine() {
     gMouseScrollCallback = nullptr;
     gDropCallback = nullptr;
 
-    // kill thread
-    if (_thread) {
-        Log::Debug("Waiting for frameLock thread to finish");
-
-        FrameSync.lock();
-        sRunUpdateFrameLockLoop = false;
-        FrameSync.unlock();
-
-        _thread->join();
-        _thread = nullptr;
-        Log::Debug("Done");
-    }
-
     // de-init window and unbind swapgroups
     // There might not be any thisNode as its creation might have failed
     if (hasNode) {
@@ -574,6 +648,14 @@ Engine::~Engine() {
         std::for_each(wins.cbegin(), wins.cend(), std::mem_fn(&Window::closeWindow));
     }
 
+    // Wait for the remaining screenshots to be saved
+    Log::Debug("Destroying capture encoder");
+    _captureEncoder = nullptr;
+
+    // Write the remaining frames into the telemetry file
+    Log::Debug("Destroying frame telemetry");
+    _telemetry = nullptr;
+
     // close TCP connections
     Log::Debug("Destroying network manager");
     NetworkManager::destroy();
@@ -607,13 +689,13 @@ Engine::~Engine() {
     Log::Debug("Destroying cluster manager");
     ClusterManager::destroy();
 
-    Log::Debug("Destroying message handler");
-    Log::destroy();
-
     Log::Debug("Terminating glfw");
     glfwTerminate();
 
     Log::Debug("Finished cleaning");
+
+    // Destroying the log writes all messages that are still waiting in its queue
+    Log::destroy();
 }
 
 void Engine::initWindows(int majorVersion, int minorVersion) {
@@ -627,7 +709,7 @@ void Engine::initWindows(int majorVersion, int minorVersion) {
         int minor = 0;
         int release = 0;
         glfwGetVersion(&major, &minor, &release);
-        Log::Info(std::format("Using GLFW version {}.{}.{}", major, minor, release));
+        Log::Info("Using GLFW version {}.{}.{}", major, minor, release);
     }
 
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, majorVersion);
@@ -672,10 +754,6 @@ void Engine::initWindows(int majorVersion, int minorVersion) {
     // clear directly otherwise junk will be displayed on some OSs (OS X Yosemite)
     glClearColor(0.f, 0.f, 0.f, 0.f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-    if (RunFrameLockCheckThread && ClusterManager::instance().numberOfNodes() > 1) {
-        _thread = std::make_unique<std::thread>(updateFrameLockLoop, nullptr);
-    }
 }
 
 void Engine::terminate() {
@@ -697,6 +775,7 @@ void Engine::frameLockPreStage() {
     }
     if (nm.isComputerServer()) {
         addValue(_statistics.syncTimes, static_cast<float>(glfwGetTime() - ts));
+        _statistics.syncSendTimes = nm.syncSendTimes();
     }
 
     // run only on clients
@@ -707,8 +786,7 @@ void Engine::frameLockPreStage() {
     // not server
     const double t0 = glfwGetTime();
     while (nm.isRunning() && !nm.isSyncComplete()) {
-        std::unique_lock lk(FrameSync);
-        NetworkManager::cond.wait(lk);
+        nm.waitForSyncComplete(std::chrono::steady_clock::now() + FrameLockTimeout);
 
         if (glfwGetTime() - t0 <= 1.0) {
             continue;
@@ -717,14 +795,14 @@ void Engine::frameLockPreStage() {
         // more than a second
         const Network& c = nm.syncConnection(0);
         if (_settings.printSyncMessage && !c.isUpdated()) {
-            Log::Info(std::format(
+            Log::Info(
                 "Waiting for master. frame send {} != recv {}\n\tSwap groups: {}\n\t"
                 "Swap barrier: {}\n\tUniversal frame number: {}\n\tSGCT frame number: {}",
                 c.sendFrameCurrent(), c.recvFramePrevious(),
                 Window::isUsingSwapGroups() ? "enabled" : "disabled",
                 Window::isBarrierActive() ? "enabled" : "disabled",
                 Window::swapGroupFrameNumber(), _frameCounter
-            ));
+            );
         }
 
         if (glfwGetTime() - t0 > _settings.syncTimeout) {
@@ -754,8 +832,7 @@ void Engine::frameLockPostStage() {
 
     const double t0 = glfwGetTime();
     while (nm.isRunning() && nm.activeConnectionsCount() > 0 && !nm.isSyncComplete()) {
-        std::unique_lock lk(FrameSync);
-        NetworkManager::cond.wait(lk);
+        nm.waitForSyncComplete(std::chrono::steady_clock::now() + FrameLockTimeout);
 
         if (glfwGetTime() - t0 <= 1.0) {
             continue;
@@ -763,7 +840,7 @@ void Engine::frameLockPostStage() {
         // more than a second
         for (int i = 0; i < nm.syncConnectionsCount(); i++) {
             if (_settings.printSyncMessage && !nm.connection(i).isUpdated()) {
-                Log::Info(std::format(
+                Log::Info(
                     "Waiting for IG {}: send frame {} != recv frame {}\n\tSwap groups: {}"
                     "\n\tSwap barrier: {}\n\tUniversal frame number: {}\n\t"
                     "SGCT frame number: {}", i, nm.connection(i).sendFrameCurrent(),
@@ -771,7 +848,7 @@ void Engine::frameLockPostStage() {
                     Window::isUsingSwapGroups() ? "enabled" : "disabled",
                     Window::isBarrierActive() ? "enabled" : "disabled",
                     Window::swapGroupFrameNumber(), _frameCounter
-                ));
+                );
             }
         }
 
@@ -789,11 +866,6 @@ void Engine::frameLockPostStage() {
 void Engine::exec() {
     Window::makeSharedContextCurrent();
 
-    unsigned int timeQueryBegin = 0;
-    glGenQueries(1, &timeQueryBegin);
-    unsigned int timeQueryEnd = 0;
-    glGenQueries(1, &timeQueryEnd);
-
     Node& thisNode = ClusterManager::instance().thisNode();
     const std::vector<std::unique_ptr<Window>>& wins = thisNode.windows();
     while (!_shouldTerminate && !thisNode.closeAllWindows() &&
@@ -801,7 +873,8 @@ void Engine::exec() {
     {
 #ifdef SGCT_HAS_VRPN
         if (isMaster()) {
-            TrackingManager::instance().updateTrackingDevices();
+            // Predict the head pose for when the frame will be shown
+            TrackingManager::instance().updateTrackingDevices(time() + _medianFrameTime);
         }
 #endif // SGCT_HAS_VRPN
 
@@ -812,10 +885,27 @@ void Engine::exec() {
 
         Window::makeSharedContextCurrent();
 
+        // Publish the textures whose asynchronous loading has finished. Doing this at the
+        // frame boundary means that a texture never changes in the middle of a frame
+        TextureManager::instance().update();
+
+        FrameTelemetry::Sample telemetry;
+        telemetry.frameNumber = _frameCounter;
+        telemetry.timestamp = std::chrono::duration<double>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        double phaseStart = glfwGetTime();
+        auto endPhase = [&telemetry, &phaseStart](FrameTelemetry::Phase phase) {
+            const double now = glfwGetTime();
+            telemetry.durations[static_cast<int>(phase)] += now - phaseStart;
+            phaseStart = now;
+        };
+
         if (_preSyncFn) [[likely]] {
             ZoneScopedN("[SGCT] PreSync");
             _preSyncFn();
         }
+        endPhase(FrameTelemetry::Phase::PreSync);
 
         if (NetworkManager::instance().isComputerServer()) {
             SharedData::instance().encode();
@@ -825,8 +915,10 @@ void Engine::exec() {
             Log::Error("Network disconnected. Exiting");
             break;
         }
+        endPhase(FrameTelemetry::Phase::Encode);
 
         frameLockPreStage();
+        endPhase(FrameTelemetry::Phase::NetworkWait);
         std::for_each(wins.cbegin(), wins.cend(), std::mem_fn(&Window::update));
         Window::makeSharedContextCurrent();
 
@@ -840,51 +932,45 @@ void Engine::exec() {
             const double startFrameTime = glfwGetTime();
             const double ft = static_cast<float>(startFrameTime - _statsPrevTimestamp);
             addValue(_statistics.frametimes, ft);
+            telemetry.durations[static_cast<int>(FrameTelemetry::Phase::Frame)] = ft;
             _statsPrevTimestamp = startFrameTime;
 
             if (_statisticsRenderer) [[unlikely]] {
-                glQueryCounter(timeQueryBegin, GL_TIMESTAMP);
+                if (_gpuTimer.beginFrame()) {
+                    collectGpuZones();
+                }
+                _gpuTimer.begin("Draw");
             }
         }
 
         // Render Viewports / Draw
+        phaseStart = glfwGetTime();
         std::for_each(wins.cbegin(), wins.cend(), std::mem_fn(&Window::draw));
         std::for_each(wins.cbegin(), wins.cend(), std::mem_fn(&Window::renderFBOTexture));
 
         Window::makeSharedContextCurrent();
 
-        if (_statisticsRenderer) [[unlikely]] {
-            ZoneScopedN("glQueryCounter");
-            glQueryCounter(timeQueryEnd, GL_TIMESTAMP);
+        if (_gpuTimer.isRecording()) [[unlikely]] {
+            _gpuTimer.end();
+            _gpuTimer.endFrame();
         }
+        endPhase(FrameTelemetry::Phase::Draw);
 
         if (_postDrawFn) [[likely]] {
             ZoneScopedN("[SGCT] PostDraw");
             _postDrawFn();
         }
+        endPhase(FrameTelemetry::Phase::PostDraw);
 
         if (_statisticsRenderer) [[unlikely]] {
             ZoneScopedN("Statistics Update");
-            // wait until the query results are available
-            GLint done = GL_FALSE;
-            while (!done) {
-                glGetQueryObjectiv(timeQueryEnd, GL_QUERY_RESULT_AVAILABLE, &done);
-            }
-
-            // get the query results
-            GLuint64 timerStart = 0;
-            glGetQueryObjectui64v(timeQueryBegin, GL_QUERY_RESULT, &timerStart);
-            GLuint64 timerEnd = 0;
-            glGetQueryObjectui64v(timeQueryEnd, GL_QUERY_RESULT, &timerEnd);
-
-            const double t = static_cast<double>(timerEnd - timerStart) / 1000000000.0;
-            addValue(_statistics.drawTimes, t);
-
             _statisticsRenderer->update();
         }
 
         // master will wait for nodes render before swapping
+        phaseStart = glfwGetTime();
         frameLockPostStage();
+        endPhase(FrameTelemetry::Phase::NetworkWait);
         // Swap front and back rendering buffers
         for (const std::unique_ptr<Window>& window : wins) {
             bool shouldTakeScreenshot = _shouldTakeScreenshot;
@@ -908,6 +994,19 @@ void Engine::exec() {
             }
             window->swapBuffers(shouldTakeScreenshot);
         }
+        endPhase(FrameTelemetry::Phase::Swap);
+
+        {
+            const CaptureEncoder::Statistics stats = _captureEncoder->statistics();
+            addValue(_statistics.captureQueueDepths, stats.queueDepth);
+            addValue(_statistics.captureEncodeTimes, stats.lastEncodeTime);
+            _statistics.nDroppedCaptures = stats.nDropped;
+        }
+        if (_frameCounter > 0) [[likely]] {
+            // The frame time of the first frame includes the entire initialization
+            _telemetry->add(telemetry);
+            updateNodeTiming(telemetry);
+        }
 
         TracyGpuCollect;
         FrameMark;
@@ -927,8 +1026,76 @@ void Engine::exec() {
     }
 
     Window::makeSharedContextCurrent();
-    glDeleteQueries(1, &timeQueryBegin);
-    glDeleteQueries(1, &timeQueryEnd);
+    _gpuTimer.deleteQueries();
+}
+
+void Engine::collectGpuZones() {
+    ZoneScoped;
+
+    // The first zone of the shared context covers the entire drawing of the frame
+    const std::vector<GpuTimer::Zone>& zones = _gpuTimer.zones();
+    if (!zones.empty()) {
+        addValue(_statistics.drawTimes, zones.front().duration);
+    }
+
+    _statistics.gpuZones = zones;
+    for (const std::unique_ptr<Window>& window : windows()) {
+        const std::vector<GpuTimer::Zone>& z = window->gpuTimer().zones();
+        _statistics.gpuZones.insert(_statistics.gpuZones.end(), z.begin(), z.end());
+    }
+}
+
+void Engine::updateNodeTiming(const FrameTelemetry::Sample& sample) {
+    ZoneScoped;
+
+    using Phase = FrameTelemetry::Phase;
+    auto duration = [&sample](Phase phase) {
+        return sample.durations[static_cast<int>(phase)];
+    };
+
+    if (_frameCounter % 60 == 1) {
+        _medianFrameTime = _telemetry->percentiles(Phase::Frame).p50;
+    }
+    if (_medianFrameTime > 0.0 && duration(Phase::Frame) > 1.5 * _medianFrameTime) {
+        _statistics.nDroppedFrames++;
+    }
+
+    NetworkManager& nm = NetworkManager::instance();
+    if (!nm.isComputerServer()) {
+        // Sent with the acknowledgement of the next frame
+        nm.setFrameTiming({
+            .nodeIndex = static_cast<uint32_t>(ClusterManager::instance().thisNodeId()),
+            .frameNumber = static_cast<uint32_t>(sample.frameNumber),
+            .drawTime = static_cast<float>(duration(Phase::Draw)),
+            .syncTime = static_cast<float>(duration(Phase::NetworkWait)),
+            .swapTime = static_cast<float>(duration(Phase::Swap)),
+            .nDroppedFrames = static_cast<uint32_t>(_statistics.nDroppedFrames)
+        });
+        return;
+    }
+
+    _statistics.nodeTimings.clear();
+    for (int i = 0; i < nm.syncConnectionsCount(); i++) {
+        const std::optional<Network::FrameTiming> t = nm.syncConnection(i).frameTiming();
+        if (!t) {
+            continue;
+        }
+        _statistics.nodeTimings.push_back({
+            .nodeIndex = static_cast<int>(t->nodeIndex),
+            .frameNumber = t->frameNumber,
+            .drawTime = t->drawTime,
+            .syncTime = t->syncTime,
+            .swapTime = t->swapTime,
+            .nDroppedFrames = t->nDroppedFrames
+        });
+    }
+    std::sort(
+        _statistics.nodeTimings.begin(),
+        _statistics.nodeTimings.end(),
+        [](const Statistics::NodeTiming& lhs, const Statistics::NodeTiming& rhs) {
+            return lhs.nodeIndex < rhs.nodeIndex;
+        }
+    );
 }
 
 bool Engine::isMaster() const {
@@ -1021,6 +1188,14 @@ const Engine::Statistics& Engine::statistics() const {
     return _statistics;
 }
 
+CaptureEncoder& Engine::captureEncoder() {
+    return *_captureEncoder;
+}
+
+const FrameTelemetry& Engine::telemetry() const {
+    return *_telemetry;
+}
+
 float Engine::nearClipPlane() const {
     return _nearClipPlane;
 }
@@ -1114,6 +1289,10 @@ StatisticsRenderer* Engine::statisticsRenderer() {
     return _statisticsRenderer.get();
 }
 
+GpuTimer& Engine::gpuTimer() {
+    return _gpuTimer;
+}
+
 const Engine::Settings& Engine::settings() const {
     return _settings;
 }
@@ -141,7 +141,7 @@ bool FontManager::addFont(std::string name, std::string file) {
 
     const bool inserted = _fontPaths.insert({ name, std::move(file) }).second;
     if (!inserted) {
-        Log::Warning(std::format("Font with name '{}' already exists", name));
+        Log::Warning("Font with name '{}' already exists", name);
     }
     return inserted;
 }
@@ -162,14 +162,14 @@ std::unique_ptr<Font> FontManager::createFont(const std::string& name, int heigh
     const auto it = _fontPaths.find(name);
 
     if (it == _fontPaths.end()) {
-        Log::Error(std::format("No font file specified for font '{}'", name));
+        Log::Error("No font file specified for font '{}'", name);
         return nullptr;
     }
 
     if (_library == nullptr) {
-        Log::Error(std::format(
+        Log::Error(
             "Freetype library is not initialized, cannot create font '{}'", name
-        ));
+        );
         return nullptr;
     }
 
@@ -177,19 +177,19 @@ std::unique_ptr<Font> FontManager::createFont(const std::string& name, int heigh
     const FT_Error error = FT_New_Face(_library, it->second.c_str(), 0, &face);
 
     if (error == FT_Err_Unknown_File_Format) {
-        Log::Error(std::format(
+        Log::Error(
             "Unsupported file format '{}' for font '{}'", it->second, name
-        ));
+        );
         return nullptr;
     }
     else if (error != 0 || face == nullptr) {
-        Log::Error(std::format("Font '{}' not found", it->second));
+        Log::Error("Font '{}' not found", it->second);
         return nullptr;
     }
 
     const FT_Error charSizeErr = FT_Set_Char_Size(face, height << 6, height << 6, 96, 96);
     if (charSizeErr != 0) {
-        Log::Error(std::format("Could not set pixel size for font '{}'", name));
+        Log::Error("Could not set pixel size for font '{}'", name);
         return nullptr;
     }
 
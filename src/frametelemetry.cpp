@@ -0,0 +1,480 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/frametelemetry.h>
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#define Err(code, msg) Error(Error::Component::Engine, code, msg)
+
+namespace {
+    constexpr std::string_view Magic = std::string_view("SGCTTEL\0", 8);
+    constexpr uint32_t Version = 1;
+
+    constexpr size_t HeaderSize = 8 + 4 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+    // The number of records written is the last value of the header
+    constexpr size_t CountOffset = HeaderSize - sizeof(uint64_t);
+    constexpr size_t RecordSize =
+        sizeof(uint64_t) + sizeof(double) +
+        sgct::FrameTelemetry::NumberOfPhases * sizeof(float);
+
+    // The durations are binned in microseconds. Values below 2 * SubBuckets are exact,
+    // every larger power of two is split into SubBuckets buckets of equal width, so the
+    // center of a bucket is at most 1 / (2 * SubBuckets) away from any value in it
+    constexpr int SubBucketBits = 4;
+    constexpr uint64_t SubBuckets = 1 << SubBucketBits;
+    // The last bucket collects all durations longer than 2^36 us, about 19 hours
+    constexpr int MaxExponent = 36;
+    constexpr size_t NumberOfBuckets =
+        2 * SubBuckets + (MaxExponent - SubBucketBits) * SubBuckets;
+
+    size_t bucketIndex(double duration) {
+        const uint64_t us = static_cast<uint64_t>(std::llround(
+            std::clamp(duration * 1e6, 0.0, std::ldexp(1.0, MaxExponent + 1))
+        ));
+        if (us < 2 * SubBuckets) {
+            return us;
+        }
+        const int exponent = std::bit_width(us) - 1;
+        const uint64_t mantissa = (us >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+        const size_t index =
+            2 * SubBuckets + (exponent - SubBucketBits - 1) * SubBuckets + mantissa;
+        return std::min(index, NumberOfBuckets - 1);
+    }
+
+    double bucketValue(size_t index) {
+        if (index < 2 * SubBuckets) {
+            return static_cast<double>(index) * 1e-6;
+        }
+        const size_t i = index - 2 * SubBuckets;
+        const int shift = static_cast<int>(i / SubBuckets) + 1;
+        const uint64_t lower = (SubBuckets + i % SubBuckets) << shift;
+        const uint64_t width = uint64_t(1) << shift;
+        return (static_cast<double>(lower) + static_cast<double>(width) / 2.0) * 1e-6;
+    }
+
+    template <typename T>
+    void put(unsigned char*& p, T value) {
+        std::memcpy(p, &value, sizeof(T));
+        p += sizeof(T);
+    }
+
+    template <typename T>
+    T get(const unsigned char*& p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return value;
+    }
+
+    bool seek(FILE* file, int64_t offset) {
+#ifdef WIN32
+        return _fseeki64(file, offset, SEEK_SET) == 0;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        return fseeko(file, static_cast<off_t>(offset), SEEK_SET) == 0;
+#endif // WIN32
+    }
+} // namespace
+
+namespace sgct {
+
+struct FrameTelemetry::Slice {
+    using Histogram = std::array<std::atomic<uint32_t>, NumberOfBuckets>;
+
+    /// The index of the time slice whose samples this slice contains, or -1 while the
+    /// slice is being cleared
+    std::atomic<int64_t> index = -1;
+    std::array<Histogram, NumberOfPhases> counts;
+    std::array<std::atomic<double>, NumberOfPhases> max;
+};
+
+/**
+ * Writes the samples into the ring file on a separate thread. The samples are passed
+ * from the thread that adds them to the writing thread through a single-producer,
+ * single-consumer queue, which is drained a few times per second.
+ */
+class FrameTelemetry::Recorder {
+public:
+    Recorder(const std::filesystem::path& path, uint64_t capacity, uint32_t nodeIndex);
+    ~Recorder();
+
+    void push(const Sample& sample);
+    uint64_t nDropped() const;
+
+private:
+    static constexpr uint64_t QueueSize = 1024;
+    static constexpr std::chrono::milliseconds WriteInterval =
+        std::chrono::milliseconds(100);
+
+    void worker();
+    void write();
+
+    std::array<Sample, QueueSize> _queue;
+    std::atomic<uint64_t> _head = 0;
+    std::atomic<uint64_t> _tail = 0;
+    std::atomic<uint64_t> _nDropped = 0;
+
+    const std::filesystem::path _path;
+    const uint64_t _capacity;
+    FILE* _file = nullptr;
+    uint64_t _nWritten = 0;
+    bool _hasFailed = false;
+    std::vector<unsigned char> _buffer;
+
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    bool _shouldTerminate = false;
+    std::thread _thread;
+};
+
+FrameTelemetry::Recorder::Recorder(const std::filesystem::path& path, uint64_t capacity,
+                                   uint32_t nodeIndex)
+    : _path(path)
+    , _capacity(std::max<uint64_t>(capacity, 1))
+{
+    std::string f = path.string();
+    _file = fopen(f.c_str(), "wb");
+    if (_file == nullptr) {
+        throw Err(3020, std::format("Cannot create telemetry file '{}'", path));
+    }
+
+    std::array<unsigned char, HeaderSize> header;
+    std::memcpy(header.data(), Magic.data(), Magic.size());
+    unsigned char* p = header.data() + Magic.size();
+    put(p, Version);
+    put(p, static_cast<uint32_t>(NumberOfPhases));
+    put(p, static_cast<uint32_t>(RecordSize));
+    put(p, nodeIndex);
+    put(p, _capacity);
+    put(p, _nWritten);
+    if (fwrite(header.data(), 1, header.size(), _file) != header.size() ||
+        fflush(_file) != 0)
+    {
+        fclose(_file);
+        throw Err(
+            3021, std::format("Failed to write header of telemetry file '{}'", path)
+        );
+    }
+
+    _thread = std::thread([this]() { worker(); });
+    Log::Info("Recording frame telemetry into '{}'", path);
+}
+
+FrameTelemetry::Recorder::~Recorder() {
+    {
+        const std::unique_lock lock(_mutex);
+        _shouldTerminate = true;
+    }
+    _cond.notify_one();
+    _thread.join();
+    fclose(_file);
+}
+
+void FrameTelemetry::Recorder::push(const Sample& sample) {
+    const uint64_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) == QueueSize) {
+        _nDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    _queue[head % QueueSize] = sample;
+    _head.store(head + 1, std::memory_order_release);
+}
+
+uint64_t FrameTelemetry::Recorder::nDropped() const {
+    return _nDropped.load(std::memory_order_relaxed);
+}
+
+void FrameTelemetry::Recorder::worker() {
+    while (true) {
+        bool shouldTerminate = false;
+        {
+            std::unique_lock lock(_mutex);
+            _cond.wait_for(lock, WriteInterval, [this]() { return _shouldTerminate; });
+            shouldTerminate = _shouldTerminate;
+        }
+
+        // Write the remaining samples before terminating
+        write();
+        if (shouldTerminate) {
+            return;
+        }
+    }
+}
+
+void FrameTelemetry::Recorder::write() {
+    ZoneScoped;
+
+    const uint64_t tail = _tail.load(std::memory_order_relaxed);
+    const uint64_t head = _head.load(std::memory_order_acquire);
+    if (head == tail) {
+        return;
+    }
+
+    _buffer.resize((head - tail) * RecordSize);
+    unsigned char* p = _buffer.data();
+    for (uint64_t i = tail; i < head; i++) {
+        const Sample& sample = _queue[i % QueueSize];
+        put(p, sample.frameNumber);
+        put(p, sample.timestamp);
+        for (double duration : sample.durations) {
+            put(p, static_cast<float>(duration));
+        }
+    }
+    // The samples have been copied, so their slots can be reused
+    _tail.store(head, std::memory_order_release);
+
+    if (_hasFailed) {
+        return;
+    }
+
+    // The records are written in at most two runs, as the ring wraps around at most
+    // once within a batch that is smaller than the capacity
+    const uint64_t nRecords = head - tail;
+    const uint64_t nSkipped = nRecords > _capacity ? nRecords - _capacity : 0;
+    uint64_t first = _nWritten + nSkipped;
+    const uint64_t end = _nWritten + nRecords;
+    bool success = true;
+    while (success && first < end) {
+        const uint64_t slot = first % _capacity;
+        const uint64_t n = std::min(end - first, _capacity - slot);
+        const unsigned char* data = _buffer.data() + (first - _nWritten) * RecordSize;
+        success =
+            seek(_file, static_cast<int64_t>(HeaderSize + slot * RecordSize)) &&
+            fwrite(data, RecordSize, n, _file) == n;
+        first += n;
+    }
+
+    // Only count the records once they are in the file
+    success = success && fflush(_file) == 0;
+    std::array<unsigned char, sizeof(uint64_t)> count;
+    unsigned char* c = count.data();
+    put(c, end);
+    success =
+        success && seek(_file, CountOffset) &&
+        fwrite(count.data(), 1, count.size(), _file) == count.size() &&
+        fflush(_file) == 0;
+
+    if (!success) {
+        Log::Error(
+            "Failed to write telemetry file '{}'. Stopping the recording", _path
+        );
+        _hasFailed = true;
+        return;
+    }
+    _nWritten = end;
+}
+
+FrameTelemetry::FrameTelemetry(double window)
+    : _sliceLength(window / NumberOfSlices)
+    , _slices(std::make_unique<Slice[]>(NumberOfSlices))
+{}
+
+FrameTelemetry::~FrameTelemetry() = default;
+
+void FrameTelemetry::startRecording(const std::filesystem::path& path,
+                                    uint64_t capacity, uint32_t nodeIndex)
+{
+    // Destroy the previous recorder first so that it finishes writing its file
+    _recorder = nullptr;
+    _recorder = std::make_unique<Recorder>(path, capacity, nodeIndex);
+}
+
+void FrameTelemetry::add(const Sample& sample) {
+    ZoneScoped;
+
+    const int64_t index =
+        static_cast<int64_t>(std::floor(sample.timestamp / _sliceLength));
+    Slice& slice = _slices[((index % NumberOfSlices) + NumberOfSlices) % NumberOfSlices];
+    if (slice.index.load(std::memory_order_relaxed) != index) {
+        // The slice contains samples from an earlier pass through the ring. Readers skip
+        // the slice while its index is -1 or when the index changes during their read
+        slice.index.store(-1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int p = 0; p < NumberOfPhases; p++) {
+            for (std::atomic<uint32_t>& count : slice.counts[p]) {
+                count.store(0, std::memory_order_relaxed);
+            }
+            slice.max[p].store(0.0, std::memory_order_relaxed);
+        }
+        slice.index.store(index, std::memory_order_release);
+    }
+
+    // This is the only thread that writes the counters, so there is no need for an
+    // atomic read-modify-write operation
+    for (int p = 0; p < NumberOfPhases; p++) {
+        const double duration = sample.durations[p];
+        std::atomic<uint32_t>& count = slice.counts[p][bucketIndex(duration)];
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (duration > slice.max[p].load(std::memory_order_relaxed)) {
+            slice.max[p].store(duration, std::memory_order_relaxed);
+        }
+    }
+
+    if (index > _currentSlice.load(std::memory_order_relaxed)) {
+        _currentSlice.store(index, std::memory_order_release);
+    }
+
+    if (_recorder) {
+        _recorder->push(sample);
+    }
+}
+
+FrameTelemetry::Percentiles FrameTelemetry::percentiles(Phase phase) const {
+    ZoneScoped;
+
+    const int p = static_cast<int>(phase);
+    const int64_t current = _currentSlice.load(std::memory_order_acquire);
+
+    std::array<uint64_t, NumberOfBuckets> counts = {};
+    std::array<uint64_t, NumberOfBuckets> sliceCounts;
+    Percentiles res;
+    for (int s = 0; s < NumberOfSlices; s++) {
+        const Slice& slice = _slices[s];
+        const int64_t index = slice.index.load(std::memory_order_acquire);
+        if (index < 0 || index <= current - NumberOfSlices) {
+            continue;
+        }
+
+        for (size_t i = 0; i < NumberOfBuckets; i++) {
+            sliceCounts[i] = slice.counts[p][i].load(std::memory_order_relaxed);
+        }
+        const double max = slice.max[p].load(std::memory_order_relaxed);
+
+        // If the slice was recycled while it was read, the values are a mixture of old
+        // and new samples and are ignored
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slice.index.load(std::memory_order_relaxed) != index) {
+            continue;
+        }
+
+        for (size_t i = 0; i < NumberOfBuckets; i++) {
+            counts[i] += sliceCounts[i];
+            res.nFrames += sliceCounts[i];
+        }
+        res.max = std::max(res.max, max);
+    }
+
+    if (res.nFrames == 0) {
+        return res;
+    }
+
+    auto percentile = [&](double fraction) {
+        const uint64_t rank = std::max<uint64_t>(
+            static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(res.nFrames))),
+            1
+        );
+        uint64_t sum = 0;
+        for (size_t i = 0; i < NumberOfBuckets; i++) {
+            sum += counts[i];
+            if (sum >= rank) {
+                return std::min(bucketValue(i), res.max);
+            }
+        }
+        return res.max;
+    };
+    res.p50 = percentile(0.5);
+    res.p95 = percentile(0.95);
+    res.p99 = percentile(0.99);
+    return res;
+}
+
+uint64_t FrameTelemetry::nDroppedSamples() const {
+    return _recorder ? _recorder->nDropped() : 0;
+}
+
+std::string_view FrameTelemetry::name(Phase phase) {
+    switch (phase) {
+        case Phase::PreSync: return "Pre-sync";
+        case Phase::Encode: return "Encode";
+        case Phase::NetworkWait: return "Network wait";
+        case Phase::Draw: return "Draw";
+        case Phase::PostDraw: return "Post-draw";
+        case Phase::Swap: return "Swap";
+        case Phase::Frame: return "Frame";
+        default: throw std::logic_error("Unhandled case label");
+    }
+}
+
+FrameTelemetry::Recording FrameTelemetry::readRecording(
+                                                      const std::filesystem::path& path)
+{
+    ZoneScoped;
+
+    std::string f = path.string();
+    FILE* file = fopen(f.c_str(), "rb");
+    if (file == nullptr) {
+        throw Err(3022, std::format("Cannot open telemetry file '{}'", path));
+    }
+
+    std::array<unsigned char, HeaderSize> header;
+    if (fread(header.data(), 1, header.size(), file) != header.size() ||
+        std::memcmp(header.data(), Magic.data(), Magic.size()) != 0)
+    {
+        fclose(file);
+        throw Err(3023, std::format("'{}' is not a telemetry file", path));
+    }
+    const unsigned char* p = header.data() + Magic.size();
+    const uint32_t version = get<uint32_t>(p);
+    const uint32_t nPhases = get<uint32_t>(p);
+    const uint32_t recordSize = get<uint32_t>(p);
+    Recording recording;
+    recording.nodeIndex = get<uint32_t>(p);
+    const uint64_t capacity = get<uint64_t>(p);
+    const uint64_t nWritten = get<uint64_t>(p);
+    if (version != Version) {
+        fclose(file);
+        throw Err(
+            3024,
+            std::format("Unsupported version {} of telemetry file '{}'", version, path)
+        );
+    }
+    if (capacity == 0 ||
+        recordSize < sizeof(uint64_t) + sizeof(double) + nPhases * sizeof(float))
+    {
+        fclose(file);
+        throw Err(3023, std::format("'{}' is not a telemetry file", path));
+    }
+
+    // Once the ring is full, the oldest record follows the newest one
+    const uint64_t nRecords = std::min(nWritten, capacity);
+    std::vector<unsigned char> records(nRecords * recordSize);
+    if (fread(records.data(), 1, records.size(), file) != records.size()) {
+        fclose(file);
+        throw Err(3025, std::format("Failed to read records of '{}'", path));
+    }
+    fclose(file);
+
+    // Phases that were added in later versions are ignored
+    const uint32_t nStored = std::min<uint32_t>(nPhases, NumberOfPhases);
+    recording.samples.resize(nRecords);
+    for (uint64_t i = 0; i < nRecords; i++) {
+        const uint64_t slot = (nWritten - nRecords + i) % capacity;
+        p = records.data() + slot * recordSize;
+        Sample& sample = recording.samples[i];
+        sample.frameNumber = get<uint64_t>(p);
+        sample.timestamp = get<double>(p);
+        for (uint32_t j = 0; j < nStored; j++) {
+            sample.durations[j] = get<float>(p);
+        }
+    }
+    return recording;
+}
+
+} // namespace sgct
@@ -0,0 +1,137 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/gputimer.h>
+
+#include <sgct/format.h>
+#include <sgct/opengl.h>
+#include <sgct/profiling.h>
+#include <cassert>
+
+namespace sgct {
+
+GpuTimer::Scope::Scope(GpuTimer& timer, const char* name, int index)
+    : _timer(timer)
+{
+    _timer.begin(name, index);
+}
+
+GpuTimer::Scope::~Scope() {
+    _timer.end();
+}
+
+bool GpuTimer::beginFrame() {
+    ZoneScoped;
+
+    assert(!_isRecording);
+    _currentFrame = (_currentFrame + 1) % Latency;
+    Frame& frame = _frames[_currentFrame];
+    _isRecording = true;
+
+    if (frame.nQueries == 0) {
+        return false;
+    }
+
+    // The timestamps are written in the order in which they were issued, so all results
+    // are available once the last one is
+    GLint isAvailable = GL_FALSE;
+    glGetQueryObjectiv(frame.lastQuery, GL_QUERY_RESULT_AVAILABLE, &isAvailable);
+    if (!isAvailable) {
+        _nSkippedFrames++;
+        frame.nQueries = 0;
+        return false;
+    }
+
+    _zones.resize(frame.nQueries);
+    for (size_t i = 0; i < frame.nQueries; i++) {
+        const Query& q = frame.queries[i];
+        GLuint64 begin = 0;
+        glGetQueryObjectui64v(q.begin, GL_QUERY_RESULT, &begin);
+        GLuint64 end = 0;
+        glGetQueryObjectui64v(q.end, GL_QUERY_RESULT, &end);
+
+        Zone& zone = _zones[i];
+        if (q.index >= 0) {
+            zone.name = std::format("{} {}", q.name, q.index);
+        }
+        else {
+            zone.name = q.name;
+        }
+        zone.depth = q.depth;
+        zone.duration = end > begin ? static_cast<double>(end - begin) / 1e9 : 0.0;
+    }
+    frame.nQueries = 0;
+    return true;
+}
+
+void GpuTimer::endFrame() {
+    assert(_openZones.empty());
+    _isRecording = false;
+}
+
+bool GpuTimer::isRecording() const {
+    return _isRecording;
+}
+
+void GpuTimer::begin(const char* name, int index) {
+    if (!_isRecording) {
+        return;
+    }
+
+    Frame& frame = _frames[_currentFrame];
+    if (frame.nQueries == frame.queries.size()) {
+        Query q;
+        glGenQueries(1, &q.begin);
+        glGenQueries(1, &q.end);
+        frame.queries.push_back(q);
+    }
+
+    Query& q = frame.queries[frame.nQueries];
+    q.name = name;
+    q.index = index;
+    q.depth = static_cast<int>(_openZones.size());
+    glQueryCounter(q.begin, GL_TIMESTAMP);
+    frame.lastQuery = q.begin;
+
+    _openZones.push_back(frame.nQueries);
+    frame.nQueries++;
+}
+
+void GpuTimer::end() {
+    if (!_isRecording) {
+        return;
+    }
+
+    assert(!_openZones.empty());
+    Frame& frame = _frames[_currentFrame];
+    const Query& q = frame.queries[_openZones.back()];
+    glQueryCounter(q.end, GL_TIMESTAMP);
+    frame.lastQuery = q.end;
+    _openZones.pop_back();
+}
+
+const std::vector<GpuTimer::Zone>& GpuTimer::zones() const {
+    return _zones;
+}
+
+uint64_t GpuTimer::nSkippedFrames() const {
+    return _nSkippedFrames;
+}
+
+void GpuTimer::deleteQueries() {
+    for (Frame& frame : _frames) {
+        for (const Query& q : frame.queries) {
+            glDeleteQueries(1, &q.begin);
+            glDeleteQueries(1, &q.end);
+        }
+        frame.queries.clear();
+        frame.nQueries = 0;
+    }
+}
+
+} // namespace sgct
@@ -12,11 +12,20 @@
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
+#include <sgct/pixelops.h>
 #include <png.h>
 #include <zlib.h>
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
 #include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
 
 #ifdef WIN32
 #include <CodeAnalysis/warnings.h>
@@ -64,6 +73,570 @@ namespace {
 
 namespace sgct {
 
+namespace {
+    // The stdio buffer of the output file. Larger than the default so that a frame is
+    // written to disk in fewer system calls
+    constexpr size_t FileBufferSize = 1 << 20;
+
+    void writePng(FILE* fp, const Image& image, bool fast) {
+        // initialize stuff
+        png_structp png = png_create_write_struct(
+            PNG_LIBPNG_VER_STRING,
+            nullptr,
+            nullptr,
+            nullptr
+        );
+        if (!png) {
+            throw Err(9009, "Failed to create PNG struct");
+        }
+
+        // Compression levels 1-9.
+        //   -1 = Default compression
+        //    0 = No compression
+        //    1 = Best speed
+        //    9 = Best compression
+        // The fast path only looks for runs of identical bytes. The Up filter turns areas
+        // that are repeated from the previous row into runs of zeros, without it the runs
+        // would be broken up by the interleaved color channels
+        png_set_compression_level(png, fast ? 1 : -1);
+        png_set_filter(png, 0, fast ? PNG_FILTER_UP : PNG_FILTER_NONE);
+        png_set_compression_mem_level(png, fast ? 9 : 8);
+        png_set_compression_strategy(png, fast ? Z_RLE : Z_DEFAULT_STRATEGY);
+        png_set_compression_window_bits(png, 15);
+        png_set_compression_method(png, 8);
+        png_set_compression_buffer_size(png, fast ? FileBufferSize : 8192);
+
+        png_infop info = png_create_info_struct(png);
+        if (!info) {
+            png_destroy_write_struct(&png, nullptr);
+            throw Err(9010, "Failed to create PNG info struct");
+        }
+
+        if (setjmp(png_jmpbuf(png))) {
+            png_destroy_write_struct(&png, &info);
+            throw Err(9011, "One of the called PNG functions failed");
+        }
+
+        png_init_io(png, fp);
+
+        const int colorType = [](int channels) {
+            switch (channels) {
+                case 1: return PNG_COLOR_TYPE_GRAY;
+                case 2: return PNG_COLOR_TYPE_GRAY_ALPHA;
+                case 3: return PNG_COLOR_TYPE_RGB;
+                case 4: return PNG_COLOR_TYPE_RGB_ALPHA;
+                default: throw std::logic_error("Unhandled case label");
+            }
+        }(image.channels());
+
+        const ivec2 size = image.size();
+        const int bpc = image.bytesPerChannel();
+
+        // write header
+        png_set_IHDR(
+            png,
+            info,
+            size.x,
+            size.y,
+            bpc * 8,
+            colorType,
+            PNG_INTERLACE_NONE,
+            PNG_COMPRESSION_TYPE_BASE,
+            PNG_FILTER_TYPE_BASE
+        );
+
+        if (colorType == PNG_COLOR_TYPE_RGB || colorType == PNG_COLOR_TYPE_RGB_ALPHA) {
+            png_set_bgr(png);
+        }
+        png_write_info(png, info);
+
+        // swap big-endian to little endian
+        if (bpc == 2) {
+            png_set_swap(png);
+        }
+
+        // libPNG doesn't modify the pixel data, it just doesn't know about const
+        unsigned char* data = const_cast<unsigned char*>(image.data());
+        std::vector<png_bytep> rowPtrs(size.y);
+        for (int y = 0; y < size.y; y++) {
+            const size_t idx = static_cast<size_t>(size.y) - 1 - static_cast<size_t>(y);
+            rowPtrs[idx] = &data[y * size.x * image.channels() * bpc];
+        }
+        png_write_image(png, rowPtrs.data());
+        rowPtrs.clear();
+
+        png_write_end(png, nullptr);
+        png_destroy_write_struct(&png, &info);
+    }
+
+    void writePngChunk(FILE* fp, std::string_view type, const unsigned char* data,
+                       size_t length)
+    {
+        std::array<unsigned char, 8> header = {
+            static_cast<unsigned char>((length >> 24) & 0xFF),
+            static_cast<unsigned char>((length >> 16) & 0xFF),
+            static_cast<unsigned char>((length >> 8) & 0xFF),
+            static_cast<unsigned char>(length & 0xFF),
+            static_cast<unsigned char>(type[0]),
+            static_cast<unsigned char>(type[1]),
+            static_cast<unsigned char>(type[2]),
+            static_cast<unsigned char>(type[3])
+        };
+
+        // The CRC covers the chunk type and the data, but not the length
+        uLong crc = crc32(0, header.data() + 4, 4);
+        if (length > 0) {
+            crc = crc32(crc, data, static_cast<uInt>(length));
+        }
+        const std::array<unsigned char, 4> footer = {
+            static_cast<unsigned char>((crc >> 24) & 0xFF),
+            static_cast<unsigned char>((crc >> 16) & 0xFF),
+            static_cast<unsigned char>((crc >> 8) & 0xFF),
+            static_cast<unsigned char>(crc & 0xFF)
+        };
+
+        if (fwrite(header.data(), 1, header.size(), fp) != header.size() ||
+            (length > 0 && fwrite(data, 1, length, fp) != length) ||
+            fwrite(footer.data(), 1, footer.size(), fp) != footer.size())
+        {
+            throw Err(9019, std::format("Failed to write PNG chunk {}", type));
+        }
+    }
+
+    // Compresses the `length` bytes at `in` into `out`, starting at the current end of
+    // the stream, and grows `out` if necessary
+    void deflateInto(z_stream& stream, std::vector<unsigned char>& out,
+                     unsigned char* in, size_t length, int flush)
+    {
+        stream.next_in = in;
+        stream.avail_in = static_cast<uInt>(length);
+        do {
+            if (stream.total_out == out.size()) {
+                out.resize(std::max<size_t>(out.size() * 2, 1 << 16));
+            }
+            stream.next_out = out.data() + stream.total_out;
+            stream.avail_out = static_cast<uInt>(out.size() - stream.total_out);
+            deflate(&stream, flush);
+        } while (stream.avail_out == 0);
+    }
+
+    // Writes a PNG like writePng does, but splits the image into horizontal stripes that
+    // are filtered and compressed on separate threads. Every stripe but the last one ends
+    // with a sync flush, which pads the deflate stream to a byte boundary, so that the
+    // compressed stripes can be concatenated into a single valid zlib stream. This is the
+    // same approach that pigz uses. At most `nThreads` threads are used, or all cores if
+    // it is 0
+    void writeParallelPng(FILE* fp, const Image& image, int nThreads) {
+        const int nChannels = image.channels();
+        const int bpc = image.bytesPerChannel();
+        const ivec2 size = image.size();
+        const size_t pixelSize = static_cast<size_t>(nChannels) * bpc;
+        const size_t rowSize = static_cast<size_t>(size.x) * pixelSize;
+
+        const int colorType = [](int channels) {
+            switch (channels) {
+                case 1: return PNG_COLOR_TYPE_GRAY;
+                case 2: return PNG_COLOR_TYPE_GRAY_ALPHA;
+                case 3: return PNG_COLOR_TYPE_RGB;
+                case 4: return PNG_COLOR_TYPE_RGB_ALPHA;
+                default: throw std::logic_error("Unhandled case label");
+            }
+        }(nChannels);
+
+        // Each stripe has to be large enough that the compression does not suffer too
+        // much from starting without a history of previous rows
+        constexpr int MinRowsPerStripe = 64;
+        if (nThreads <= 0) {
+            nThreads =
+                static_cast<int>(std::max(std::thread::hardware_concurrency(), 1u));
+        }
+        const int nStripes = std::clamp(size.y / MinRowsPerStripe, 1, nThreads);
+
+        struct Stripe {
+            std::vector<unsigned char> data;
+            /// The Adler-32 checksum of the uncompressed (filtered) stripe
+            uLong adler = 0;
+            /// The number of uncompressed bytes in the stripe
+            size_t length = 0;
+            bool success = false;
+        };
+        std::vector<Stripe> stripes(nStripes);
+
+        // PNG stores the rows top to bottom, the colors in RGB(A) order, and 16 bit
+        // values in big endian, whereas our image is bottom to top, BGR(A), and little
+        // endian
+        auto convertRow = [&](int y, unsigned char* dst) {
+            const unsigned char* src =
+                image.data() + static_cast<size_t>(size.y - 1 - y) * rowSize;
+            if (bpc == 1 && nChannels < 3) {
+                std::memcpy(dst, src, rowSize);
+                return;
+            }
+            if (bpc == 1) {
+                pixelops::swapRedBlue(src, dst, size.x, nChannels);
+                return;
+            }
+            if (bpc == 2 && nChannels < 3) {
+                pixelops::swapBytes16(src, dst, static_cast<size_t>(size.x) * nChannels);
+                return;
+            }
+            for (int x = 0; x < size.x; x++) {
+                const unsigned char* srcPixel = src + x * pixelSize;
+                unsigned char* dstPixel = dst + x * pixelSize;
+                for (int c = 0; c < nChannels; c++) {
+                    const int srcChannel = (nChannels >= 3 && c < 3) ? 2 - c : c;
+                    for (int b = 0; b < bpc; b++) {
+                        dstPixel[c * bpc + b] = srcPixel[srcChannel * bpc + bpc - 1 - b];
+                    }
+                }
+            }
+        };
+
+        auto compressStripe = [&](int i) {
+            Stripe& stripe = stripes[i];
+            const int y0 = static_cast<int>(static_cast<int64_t>(size.y) * i / nStripes);
+            const int y1 =
+                static_cast<int>(static_cast<int64_t>(size.y) * (i + 1) / nStripes);
+            const bool isLast = i == nStripes - 1;
+
+            // A raw deflate stream without the zlib header and checksum as those are only
+            // written once for the whole image
+            z_stream stream = {};
+            const int res = deflateInit2(
+                &stream,
+                Z_DEFAULT_COMPRESSION,
+                Z_DEFLATED,
+                -15,
+                8,
+                Z_DEFAULT_STRATEGY
+            );
+            if (res != Z_OK) {
+                return;
+            }
+
+            stripe.length = static_cast<size_t>(y1 - y0) * (rowSize + 1);
+            stripe.data.resize(deflateBound(&stream, static_cast<uLong>(stripe.length)));
+            stripe.adler = adler32(0, nullptr, 0);
+
+            // Every row is stored as the difference to the row above (the Up filter). The
+            // row above the first row of a stripe belongs to the previous stripe
+            std::vector<unsigned char> prev(rowSize, 0);
+            std::vector<unsigned char> curr(rowSize);
+            std::vector<unsigned char> filtered(rowSize + 1);
+            if (y0 > 0) {
+                convertRow(y0 - 1, prev.data());
+            }
+            for (int y = y0; y < y1; y++) {
+                convertRow(y, curr.data());
+                filtered[0] = 2;
+                for (size_t j = 0; j < rowSize; j++) {
+                    filtered[j + 1] = static_cast<unsigned char>(curr[j] - prev[j]);
+                }
+                std::swap(prev, curr);
+
+                stripe.adler = adler32(
+                    stripe.adler,
+                    filtered.data(),
+                    static_cast<uInt>(filtered.size())
+                );
+                const int flush =
+                    y < y1 - 1 ? Z_NO_FLUSH : (isLast ? Z_FINISH : Z_SYNC_FLUSH);
+                deflateInto(stream, stripe.data, filtered.data(), filtered.size(), flush);
+            }
+
+            stripe.data.resize(stream.total_out);
+            deflateEnd(&stream);
+            stripe.success = true;
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(nStripes - 1);
+        for (int i = 1; i < nStripes; i++) {
+            threads.emplace_back(compressStripe, i);
+        }
+        compressStripe(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        if (std::any_of(
+                stripes.cbegin(),
+                stripes.cend(),
+                [](const Stripe& s) { return !s.success; }
+            ))
+        {
+            throw Err(9020, "Failed to compress PNG data");
+        }
+
+        // The zlib header for the default compression level and a 32K window, followed by
+        // the stripes and the checksum of the entire uncompressed data
+        stripes.front().data.insert(stripes.front().data.begin(), { 0x78, 0x9C });
+        uLong adler = stripes.front().adler;
+        for (int i = 1; i < nStripes; i++) {
+            adler = adler32_combine(
+                adler,
+                stripes[i].adler,
+                static_cast<z_off_t>(stripes[i].length)
+            );
+        }
+        stripes.back().data.insert(
+            stripes.back().data.end(),
+            {
+                static_cast<unsigned char>((adler >> 24) & 0xFF),
+                static_cast<unsigned char>((adler >> 16) & 0xFF),
+                static_cast<unsigned char>((adler >> 8) & 0xFF),
+                static_cast<unsigned char>(adler & 0xFF)
+            }
+        );
+
+        constexpr std::array<unsigned char, 8> Signature = {
+            0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'
+        };
+        if (fwrite(Signature.data(), 1, Signature.size(), fp) != Signature.size()) {
+            throw Err(9019, "Failed to write PNG signature");
+        }
+
+        const std::array<unsigned char, 13> header = {
+            static_cast<unsigned char>((size.x >> 24) & 0xFF),
+            static_cast<unsigned char>((size.x >> 16) & 0xFF),
+            static_cast<unsigned char>((size.x >> 8) & 0xFF),
+            static_cast<unsigned char>(size.x & 0xFF),
+            static_cast<unsigned char>((size.y >> 24) & 0xFF),
+            static_cast<unsigned char>((size.y >> 16) & 0xFF),
+            static_cast<unsigned char>((size.y >> 8) & 0xFF),
+            static_cast<unsigned char>(size.y & 0xFF),
+            static_cast<unsigned char>(bpc * 8),
+            static_cast<unsigned char>(colorType),
+            PNG_COMPRESSION_TYPE_BASE,
+            PNG_FILTER_TYPE_BASE,
+            PNG_INTERLACE_NONE
+        };
+        writePngChunk(fp, "IHDR", header.data(), header.size());
+
+        // The concatenation of all IDAT chunks forms the zlib stream, so every stripe can
+        // be written as its own chunk
+        for (const Stripe& stripe : stripes) {
+            writePngChunk(fp, "IDAT", stripe.data.data(), stripe.data.size());
+        }
+        writePngChunk(fp, "IEND", nullptr, 0);
+    }
+
+    void writeTga(FILE* fp, const Image& image) {
+        const int nChannels = image.channels();
+        const ivec2 size = image.size();
+        if (image.bytesPerChannel() != 1 || nChannels == 2) {
+            throw Err(
+                9013,
+                std::format(
+                    "Cannot save {} bit image with {} channels as TGA",
+                    image.bytesPerChannel() * 8, nChannels
+                )
+            );
+        }
+        if (size.x > std::numeric_limits<uint16_t>::max() ||
+            size.y > std::numeric_limits<uint16_t>::max())
+        {
+            throw Err(
+                9014, std::format("Image size {}x{} too large for TGA", size.x, size.y)
+            );
+        }
+
+        // TGA stores the rows bottom to top and the colors in BGR(A) order by default,
+        // which is exactly the layout of our data, so the pixels are written as they are
+        std::array<unsigned char, 18> header = {};
+        header[2] = nChannels == 1 ? 3 : 2; // uncompressed grayscale or true-color
+        header[12] = static_cast<unsigned char>(size.x & 0xFF);
+        header[13] = static_cast<unsigned char>((size.x >> 8) & 0xFF);
+        header[14] = static_cast<unsigned char>(size.y & 0xFF);
+        header[15] = static_cast<unsigned char>((size.y >> 8) & 0xFF);
+        header[16] = static_cast<unsigned char>(nChannels * 8);
+        header[17] = nChannels == 4 ? 8 : 0; // number of alpha bits
+        const size_t dataSize = static_cast<size_t>(size.x) * size.y * nChannels;
+
+        if (fwrite(header.data(), 1, header.size(), fp) != header.size() ||
+            fwrite(image.data(), 1, dataSize, fp) != dataSize)
+        {
+            throw Err(9015, "Failed to write TGA data");
+        }
+    }
+
+    void writeRaw(FILE* fp, const Image& image) {
+        const ivec2 size = image.size();
+        const size_t dataSize = static_cast<size_t>(size.x) * size.y *
+            image.channels() * image.bytesPerChannel();
+        if (fwrite(image.data(), 1, dataSize, fp) != dataSize) {
+            throw Err(9016, "Failed to write raw image data");
+        }
+    }
+
+    void writeQoi(FILE* fp, const Image& image) {
+        // See https://qoiformat.org/qoi-specification.pdf for the description of the
+        // format and the different chunk types
+        const int nChannels = image.channels();
+        const ivec2 size = image.size();
+        if (image.bytesPerChannel() != 1 || (nChannels != 3 && nChannels != 4)) {
+            throw Err(
+                9017,
+                std::format(
+                    "Cannot save {} bit image with {} channels as QOI",
+                    image.bytesPerChannel() * 8, nChannels
+                )
+            );
+        }
+
+        struct Pixel {
+            unsigned char r = 0;
+            unsigned char g = 0;
+            unsigned char b = 0;
+            unsigned char a = 0;
+
+            bool operator==(const Pixel&) const noexcept = default;
+        };
+
+        std::vector<unsigned char> buffer;
+        // The worst case is that every pixel is stored as a separate color chunk
+        buffer.reserve(
+            14 + static_cast<size_t>(size.x) * size.y * (nChannels + 1) + 8
+        );
+        auto push = [&buffer](int v) {
+            buffer.push_back(static_cast<unsigned char>(v));
+        };
+        auto push32 = [&push](uint32_t v) {
+            push(v >> 24);
+            push((v >> 16) & 0xFF);
+            push((v >> 8) & 0xFF);
+            push(v & 0xFF);
+        };
+
+        push('q');
+        push('o');
+        push('i');
+        push('f');
+        push32(static_cast<uint32_t>(size.x));
+        push32(static_cast<uint32_t>(size.y));
+        push(nChannels);
+        push(0); // sRGB with linear alpha
+
+        std::array<Pixel, 64> index = {};
+        Pixel prev = { .r = 0, .g = 0, .b = 0, .a = 255 };
+        int run = 0;
+        // QOI stores the rows top to bottom and the colors in RGB(A) order
+        for (int y = size.y - 1; y >= 0; y--) {
+            const unsigned char* row =
+                image.data() + static_cast<size_t>(y) * size.x * nChannels;
+            for (int x = 0; x < size.x; x++) {
+                const unsigned char* p = row + static_cast<size_t>(x) * nChannels;
+                const Pixel px = {
+                    .r = p[2],
+                    .g = p[1],
+                    .b = p[0],
+                    .a = nChannels == 4 ? p[3] : static_cast<unsigned char>(255)
+                };
+
+                if (px == prev) {
+                    run++;
+                    if (run == 62) {
+                        push(0xC0 | (run - 1));
+                        run = 0;
+                    }
+                    continue;
+                }
+
+                if (run > 0) {
+                    push(0xC0 | (run - 1));
+                    run = 0;
+                }
+
+                const int hash = (px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64;
+                if (index[hash] == px) {
+                    push(hash);
+                }
+                else if (px.a != prev.a) {
+                    index[hash] = px;
+                    push(0xFF);
+                    push(px.r);
+                    push(px.g);
+                    push(px.b);
+                    push(px.a);
+                }
+                else {
+                    index[hash] = px;
+
+                    // The differences wrap around, so 0 - 255 is 1
+                    const int dr = static_cast<int8_t>(px.r - prev.r);
+                    const int dg = static_cast<int8_t>(px.g - prev.g);
+                    const int db = static_cast<int8_t>(px.b - prev.b);
+                    const int dgr = dr - dg;
+                    const int dgb = db - dg;
+
+                    if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 &&
+                        db >= -2 && db <= 1)
+                    {
+                        push(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+                    }
+                    else if (dg >= -32 && dg <= 31 && dgr >= -8 && dgr <= 7 &&
+                             dgb >= -8 && dgb <= 7)
+                    {
+                        push(0x80 | (dg + 32));
+                        push((dgr + 8) << 4 | (dgb + 8));
+                    }
+                    else {
+                        push(0xFE);
+                        push(px.r);
+                        push(px.g);
+                        push(px.b);
+                    }
+                }
+                prev = px;
+            }
+        }
+        if (run > 0) {
+            push(0xC0 | (run - 1));
+        }
+
+        // End marker
+        for (int i = 0; i < 7; i++) {
+            push(0x00);
+        }
+        push(0x01);
+
+        if (fwrite(buffer.data(), 1, buffer.size(), fp) != buffer.size()) {
+            throw Err(9018, "Failed to write QOI data");
+        }
+    }
+
+    // The image libraries provide the rows top to bottom in RGB(A) order, whereas our
+    // images are stored bottom to top in BGR(A) order
+    void convertLoadedData(unsigned char* data, ivec2 size, int nChannels) {
+        if (data == nullptr) {
+            return;
+        }
+
+        const size_t nPixels = static_cast<size_t>(size.x) * size.y;
+        pixelops::flipVertically(data, static_cast<size_t>(size.x) * nChannels, size.y);
+        if (nChannels >= 3) {
+            pixelops::swapRedBlue(data, data, nPixels, nChannels);
+        }
+    }
+} // namespace
+
+std::string_view Image::extension(Format format) {
+    switch (format) {
+        case Format::Png:
+        case Format::FastPng:
+        case Format::ParallelPng:
+            return "png";
+        case Format::Tga:
+            return "tga";
+        case Format::Raw:
+            return "raw";
+        case Format::Qoi:
+            return "qoi";
+        default:
+            throw std::logic_error("Unhandled case label");
+    }
+}
+
 Image::~Image() {
     if (_data) {
         stbi_image_free(_data);
@@ -75,7 +648,6 @@ void Image::load(const std::filesystem::path& filename) {
         throw Err(9000, "Cannot load empty filepath");
     }
 
-    stbi_set_flip_vertically_on_load(1);
     std::string name = filename.string();
     _data = stbi_load(name.c_str(), &_size.x, &_size.y, &_nChannels, 0);
     if (_data == nullptr) {
@@ -85,30 +657,35 @@ void Image::load(const std::filesystem::path& filename) {
     }
     _bytesPerChannel = 1;
     _dataSize = _size.x * _size.y * _nChannels * _bytesPerChannel;
-
-    // Convert BGR to RGB
-    if (_nChannels >= 3) {
-        for (size_t i = 0; i < _dataSize; i += _nChannels) {
-            std::swap(_data[i], _data[i + 2]);
-        }
-    }
+    convertLoadedData(_data, _size, _nChannels);
 }
 
 void Image::load(unsigned char* data, int length) {
-    stbi_set_flip_vertically_on_load(1);
     _data = stbi_load_from_memory(data, length, &_size.x, &_size.y, &_nChannels, 0);
     _bytesPerChannel = 1;
     _dataSize = _size.x * _size.y * _nChannels * _bytesPerChannel;
+    convertLoadedData(_data, _size, _nChannels);
+}
 
-    // Convert BGR to RGB
-    if (_nChannels >= 3) {
-        for (size_t i = 0; i < _dataSize; i += _nChannels) {
-            std::swap(_data[i], _data[i + 2]);
-        }
+void Image::save(const std::filesystem::path& filename) const {
+    const std::string ext = filename.extension().string();
+    if (ext == ".tga" || ext == ".TGA") {
+        save(filename, Format::Tga);
+    }
+    else if (ext == ".raw" || ext == ".RAW") {
+        save(filename, Format::Raw);
+    }
+    else if (ext == ".qoi" || ext == ".QOI") {
+        save(filename, Format::Qoi);
+    }
+    else {
+        save(filename, Format::Png);
     }
 }
 
-void Image::save(const std::filesystem::path& filename) {
+void Image::save(const std::filesystem::path& filename, Format format,
+                 int nThreads) const
+{
     if (filename.empty()) {
         throw Err(9002, "Filename not set for saving image");
     }
@@ -128,92 +705,42 @@ void Image::save(const std::filesystem::path& filename) {
     std::string f = filename.string();
     FILE* fp = fopen(f.c_str(), "wb");
     if (fp == nullptr) {
-        throw Err(9008, std::format("Cannot create PNG file '{}'", filename));
+        throw Err(9008, std::format("Cannot create image file '{}'", filename));
     }
-
-    // initialize stuff
-    png_structp png = png_create_write_struct(
-        PNG_LIBPNG_VER_STRING,
-        nullptr,
-        nullptr,
-        nullptr
-    );
-    if (!png) {
-        throw Err(9009, "Failed to create PNG struct");
-    }
-
-    // Compression levels 1-9.
-    //   -1 = Default compression
-    //    0 = No compression
-    //    1 = Best speed
-    //    9 = Best compression
-    png_set_compression_level(png, -1);
-    png_set_filter(png, 0, PNG_FILTER_NONE);
-    png_set_compression_mem_level(png, 8);
-    png_set_compression_strategy(png, Z_DEFAULT_STRATEGY);
-    png_set_compression_window_bits(png, 15);
-    png_set_compression_method(png, 8);
-    png_set_compression_buffer_size(png, 8192);
-
-    png_infop info = png_create_info_struct(png);
-    if (!info) {
-        throw Err(9010, "Failed to create PNG info struct");
-    }
-
-    if (setjmp(png_jmpbuf(png))) {
-        png_destroy_write_struct(&png, &info);
-        throw Err(9011, "One of the called PNG functions failed");
-    }
-
-    png_init_io(png, fp);
-
-    const int colorType = [](int channels) {
-        switch (channels) {
-            case 1: return PNG_COLOR_TYPE_GRAY;
-            case 2: return PNG_COLOR_TYPE_GRAY_ALPHA;
-            case 3: return PNG_COLOR_TYPE_RGB;
-            case 4: return PNG_COLOR_TYPE_RGB_ALPHA;
-            default: throw std::logic_error("Unhandled case label");
+    setvbuf(fp, nullptr, _IOFBF, FileBufferSize);
+
+    try {
+        switch (format) {
+            case Format::Png:
+                writePng(fp, *this, false);
+                break;
+            case Format::FastPng:
+                writePng(fp, *this, true);
+                break;
+            case Format::ParallelPng:
+                writeParallelPng(fp, *this, nThreads);
+                break;
+            case Format::Tga:
+                writeTga(fp, *this);
+                break;
+            case Format::Raw:
+                writeRaw(fp, *this);
+                break;
+            case Format::Qoi:
+                writeQoi(fp, *this);
+                break;
+            default:
+                throw std::logic_error("Unhandled case label");
         }
-    }(_nChannels);
-
-    // write header
-    png_set_IHDR(
-        png,
-        info,
-        _size.x,
-        _size.y,
-        _bytesPerChannel * 8,
-        colorType,
-        PNG_INTERLACE_NONE,
-        PNG_COMPRESSION_TYPE_BASE,
-        PNG_FILTER_TYPE_BASE
-    );
-
-    if (colorType == PNG_COLOR_TYPE_RGB || colorType == PNG_COLOR_TYPE_RGB_ALPHA) {
-        png_set_bgr(png);
     }
-    png_write_info(png, info);
-
-    // swap big-endian to little endian
-    if (_bytesPerChannel == 2) {
-        png_set_swap(png);
-    }
-
-    std::vector<png_bytep> rowPtrs(_size.y);
-    for (int y = 0; y < _size.y; y++) {
-        const size_t idx = static_cast<size_t>(_size.y) - 1 - static_cast<size_t>(y);
-        rowPtrs[idx] = &_data[y * _size.x * _nChannels * _bytesPerChannel];
+    catch (...) {
+        fclose(fp);
+        throw;
     }
-    png_write_image(png, rowPtrs.data());
-    rowPtrs.clear();
-
-    png_write_end(png, nullptr);
-    png_destroy_write_struct(&png, &info);
     fclose(fp);
 
     const double t = (time() - t0) * 1000.0;
-    Log::Debug(std::format("'{}' was saved successfully ({:.2f} ms)", filename, t));
+    Log::Debug("'{}' was saved successfully ({:.2f} ms)", filename, t);
 }
 
 unsigned char* Image::data() {
@@ -273,10 +800,10 @@ void Image::allocateOrResizeData() {
         _data = new unsigned char[dataSize];
         _dataSize = dataSize;
 
-        Log::Debug(std::format(
+        Log::Debug(
             "Allocated {} bytes for image data ({:.2f} ms)",
             _dataSize, (time() - t0) * 1000.0
-        ));
+        );
     }
 }
 
@@ -8,13 +8,17 @@
 
 #include <sgct/log.h>
 
-#include <sgct/format.h>
-#include <sgct/networkmanager.h>
-#include <sgct/mutexes.h>
-#include <cstdarg>
+#include <sgct/profiling.h>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <ctime>
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
 
 #ifdef WIN32
 #define WIN32_LEAN_AND_MEAN
@@ -37,7 +41,352 @@ namespace {
 
 namespace sgct {
 
+/**
+ * Owns the queue of messages and the thread that writes them. The queue is a bounded
+ * multi-producer, single-consumer ring of entries that each carry a sequence number. A
+ * producer claims the next position with a compare-and-swap and publishes the entry by
+ * advancing its sequence number, the writing thread hands the entry back by advancing it
+ * by the size of the queue. The strings of the entries keep their capacity, so once the
+ * queue has warmed up, logging a message does not allocate memory.
+ */
+class Log::Writer {
+public:
+    Writer();
+    ~Writer();
+
+    /// \return The number of messages that have to be written before this one is
+    uint64_t push(Level level, std::string_view message);
+    uint64_t position() const;
+    void flush(uint64_t position);
+    bool isWriterThread() const;
+
+    void setShowTime(bool state);
+    void setShowLogLevel(bool state);
+    void setLogToConsole(bool state);
+    void setLogFile(std::filesystem::path path, uint64_t maxSize, int nBackups);
+    void setLogCallback(std::function<void(Level, std::string_view)> fn);
+
+    uint64_t nDropped() const;
+
+private:
+    static constexpr uint64_t QueueSize = 4096;
+    static constexpr std::chrono::milliseconds WriteInterval =
+        std::chrono::milliseconds(20);
+
+    /// Strings that have grown larger than this are released after they were written
+    static constexpr size_t MaxRetainedCapacity = 1024;
+
+    struct Entry {
+        std::atomic<uint64_t> sequence = 0;
+        Level level = Level::Info;
+        std::chrono::system_clock::time_point time;
+        std::string message;
+    };
+
+    void worker();
+    void write();
+    void writeFile();
+
+    std::unique_ptr<Entry[]> _entries;
+    std::atomic<uint64_t> _writePosition = 0;
+    std::atomic<uint64_t> _nDropped = 0;
+
+    // Only accessed by the writing thread
+    uint64_t _readPosition = 0;
+    uint64_t _nReportedDropped = 0;
+    std::string _line;
+    std::string _buffer;
+    time_t _lastTime = 0;
+    std::string _lastTimeText;
+
+    // Guarded by the mutex
+    bool _showTime = false;
+    bool _showLevel = true;
+    bool _logToConsole = true;
+    std::function<void(Level, std::string_view)> _messageCallback;
+    std::ofstream _file;
+    std::filesystem::path _filePath;
+    uint64_t _fileSize = 0;
+    uint64_t _maxFileSize = 0;
+    int _nBackups = 0;
+    uint64_t _nWritten = 0;
+    bool _isFlushRequested = false;
+    bool _shouldTerminate = false;
+
+    std::mutex _mutex;
+    std::condition_variable _writeCond;
+    std::condition_variable _flushCond;
+    std::thread _thread;
+};
+
+Log::Writer::Writer()
+    : _entries(std::make_unique<Entry[]>(QueueSize))
+{
+    for (uint64_t i = 0; i < QueueSize; i++) {
+        _entries[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _thread = std::thread([this]() { worker(); });
+}
+
+Log::Writer::~Writer() {
+    {
+        const std::unique_lock lock(_mutex);
+        _shouldTerminate = true;
+    }
+    _writeCond.notify_one();
+    _thread.join();
+}
+
+uint64_t Log::Writer::push(Level level, std::string_view message) {
+    const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+
+    uint64_t pos = _writePosition.load(std::memory_order_relaxed);
+    Entry* entry = nullptr;
+    while (true) {
+        entry = &_entries[pos % QueueSize];
+        const uint64_t seq = entry->sequence.load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(seq - pos);
+        if (diff == 0) {
+            if (_writePosition.compare_exchange_weak(pos, pos + 1,
+                                                     std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The writing thread has not released this entry yet, so the queue is full
+            _nDropped.fetch_add(1, std::memory_order_relaxed);
+            return pos;
+        }
+        else {
+            // Another thread has claimed this position first
+            pos = _writePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    entry->level = level;
+    entry->time = now;
+    try {
+        entry->message.assign(message);
+    }
+    catch (...) {
+        // The entry has been claimed, so it has to be published no matter what
+        entry->message.clear();
+    }
+    entry->sequence.store(pos + 1, std::memory_order_release);
+    return pos + 1;
+}
+
+uint64_t Log::Writer::position() const {
+    return _writePosition.load(std::memory_order_relaxed);
+}
+
+void Log::Writer::flush(uint64_t position) {
+    std::unique_lock lock(_mutex);
+    while (_nWritten < position && !_shouldTerminate) {
+        _isFlushRequested = true;
+        _writeCond.notify_one();
+        // A message that was claimed before but not published yet holds up the writing
+        // thread, so it has to be asked again after a while
+        _flushCond.wait_for(lock, WriteInterval);
+    }
+}
+
+bool Log::Writer::isWriterThread() const {
+    return std::this_thread::get_id() == _thread.get_id();
+}
+
+void Log::Writer::setShowTime(bool state) {
+    const std::unique_lock lock(_mutex);
+    _showTime = state;
+}
+
+void Log::Writer::setShowLogLevel(bool state) {
+    const std::unique_lock lock(_mutex);
+    _showLevel = state;
+}
+
+void Log::Writer::setLogToConsole(bool state) {
+    const std::unique_lock lock(_mutex);
+    _logToConsole = state;
+}
+
+void Log::Writer::setLogFile(std::filesystem::path path, uint64_t maxSize, int nBackups) {
+    const std::unique_lock lock(_mutex);
+    _file.close();
+    _filePath = std::move(path);
+    _maxFileSize = maxSize;
+    _nBackups = nBackups;
+    _fileSize = 0;
+    if (_filePath.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    const uintmax_t size = std::filesystem::file_size(_filePath, ec);
+    _fileSize = ec ? 0 : size;
+    _file.open(_filePath, std::ios::out | std::ios::app | std::ios::binary);
+    if (!_file.good()) {
+        std::cerr << std::format("Could not open log file '{}'\n", _filePath);
+        _filePath.clear();
+    }
+}
+
+void Log::Writer::setLogCallback(std::function<void(Level, std::string_view)> fn) {
+    const std::unique_lock lock(_mutex);
+    _messageCallback = std::move(fn);
+}
+
+uint64_t Log::Writer::nDropped() const {
+    return _nDropped.load(std::memory_order_relaxed);
+}
+
+void Log::Writer::worker() {
+    while (true) {
+        bool shouldTerminate = false;
+        {
+            std::unique_lock lock(_mutex);
+            _writeCond.wait_for(
+                lock,
+                WriteInterval,
+                [this]() { return _shouldTerminate || _isFlushRequested; }
+            );
+            _isFlushRequested = false;
+            shouldTerminate = _shouldTerminate;
+        }
+
+        // Write the remaining messages before terminating
+        write();
+        if (shouldTerminate) {
+            return;
+        }
+    }
+}
+
+void Log::Writer::write() {
+    ZoneScoped;
+
+    bool showTime = false;
+    bool showLevel = false;
+    bool logToConsole = false;
+    std::function<void(Level, std::string_view)> callback;
+    {
+        const std::unique_lock lock(_mutex);
+        showTime = _showTime;
+        showLevel = _showLevel;
+        logToConsole = _logToConsole;
+        callback = _messageCallback;
+    }
+
+    auto append = [&](Level level, std::chrono::system_clock::time_point time,
+                      std::string_view message)
+    {
+        _line.clear();
+        if (showLevel) {
+            std::format_to(std::back_inserter(_line), "({}) ", levelToString(level));
+        }
+        if (showTime) {
+            // The time of day only changes once per second, but converting it is not
+            // cheap, so the last result is reused
+            const time_t t = std::chrono::system_clock::to_time_t(time);
+            if (t != _lastTime) {
+                std::array<char, 16> timeBuffer = {};
+                const tm* timeInfo = localtime(&t);
+                strftime(timeBuffer.data(), timeBuffer.size(), "%X", timeInfo);
+                _lastTimeText = timeBuffer.data();
+                _lastTime = t;
+            }
+            std::format_to(std::back_inserter(_line), "{} | ", _lastTimeText);
+        }
+        _line += message;
+
+        if (callback) {
+            callback(level, _line);
+        }
+        _buffer += _line;
+        _buffer += '\n';
+    };
+
+    _buffer.clear();
+    const uint64_t nDropped = _nDropped.load(std::memory_order_relaxed);
+    if (nDropped != _nReportedDropped) {
+        append(
+            Level::Warning,
+            std::chrono::system_clock::now(),
+            std::format("{} log messages were dropped", nDropped - _nReportedDropped)
+        );
+        _nReportedDropped = nDropped;
+    }
+
+    while (true) {
+        Entry& entry = _entries[_readPosition % QueueSize];
+        if (entry.sequence.load(std::memory_order_acquire) != _readPosition + 1) {
+            break;
+        }
+
+        append(entry.level, entry.time, entry.message);
+
+        if (entry.message.capacity() > MaxRetainedCapacity) {
+            std::string().swap(entry.message);
+        }
+        entry.sequence.store(_readPosition + QueueSize, std::memory_order_release);
+        _readPosition++;
+    }
+
+    if (!_buffer.empty()) {
+        if (logToConsole) {
+            // The console is flushed here to make sure that any application listening to
+            // our log messages (looking at you C-Troll) is actually getting the messages
+            // immediately. Without the flush, all of the messages stack up in the buffer
+            // and are only sent once the application is finished, which is no bueno
+            std::cout << _buffer << std::flush;
+#ifdef WIN32
+            OutputDebugStringA(_buffer.c_str());
+#endif // WIN32
+        }
+    }
+
+    const std::unique_lock lock(_mutex);
+    if (!_buffer.empty() && _file.is_open()) {
+        writeFile();
+    }
+    _nWritten = _readPosition;
+    _flushCond.notify_all();
+}
+
+void Log::Writer::writeFile() {
+    if (_maxFileSize > 0 && _fileSize > 0 && _fileSize + _buffer.size() > _maxFileSize) {
+        // Shift the existing backups by one and drop the oldest one
+        _file.close();
+        auto backup = [this](int i) {
+            std::filesystem::path p = _filePath;
+            p += std::format(".{}", i);
+            return p;
+        };
+        std::error_code ec;
+        if (_nBackups > 0) {
+            std::filesystem::remove(backup(_nBackups), ec);
+            for (int i = _nBackups - 1; i > 0; i--) {
+                std::filesystem::rename(backup(i), backup(i + 1), ec);
+            }
+            std::filesystem::rename(_filePath, backup(1), ec);
+        }
+        _file.open(_filePath, std::ios::out | std::ios::trunc | std::ios::binary);
+        _fileSize = 0;
+        if (!_file.good()) {
+            std::cerr << std::format("Could not reopen log file '{}'\n", _filePath);
+            return;
+        }
+    }
+
+    _file.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+    _file.flush();
+    _fileSize += _buffer.size();
+}
+
+
 Log* Log::_instance = nullptr;
+std::atomic<Log::Level> Log::_notifyLevel = Log::Level::Info;
 
 Log& Log::instance() {
     if (!_instance) {
@@ -51,82 +400,83 @@ void Log::destroy() {
     _instance = nullptr;
 }
 
-Log::Log() {
-    _parseBuffer.resize(128);
-}
+Log::Log()
+    : _writer(std::make_unique<Writer>())
+{}
 
-void Log::printv(Level level, std::string message) {
-    if (_showTime) {
-        constexpr int TimeBufferSize = 9;
-        std::array<char, TimeBufferSize> timeBuffer;
-        const time_t now = ::time(nullptr);
-        tm* timeInfoPtr = nullptr;
-        timeInfoPtr = localtime(&now);
-        strftime(timeBuffer.data(), TimeBufferSize, "%X", timeInfoPtr);
+Log::~Log() = default;
 
-        message = std::format("{} | {}", timeBuffer.data(), message);
-    }
-    if (_showLevel) {
-        message = std::format("({}) {}", levelToString(level), message);
-    }
+void Log::log(Level level, std::string_view format, std::format_args args) {
+    // The message is formatted into a buffer that keeps its capacity between messages
+    thread_local std::string buffer;
+    buffer.clear();
+    std::vformat_to(std::back_inserter(buffer), format, args);
+    instance().push(level, buffer);
+}
 
-    if (_logToConsole) {
-        // We need an endl here to make sure that any application listening to our log
-        // messages (looking at you C-Troll) is actually getting the messages immediately.
-        // If the `flush` doesn't happen here, all of the messages stack up in the buffer
-        // and are only sent once the application is finished, which is no bueno
-        std::cout << message << '\n';
-#ifdef WIN32
-        OutputDebugStringA((message + '\n').c_str());
-#endif // WIN32
-    }
+void Log::push(Level level, std::string_view message) {
+    const uint64_t position = _writer->push(level, message);
 
-    if (_messageCallback) {
-        _messageCallback(level, message);
+    // Errors are often followed by the application shutting down, so they are not left
+    // waiting in the queue. The callback logging an error must not wait for itself
+    if (level == Level::Error && !_writer->isWriterThread()) {
+        _writer->flush(position);
     }
 }
 
 void Log::setNotifyLevel(Level nl) {
-    _level = nl;
+    _notifyLevel = nl;
 }
 
 void Log::setShowTime(bool state) {
-    _showTime = state;
+    _writer->setShowTime(state);
 }
 
 void Log::setShowLogLevel(bool state) {
-    _showLevel = state;
+    _writer->setShowLogLevel(state);
 }
 
 void Log::setLogToConsole(bool state) {
-    _logToConsole = state;
+    _writer->setLogToConsole(state);
+}
+
+void Log::setLogFile(std::filesystem::path path, uint64_t maxSize, int nBackups) {
+    _writer->setLogFile(std::move(path), maxSize, nBackups);
 }
 
 void Log::setLogCallback(std::function<void(Level, std::string_view)> fn) {
-    _messageCallback = std::move(fn);
+    _writer->setLogCallback(std::move(fn));
+}
+
+void Log::flush() {
+    _writer->flush(_writer->position());
+}
+
+uint64_t Log::nDroppedMessages() const {
+    return _writer->nDropped();
 }
 
 void Log::Debug(std::string_view message) {
-    if (instance()._level <= Level::Debug) {
-        instance().printv(Level::Debug, std::string(message));
+    if (isEnabled(Level::Debug)) {
+        instance().push(Level::Debug, message);
     }
 }
 
 void Log::Info(std::string_view message) {
-    if (instance()._level <= Level::Info) {
-        instance().printv(Level::Info, std::string(message));
+    if (isEnabled(Level::Info)) {
+        instance().push(Level::Info, message);
     }
 }
 
 void Log::Warning(std::string_view message) {
-    if (instance()._level <= Level::Warning) {
-        instance().printv(Level::Warning, std::string(message));
+    if (isEnabled(Level::Warning)) {
+        instance().push(Level::Warning, message);
     }
 }
 
 void Log::Error(std::string_view message) {
-    if (instance()._level <= Level::Error) {
-        instance().printv(Level::Error, std::string(message));
+    if (isEnabled(Level::Error)) {
+        instance().push(Level::Error, message);
     }
 }
 
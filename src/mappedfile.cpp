@@ -0,0 +1,98 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/mappedfile.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#define VC_EXTRALEAN
+#include <windows.h>
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // WIN32
+
+#include <sgct/profiling.h>
+
+namespace sgct {
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+    ZoneScoped;
+
+#ifdef WIN32
+    HANDLE file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (file == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+        // The mapping keeps the file open, so the handle is not needed after this
+        _mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mapping) {
+            _data = reinterpret_cast<const unsigned char*>(
+                MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0)
+            );
+            _size = _data ? static_cast<size_t>(size.QuadPart) : 0;
+        }
+    }
+    CloseHandle(file);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file == -1) {
+        return;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) == 0 && info.st_size > 0) {
+        void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED) {
+            _data = reinterpret_cast<const unsigned char*>(data);
+            _size = static_cast<size_t>(info.st_size);
+        }
+    }
+    // The mapping stays valid after the file descriptor is closed
+    close(file);
+#endif // WIN32
+}
+
+MappedFile::~MappedFile() {
+#ifdef WIN32
+    if (_data) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping) {
+        CloseHandle(_mapping);
+    }
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    if (_data) {
+        munmap(const_cast<unsigned char*>(_data), _size);
+    }
+#endif // WIN32
+}
+
+const unsigned char* MappedFile::data() const {
+    return _data;
+}
+
+size_t MappedFile::size() const {
+    return _size;
+}
+
+} // namespace sgct
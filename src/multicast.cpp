@@ -0,0 +1,478 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/multicast.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#define SGCT_ERRNO WSAGetLastError()
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <unistd.h>
+#define SOCKET_ERROR (-1)
+#define INVALID_SOCKET (~0)
+#define SGCT_ERRNO errno
+#endif // WIN32
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Network, code, msg)
+
+namespace {
+    // Every datagram starts with this marker, followed by the sequence number and the
+    // total length of the message and the index and the number of the message's
+    // fragments. The marker protects against unrelated traffic on the same port
+    constexpr uint32_t DatagramMarker = 0x54434753; // "SGCT"
+    constexpr int DatagramHeaderSize = 3 * sizeof(uint32_t) + 2 * sizeof(uint16_t);
+
+    // Stays below the usual Ethernet MTU so that the datagrams are not fragmented by IP
+    constexpr int DatagramSize = 1400;
+    constexpr int FragmentSize = DatagramSize - DatagramHeaderSize;
+
+    // Incomplete messages that are older than the most recent ones are dropped
+    constexpr size_t MaxPendingMessages = 32;
+
+    // Large enough to hold a few frames of sync data if the receiving thread lags behind
+    constexpr int SocketBufferSize = 4 * 1024 * 1024;
+
+    // How often the receiving thread checks whether it should terminate
+    constexpr int ReceiveTimeout = 100;
+
+    uint32_t parseAddress(const std::string& address) {
+        in_addr addr = {};
+        if (inet_pton(AF_INET, address.c_str(), &addr) != 1) {
+            throw Err(
+                5041,
+                std::format("Multicast address '{}' is not an IPv4 address", address)
+            );
+        }
+        return addr.s_addr;
+    }
+
+    bool isMulticastAddress(uint32_t address) {
+        // 224.0.0.0/4
+        return (ntohl(address) & 0xF0000000) == 0xE0000000;
+    }
+
+    template <typename T>
+    bool setOption(SGCT_SOCKET s, int level, int option, const T& value) {
+        const int res = setsockopt(
+            s,
+            level,
+            option,
+            reinterpret_cast<const char*>(&value),
+            sizeof(value)
+        );
+        return res != SOCKET_ERROR;
+    }
+
+    void closeSocket(SGCT_SOCKET s) {
+#ifdef WIN32
+        closesocket(s);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        close(s);
+#endif // WIN32
+    }
+
+    SGCT_SOCKET createSocket() {
+        const SGCT_SOCKET s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (s == INVALID_SOCKET) {
+            throw Err(
+                5040,
+                std::format("Failed to create multicast socket: {}", SGCT_ERRNO)
+            );
+        }
+        return s;
+    }
+} // namespace
+
+namespace sgct {
+
+MulticastSender::MulticastSender(const std::string& address, int port, int ttl,
+                                 const std::string& interfaceAddress)
+    : _address(parseAddress(address))
+    , _port(htons(static_cast<uint16_t>(port)))
+{
+    _socket = createSocket();
+
+    bool success = setOption(_socket, SOL_SOCKET, SO_SNDBUF, SocketBufferSize);
+    if (isMulticastAddress(_address)) {
+        success &= setOption(_socket, IPPROTO_IP, IP_MULTICAST_TTL, ttl);
+
+        // Required for receivers that run on the same computer as the sender
+        const int loop = 1;
+        success &= setOption(_socket, IPPROTO_IP, IP_MULTICAST_LOOP, loop);
+
+        if (!interfaceAddress.empty()) {
+            in_addr iface = {};
+            iface.s_addr = parseAddress(interfaceAddress);
+            success &= setOption(_socket, IPPROTO_IP, IP_MULTICAST_IF, iface);
+        }
+    }
+    else {
+        const int broadcast = 1;
+        success &= setOption(_socket, SOL_SOCKET, SO_BROADCAST, broadcast);
+    }
+
+    if (!success) {
+        const int error = SGCT_ERRNO;
+        closeSocket(_socket);
+        throw Err(
+            5042,
+            std::format("Failed to configure multicast socket for {}: {}", address, error)
+        );
+    }
+
+    _datagram.resize(DatagramSize);
+    Log::Info("Sending sync data to {}:{} via UDP", address, port);
+}
+
+MulticastSender::~MulticastSender() {
+    closeSocket(_socket);
+}
+
+uint32_t MulticastSender::send(std::span<const Network::Buffer> buffers) {
+    ZoneScoped;
+
+    const uint32_t sequence = _nextSequence++;
+
+    // Only this function modifies the history, so the message can be read without the
+    // lock once it has been stored
+    Message& msg = _history[sequence % HistorySize];
+    {
+        const std::unique_lock lock(_historyMutex);
+        msg.sequence = sequence;
+        msg.data.clear();
+        for (const Network::Buffer& b : buffers) {
+            const char* data = reinterpret_cast<const char*>(b.data);
+            msg.data.insert(msg.data.end(), data, data + b.length);
+        }
+    }
+
+    const size_t length = msg.data.size();
+    const size_t nFragments =
+        std::max<size_t>((length + FragmentSize - 1) / FragmentSize, 1);
+    if (nFragments > std::numeric_limits<uint16_t>::max() ||
+        length > std::numeric_limits<uint32_t>::max())
+    {
+        throw Err(
+            5044,
+            std::format("Message of {} bytes is too large for multicast", length)
+        );
+    }
+
+    sockaddr_in destination = {};
+    destination.sin_family = AF_INET;
+    destination.sin_port = _port;
+    destination.sin_addr.s_addr = _address;
+
+    const uint32_t totalLength = static_cast<uint32_t>(length);
+    const uint16_t count = static_cast<uint16_t>(nFragments);
+    for (uint16_t fragment = 0; fragment < count; fragment++) {
+        const size_t offset = static_cast<size_t>(fragment) * FragmentSize;
+        const int fragmentLength =
+            static_cast<int>(std::min<size_t>(FragmentSize, length - offset));
+
+        char* d = _datagram.data();
+        std::memcpy(d, &DatagramMarker, sizeof(DatagramMarker));
+        std::memcpy(d + 4, &sequence, sizeof(sequence));
+        std::memcpy(d + 8, &totalLength, sizeof(totalLength));
+        std::memcpy(d + 12, &fragment, sizeof(fragment));
+        std::memcpy(d + 14, &count, sizeof(count));
+        std::memcpy(d + DatagramHeaderSize, msg.data.data() + offset, fragmentLength);
+
+        const int res = sendto(
+            _socket,
+            d,
+            DatagramHeaderSize + fragmentLength,
+            0,
+            reinterpret_cast<const sockaddr*>(&destination),
+            sizeof(destination)
+        );
+        if (res == SOCKET_ERROR) {
+            // The receivers request the message through TCP if it does not arrive
+            Log::Warning(
+                "Sending multicast message {} failed: {}", sequence, SGCT_ERRNO
+            );
+            break;
+        }
+    }
+
+    return sequence;
+}
+
+bool MulticastSender::message(uint32_t sequence, std::vector<char>& message) const {
+    const std::unique_lock lock(_historyMutex);
+    const Message& msg = _history[sequence % HistorySize];
+    if (msg.sequence != sequence) {
+        return false;
+    }
+    message = msg.data;
+    return true;
+}
+
+MulticastReceiver::MulticastReceiver(const std::string& address, int port,
+                                     const std::string& interfaceAddress)
+{
+    const uint32_t group = parseAddress(address);
+    _socket = createSocket();
+
+    // Allow multiple nodes on the same computer to receive the messages
+    const int reuse = 1;
+    bool success = setOption(_socket, SOL_SOCKET, SO_REUSEADDR, reuse);
+#ifdef __APPLE__
+    success &= setOption(_socket, SOL_SOCKET, SO_REUSEPORT, reuse);
+#endif // __APPLE__
+    success &= setOption(_socket, SOL_SOCKET, SO_RCVBUF, SocketBufferSize);
+#ifdef WIN32
+    const DWORD timeout = ReceiveTimeout;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    timeval timeout = {};
+    timeout.tv_usec = ReceiveTimeout * 1000;
+#endif // WIN32
+    success &= setOption(_socket, SOL_SOCKET, SO_RCVTIMEO, timeout);
+
+    sockaddr_in local = {};
+    local.sin_family = AF_INET;
+    local.sin_port = htons(static_cast<uint16_t>(port));
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    const int bindRes =
+        bind(_socket, reinterpret_cast<const sockaddr*>(&local), sizeof(local));
+    if (!success || bindRes == SOCKET_ERROR) {
+        const int error = SGCT_ERRNO;
+        closeSocket(_socket);
+        throw Err(
+            5042,
+            std::format("Failed to bind multicast socket to port {}: {}", port, error)
+        );
+    }
+
+    if (isMulticastAddress(group)) {
+        ip_mreq request = {};
+        request.imr_multiaddr.s_addr = group;
+        request.imr_interface.s_addr = interfaceAddress.empty() ?
+            htonl(INADDR_ANY) :
+            parseAddress(interfaceAddress);
+        if (!setOption(_socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, request)) {
+            const int error = SGCT_ERRNO;
+            closeSocket(_socket);
+            throw Err(
+                5043,
+                std::format("Failed to join multicast group {}: {}", address, error)
+            );
+        }
+    }
+
+    _thread = std::thread([this]() { run(); });
+    _timerThread = std::thread([this]() { runTimer(); });
+    Log::Info("Receiving sync data from {}:{} via UDP", address, port);
+}
+
+MulticastReceiver::~MulticastReceiver() {
+    {
+        const std::unique_lock lock(_mutex);
+        _shouldTerminate = true;
+    }
+    _timerCond.notify_all();
+    _timerThread.join();
+    _thread.join();
+    closeSocket(_socket);
+}
+
+void MulticastReceiver::takeAsync(uint32_t sequence, std::chrono::milliseconds timeout,
+                                  Callback callback)
+{
+    ZoneScoped;
+
+    std::vector<char> message;
+    std::unique_lock<std::mutex> callbackLock;
+    {
+        const std::unique_lock lock(_mutex);
+        const auto it = _messages.find(sequence);
+        if (it == _messages.end() || it->second.nMissingFragments > 0) {
+            _requests[sequence] = {
+                .deadline = std::chrono::steady_clock::now() + timeout,
+                .callback = std::move(callback)
+            };
+            _timerCond.notify_all();
+            return;
+        }
+        std::swap(message, it->second.data);
+        forget(sequence);
+
+        // Taken before the request lock is released so that #cancel waits for it
+        callbackLock = std::unique_lock(_callbackMutex);
+    }
+    call(callback, sequence, &message);
+}
+
+void MulticastReceiver::cancel() {
+    {
+        const std::unique_lock lock(_mutex);
+        _requests.clear();
+    }
+    // Wait for a callback that was already taken out of the requests. The callback lock
+    // is always taken before the request lock is released, so every such callback either
+    // holds it already or has not been taken out of the requests
+    const std::unique_lock lock(_callbackMutex);
+}
+
+void MulticastReceiver::forget(uint32_t sequence) {
+    // Older messages are only kept if they are still requested
+    _lastTaken = std::max(_lastTaken.value_or(0), sequence);
+    for (auto it = _messages.begin(); it != _messages.end() && it->first <= sequence;) {
+        if (it->first == sequence || !_requests.contains(it->first)) {
+            it = _messages.erase(it);
+        }
+        else {
+            it++;
+        }
+    }
+}
+
+void MulticastReceiver::call(const Callback& callback, uint32_t sequence,
+                             std::vector<char>* message)
+{
+    try {
+        callback(sequence, message);
+    }
+    catch (const std::runtime_error& e) {
+        Log::Error(e.what());
+    }
+}
+
+void MulticastReceiver::runTimer() {
+    std::unique_lock lock(_mutex);
+    while (!_shouldTerminate) {
+        if (_requests.empty()) {
+            _timerCond.wait(lock);
+            continue;
+        }
+
+        const auto next = std::min_element(
+            _requests.begin(),
+            _requests.end(),
+            [](const auto& a, const auto& b) {
+                return a.second.deadline < b.second.deadline;
+            }
+        );
+        const std::chrono::steady_clock::time_point deadline = next->second.deadline;
+        if (std::chrono::steady_clock::now() < deadline) {
+            _timerCond.wait_until(lock, deadline);
+            continue;
+        }
+
+        const uint32_t sequence = next->first;
+        const Callback callback = std::move(next->second.callback);
+        _requests.erase(next);
+        forget(sequence);
+
+        {
+            const std::unique_lock callbackLock(_callbackMutex);
+            lock.unlock();
+            call(callback, sequence, nullptr);
+        }
+        lock.lock();
+    }
+}
+
+void MulticastReceiver::run() {
+    std::vector<char> datagram(std::numeric_limits<uint16_t>::max());
+    while (!_shouldTerminate) {
+        const int size = static_cast<int>(
+            recv(_socket, datagram.data(), static_cast<int>(datagram.size()), 0)
+        );
+        if (size < DatagramHeaderSize) {
+            // Timeouts, errors, and datagrams that are too short to be ours
+            continue;
+        }
+
+        uint32_t marker = 0;
+        uint32_t sequence = 0;
+        uint32_t length = 0;
+        uint16_t fragment = 0;
+        uint16_t nFragments = 0;
+        const char* d = datagram.data();
+        std::memcpy(&marker, d, sizeof(marker));
+        std::memcpy(&sequence, d + 4, sizeof(sequence));
+        std::memcpy(&length, d + 8, sizeof(length));
+        std::memcpy(&fragment, d + 12, sizeof(fragment));
+        std::memcpy(&nFragments, d + 14, sizeof(nFragments));
+
+        const size_t offset = static_cast<size_t>(fragment) * FragmentSize;
+        const size_t fragmentLength = static_cast<size_t>(size - DatagramHeaderSize);
+        const size_t expectedFragments =
+            std::max<size_t>((length + FragmentSize - 1) / FragmentSize, 1);
+        const bool isValid = marker == DatagramMarker &&
+            nFragments == expectedFragments && fragment < nFragments &&
+            offset + fragmentLength <= length &&
+            (fragment == nFragments - 1 || fragmentLength == FragmentSize);
+        if (!isValid) {
+            continue;
+        }
+
+        std::unique_lock lock(_mutex);
+        if (_lastTaken && sequence <= *_lastTaken && !_requests.contains(sequence)) {
+            // Arrived too late, the message has already been requested through TCP
+            continue;
+        }
+
+        auto [it, isNew] = _messages.try_emplace(sequence);
+        PartialMessage& msg = it->second;
+        if (isNew) {
+            msg.data.resize(length);
+            msg.hasFragment.assign(nFragments, false);
+            msg.nMissingFragments = nFragments;
+        }
+        if (msg.data.size() != length || msg.hasFragment.size() != nFragments ||
+            msg.hasFragment[fragment])
+        {
+            continue;
+        }
+
+        std::memcpy(msg.data.data() + offset, d + DatagramHeaderSize, fragmentLength);
+        msg.hasFragment[fragment] = true;
+        msg.nMissingFragments--;
+
+        const auto request = _requests.find(sequence);
+        if (msg.nMissingFragments == 0 && request != _requests.end()) {
+            const Callback callback = std::move(request->second.callback);
+            _requests.erase(request);
+            std::vector<char> message = std::move(msg.data);
+            forget(sequence);
+
+            const std::unique_lock callbackLock(_callbackMutex);
+            lock.unlock();
+            call(callback, sequence, &message);
+            continue;
+        }
+
+        while (_messages.size() > MaxPendingMessages) {
+            _messages.erase(_messages.begin());
+        }
+    }
+}
+
+} // namespace sgct
@@ -18,7 +18,9 @@
 #define SGCT_ERRNO WSAGetLastError()
 #else // ^^^^ WIN32 // !WIN32 vvvv
 #include <sys/types.h>
+#include <sys/ioctl.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <arpa/inet.h>
@@ -36,20 +38,34 @@
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
+#include <sgct/multicast.h>
 #include <sgct/mutexes.h>
 #include <sgct/networkmanager.h>
+#include <sgct/networkreactor.h>
 #include <sgct/profiling.h>
 #include <sgct/shareddata.h>
+#include <zlib.h>
 #include <algorithm>
+#include <climits>
 #include <cstring>
+#include <limits>
 
 #define Err(code, msg) sgct::Error(sgct::Error::Component::Network, code, msg)
 
 namespace {
     constexpr int MaxNumberOfAttempts = 10;
 
+    // Unchanged stretches that are shorter than this are included in a delta run as it is
+    // cheaper to send them than to start a new run with its own offset and length
+    constexpr int MinDeltaGap = 2 * sizeof(uint32_t);
+
     constexpr int MaxNetworkSyncFrameNumber = 10000;
 
+    // The multicast datagrams are sent before the header of a sync message, so they have
+    // usually arrived by the time the header is received. If they have not arrived after
+    // this time, the message is requested again through the TCP connection
+    constexpr std::chrono::milliseconds MulticastTimeout(10);
+
 
     int receiveData(SGCT_SOCKET lsocket, char* buffer, int length, int flags) {
         long iResult = 0;
@@ -65,9 +81,9 @@ namespace {
 #else // ^^^^ WIN32 // !WIN32 vvvv
             else if (SGCT_ERRNO == EINTR && attempts <= MaxNumberOfAttempts) {
 #endif // WIN32
-                sgct::Log::Warning(std::format(
+                sgct::Log::Warning(
                     "Receiving data after interrupted system error (attempt {})", attempts
-                ));
+                );
                 attempts++;
             }
             else {
@@ -82,6 +98,110 @@ namespace {
         return static_cast<int>(iResult);
     }
 
+    // Returns the number of bytes that can be read from the socket without blocking or -1
+    // if that could not be determined
+    int bytesAvailable(SGCT_SOCKET lsocket) {
+#ifdef WIN32
+        u_long available = 0;
+        if (ioctlsocket(lsocket, FIONREAD, &available) == SOCKET_ERROR) {
+            return -1;
+        }
+        return static_cast<int>(std::min<u_long>(available, INT_MAX));
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        int available = 0;
+        if (ioctl(lsocket, FIONREAD, &available) == -1) {
+            return -1;
+        }
+        return available;
+#endif // WIN32
+    }
+
+#ifdef WIN32
+    using IoBuffer = WSABUF;
+
+    IoBuffer ioBuffer(const void* data, int length) {
+        CHAR* buffer = static_cast<CHAR*>(const_cast<void*>(data));
+        return { static_cast<ULONG>(length), buffer };
+    }
+
+    size_t ioBufferLength(const IoBuffer& buffer) {
+        return buffer.len;
+    }
+
+    void advanceIoBuffer(IoBuffer& buffer, size_t nBytes) {
+        buffer.buf += nBytes;
+        buffer.len -= static_cast<ULONG>(nBytes);
+    }
+#else // ^^^^ WIN32 // !WIN32 vvvv
+    using IoBuffer = iovec;
+
+    IoBuffer ioBuffer(const void* data, int length) {
+        return { const_cast<void*>(data), static_cast<size_t>(length) };
+    }
+
+    size_t ioBufferLength(const IoBuffer& buffer) {
+        return buffer.iov_len;
+    }
+
+    void advanceIoBuffer(IoBuffer& buffer, size_t nBytes) {
+        buffer.iov_base = static_cast<char*>(buffer.iov_base) + nBytes;
+        buffer.iov_len -= nBytes;
+    }
+#endif // WIN32
+
+    // Hands all of the provided buffers to the socket in as few system calls as possible.
+    // The buffers are modified to keep track of partial writes
+    void sendBuffers(SGCT_SOCKET socket, IoBuffer* buffers, size_t nBuffers) {
+        // Skip empty buffers at the front so that a partial write is always attributed
+        // to a buffer that actually contains data
+        while (nBuffers > 0 && ioBufferLength(*buffers) == 0) {
+            buffers++;
+            nBuffers--;
+        }
+
+        while (nBuffers > 0) {
+#ifdef WIN32
+            DWORD sent = 0;
+            const int res = WSASend(
+                socket,
+                buffers,
+                static_cast<DWORD>(nBuffers),
+                &sent,
+                0,
+                nullptr,
+                nullptr
+            );
+            if (res == SOCKET_ERROR) {
+                throw Err(5014, std::format("Send data failed: {}", SGCT_ERRNO));
+            }
+            size_t remaining = sent;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+            msghdr message = {};
+            message.msg_iov = buffers;
+            // sendmsg refuses to take more than IOV_MAX buffers at once
+            message.msg_iovlen = std::min<size_t>(nBuffers, IOV_MAX);
+            const long sent = sendmsg(socket, &message, 0);
+            if (sent == SOCKET_ERROR) {
+                if (SGCT_ERRNO == EINTR) {
+                    continue;
+                }
+                throw Err(5014, std::format("Send data failed: {}", SGCT_ERRNO));
+            }
+            size_t remaining = static_cast<size_t>(sent);
+#endif // WIN32
+
+            // Drop all buffers that were sent completely and adjust the partial one
+            while (nBuffers > 0 && remaining >= ioBufferLength(*buffers)) {
+                remaining -= ioBufferLength(*buffers);
+                buffers++;
+                nBuffers--;
+            }
+            if (nBuffers > 0) {
+                advanceIoBuffer(*buffers, remaining);
+            }
+        }
+    }
+
     void setOptions(SGCT_SOCKET socket, sgct::Network::ConnectionType connectionType) {
         constexpr int TrueFlag = 1;
 
@@ -153,6 +273,27 @@ namespace {
         };
         return std::string_view(header, 8) == std::string_view(rhs.data(), 8);
     }
+
+    // The fields of the FrameTiming are all 4 bytes large and stored in order
+    void writeFrameTiming(const sgct::Network::FrameTiming& timing, char* data) {
+        std::memcpy(data + 0, &timing.nodeIndex, sizeof(uint32_t));
+        std::memcpy(data + 4, &timing.frameNumber, sizeof(uint32_t));
+        std::memcpy(data + 8, &timing.drawTime, sizeof(float));
+        std::memcpy(data + 12, &timing.syncTime, sizeof(float));
+        std::memcpy(data + 16, &timing.swapTime, sizeof(float));
+        std::memcpy(data + 20, &timing.nDroppedFrames, sizeof(uint32_t));
+    }
+
+    sgct::Network::FrameTiming readFrameTiming(const char* data) {
+        sgct::Network::FrameTiming timing;
+        std::memcpy(&timing.nodeIndex, data + 0, sizeof(uint32_t));
+        std::memcpy(&timing.frameNumber, data + 4, sizeof(uint32_t));
+        std::memcpy(&timing.drawTime, data + 8, sizeof(float));
+        std::memcpy(&timing.syncTime, data + 12, sizeof(float));
+        std::memcpy(&timing.swapTime, data + 16, sizeof(float));
+        std::memcpy(&timing.nDroppedFrames, data + 20, sizeof(uint32_t));
+        return timing;
+    }
 } // namespace
 
 namespace sgct {
@@ -161,6 +302,82 @@ int Network::lastError() {
     return SGCT_ERRNO;
 }
 
+int Network::compressData(const void* data, int length, std::vector<char>& buffer,
+                          int level)
+{
+    const Buffer b = { data, length };
+    return compressData(std::span<const Buffer>(&b, 1), buffer, level);
+}
+
+int Network::compressData(std::span<const Buffer> buffers, std::vector<char>& buffer,
+                          int level)
+{
+    ZoneScoped;
+
+    uLong length = 0;
+    for (const Buffer& b : buffers) {
+        length += static_cast<uLong>(b.length);
+    }
+
+    const uLong bound = compressBound(length);
+    if (buffer.size() < bound) {
+        buffer.resize(bound);
+    }
+
+    z_stream stream = {};
+    if (deflateInit(&stream, level) != Z_OK) {
+        return 0;
+    }
+    stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+    stream.avail_out = static_cast<uInt>(bound);
+
+    int res = Z_OK;
+    for (size_t i = 0; i < buffers.size() && res == Z_OK; i++) {
+        const bool isLast = i == buffers.size() - 1;
+        if (buffers[i].length == 0 && !isLast) {
+            // zlib reports an error if it is asked to make progress without any input
+            continue;
+        }
+        stream.next_in =
+            reinterpret_cast<Bytef*>(const_cast<void*>(buffers[i].data));
+        stream.avail_in = static_cast<uInt>(buffers[i].length);
+        res = deflate(&stream, isLast ? Z_FINISH : Z_NO_FLUSH);
+    }
+    if (buffers.empty()) {
+        res = deflate(&stream, Z_FINISH);
+    }
+    const uLong size = stream.total_out;
+    deflateEnd(&stream);
+
+    if (res != Z_STREAM_END || size >= length) {
+        return 0;
+    }
+    return static_cast<int>(size);
+}
+
+void Network::uncompressData(const void* data, int length, void* destination,
+                             int uncompressedLength)
+{
+    ZoneScoped;
+
+    uLongf size = static_cast<uLongf>(uncompressedLength);
+    const int res = uncompress(
+        reinterpret_cast<Bytef*>(destination),
+        &size,
+        reinterpret_cast<const Bytef*>(data),
+        static_cast<uLong>(length)
+    );
+    if (res != Z_OK || size != static_cast<uLongf>(uncompressedLength)) {
+        throw Err(
+            5015,
+            std::format(
+                "Failed to decompress message ({}). Got {} of {} bytes",
+                res, size, uncompressedLength
+            )
+        );
+    }
+}
+
 Network::Network(int port, const std::string& address, bool isServer, ConnectionType t)
     : _socket(INVALID_SOCKET)
     , _listenSocket(INVALID_SOCKET)
@@ -229,10 +446,10 @@ Network::Network(int port, const std::string& address, bool isServer, Connection
     else {
         // Client socket: Connect to server
         while (!_shouldTerminate) {
-            Log::Info(std::format(
+            Log::Info(
                 "Attempting to connect to server (id: {}, ip: {}, type: {})",
                 _id, address, typeStr(type())
-            ));
+            );
 
             _socket = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
             if (_socket == INVALID_SOCKET) {
@@ -255,7 +472,7 @@ Network::Network(int port, const std::string& address, bool isServer, Connection
                 Log::Debug("Waiting for connection...");
             }
             else {
-                Log::Debug(std::format("Connect error code: {}", SGCT_ERRNO));
+                Log::Debug("Connect error code: {}", SGCT_ERRNO);
             }
             std::this_thread::sleep_for(std::chrono::seconds(1)); // wait for next attempt
         }
@@ -310,7 +527,7 @@ void Network::connectionHandler() {
         });
     }
 
-    Log::Info(std::format("Exiting connection handler for connection {}", _id));
+    Log::Info("Exiting connection handler for connection {}", _id);
 }
 
 int Network::port() const {
@@ -321,6 +538,26 @@ std::condition_variable& Network::startConnectionConditionVar() {
     return _startConnectionCond;
 }
 
+void Network::setReactor(NetworkReactor* reactor) {
+    _reactor = reactor;
+}
+
+void Network::setMulticastReceiver(MulticastReceiver* receiver) {
+    _multicastReceiver = receiver;
+}
+
+void Network::setMulticastSender(const MulticastSender* sender) {
+    _multicastSender = sender;
+}
+
+void Network::setDeltaEncoding(bool enabled) {
+    _sendsDelta = enabled;
+}
+
+SGCT_SOCKET Network::nativeSocket() const {
+    return _socket;
+}
+
 void Network::closeSocket(SGCT_SOCKET socket) {
     if (socket == INVALID_SOCKET) {
         return;
@@ -349,17 +586,25 @@ int Network::iterateFrameCounter() {
     return _currentSendFrame;
 }
 
-void Network::pushClientMessage() {
+void Network::pushClientMessage(const std::optional<FrameTiming>& timing) {
     // The servers' render function is locked until an ack message is received
     const int currentFrame = iterateFrameCounter();
-    uint32_t localSyncHeaderSize = 0;
+    const bool hasTiming = timing.has_value() && _acceptsFrameTiming;
+    uint32_t localSyncHeaderSize = hasTiming ? FrameTimingSize : 0;
 
     std::array<char, HeaderSize> data = {};
     data[0] = Network::DataId;
     std::memcpy(data.data() + 1, &currentFrame, sizeof(currentFrame));
     std::memcpy(data.data() + 5, &localSyncHeaderSize, sizeof(localSyncHeaderSize));
     std::memset(data.data() + 9, DefaultId, 4);
-    sendData(data.data(), HeaderSize);
+    if (hasTiming) {
+        std::array<char, FrameTimingSize> payload;
+        writeFrameTiming(*timing, payload.data());
+        sendData(data.data(), HeaderSize, payload.data(), FrameTimingSize);
+    }
+    else {
+        sendData(data.data(), HeaderSize);
+    }
 }
 
 int Network::sendFrameCurrent() const {
@@ -398,6 +643,27 @@ bool Network::isUpdated() const {
     return (state && _isConnected);
 }
 
+bool Network::waitForUpdate(std::chrono::steady_clock::time_point deadline) const {
+    ZoneScoped;
+
+    std::unique_lock lock(_updateMutex);
+    _updateCond.wait_until(
+        lock,
+        deadline,
+        [this]() { return isUpdated() || !_isConnected; }
+    );
+    return isUpdated();
+}
+
+void Network::notifyUpdate() {
+    // Taking the lock ensures that a thread in #waitForUpdate is either before its check
+    // of the state or already waiting, so that the notification can not get lost
+    {
+        const std::unique_lock lock(_updateMutex);
+    }
+    _updateCond.notify_all();
+}
+
 void Network::setDecodeFunction(std::function<void(const char*, int)> fn) {
     decoderCallback = std::move(fn);
 }
@@ -418,15 +684,195 @@ void Network::setAcknowledgeFunction(std::function<void(int, int)> fn) {
     _acknowledgeCallback = std::move(fn);
 }
 
+void Network::setStreamDecodeFunction(
+                     std::function<void(const char*, int, int64_t, int64_t, int, int)> fn)
+{
+    _streamDecoderCallback = std::move(fn);
+}
+
+void Network::setStreamResumeFunction(std::function<int64_t(int, int64_t)> fn) {
+    _streamResumeCallback = std::move(fn);
+}
+
 void Network::setConnectedStatus(bool state) {
-    const std::unique_lock lock(_connectionMutex);
-    _isConnected = state;
+    {
+        const std::unique_lock lock(_connectionMutex);
+        _isConnected = state;
+    }
+
+    // Wake up anyone that is waiting for a stream acknowledgement on this connection.
+    // Taking the lock ensures that the waiting thread is either before its check of the
+    // connection status or already waiting
+    {
+        const std::unique_lock lock(_streamAckMutex);
+    }
+    _streamAckCond.notify_all();
+
+    notifyUpdate();
+}
+
+int Network::encodeDelta(const void* previous, int previousLength, const void* data,
+                         int length, std::vector<char>& buffer)
+{
+    ZoneScoped;
+
+    const char* prev = reinterpret_cast<const char*>(previous);
+    const char* curr = reinterpret_cast<const char*>(data);
+
+    // A delta that is not smaller than the data is useless, so that is all the space we
+    // will ever need
+    if (static_cast<int>(buffer.size()) < length) {
+        buffer.resize(length);
+    }
+    int size = 0;
+    uint32_t nRuns = 0;
+    auto append = [&](const void* src, int n) {
+        if (size + n >= length) {
+            return false;
+        }
+        std::memcpy(buffer.data() + size, src, n);
+        size += n;
+        return true;
+    };
+    auto appendRun = [&](int offset, int runLength) {
+        const uint32_t o = static_cast<uint32_t>(offset);
+        const uint32_t l = static_cast<uint32_t>(runLength);
+        nRuns++;
+        return append(&o, sizeof(o)) && append(&l, sizeof(l)) &&
+               append(curr + offset, runLength);
+    };
+
+    // The number of runs is filled in at the end
+    const uint32_t totalLength = static_cast<uint32_t>(length);
+    if (!append(&totalLength, sizeof(totalLength)) || !append(&nRuns, sizeof(nRuns))) {
+        return 0;
+    }
+
+    const int common = std::min(previousLength, length);
+    int i = 0;
+    while (i < common) {
+        // Skip over the unchanged data a word at a time
+        while (i + 8 <= common && std::memcmp(prev + i, curr + i, 8) == 0) {
+            i += 8;
+        }
+        while (i < common && prev[i] == curr[i]) {
+            i++;
+        }
+        if (i == common) {
+            break;
+        }
+
+        // Extend the run until there is a long enough unchanged stretch
+        const int begin = i;
+        int end = i + 1;
+        while (i < common && i - end < MinDeltaGap) {
+            if (prev[i] != curr[i]) {
+                end = i + 1;
+            }
+            i++;
+        }
+        if (!appendRun(begin, end - begin)) {
+            return 0;
+        }
+    }
+
+    // Everything that is past the end of the previous data is new
+    if (length > common && !appendRun(common, length - common)) {
+        return 0;
+    }
+
+    std::memcpy(buffer.data() + sizeof(totalLength), &nRuns, sizeof(nRuns));
+    return size;
+}
+
+void Network::applyDelta(const void* delta, int length, std::vector<char>& data) {
+    ZoneScoped;
+
+    const char* d = reinterpret_cast<const char*>(delta);
+    const char* end = d + length;
+
+    auto check = [](bool isValid) {
+        if (!isValid) {
+            throw Err(5016, "Malformed delta encoded sync message");
+        }
+    };
+    auto read = [&](uint32_t& value) {
+        check(end - d >= static_cast<std::ptrdiff_t>(sizeof(value)));
+        std::memcpy(&value, d, sizeof(value));
+        d += sizeof(value);
+    };
+
+    uint32_t totalLength = 0;
+    read(totalLength);
+    uint32_t nRuns = 0;
+    read(nRuns);
+
+    // All runs are checked before the data is changed. A delta that was cut off at the
+    // end of a run is caught by the number of runs, and a corrupted total length by the
+    // last run having to fill the data up to that length if it grows
+    const char* runs = d;
+    uint32_t lastOffset = 0;
+    uint32_t lastEnd = 0;
+    for (uint32_t i = 0; i < nRuns; i++) {
+        uint32_t offset = 0;
+        read(offset);
+        uint32_t runLength = 0;
+        read(runLength);
+        check(
+            offset <= totalLength && runLength <= totalLength - offset &&
+            end - d >= static_cast<std::ptrdiff_t>(runLength)
+        );
+        d += runLength;
+        lastOffset = offset;
+        lastEnd = offset + runLength;
+    }
+    check(d == end);
+    check(
+        totalLength <= data.size() ||
+        (nRuns > 0 && lastOffset <= data.size() && lastEnd == totalLength)
+    );
+
+    data.resize(totalLength);
+    d = runs;
+    for (uint32_t i = 0; i < nRuns; i++) {
+        uint32_t offset = 0;
+        read(offset);
+        uint32_t runLength = 0;
+        read(runLength);
+        std::memcpy(data.data() + offset, d, runLength);
+        d += runLength;
+    }
 }
 
 bool Network::isConnected() const {
     return _isConnected;
 }
 
+bool Network::acceptsCompression() const {
+    return _acceptsCompression;
+}
+
+bool Network::acceptsDelta() const {
+    return _acceptsDelta;
+}
+
+bool Network::acceptsMulticast() const {
+    return _acceptsMulticast;
+}
+
+bool Network::acceptsFrameTiming() const {
+    return _acceptsFrameTiming;
+}
+
+std::optional<Network::FrameTiming> Network::frameTiming() const {
+    const std::unique_lock lock(_frameTimingMutex);
+    return _frameTiming;
+}
+
+bool Network::exchangeNeedsKeyframe() {
+    return _needsKeyframe.exchange(false);
+}
+
 Network::ConnectionType Network::type() const {
     const std::unique_lock lock(_connectionMutex);
     return _connectionType;
@@ -460,24 +906,23 @@ void Network::updateBuffer(std::vector<char>& buffer, uint32_t reqSize,
     currSize = reqSize;
 }
 
-int Network::readSyncMessage(char* header, int32_t& syncFrame, uint32_t& dataSize,
-                             uint32_t& uncompressedDataSize)
+void Network::parseHeader(const char* header, int32_t& packageId, uint32_t& dataSize,
+                          uint32_t& uncompressedDataSize)
 {
-    int iResult = receiveData(_socket, header, static_cast<int>(HeaderSize), 0);
+    _headerId = header[0];
 
-    if (iResult == static_cast<int>(HeaderSize)) {
-        _headerId = header[0];
-        if (_headerId == DataId) {
-            std::memcpy(&syncFrame, header + 1, sizeof(syncFrame));
+    if (type() == ConnectionType::SyncConnection) {
+        if (_headerId == DataId || _headerId == SyncDeltaId) {
+            std::memcpy(&packageId, header + 1, sizeof(packageId));
             std::memcpy(&dataSize, header + 5, sizeof(dataSize));
             std::memcpy(&uncompressedDataSize, header + 9, sizeof(uncompressedDataSize));
 
-            setRecvFrame(syncFrame);
-            if (syncFrame < 0) {
+            setRecvFrame(packageId);
+            if (packageId < 0) {
                 throw Err(
                     5010,
                     std::format(
-                        "Error in sync frame {} for connection {}", syncFrame, _id
+                        "Error in sync frame {} for connection {}", packageId, _id
                     )
                 );
             }
@@ -490,24 +935,22 @@ int Network::readSyncMessage(char* header, int32_t& syncFrame, uint32_t& dataSiz
                 _uncompressedBufferSize
             );
         }
+        else if (_headerId == MulticastSyncId || _headerId == MulticastNackId) {
+            // The frame number or the sequence number. Neither of the messages has a
+            // payload, the sequence number of a MulticastSyncId is read when handling it
+            std::memcpy(&packageId, header + 1, sizeof(packageId));
+        }
+        else if (_headerId == MulticastRepairId) {
+            // The sequence number followed by the size of the repeated multicast message
+            std::memcpy(&packageId, header + 1, sizeof(packageId));
+            std::memcpy(&dataSize, header + 5, sizeof(dataSize));
+            updateBuffer(_recvBuffer, dataSize, _bufferSize);
+        }
     }
-
-    // Get the data/message
-    if (dataSize > 0) {
-        iResult = receiveData(_socket, _recvBuffer.data(), dataSize, 0);
-    }
-
-    return iResult;
-}
-
-int Network::readDataTransferMessage(char* header, int32_t& packageId, uint32_t& dataSize,
-                                     uint32_t& uncompressedDataSize)
-{
-    int iResult = receiveData(_socket, header, static_cast<int>(HeaderSize), 0);
-
-    if (iResult == static_cast<int>(HeaderSize)) {
-        _headerId = header[0];
-        if (_headerId == DataId) {
+    else {
+        if (_headerId == DataId || _headerId == StreamBeginId ||
+            _headerId == StreamChunkId || _headerId == StreamAckId)
+        {
             // parse the package _id
             std::memcpy(&packageId, header + 1, sizeof(packageId));
             std::memcpy(&dataSize, header + 5, sizeof(dataSize));
@@ -526,15 +969,499 @@ int Network::readDataTransferMessage(char* header, int32_t& packageId, uint32_t&
             _acknowledgeCallback(packageId, _id);
         }
     }
+}
+
+bool Network::hasPayload(int32_t packageId, uint32_t dataSize) const {
+    if (type() == ConnectionType::SyncConnection) {
+        return dataSize > 0;
+    }
+    else {
+        return dataSize > 0 && packageId > -1;
+    }
+}
+
+int Network::readSyncMessage(char* header, int32_t& syncFrame, uint32_t& dataSize,
+                             uint32_t& uncompressedDataSize)
+{
+    int iResult = receiveData(_socket, header, static_cast<int>(HeaderSize), 0);
+
+    if (iResult == static_cast<int>(HeaderSize)) {
+        parseHeader(header, syncFrame, dataSize, uncompressedDataSize);
+    }
+
+    // Get the data/message
+    if (hasPayload(syncFrame, dataSize)) {
+        iResult = receiveData(_socket, _recvBuffer.data(), dataSize, 0);
+    }
+
+    return iResult;
+}
+
+int Network::readDataTransferMessage(char* header, int32_t& packageId, uint32_t& dataSize,
+                                     uint32_t& uncompressedDataSize)
+{
+    int iResult = receiveData(_socket, header, static_cast<int>(HeaderSize), 0);
+
+    if (iResult == static_cast<int>(HeaderSize)) {
+        parseHeader(header, packageId, dataSize, uncompressedDataSize);
+    }
 
     // Get the data/message
-    if (dataSize > 0 && packageId > -1) {
+    if (hasPayload(packageId, dataSize)) {
         iResult = receiveData(_socket, _recvBuffer.data(), dataSize, 0);
     }
 
     return iResult;
 }
 
+void Network::sendCapabilities() const {
+    uint32_t capabilities = CapabilityCompression;
+    if (!_isServer || _sendsDelta) {
+        capabilities |= CapabilityDelta;
+    }
+    if (_multicastReceiver) {
+        capabilities |= CapabilityMulticast;
+    }
+    if (_isServer) {
+        capabilities |= CapabilityFrameTiming;
+    }
+    const uint32_t dataSize = 0;
+
+    std::array<char, HeaderSize> data = {};
+    data[0] = CapabilityId;
+    std::memcpy(data.data() + 1, &capabilities, sizeof(capabilities));
+    std::memcpy(data.data() + 5, &dataSize, sizeof(dataSize));
+    std::memset(data.data() + 9, DefaultId, 4);
+    sendData(data.data(), HeaderSize);
+}
+
+void Network::sendAcknowledge(int packageId) const {
+    const uint32_t dataSize = 0;
+
+    std::array<char, HeaderSize> data = {};
+    data[0] = Ack;
+    std::memcpy(data.data() + 1, &packageId, sizeof(packageId));
+    std::memcpy(data.data() + 5, &dataSize, sizeof(dataSize));
+    sendData(data.data(), HeaderSize);
+}
+
+void Network::sendStreamAck(int packageId, int64_t bytes) const {
+    const uint32_t dataSize = sizeof(bytes);
+
+    std::array<char, HeaderSize> data = {};
+    data[0] = StreamAckId;
+    std::memcpy(data.data() + 1, &packageId, sizeof(packageId));
+    std::memcpy(data.data() + 5, &dataSize, sizeof(dataSize));
+    sendData(data.data(), HeaderSize, &bytes, sizeof(bytes));
+}
+
+void Network::sendStreamBegin(int packageId, int64_t totalSize) {
+    {
+        const std::unique_lock lock(_streamAckMutex);
+        _streamAckPackageId = packageId;
+        _streamAckBytes = -1;
+    }
+
+    const uint32_t dataSize = sizeof(totalSize);
+
+    std::array<char, HeaderSize> data = {};
+    data[0] = StreamBeginId;
+    std::memcpy(data.data() + 1, &packageId, sizeof(packageId));
+    std::memcpy(data.data() + 5, &dataSize, sizeof(dataSize));
+    sendData(data.data(), HeaderSize, &totalSize, sizeof(totalSize));
+}
+
+void Network::sendStreamChunk(int packageId, int64_t offset, const void* data,
+                              int length, int uncompressedLength) const
+{
+    // The payload starts with the offset of the chunk, which is never compressed
+    const uint32_t dataSize = static_cast<uint32_t>(sizeof(offset) + length);
+
+    std::array<char, HeaderSize> header = {};
+    header[0] = StreamChunkId;
+    std::memcpy(header.data() + 1, &packageId, sizeof(packageId));
+    std::memcpy(header.data() + 5, &dataSize, sizeof(dataSize));
+    std::memcpy(header.data() + 9, &uncompressedLength, sizeof(uncompressedLength));
+    const std::array<Buffer, 2> buffers = {
+        Buffer{ &offset, static_cast<int>(sizeof(offset)) },
+        Buffer{ data, length }
+    };
+    sendData(header.data(), HeaderSize, buffers);
+}
+
+std::optional<int64_t> Network::waitForStreamAck(int packageId, int64_t bytes,
+                                                 std::chrono::milliseconds timeout)
+{
+    std::unique_lock lock(_streamAckMutex);
+    const bool isAcknowledged = _streamAckCond.wait_for(
+        lock,
+        timeout,
+        [&]() {
+            return !_isConnected || _shouldTerminate ||
+                   (_streamAckPackageId == packageId && _streamAckBytes > bytes);
+        }
+    );
+    if (!isAcknowledged || !_isConnected || _shouldTerminate) {
+        return std::nullopt;
+    }
+    return _streamAckBytes;
+}
+
+void Network::setStreamAck(int packageId, int64_t bytes) {
+    {
+        const std::unique_lock lock(_streamAckMutex);
+        if (packageId != _streamAckPackageId) {
+            // A late acknowledgement of a stream that we have already given up on
+            return;
+        }
+        _streamAckBytes = std::max(_streamAckBytes, bytes);
+    }
+    _streamAckCond.notify_all();
+}
+
+void Network::beginStream(int packageId, int64_t totalSize) {
+    if (packageId != _streamPackageId || totalSize != _streamTotalSize) {
+        int64_t offset = 0;
+        if (_streamResumeCallback) {
+            offset = std::clamp<int64_t>(
+                _streamResumeCallback(packageId, totalSize),
+                0,
+                totalSize
+            );
+        }
+
+        _streamPackageId = packageId;
+        _streamTotalSize = totalSize;
+        _streamReceived = offset;
+
+        _streamBuffer.clear();
+        if (!_streamDecoderCallback && _packageDecoderCallback) {
+            if (totalSize > std::numeric_limits<int>::max()) {
+                Log::Error(
+                    "Stream {} with {} bytes is too large to be assembled in memory. "
+                    "Provide a function to receive the individual chunks instead",
+                    packageId, totalSize
+                );
+            }
+            else {
+                _streamBuffer.resize(totalSize);
+            }
+        }
+    }
+
+    Log::Debug(
+        "Receiving stream {} on connection {} from byte {} of {}",
+        packageId, _id, _streamReceived, totalSize
+    );
+    _nStreamChunksSinceAck = 0;
+
+    // Tell the sender where to continue
+    sendStreamAck(packageId, _streamReceived);
+    if (_streamReceived == _streamTotalSize) {
+        receiveStreamChunk(packageId, _streamReceived, nullptr, 0);
+    }
+}
+
+void Network::receiveStreamChunk(int packageId, int64_t offset, const char* data,
+                                 int length)
+{
+    if (packageId != _streamPackageId || offset + length > _streamTotalSize) {
+        throw Err(
+            5017,
+            std::format(
+                "Unexpected chunk for stream {} on connection {}", packageId, _id
+            )
+        );
+    }
+
+    if (offset != _streamReceived) {
+        // A chunk that was sent before the stream was resumed, or one that the sender
+        // sent after it resumed from an outdated acknowledgement. The sender continues
+        // with increasing offsets, so it reaches our position again
+        Log::Debug(
+            "Ignoring chunk at byte {} of stream {} on connection {}, expected byte {}",
+            offset, packageId, _id, _streamReceived
+        );
+        return;
+    }
+
+    if (length > 0) {
+        if (_streamDecoderCallback) {
+            _streamDecoderCallback(
+                data,
+                length,
+                _streamReceived,
+                _streamTotalSize,
+                packageId,
+                _id
+            );
+        }
+        else if (!_streamBuffer.empty()) {
+            std::memcpy(_streamBuffer.data() + _streamReceived, data, length);
+        }
+        _streamReceived += length;
+        _nStreamChunksSinceAck++;
+
+        const bool isDone = _streamReceived == _streamTotalSize;
+        if (isDone || _nStreamChunksSinceAck >= StreamAckInterval) {
+            sendStreamAck(packageId, _streamReceived);
+            _nStreamChunksSinceAck = 0;
+        }
+    }
+
+    if (_streamReceived < _streamTotalSize) {
+        return;
+    }
+
+    // The stream is complete
+    if (!_streamDecoderCallback && _packageDecoderCallback &&
+        static_cast<int64_t>(_streamBuffer.size()) == _streamTotalSize)
+    {
+        _packageDecoderCallback(
+            _streamBuffer.data(),
+            static_cast<int>(_streamTotalSize),
+            packageId,
+            _id
+        );
+    }
+    sendAcknowledge(packageId);
+
+    _streamPackageId = -1;
+    _streamTotalSize = 0;
+    _streamReceived = 0;
+    _streamBuffer.clear();
+    _streamBuffer.shrink_to_fit();
+}
+
+char* Network::uncompressedPayload(uint32_t dataSize, uint32_t uncompressedDataSize) {
+    if (uncompressedDataSize == 0) {
+        return _recvBuffer.data();
+    }
+
+    uncompressData(
+        _recvBuffer.data(),
+        static_cast<int>(dataSize),
+        _uncompressBuffer.data(),
+        static_cast<int>(uncompressedDataSize)
+    );
+    return _uncompressBuffer.data();
+}
+
+bool Network::decodeSyncMessage(char id, const char* data, uint32_t dataSize,
+                                uint32_t uncompressedDataSize)
+{
+    const char* payload = data;
+    uint32_t size = dataSize;
+    if (uncompressedDataSize > 0) {
+        updateBuffer(_uncompressBuffer, uncompressedDataSize, _uncompressedBufferSize);
+        uncompressData(
+            data,
+            static_cast<int>(dataSize),
+            _uncompressBuffer.data(),
+            static_cast<int>(uncompressedDataSize)
+        );
+        payload = _uncompressBuffer.data();
+        size = uncompressedDataSize;
+    }
+
+    if (id == DataId) {
+        if (size > 0) {
+            decoderCallback(payload, static_cast<int>(size));
+
+            // Keep a copy in case the next message is delta encoded, which only happens
+            // if the server has announced it
+            if (_acceptsDelta) {
+                _syncBaseline.assign(payload, payload + size);
+            }
+        }
+        else {
+            _syncBaseline.clear();
+        }
+        _hasLostSyncBaseline = false;
+        return true;
+    }
+    else if (!_hasLostSyncBaseline) {
+        applyDelta(payload, static_cast<int>(size), _syncBaseline);
+        decoderCallback(_syncBaseline.data(), static_cast<int>(_syncBaseline.size()));
+        return true;
+    }
+
+    // The delta is relative to a message that was never received
+    return false;
+}
+
+void Network::receiveMulticastSync(int32_t frame, uint32_t sequence) {
+    ZoneScoped;
+
+    {
+        const std::unique_lock lock(_multicastMutex);
+        PendingMulticast& p = _pendingMulticasts.emplace_back();
+        p.frame = frame;
+        p.sequence = sequence;
+    }
+
+    // The datagrams are waited for on the receiver's threads so that this thread, which
+    // might be shared with other connections, never blocks
+    _multicastReceiver->takeAsync(
+        sequence,
+        MulticastTimeout,
+        [this](uint32_t s, std::vector<char>* message) { completeMulticast(s, message); }
+    );
+}
+
+void Network::completeMulticast(uint32_t sequence, std::vector<char>* message) {
+    const std::unique_lock lock(_multicastMutex);
+    const auto it = std::find_if(
+        _pendingMulticasts.begin(),
+        _pendingMulticasts.end(),
+        [sequence](const PendingMulticast& p) {
+            return p.sequence == sequence && p.state == PendingMulticast::State::Waiting;
+        }
+    );
+    if (it == _pendingMulticasts.end()) {
+        // The connection was reset since the message was requested
+        return;
+    }
+
+    if (message) {
+        std::swap(it->message, *message);
+        it->state = PendingMulticast::State::Received;
+        decodePendingMulticasts();
+    }
+    else {
+        Log::Debug(
+            "Requesting multicast message {} for frame {} on connection {}",
+            sequence, it->frame, _id
+        );
+        it->state = PendingMulticast::State::Requested;
+        sendMulticastNack(sequence);
+    }
+}
+
+void Network::receiveMulticastRepair(uint32_t sequence, uint32_t dataSize) {
+    ZoneScoped;
+
+    const std::unique_lock lock(_multicastMutex);
+    const auto it = std::find_if(
+        _pendingMulticasts.begin(),
+        _pendingMulticasts.end(),
+        [sequence](const PendingMulticast& p) {
+            return p.sequence == sequence &&
+                   p.state == PendingMulticast::State::Requested;
+        }
+    );
+    if (it == _pendingMulticasts.end()) {
+        Log::Warning(
+            "Unexpected repeated multicast message {} on connection {}", sequence, _id
+        );
+        return;
+    }
+
+    if (dataSize > 0) {
+        it->message.assign(_recvBuffer.data(), _recvBuffer.data() + dataSize);
+        it->state = PendingMulticast::State::Received;
+    }
+    else {
+        it->state = PendingMulticast::State::Lost;
+    }
+    decodePendingMulticasts();
+}
+
+void Network::decodePendingMulticasts() {
+    // Called with the _multicastMutex held. The messages are decoded in the order in
+    // which they were sent, so a message has to wait for all of the previous ones
+    bool hasUpdated = false;
+    while (!_pendingMulticasts.empty()) {
+        const PendingMulticast::State state = _pendingMulticasts.front().state;
+        if (state != PendingMulticast::State::Received &&
+            state != PendingMulticast::State::Lost)
+        {
+            break;
+        }
+
+        // Removed first so that a malformed message does not block the following ones
+        const PendingMulticast p = std::move(_pendingMulticasts.front());
+        _pendingMulticasts.pop_front();
+
+        bool isDecoded = false;
+        if (p.state == PendingMulticast::State::Received) {
+            isDecoded = !decoderCallback || decodeMulticastMessage(
+                p.message.data(),
+                static_cast<uint32_t>(p.message.size())
+            );
+        }
+        else if (p.state == PendingMulticast::State::Lost) {
+            // The server no longer has the message, so the following delta encoded
+            // messages can not be applied until the server sends the next complete one
+            Log::Warning(
+                "Multicast message {} is no longer available on connection {}",
+                p.sequence, _id
+            );
+            _hasLostSyncBaseline = true;
+        }
+
+        // Only a frame that was actually applied counts as received, so the frame lock
+        // keeps waiting until the server sends the next complete message
+        if (isDecoded) {
+            setRecvFrame(p.frame);
+            hasUpdated = true;
+        }
+    }
+
+    if (hasUpdated) {
+        notifyUpdate();
+    }
+}
+
+bool Network::decodeMulticastMessage(const char* message, uint32_t length) {
+    // A multicast message is a complete sync message including its header
+    uint32_t dataSize = 0;
+    uint32_t uncompressedDataSize = 0;
+    if (length >= HeaderSize) {
+        std::memcpy(&dataSize, message + 5, sizeof(dataSize));
+        std::memcpy(&uncompressedDataSize, message + 9, sizeof(uncompressedDataSize));
+    }
+
+    const char id = length >= HeaderSize ? message[0] : DefaultId;
+    if ((id != DataId && id != SyncDeltaId) || dataSize != length - HeaderSize) {
+        throw Err(
+            5045,
+            std::format("Malformed multicast sync message on connection {}", _id)
+        );
+    }
+
+    return decodeSyncMessage(id, message + HeaderSize, dataSize, uncompressedDataSize);
+}
+
+void Network::sendMulticastNack(uint32_t sequence) const {
+    std::array<char, HeaderSize> data = {};
+    data[0] = MulticastNackId;
+    std::memcpy(data.data() + 1, &sequence, sizeof(sequence));
+    sendData(data.data(), HeaderSize);
+}
+
+void Network::sendMulticastRepair(uint32_t sequence) {
+    ZoneScoped;
+
+    std::vector<char> message;
+    if (!_multicastSender || !_multicastSender->message(sequence, message)) {
+        // The client is told that the message is gone and the next message it receives
+        // has to be a complete one
+        Log::Warning(
+            "Multicast message {} requested by connection {} is no longer available",
+            sequence, _id
+        );
+        _needsKeyframe = true;
+    }
+
+    const uint32_t dataSize = static_cast<uint32_t>(message.size());
+    std::array<char, HeaderSize> header = {};
+    header[0] = MulticastRepairId;
+    std::memcpy(header.data() + 1, &sequence, sizeof(sequence));
+    std::memcpy(header.data() + 5, &dataSize, sizeof(dataSize));
+    sendData(header.data(), HeaderSize, message.data(), static_cast<int>(dataSize));
+}
+
 int Network::readExternalMessage() {
     long iResult = recv(_socket, _recvBuffer.data(), _bufferSize, 0);
 
@@ -546,15 +1473,160 @@ int Network::readExternalMessage() {
     while (iResult <= 0 && SGCT_ERRNO == EINTR && attempts <= MaxNumberOfAttempts) {
 #endif // WIN32
         iResult = recv(_socket, _recvBuffer.data(), _bufferSize, 0);
-        Log::Info(std::format(
+        Log::Info(
             "Receiving data after interrupted system error (attempt {})", attempts
-        ));
+        );
         attempts++;
     }
 
     return static_cast<int>(iResult);
 }
 
+bool Network::handleMessage(const char* header, int32_t packageId, uint32_t dataSize,
+                            uint32_t uncompressedDataSize)
+{
+    if (_headerId == CapabilityId) {
+        uint32_t capabilities = 0;
+        std::memcpy(&capabilities, header + 1, sizeof(capabilities));
+        _acceptsCompression = (capabilities & CapabilityCompression) != 0;
+        _acceptsDelta = (capabilities & CapabilityDelta) != 0;
+        // Only a server that sends multicast messages can make use of the capability
+        _acceptsMulticast =
+            (capabilities & CapabilityMulticast) != 0 && _multicastSender != nullptr;
+        _acceptsFrameTiming = (capabilities & CapabilityFrameTiming) != 0;
+        Log::Debug(
+            "Connection {} {} compressed and {} delta encoded messages{}{}",
+            _id, _acceptsCompression ? "accepts" : "does not accept",
+            _acceptsDelta ? "accepts" : "does not accept",
+            _acceptsMulticast ? " and receives multicast messages" : "",
+            _acceptsFrameTiming ? " and collects frame timing" : ""
+        );
+    }
+    else if (type() == ConnectionType::SyncConnection) {
+        // handle sync disconnect
+        if (isDisconnectPackage(header)) {
+            setConnectedStatus(false);
+
+            // Terminate client only. The server only resets the connection,
+            // allowing clients to connect.
+            if (!_isServer) {
+                _shouldTerminate = true;
+            }
+
+            Log::Info("Client {} terminated connection", _id);
+            return false;
+        }
+        // handle sync communication. The acknowledgement of a client can carry the
+        // timing of its most recent frame
+        if (_isServer && _headerId == DataId && dataSize == FrameTimingSize &&
+            uncompressedDataSize == 0)
+        {
+            const FrameTiming timing = readFrameTiming(_recvBuffer.data());
+            {
+                const std::unique_lock lock(_frameTimingMutex);
+                _frameTiming = timing;
+            }
+            notifyUpdate();
+        }
+        else if ((_headerId == DataId || _headerId == SyncDeltaId) && decoderCallback) {
+            decodeSyncMessage(
+                _headerId,
+                _recvBuffer.data(),
+                dataSize,
+                uncompressedDataSize
+            );
+            notifyUpdate();
+        }
+        else if (_headerId == MulticastSyncId && decoderCallback &&
+                 _multicastReceiver)
+        {
+            uint32_t sequence = 0;
+            std::memcpy(&sequence, header + 5, sizeof(sequence));
+            receiveMulticastSync(packageId, sequence);
+        }
+        else if (_headerId == MulticastRepairId && decoderCallback) {
+            receiveMulticastRepair(static_cast<uint32_t>(packageId), dataSize);
+        }
+        else if (_headerId == MulticastNackId) {
+            sendMulticastRepair(static_cast<uint32_t>(packageId));
+        }
+        else if (_headerId == ConnectedId && _connectedCallback) {
+            _connectedCallback();
+            notifyUpdate();
+        }
+    }
+    // handle data transfer communication
+    else if (type() == ConnectionType::DataTransfer) {
+        // Disconnect if requested
+        if (isDisconnectPackage(header)) {
+            setConnectedStatus(false);
+            Log::Info("File connection {} terminated", _id);
+        }
+        //  Handle communication
+        else {
+            if (_headerId == DataId && _packageDecoderCallback && dataSize > 0) {
+                char* payload = uncompressedPayload(dataSize, uncompressedDataSize);
+                const uint32_t size =
+                    uncompressedDataSize > 0 ? uncompressedDataSize : dataSize;
+                _packageDecoderCallback(
+                    payload,
+                    static_cast<int>(size),
+                    packageId,
+                    _id
+                );
+
+                // send acknowledge
+                sendAcknowledge(packageId);
+
+                {
+                    // Clear the buffers
+                    const std::unique_lock lk(_connectionMutex);
+
+                    _recvBuffer.clear();
+                    _uncompressBuffer.clear();
+
+                    _bufferSize = 0;
+                    _uncompressedBufferSize = 0;
+                }
+            }
+            else if (_headerId == StreamBeginId && dataSize == sizeof(int64_t)) {
+                int64_t totalSize = 0;
+                std::memcpy(&totalSize, _recvBuffer.data(), sizeof(totalSize));
+                beginStream(packageId, totalSize);
+            }
+            else if (_headerId == StreamChunkId && dataSize > sizeof(int64_t)) {
+                // The payload starts with the offset of the chunk in the stream
+                int64_t offset = 0;
+                std::memcpy(&offset, _recvBuffer.data(), sizeof(offset));
+                const char* payload = _recvBuffer.data() + sizeof(offset);
+                uint32_t size = dataSize - sizeof(offset);
+                if (uncompressedDataSize > 0) {
+                    uncompressData(
+                        payload,
+                        static_cast<int>(size),
+                        _uncompressBuffer.data(),
+                        static_cast<int>(uncompressedDataSize)
+                    );
+                    payload = _uncompressBuffer.data();
+                    size = uncompressedDataSize;
+                }
+                receiveStreamChunk(packageId, offset, payload, static_cast<int>(size));
+            }
+            else if (_headerId == StreamAckId && dataSize == sizeof(int64_t)) {
+                int64_t bytes = 0;
+                std::memcpy(&bytes, _recvBuffer.data(), sizeof(bytes));
+                setStreamAck(packageId, bytes);
+            }
+            else if (_headerId == ConnectedId && _connectedCallback) {
+                _connectedCallback();
+                notifyUpdate();
+            }
+        }
+    }
+
+    return true;
+}
+
 void Network::communicationHandler() {
     if (_shouldTerminate) {
         return;
@@ -563,7 +1635,7 @@ void Network::communicationHandler() {
     // listen for client if server
     if (_isServer) {
         Log::Info(
-            std::format("Waiting for client {} to connect on port {}", _id, _port)
+            "Waiting for client {} to connect on port {}", _id, _port
         );
 
         _socket = accept(_listenSocket, nullptr, nullptr);
@@ -574,14 +1646,14 @@ void Network::communicationHandler() {
         while (!_shouldTerminate && _socket == INVALID_SOCKET && SGCT_ERRNO == EINTR) {
 #endif // WIN32
             Log::Info(
-                std::format("Re-accept after interrupted system on connection {}", _id)
+                "Re-accept after interrupted system on connection {}", _id
             );
             _socket = accept(_listenSocket, nullptr, nullptr);
         }
 
         if (_socket == INVALID_SOCKET) {
             Log::Error(
-                std::format("Accept connection {} failed. Error: {}", _id, SGCT_ERRNO)
+                "Accept connection {} failed. Error: {}", _id, SGCT_ERRNO
             );
 
             if (_updateCallback) {
@@ -591,8 +1663,32 @@ void Network::communicationHandler() {
         }
     }
 
+    // Tell the other side which message features we understand. This has to happen
+    // before the connection is marked as connected as no other thread is allowed to send
+    // on this socket until then
+    _acceptsCompression = false;
+    _acceptsDelta = false;
+    _acceptsMulticast = false;
+    _acceptsFrameTiming = false;
+    _needsKeyframe = true;
+    if (_multicastReceiver) {
+        // Nothing that was requested through the previous connection is decoded
+        _multicastReceiver->cancel();
+    }
+    {
+        const std::unique_lock lock(_multicastMutex);
+        _pendingMulticasts.clear();
+    }
+    _syncBaseline.clear();
+    _hasLostSyncBaseline = false;
+    {
+        const std::unique_lock lock(_frameTimingMutex);
+        _frameTiming = std::nullopt;
+    }
+    sendCapabilities();
+
     setConnectedStatus(true);
-    Log::Info(std::format("Connection {} established", _id));
+    Log::Info("Connection {} established", _id);
 
     if (_updateCallback) {
         _updateCallback(*this);
@@ -608,14 +1704,23 @@ void Network::communicationHandler() {
         _uncompressBuffer.resize(_uncompressedBufferSize);
     }
 
+    if (_reactor) {
+        // From here on, the messages are received on the reactor's I/O threads and this
+        // thread is no longer needed
+        _isReadingPayload = false;
+        _nPendingBytes = 0;
+        _reactor->add(*this);
+        return;
+    }
+
     // Receive data until the server closes the connection
     int iResult = 0;
     do {
         // resize buffer request
         if (type() != ConnectionType::DataTransfer && _requestedSize > _bufferSize) {
-            Log::Info(std::format(
+            Log::Info(
                 "Re-sizing buffer {} -> {}", _bufferSize, _requestedSize.load()
-            ));
+            );
             updateBuffer(_recvBuffer, _requestedSize, _bufferSize);
         }
         int32_t packageId = -1;
@@ -625,10 +1730,9 @@ void Network::communicationHandler() {
         _headerId = DefaultId;
 
         if (type() == ConnectionType::SyncConnection) {
-            int32_t syncFrameNumber = -1;
             iResult = readSyncMessage(
                 RecvHeader.data(),
-                syncFrameNumber,
+                packageId,
                 dataSize,
                 uncompressedDataSize
             );
@@ -648,7 +1752,7 @@ void Network::communicationHandler() {
         // handle failed receive
         if (iResult == 0) {
             setConnectedStatus(false);
-            Log::Info(std::format("TCP connection {} closed", _id));
+            Log::Info("TCP connection {} closed", _id);
         }
         else if (iResult < 0) {
             setConnectedStatus(false);
@@ -658,74 +1762,115 @@ void Network::communicationHandler() {
             );
         }
 
-        if (type() == ConnectionType::SyncConnection) {
-            // handle sync disconnect
-            if (isDisconnectPackage(RecvHeader.data())) {
-                setConnectedStatus(false);
-
-                // Terminate client only. The server only resets the connection,
-                // allowing clients to connect.
-                if (!_isServer) {
-                    _shouldTerminate = true;
-                }
+        // A message that can not be handled closes the connection, the same as on the
+        // reactor's threads, so that the remote end can establish it again instead of
+        // the connection being counted while nobody reads from it
+        bool isOpen = false;
+        try {
+            isOpen = handleMessage(
+                RecvHeader.data(),
+                packageId,
+                dataSize,
+                uncompressedDataSize
+            );
+        }
+        catch (const std::runtime_error& e) {
+            Log::Error(e.what());
+        }
+        if (!isOpen) {
+            break;
+        }
+    } while (iResult > 0 || _isConnected);
 
-                Log::Info(std::format("Client {} terminated connection", _id));
-                break;
-            }
-            // handle sync communication
-            if (_headerId == DataId && decoderCallback) {
-                if (dataSize > 0) {
-                    decoderCallback(_recvBuffer.data(), dataSize);
-                }
+    finishConnection();
+}
 
-                NetworkManager::cond.notify_all();
-            }
-            else if (_headerId == ConnectedId && _connectedCallback) {
-                _connectedCallback();
-                NetworkManager::cond.notify_all();
-            }
+bool Network::receiveAvailable() {
+    ZoneScoped;
+
+    bool hasReceived = false;
+    while (true) {
+        // Only read what is already there so that this call never blocks. If the socket
+        // was reported as readable but nothing is available, the remote end has closed
+        // the connection and reading a single byte is enough to find out
+        const int available = bytesAvailable(_socket);
+        if (available < 0 || (available == 0 && hasReceived)) {
+            return available == 0;
         }
-        // handle data transfer communication
-        else if (type() == ConnectionType::DataTransfer) {
-            // Disconnect if requested
-            if (isDisconnectPackage(RecvHeader.data())) {
-                setConnectedStatus(false);
-                Log::Info(std::format("File connection {} terminated", _id));
-            }
-            //  Handle communication
-            else {
-                if (_headerId == DataId && _packageDecoderCallback && dataSize > 0) {
-                    _packageDecoderCallback(_recvBuffer.data(), dataSize, packageId, _id);
-
-                    // send acknowledge
-                    uint32_t pLength = 0;
-                    std::array<char, HeaderSize> sendBuffer = {};
-                    sendBuffer[0] = Ack;
-                    std::memcpy(sendBuffer.data() + 1, &packageId, sizeof(packageId));
-                    std::memcpy(sendBuffer.data() + 5, &pLength, sizeof(pLength));
-                    sendData(sendBuffer.data(), HeaderSize);
-
-                    {
-                        // Clear the buffers
-                        const std::unique_lock lk(_connectionMutex);
-
-                        _recvBuffer.clear();
-                        _uncompressBuffer.clear();
-
-                        _bufferSize = 0;
-                        _uncompressedBufferSize = 0;
-                    }
-                }
-                else if (_headerId == ConnectedId && _connectedCallback) {
-                    _connectedCallback();
-                    NetworkManager::cond.notify_all();
-                }
+
+        char* destination = _isReadingPayload ?
+            _recvBuffer.data() + _nPendingBytes :
+            _pendingHeader.data() + _nPendingBytes;
+        const uint32_t size = _isReadingPayload ? _pendingDataSize : HeaderSize;
+        const int remaining = static_cast<int>(size - _nPendingBytes);
+        const int length = available == 0 ? 1 : std::min(available, remaining);
+
+        const long res = recv(_socket, destination, length, 0);
+        if (res == 0) {
+            Log::Info("TCP connection {} closed", _id);
+            return false;
+        }
+#ifdef WIN32
+        if (res < 0 && SGCT_ERRNO == WSAEINTR) {
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        if (res < 0 && SGCT_ERRNO == EINTR) {
+#endif // WIN32
+            continue;
+        }
+        if (res < 0) {
+            Log::Error(
+                "TCP connection {} receive failed: {}", _id, SGCT_ERRNO
+            );
+            return false;
+        }
+
+        hasReceived = true;
+        _nPendingBytes += static_cast<uint32_t>(res);
+        if (_nPendingBytes < size) {
+            continue;
+        }
+        _nPendingBytes = 0;
+
+        if (!_isReadingPayload) {
+            _pendingPackageId = -1;
+            _pendingDataSize = 0;
+            _pendingUncompressedDataSize = 0;
+            parseHeader(
+                _pendingHeader.data(),
+                _pendingPackageId,
+                _pendingDataSize,
+                _pendingUncompressedDataSize
+            );
+
+            if (hasPayload(_pendingPackageId, _pendingDataSize)) {
+                _isReadingPayload = true;
+                continue;
             }
         }
-    } while (iResult > 0 || _isConnected);
+        _isReadingPayload = false;
 
+        const bool isOpen = handleMessage(
+            _pendingHeader.data(),
+            _pendingPackageId,
+            _pendingDataSize,
+            _pendingUncompressedDataSize
+        );
+        if (!isOpen) {
+            return false;
+        }
+    }
+}
+
+void Network::finishConnection() {
+    setConnectedStatus(false);
+
+    if (_multicastReceiver) {
+        // A message that arrives late must not be decoded while the buffers are cleared
+        _multicastReceiver->cancel();
+    }
     _recvBuffer.clear();
     _uncompressBuffer.clear();
+    _syncBaseline.clear();
 
     // Close socket; contains mutex
     closeSocket(_socket);
@@ -734,12 +1879,13 @@ void Network::communicationHandler() {
         _updateCallback(*this);
     }
 
-    Log::Info(std::format("Node {} disconnected", _id));
+    Log::Info("Node {} disconnected", _id);
 }
 
 void Network::sendData(const void* data, int length) const {
     ZoneScoped;
 
+    const std::unique_lock lock(_sendMutex);
     long sendSize = length;
 
     while (sendSize > 0) {
@@ -757,6 +1903,34 @@ void Network::sendData(const void* data, int length) const {
     }
 }
 
+void Network::sendData(const void* header, int headerLength, const void* data,
+                       int length) const
+{
+    ZoneScoped;
+
+    std::array<IoBuffer, 2> buffers = {
+        ioBuffer(header, headerLength),
+        ioBuffer(data, length)
+    };
+    const std::unique_lock lock(_sendMutex);
+    sendBuffers(_socket, buffers.data(), buffers.size());
+}
+
+void Network::sendData(const void* header, int headerLength,
+                       std::span<const Buffer> buffers) const
+{
+    ZoneScoped;
+
+    std::vector<IoBuffer> ioBuffers;
+    ioBuffers.reserve(buffers.size() + 1);
+    ioBuffers.push_back(ioBuffer(header, headerLength));
+    for (const Buffer& b : buffers) {
+        ioBuffers.push_back(ioBuffer(b.data, b.length));
+    }
+    const std::unique_lock lock(_sendMutex);
+    sendBuffers(_socket, ioBuffers.data(), ioBuffers.size());
+}
+
 void Network::closeNetwork(bool forced) {
     ZoneScoped;
 
@@ -765,9 +1939,18 @@ void Network::closeNetwork(bool forced) {
     _connectedCallback = nullptr;
     _acknowledgeCallback = nullptr;
     _packageDecoderCallback = nullptr;
+    _streamDecoderCallback = nullptr;
+    _streamResumeCallback = nullptr;
+
+    if (_reactor) {
+        _reactor->remove(*this);
+    }
+    if (_multicastReceiver) {
+        _multicastReceiver->cancel();
+    }
 
     // release conditions
-    NetworkManager::cond.notify_all();
+    notifyUpdate();
     _startConnectionCond.notify_all();
 
     // blocking sockets -> cannot wait for thread so just kill it brutally
@@ -782,7 +1965,7 @@ void Network::closeNetwork(bool forced) {
     }
     _mainThread = nullptr;
 
-    Log::Info(std::format("Connection {} successfully terminated", _id));
+    Log::Info("Connection {} successfully terminated", _id);
 }
 
 void Network::initShutdown() {
@@ -795,7 +1978,7 @@ void Network::initShutdown() {
         sendData(GameOver.data(), HeaderSize);
     }
 
-    Log::Info(std::format("Closing connection {}", _id));
+    Log::Info("Closing connection {}", _id);
 
     {
         ZoneScopedN("Decoder callback lock");
@@ -811,6 +1994,11 @@ void Network::initShutdown() {
         _startConnectionCond.notify_all();
     }
 
+    // Make sure that the socket is no longer used by the reactor before closing it
+    if (_reactor) {
+        _reactor->remove(*this);
+    }
+
     closeSocket(_socket);
     closeSocket(_listenSocket);
 }
@@ -20,13 +20,21 @@
 #include <sgct/error.h>
 #include <sgct/format.h>
 #include <sgct/log.h>
+#include <sgct/multicast.h>
 #include <sgct/mutexes.h>
+#include <sgct/networkreactor.h>
 #include <sgct/node.h>
 #include <sgct/profiling.h>
 #include <sgct/shareddata.h>
+#include <sgct/syncfanout.h>
 #include <algorithm>
+#include <array>
 #include <cstring>
+#include <exception>
+#include <fstream>
+#include <mutex>
 #include <numeric>
+#include <thread>
 
 #ifdef WIN32
     #include <ws2tcpip.h>
@@ -43,37 +51,108 @@
 #define Error(code, msg) Error(Error::Component::Network, code, msg)
 
 namespace {
+    // The maximum number of additional threads that are used to send the sync data to
+    // the clients. The render thread always takes part in the sending as well
+    constexpr int MaxSyncFanOutThreads = 7;
 
-    void prepareTransferData(const void* data, std::vector<char>& buffer, int& length,
-                             int packageId)
+    // The number of chunks of a streamed data transfer that can be in flight before the
+    // sender waits for an acknowledgement from the receiver
+    constexpr int StreamWindowSize = 4 * sgct::Network::StreamAckInterval;
+
+    // The time after which a stream is considered to be interrupted if the receiver has
+    // not acknowledged anything and the time we wait for it to reconnect afterwards
+    constexpr std::chrono::seconds StreamTimeout(30);
+
+    std::array<char, sgct::Network::HeaderSize> transferHeader(int packageId, int length,
+                                                               int uncompressedLength)
+    {
+        std::array<char, sgct::Network::HeaderSize> header = {};
+        header[0] = sgct::Network::DataId;
+        std::memcpy(header.data() + 1, &packageId, sizeof(packageId));
+        std::memcpy(header.data() + 5, &length, sizeof(length));
+        // the uncompressed size is DefaultId if compression is not used
+        std::memcpy(header.data() + 9, &uncompressedLength, sizeof(uncompressedLength));
+        return header;
+    }
+
+    // Returns the number of compressed bytes in the buffer or 0 if the data should be
+    // sent uncompressed, either because compression is disabled, the data is too small,
+    // or compression would not make it any smaller
+    int compressIfUseful(std::span<const sgct::Network::Buffer> buffers, int length,
+                         std::vector<char>& buffer,
+                   const std::optional<sgct::NetworkManager::Compression>& compression)
     {
-        int messageLength = length;
+        if (!compression.has_value() || length < compression->threshold) {
+            return 0;
+        }
 
-        length += static_cast<int>(sgct::Network::HeaderSize);
-        buffer.resize(length);
+        ZoneScopedN("Compress");
+        return sgct::Network::compressData(buffers, buffer, compression->level);
+    }
 
-        buffer[0] = sgct::Network::DataId;
-        std::memcpy(buffer.data() + 1, &packageId, sizeof(packageId));
+    int compressIfUseful(const void* data, int length, std::vector<char>& buffer,
+                 const std::optional<sgct::NetworkManager::Compression>& compression)
+    {
+        const sgct::Network::Buffer b = { data, length };
+        return compressIfUseful(
+            std::span<const sgct::Network::Buffer>(&b, 1),
+            length,
+            buffer,
+            compression
+        );
+    }
 
-        // set uncompressed size to DefaultId since compression is not used
-        std::memset(buffer.data() + 9, sgct::Network::DefaultId, sizeof(int));
+    // Sends the buffers as a single data transfer message to all of the connections. The
+    // header is sent together with the buffers in a gathered write, so the payload is
+    // never copied unless it has to be compressed
+    void sendTransferData(std::span<const sgct::Network* const> connections,
+                          std::span<const sgct::Network::Buffer> buffers, int packageId,
+                   const std::optional<sgct::NetworkManager::Compression>& compression)
+    {
+        using namespace sgct;
 
-        // add data to buffer
-        std::memcpy(
-            buffer.data() + sgct::Network::HeaderSize,
-            data,
-            length - sgct::Network::HeaderSize
+        int length = 0;
+        for (const Network::Buffer& b : buffers) {
+            length += b.length;
+        }
+
+        const bool anyAcceptsCompression = std::any_of(
+            connections.begin(),
+            connections.end(),
+            [](const Network* c) { return c->isConnected() && c->acceptsCompression(); }
         );
+        std::vector<char> compressed;
+        const int compressedLength = anyAcceptsCompression ?
+            compressIfUseful(buffers, length, compressed, compression) :
+            0;
+
+        const std::array<char, Network::HeaderSize> header =
+            transferHeader(packageId, length, 0);
+        const std::array<char, Network::HeaderSize> compressedHeader =
+            transferHeader(packageId, compressedLength, length);
+        for (const Network* connection : connections) {
+            if (!connection->isConnected()) {
+                continue;
+            }
 
-        std::memcpy(buffer.data() + 5, &messageLength, sizeof(messageLength));
+            if (compressedLength > 0 && connection->acceptsCompression()) {
+                connection->sendData(
+                    compressedHeader.data(),
+                    Network::HeaderSize,
+                    compressed.data(),
+                    compressedLength
+                );
+            }
+            else {
+                connection->sendData(header.data(), Network::HeaderSize, buffers);
+            }
+        }
     }
 
 } // namespace
 
 namespace sgct {
 
-std::condition_variable NetworkManager::cond;
-
 NetworkManager* NetworkManager::_instance = nullptr;
 
 NetworkManager& NetworkManager::instance() {
@@ -114,6 +193,10 @@ NetworkManager::NetworkManager(NetworkMode nm,
 {
     ZoneScoped;
 
+    // The reactor does not use Winsock, so it is created first to not have to clean up
+    // Winsock if it throws
+    _reactor = std::make_unique<NetworkReactor>();
+
     Log::Debug("Initiating network API");
 #ifdef WIN32
     WORD version = MAKEWORD(2, 2);
@@ -214,7 +297,7 @@ NetworkManager::NetworkManager(NetworkMode nm,
 
     Log::Debug("Detected local addresses:");
     for (const std::string& address : _localAddresses) {
-        Log::Debug(std::format("  {}", address));
+        Log::Debug("  {}", address);
     }
 }
 
@@ -222,7 +305,8 @@ NetworkManager::~NetworkManager() {
     ZoneScoped;
 
     _isRunning = false;
-    cond.notify_all();
+
+    _syncFanOut = nullptr;
 
     // signal to terminate
     for (const std::unique_ptr<Network>& connection : _networkConnections) {
@@ -241,6 +325,9 @@ NetworkManager::~NetworkManager() {
     _networkConnections.clear();
     _syncConnections.clear();
     _dataTransferConnections.clear();
+    _multicastSender = nullptr;
+    _multicastReceiver = nullptr;
+    _reactor = nullptr;
 
 #ifdef WIN32
     WSACleanup();
@@ -309,6 +396,31 @@ void NetworkManager::initialize() {
             }
         }
 
+        if (_multicast) {
+            try {
+                if (_isServer) {
+                    _multicastSender = std::make_unique<MulticastSender>(
+                        _multicast->address,
+                        _multicast->port,
+                        _multicast->ttl,
+                        _multicast->interfaceAddress
+                    );
+                }
+                else {
+                    _multicastReceiver = std::make_unique<MulticastReceiver>(
+                        _multicast->address,
+                        _multicast->port,
+                        _multicast->interfaceAddress
+                    );
+                }
+            }
+            catch (const std::runtime_error& e) {
+                Log::Warning(
+                    "Sending the sync data through TCP only. {}", e.what()
+                );
+            }
+        }
+
         // if client
         if (!_isServer) {
             addConnection(cm.thisNode().syncPort(), remoteAddress);
@@ -323,18 +435,7 @@ void NetworkManager::initialize() {
                     remoteAddress,
                     Network::ConnectionType::DataTransfer
                 );
-                if (_dataTransferDecodeFn) {
-                    _networkConnections.back()->setPackageDecodeFunction(
-                        _dataTransferDecodeFn
-                    );
-                }
-
-                // acknowledge callback
-                if (_dataTransferAcknowledgeFn) {
-                    _networkConnections.back()->setAcknowledgeFunction(
-                        _dataTransferAcknowledgeFn
-                    );
-                }
+                setDataTransferFunctions(*_networkConnections.back());
             }
         }
 
@@ -350,7 +451,7 @@ void NetworkManager::initialize() {
                     [](const char* data, int length) {
                         std::vector<char> d(data, data + length);
                         d.push_back('\0');
-                        Log::Info(std::format("[client]: {} [end]", d.data()));
+                        Log::Info("[client]: {} [end]", d.data());
                     }
                 );
 
@@ -361,25 +462,23 @@ void NetworkManager::initialize() {
                         remoteAddress,
                         Network::ConnectionType::DataTransfer
                     );
-                    if (_dataTransferDecodeFn) {
-                        _networkConnections.back()->setPackageDecodeFunction(
-                            _dataTransferDecodeFn
-                        );
-                    }
-
-                    // acknowledge callback
-                    if (_dataTransferAcknowledgeFn) {
-                        _networkConnections.back()->setAcknowledgeFunction(
-                            _dataTransferAcknowledgeFn
-                        );
-                    }
+                    setDataTransferFunctions(*_networkConnections.back());
                 }
             }
         }
     }
 
+    if (_isServer && _syncConnections.size() > 1) {
+        const int nThreads = std::min(
+            static_cast<int>(_syncConnections.size()) - 1,
+            MaxSyncFanOutThreads
+        );
+        Log::Debug("Sending sync data with {} additional threads", nThreads);
+        _syncFanOut = std::make_unique<SyncFanOut>(nThreads);
+    }
+
     Log::Debug(
-        std::format("Cluster sync: {}", cm.firmFrameLockSyncStatus() ? "firm" : "loose")
+        "Cluster sync: {}", cm.firmFrameLockSyncStatus() ? "firm" : "loose"
     );
 }
 
@@ -387,45 +486,231 @@ void NetworkManager::clearCallbacks() {
     _dataTransferDecodeFn = nullptr;
     _dataTransferStatusFn = nullptr;
     _dataTransferAcknowledgeFn = nullptr;
+    _dataTransferChunkFn = nullptr;
+    _dataTransferResumeFn = nullptr;
+    _dataTransferProgressFn = nullptr;
 }
 
-std::optional<std::pair<double, double>> NetworkManager::sync(SyncMode sm) const {
+void NetworkManager::setCompression(std::optional<Compression> compression) {
+    _compression = std::move(compression);
+}
+
+void NetworkManager::setDataTransferStreamFunctions(
+                  std::function<void(const char*, int, int64_t, int64_t, int, int)> chunk,
+                                              std::function<int64_t(int, int64_t)> resume,
+                                 std::function<void(int, int64_t, int64_t, int)> progress)
+{
+    _dataTransferChunkFn = std::move(chunk);
+    _dataTransferResumeFn = std::move(resume);
+    _dataTransferProgressFn = std::move(progress);
+}
+
+void NetworkManager::setDeltaEncoding(std::optional<DeltaEncoding> deltaEncoding) {
+    _deltaEncoding = std::move(deltaEncoding);
+    _previousSyncPayload.clear();
+    _nFramesSinceKeyframe = 0;
+}
+
+void NetworkManager::setMulticast(std::optional<Multicast> multicast) {
+    _multicast = std::move(multicast);
+}
+
+std::optional<std::pair<double, double>> NetworkManager::sync(SyncMode sm) {
     if (_syncConnections.empty()) {
         return std::nullopt;
     }
     if (sm == SyncMode::SendDataToClients) {
+        ZoneScopedN("Send data to clients");
+
         double maxTime = -std::numeric_limits<double>::max();
         double minTime = std::numeric_limits<double>::max();
 
-        bool hasFoundConnection = false;
-        for (Network* connection : _syncConnections) {
+        const unsigned char* dataBlock = SharedData::instance().dataBlock();
+        const int currentSize =
+            SharedData::instance().dataSize() - static_cast<int>(Network::HeaderSize);
+        const char* payload =
+            reinterpret_cast<const char*>(dataBlock) + Network::HeaderSize;
+
+        // Every client that does not need a keyframe has received the previous frame, so
+        // the delta to the previous frame is computed once and shared between them
+        int deltaSize = 0;
+        if (_deltaEncoding) {
+            ZoneScopedN("Delta encoding");
+
+            _nFramesSinceKeyframe++;
+            const bool isKeyframe =
+                _nFramesSinceKeyframe >= _deltaEncoding->keyframeInterval;
+            if (isKeyframe) {
+                _nFramesSinceKeyframe = 0;
+            }
+
+            const bool anyAcceptsDelta = std::any_of(
+                _syncConnections.cbegin(),
+                _syncConnections.cend(),
+                [](const Network* c) { return c->isConnected() && c->acceptsDelta(); }
+            );
+            if (!isKeyframe && anyAcceptsDelta) {
+                deltaSize = Network::encodeDelta(
+                    _previousSyncPayload.data(),
+                    static_cast<int>(_previousSyncPayload.size()),
+                    payload,
+                    currentSize,
+                    _deltaBuffer
+                );
+            }
+            _previousSyncPayload.assign(payload, payload + currentSize);
+        }
+
+        // Each connection keeps its own frame counter, so every client gets its own copy
+        // of the header while the payload is shared between all of them
+        std::vector<SyncFanOut::Job> localJobs;
+        std::vector<SyncFanOut::Job>& jobs = _syncFanOut ? _syncFanOut->jobs : localJobs;
+        jobs.clear();
+        bool compressFull = false;
+        bool compressDelta = false;
+        // All multicast clients receive the same message, so it can only be delta
+        // encoded or compressed if every one of them is able to decode that
+        bool hasMulticast = false;
+        bool multicastDelta = true;
+        bool multicastCompressed = true;
+        for (size_t i = 0; i < _syncConnections.size(); i++) {
+            Network* connection = _syncConnections[i];
             if (!connection->isServer() || !connection->isConnected()) {
                 continue;
             }
 
-            hasFoundConnection = true;
-
             const double currentTime = connection->loopTime();
             maxTime = std::max(currentTime, maxTime);
             minTime = std::min(currentTime, minTime);
 
-            const int currentSize =
-                SharedData::instance().dataSize() - static_cast<int>(Network::HeaderSize);
+            SyncFanOut::Job job;
+            job.connection = connection;
+            job.index = static_cast<int>(i);
+            // Whatever is sent now is the baseline for the next delta. A repair that
+            // flags the connection after this point forces a keyframe next frame
+            const bool needsKeyframe = connection->exchangeNeedsKeyframe();
+            job.isDelta = deltaSize > 0 && connection->acceptsDelta() && !needsKeyframe;
+            job.isMulticast = _multicastSender && connection->acceptsMulticast();
+
+            if (job.isMulticast) {
+                hasMulticast = true;
+                multicastDelta &= job.isDelta;
+                multicastCompressed &= connection->acceptsCompression();
+            }
+            else if (connection->acceptsCompression()) {
+                (job.isDelta ? compressDelta : compressFull) = true;
+            }
+            jobs.push_back(job);
+        }
+        multicastCompressed &= hasMulticast;
+        if (multicastCompressed) {
+            (multicastDelta ? compressDelta : compressFull) = true;
+        }
+
+        // The payloads are compressed at most once per frame and only if at least one of
+        // the clients is able to decompress them
+        const int compressedFullSize = compressFull ?
+            compressIfUseful(payload, currentSize, _compressBuffer, _compression) :
+            0;
+        const int compressedDeltaSize = compressDelta ?
+            compressIfUseful(
+                _deltaBuffer.data(),
+                deltaSize,
+                _compressDeltaBuffer,
+                _compression
+            ) :
+            0;
+
+        // The multicast message is sent first so that its datagrams have usually arrived
+        // by the time the clients receive the headers through their TCP connections
+        uint32_t multicastSequence = 0;
+        if (hasMulticast) {
+            ZoneScopedN("Multicast");
+
+            const char* data = multicastDelta ? _deltaBuffer.data() : payload;
+            int length = multicastDelta ? deltaSize : currentSize;
+            int uncompressedLength = 0;
+            const int compressedSize =
+                multicastDelta ? compressedDeltaSize : compressedFullSize;
+            if (multicastCompressed && compressedSize > 0) {
+                data =
+                    multicastDelta ? _compressDeltaBuffer.data() : _compressBuffer.data();
+                uncompressedLength = length;
+                length = compressedSize;
+            }
+
+            std::array<char, Network::HeaderSize> header = {};
+            header[0] = multicastDelta ? Network::SyncDeltaId : Network::DataId;
+            std::memcpy(header.data() + 5, &length, sizeof(length));
+            std::memcpy(
+                header.data() + 9,
+                &uncompressedLength,
+                sizeof(uncompressedLength)
+            );
+
+            const std::array<Network::Buffer, 2> buffers = {
+                Network::Buffer{ header.data(), static_cast<int>(header.size()) },
+                Network::Buffer{ data, length }
+            };
+            multicastSequence = _multicastSender->send(buffers);
+        }
 
+        for (SyncFanOut::Job& job : jobs) {
             // iterate counter
-            const int currentFrame = connection->iterateFrameCounter();
+            const int currentFrame = job.connection->iterateFrameCounter();
+
+            if (job.isMulticast) {
+                // The client receives the payload through multicast
+                job.header = {};
+                job.header[0] = Network::MulticastSyncId;
+                std::memcpy(job.header.data() + 1, &currentFrame, sizeof(currentFrame));
+                std::memcpy(
+                    job.header.data() + 5,
+                    &multicastSequence,
+                    sizeof(multicastSequence)
+                );
+                job.payload = nullptr;
+                job.length = 0;
+                continue;
+            }
+
+            std::memcpy(job.header.data(), dataBlock, Network::HeaderSize);
+            job.header[0] = job.isDelta ? Network::SyncDeltaId : Network::DataId;
+            std::memcpy(job.header.data() + 1, &currentFrame, sizeof(currentFrame));
+
+            job.payload = job.isDelta ? _deltaBuffer.data() : payload;
+            job.length = job.isDelta ? deltaSize : currentSize;
+            const int compressedSize =
+                job.isDelta ? compressedDeltaSize : compressedFullSize;
+            if (compressedSize > 0 && job.connection->acceptsCompression()) {
+                std::memcpy(job.header.data() + 9, &job.length, sizeof(job.length));
+                job.payload =
+                    job.isDelta ? _compressDeltaBuffer.data() : _compressBuffer.data();
+                job.length = compressedSize;
+            }
+            std::memcpy(job.header.data() + 5, &job.length, sizeof(job.length));
+        }
 
-            unsigned char* dataBlock = SharedData::instance().dataBlock();
-            std::memcpy(dataBlock + 1, &currentFrame, sizeof(currentFrame));
-            std::memcpy(dataBlock + 5, &currentSize, sizeof(currentSize));
+        if (_syncFanOut && jobs.size() > 1) {
+            _syncFanOut->run(jobs);
+        }
+        else {
+            for (SyncFanOut::Job& job : jobs) {
+                SyncFanOut::send(job);
+            }
+        }
 
-            connection->sendData(
-                SharedData::instance().dataBlock(),
-                SharedData::instance().dataSize()
-            );
+        _syncSendTimes.assign(_syncConnections.size(), 0.0);
+        for (const SyncFanOut::Job& job : jobs) {
+            _syncSendTimes[job.index] = job.sendTime;
+        }
+        for (const SyncFanOut::Job& job : jobs) {
+            if (job.error) {
+                std::rethrow_exception(job.error);
+            }
         }
 
-        if (hasFoundConnection) {
+        if (!jobs.empty()) {
             return std::make_pair(minTime, maxTime);
         }
     }
@@ -434,13 +719,21 @@ std::optional<std::pair<double, double>> NetworkManager::sync(SyncMode sm) const
             if (!connection->isServer() && connection->isConnected()) {
                 // The servers's render function is locked until a message starting with
                 // the ack-byte is received.
-                connection->pushClientMessage();
+                connection->pushClientMessage(_frameTiming);
             }
         }
     }
     return std::nullopt;
 }
 
+const std::vector<double>& NetworkManager::syncSendTimes() const {
+    return _syncSendTimes;
+}
+
+void NetworkManager::setFrameTiming(const Network::FrameTiming& timing) {
+    _frameTiming = timing;
+}
+
 bool NetworkManager::isSyncComplete() const {
     const unsigned int counter = static_cast<unsigned int>(std::count_if(
         _syncConnections.cbegin(),
@@ -450,23 +743,241 @@ bool NetworkManager::isSyncComplete() const {
     return (counter == _nActiveSyncConnections);
 }
 
-void NetworkManager::transferData(const void* data, int length, int packageId) const {
-    std::vector<char> buffer;
-    prepareTransferData(data, buffer, length, packageId);
-    for (Network* connection : _dataTransferConnections) {
-        if (connection->isConnected()) {
-            connection->sendData(buffer.data(), length);
+bool NetworkManager::waitForSyncComplete(
+                                     std::chrono::steady_clock::time_point deadline) const
+{
+    ZoneScoped;
+
+    // Waiting for the connections one after another finishes when the last one of them
+    // has been updated. Connections that are already updated return immediately
+    for (const Network* connection : _syncConnections) {
+        if (!connection->waitForUpdate(deadline) && connection->isConnected()) {
+            return false;
         }
     }
+    return isSyncComplete();
+}
+
+void NetworkManager::transferData(const void* data, int length, int packageId) const {
+    const Network::Buffer buffer = { data, length };
+    transferData(std::span<const Network::Buffer>(&buffer, 1), packageId);
 }
 
 void NetworkManager::transferData(const void* data, int length, int packageId,
                                   const Network& connection) const
 {
-    if (connection.isConnected()) {
-        std::vector<char> buffer;
-        prepareTransferData(data, buffer, length, packageId);
-        connection.sendData(buffer.data(), length);
+    const Network::Buffer buffer = { data, length };
+    transferData(std::span<const Network::Buffer>(&buffer, 1), packageId, connection);
+}
+
+void NetworkManager::transferData(std::span<const Network::Buffer> buffers,
+                                  int packageId) const
+{
+    ZoneScoped;
+
+    sendTransferData(_dataTransferConnections, buffers, packageId, _compression);
+}
+
+void NetworkManager::transferData(std::span<const Network::Buffer> buffers, int packageId,
+                                  const Network& connection) const
+{
+    ZoneScoped;
+
+    const Network* c = &connection;
+    sendTransferData(
+        std::span<const Network* const>(&c, 1),
+        buffers,
+        packageId,
+        _compression
+    );
+}
+
+void NetworkManager::transferStream(int packageId, int64_t totalSize,
+                              const std::function<void(char*, int64_t, int)>& source)
+{
+    ZoneScoped;
+
+    // Every connection is served by its own thread as the receivers might be at
+    // different positions in the stream and acknowledge at different speeds
+    std::vector<Network*> connections;
+    std::copy_if(
+        _dataTransferConnections.cbegin(),
+        _dataTransferConnections.cend(),
+        std::back_inserter(connections),
+        std::mem_fn(&Network::isConnected)
+    );
+    std::vector<std::exception_ptr> errors(connections.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < connections.size(); i++) {
+        threads.emplace_back([this, &connections, &errors, i, packageId, totalSize,
+                              &source]()
+        {
+            try {
+                streamToConnection(*connections[i], packageId, totalSize, source);
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+void NetworkManager::transferFile(const std::filesystem::path& path, int packageId) {
+    ZoneScoped;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.good()) {
+        throw Error(5029, std::format("Could not open file '{}' for streaming", path));
+    }
+    file.seekg(0, std::ios::end);
+    const int64_t size = static_cast<int64_t>(file.tellg());
+
+    // The connections read from the file concurrently, but one file handle is enough as
+    // reading from disk is much faster than sending over the network
+    std::mutex fileMutex;
+    transferStream(
+        packageId,
+        size,
+        [&](char* destination, int64_t offset, int length) {
+            const std::unique_lock lock(fileMutex);
+            file.seekg(offset, std::ios::beg);
+            if (!file.read(destination, length)) {
+                throw Error(
+                    5030,
+                    std::format("Failed to read {} bytes from '{}'", length, path)
+                );
+            }
+        }
+    );
+}
+
+void NetworkManager::streamToConnection(Network& connection, int packageId,
+                                        int64_t totalSize,
+                           const std::function<void(char*, int64_t, int)>& source)
+{
+    ZoneScoped;
+
+    std::vector<char> chunk(
+        static_cast<size_t>(std::min<int64_t>(Network::StreamChunkSize, totalSize))
+    );
+    std::vector<char> compressed;
+
+    while (_isRunning) {
+        std::optional<int64_t> acknowledged;
+        try {
+            // The receiver answers the beginning of a stream with the number of bytes it
+            // already has, which is 0 unless we are resuming an interrupted stream
+            connection.sendStreamBegin(packageId, totalSize);
+            acknowledged = connection.waitForStreamAck(packageId, -1, StreamTimeout);
+
+            int64_t sent = acknowledged.value_or(0);
+            while (acknowledged && *acknowledged < totalSize) {
+                const int64_t window =
+                    static_cast<int64_t>(StreamWindowSize) * Network::StreamChunkSize;
+                while (sent < totalSize && sent - *acknowledged < window) {
+                    const int length = static_cast<int>(
+                        std::min<int64_t>(Network::StreamChunkSize, totalSize - sent)
+                    );
+                    source(chunk.data(), sent, length);
+
+                    const int compressedLength = connection.acceptsCompression() ?
+                        compressIfUseful(chunk.data(), length, compressed, _compression) :
+                        0;
+                    if (compressedLength > 0) {
+                        connection.sendStreamChunk(
+                            packageId,
+                            sent,
+                            compressed.data(),
+                            compressedLength,
+                            length
+                        );
+                    }
+                    else {
+                        connection.sendStreamChunk(
+                            packageId,
+                            sent,
+                            chunk.data(),
+                            length,
+                            0
+                        );
+                    }
+                    sent += length;
+                }
+
+                acknowledged =
+                    connection.waitForStreamAck(packageId, *acknowledged, StreamTimeout);
+                if (acknowledged && _dataTransferProgressFn) {
+                    _dataTransferProgressFn(
+                        packageId,
+                        *acknowledged,
+                        totalSize,
+                        connection.id()
+                    );
+                }
+            }
+        }
+        catch (const Error& e) {
+            if (e.code != 5014) {
+                // Anything but a failed send is not caused by the connection
+                throw;
+            }
+            Log::Warning(
+                "Sending stream {} to connection {} failed: {}",
+                packageId, connection.id(), e.what()
+            );
+        }
+
+        if (acknowledged && *acknowledged >= totalSize) {
+            return;
+        }
+
+        // We either lost the connection or the receiver stopped responding. Wait for the
+        // connection to come back and resume from wherever the receiver is
+        Log::Warning(
+            "Stream {} to connection {} was interrupted. Waiting for reconnect",
+            packageId, connection.id()
+        );
+        const auto t0 = std::chrono::steady_clock::now();
+        while (_isRunning && !connection.isConnected() &&
+               std::chrono::steady_clock::now() - t0 < StreamTimeout)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        if (!connection.isConnected()) {
+            throw Error(
+                5031,
+                std::format(
+                    "Connection {} did not reconnect to resume stream {}",
+                    connection.id(), packageId
+                )
+            );
+        }
+    }
+}
+
+void NetworkManager::setDataTransferFunctions(Network& connection) {
+    if (_dataTransferDecodeFn) {
+        connection.setPackageDecodeFunction(_dataTransferDecodeFn);
+    }
+
+    // acknowledge callback
+    if (_dataTransferAcknowledgeFn) {
+        connection.setAcknowledgeFunction(_dataTransferAcknowledgeFn);
+    }
+
+    if (_dataTransferChunkFn) {
+        connection.setStreamDecodeFunction(_dataTransferChunkFn);
+    }
+    if (_dataTransferResumeFn) {
+        connection.setStreamResumeFunction(_dataTransferResumeFn);
     }
 }
 
@@ -494,7 +1005,7 @@ const Network& NetworkManager::syncConnection(int index) const {
 }
 
 void NetworkManager::updateConnectionStatus(Network& connection) {
-    Log::Debug(std::format("Updating status for connection {}", connection.id()));
+    Log::Debug("Updating status for connection {}", connection.id());
 
     int nConnections = 0;
     int nConnectedSync = 0;
@@ -519,16 +1030,16 @@ void NetworkManager::updateConnectionStatus(Network& connection) {
         }
     }
 
-    Log::Info(std::format(
+    Log::Info(
         "Number of active connections {} of {}", nConnections, totalNConnections
-    ));
-    Log::Debug(std::format(
+    );
+    Log::Debug(
         "Number of connected sync nodes {} of {}", nConnectedSync, totalNSyncConnections
-    ));
-    Log::Debug(std::format(
+    );
+    Log::Debug(
         "Number of connected data transfer nodes {} of {}",
         nConnectedDataTransfer, totalNTransferConnections
-    ));
+    );
 
     mutex::DataSync.lock();
     _nActiveConnections = nConnections;
@@ -580,9 +1091,6 @@ void NetworkManager::updateConnectionStatus(Network& connection) {
             _dataTransferStatusFn(connection.isConnected(), connection.id());
         }
     }
-
-    // signal done to caller
-    cond.notify_all();
 }
 
 void NetworkManager::setAllNodesConnected() {
@@ -615,9 +1123,19 @@ void NetworkManager::addConnection(int port, std::string address,
         _isServer,
         connectionType
     );
-    Log::Debug(std::format(
+    Log::Debug(
         "Initiating connection {} at port {}", _networkConnections.size(), port
-    ));
+    );
+    if (connectionType == Network::ConnectionType::SyncConnection) {
+        // The data transfer connections call the user's decode functions with entire
+        // payloads or stream chunks that are written to disk. On the shared I/O threads
+        // that would delay the sync messages and acknowledgements of all other
+        // connections, so data transfers keep receiving on a thread of their own
+        net->setReactor(_reactor.get());
+        net->setMulticastSender(_multicastSender.get());
+        net->setMulticastReceiver(_multicastReceiver.get());
+        net->setDeltaEncoding(_deltaEncoding.has_value());
+    }
     net->setUpdateFunction([this](Network& c) { updateConnectionStatus(c); });
     net->setConnectedFunction([this]() { setAllNodesConnected(); });
 
@@ -0,0 +1,280 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/networkreactor.h>
+
+#ifdef WIN32
+#define WIN32_LEAN_AND_MEAN
+#define VC_EXTRALEAN
+#define NOMINMAX
+#include <Windows.h>
+#include <winsock2.h>
+#define SGCT_ERRNO WSAGetLastError()
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+#define SGCT_ERRNO errno
+#endif // WIN32
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif // __linux__
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+
+#define Err(code, msg) sgct::Error(sgct::Error::Component::Network, code, msg)
+
+namespace {
+#ifndef __linux__
+    // Without epoll, the set of sockets that is waited on is rebuilt after every wait.
+    // Connections that were added in the meantime are picked up after at most this time
+    constexpr int PollTimeout = 100;
+#endif // __linux__
+
+#ifdef __linux__
+    // The key of the event that wakes up the I/O threads when the reactor is destroyed
+    constexpr uint64_t WakeUpKey = 0;
+
+    constexpr int MaxEventsPerWait = 16;
+
+    epoll_event readEvent(uint64_t key) {
+        // Each socket is only reported to a single thread until it has been handled and
+        // rearmed so that the data of a connection is never read by two threads at once
+        epoll_event event = {};
+        event.events = EPOLLIN | EPOLLONESHOT;
+        event.data.u64 = key;
+        return event;
+    }
+#endif // __linux__
+} // namespace
+
+namespace sgct {
+
+NetworkReactor::NetworkReactor([[maybe_unused]] int nThreads) {
+    ZoneScoped;
+
+#ifdef __linux__
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll == -1) {
+        throw Err(5018, std::format("Creating the epoll instance failed: {}", errno));
+    }
+
+    _wakeUpEvent = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_wakeUpEvent == -1) {
+        close(_epoll);
+        throw Err(5018, std::format("Creating the wake up event failed: {}", errno));
+    }
+
+    // The wake up event is level-triggered and never read, so once it is signalled it
+    // wakes up every I/O thread
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.u64 = WakeUpKey;
+    epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeUpEvent, &event);
+
+    nThreads = std::max(nThreads, 1);
+#else // ^^^^ __linux__ // !__linux__ vvvv
+    nThreads = 1;
+#endif // __linux__
+
+    Log::Debug("Receiving network messages on {} threads", nThreads);
+    for (int i = 0; i < nThreads; i++) {
+        _threads.emplace_back([this]() { run(); });
+    }
+}
+
+NetworkReactor::~NetworkReactor() {
+    ZoneScoped;
+
+    _shouldTerminate = true;
+#ifdef __linux__
+    const uint64_t value = 1;
+    [[maybe_unused]] const ssize_t res = write(_wakeUpEvent, &value, sizeof(value));
+#endif // __linux__
+
+    for (std::thread& thread : _threads) {
+        thread.join();
+    }
+
+#ifdef __linux__
+    close(_wakeUpEvent);
+    close(_epoll);
+#endif // __linux__
+}
+
+void NetworkReactor::add(Network& connection) {
+    ZoneScoped;
+
+    const std::unique_lock lock(_mutex);
+    const uint64_t key = _nextKey++;
+    _entries[key] = { &connection, connection.nativeSocket() };
+
+#ifdef __linux__
+    epoll_event event = readEvent(key);
+    if (epoll_ctl(_epoll, EPOLL_CTL_ADD, connection.nativeSocket(), &event) == -1) {
+        _entries.erase(key);
+        throw Err(
+            5019,
+            std::format("Adding connection {} failed: {}", connection.id(), errno)
+        );
+    }
+#endif // __linux__
+}
+
+void NetworkReactor::remove(Network& connection) {
+    ZoneScoped;
+
+    std::unique_lock lock(_mutex);
+    while (true) {
+        const auto it = std::find_if(
+            _entries.begin(),
+            _entries.end(),
+            [&connection](const auto& e) { return e.second.connection == &connection; }
+        );
+        if (it == _entries.end()) {
+            return;
+        }
+
+        if (!it->second.isBusy) {
+#ifdef __linux__
+            epoll_ctl(_epoll, EPOLL_CTL_DEL, it->second.socket, nullptr);
+#endif // __linux__
+            _entries.erase(it);
+            return;
+        }
+
+        _idleCond.wait(lock);
+    }
+}
+
+void NetworkReactor::handle(uint64_t key) {
+    ZoneScoped;
+
+    Network* connection = nullptr;
+    SGCT_SOCKET socket = 0;
+    {
+        const std::unique_lock lock(_mutex);
+        const auto it = _entries.find(key);
+        if (it == _entries.end()) {
+            // The connection was removed after the event was reported
+            return;
+        }
+        it->second.isBusy = true;
+        connection = it->second.connection;
+        socket = it->second.socket;
+    }
+
+    bool isOpen = false;
+    try {
+        isOpen = connection->receiveAvailable();
+    }
+    catch (const std::runtime_error& e) {
+        Log::Error(e.what());
+    }
+
+    if (isOpen) {
+#ifdef __linux__
+        epoll_event event = readEvent(key);
+        epoll_ctl(_epoll, EPOLL_CTL_MOD, socket, &event);
+#endif // __linux__
+    }
+    else {
+#ifdef __linux__
+        epoll_ctl(_epoll, EPOLL_CTL_DEL, socket, nullptr);
+#endif // __linux__
+        connection->finishConnection();
+    }
+
+    {
+        const std::unique_lock lock(_mutex);
+        if (isOpen) {
+            _entries[key].isBusy = false;
+        }
+        else {
+            _entries.erase(key);
+        }
+    }
+    _idleCond.notify_all();
+}
+
+void NetworkReactor::run() {
+#ifdef __linux__
+    std::array<epoll_event, MaxEventsPerWait> events;
+    while (!_shouldTerminate) {
+        const int nEvents = epoll_wait(_epoll, events.data(), MaxEventsPerWait, -1);
+        if (nEvents == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            Log::Error("Waiting for network events failed: {}", errno);
+            return;
+        }
+
+        for (int i = 0; i < nEvents; i++) {
+            if (events[i].data.u64 != WakeUpKey) {
+                handle(events[i].data.u64);
+            }
+        }
+    }
+#else // ^^^^ __linux__ // !__linux__ vvvv
+    std::vector<pollfd> fds;
+    std::vector<uint64_t> keys;
+    while (!_shouldTerminate) {
+        fds.clear();
+        keys.clear();
+        {
+            const std::unique_lock lock(_mutex);
+            for (const auto& [key, entry] : _entries) {
+                pollfd fd = {};
+                fd.fd = entry.socket;
+                fd.events = POLLIN;
+                fds.push_back(fd);
+                keys.push_back(key);
+            }
+        }
+
+        if (fds.empty()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(PollTimeout));
+            continue;
+        }
+
+#ifdef WIN32
+        const ULONG nFds = static_cast<ULONG>(fds.size());
+        const int nEvents = WSAPoll(fds.data(), nFds, PollTimeout);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        const nfds_t nFds = static_cast<nfds_t>(fds.size());
+        const int nEvents = poll(fds.data(), nFds, PollTimeout);
+#endif // WIN32
+        if (nEvents < 0) {
+#ifndef WIN32
+            if (errno == EINTR) {
+                continue;
+            }
+#endif // WIN32
+            Log::Error("Waiting for network events failed: {}", SGCT_ERRNO);
+            return;
+        }
+
+        for (size_t i = 0; i < fds.size(); i++) {
+            if (fds[i].revents != 0) {
+                handle(keys[i]);
+            }
+        }
+    }
+#endif // __linux__
+}
+
+} // namespace sgct
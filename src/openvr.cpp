@@ -108,7 +108,7 @@ void initialize(float nearClip, float farClip) {
     if (eError != vr::VRInitError_None) {
         shutdown();
         Log::Error(
-            "VR_Init Failed. Unable to init VR runtime: %s",
+            "VR_Init Failed. Unable to init VR runtime: {}",
             vr::VR_GetVRInitErrorAsEnglishDescription(eError)
         );
     }
@@ -119,7 +119,7 @@ void initialize(float nearClip, float farClip) {
         unsigned int height;
         HMD->GetRecommendedRenderTargetSize(&width, &height);
 
-        Log::Info("OpenVR render dimensions per eye: %d x %d", width, height);
+        Log::Info("OpenVR render dimensions per eye: {} x {}", width, height);
 
         // Create FBO and Texture used for sending data top HMD
         createHMDFrameBuffer(renderWidth, renderHeight, leftEyeFBODesc);
@@ -131,7 +131,7 @@ void initialize(float nearClip, float farClip) {
             vr::Prop_TrackingSystemName_String,
             nullptr
         );
-        Log::Info("OpenVR Device Name: %s", HMDDevice.c_str());
+        Log::Info("OpenVR Device Name: {}", HMDDevice);
 
         std::string HMDNumber = getTrackedDeviceString(
             HMD,
@@ -139,7 +139,7 @@ void initialize(float nearClip, float farClip) {
             vr::Prop_SerialNumber_String,
             nullptr
         );
-        Log::Info("OpenVR Device Number: %s", HMDNumber.c_str());
+        Log::Info("OpenVR Device Number: {}", HMDNumber);
 
         vr::IVRRenderModels* renderModels = reinterpret_cast<vr::IVRRenderModels*>(
             vr::VR_GetGenericInterface(vr::IVRRenderModels_Version, &eError)
@@ -147,7 +147,7 @@ void initialize(float nearClip, float farClip) {
         if (!renderModels) {
             shutdown();
             Log::Error(
-                "VR_Init Failed. Unable to get render model interface: %s",
+                "VR_Init Failed. Unable to get render model interface: {}",
                 vr::VR_GetVRInitErrorAsEnglishDescription(eError)
             );
         }
@@ -0,0 +1,434 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/pixelops.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SGCT_PIXELOPS_X86
+#include <immintrin.h>
+#ifdef WIN32
+#include <intrin.h>
+#endif // WIN32
+#endif
+
+// The SIMD kernels are compiled for their instruction set regardless of the compiler
+// flags that are used for the rest of the library and are only called if the CPU
+// supports them. MSVC does not need this as it always allows the use of all intrinsics
+#if defined(SGCT_PIXELOPS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SGCT_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define SGCT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SGCT_TARGET_SSSE3
+#define SGCT_TARGET_AVX2
+#endif
+
+namespace sgct::pixelops {
+
+namespace {
+    InstructionSet detectInstructionSet() {
+#ifdef SGCT_PIXELOPS_X86
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return InstructionSet::AVX2;
+        }
+        if (__builtin_cpu_supports("ssse3")) {
+            return InstructionSet::SSSE3;
+        }
+#else // ^^^^ __GNUC__ || __clang__ // !(__GNUC__ || __clang__) vvvv
+        std::array<int, 4> info;
+        __cpuid(info.data(), 0);
+        const int nIds = info[0];
+
+        __cpuid(info.data(), 1);
+        const bool hasSSSE3 = (info[2] & (1 << 9)) != 0;
+        const bool hasOSXSave = (info[2] & (1 << 27)) != 0;
+        const bool hasAVX = (info[2] & (1 << 28)) != 0;
+
+        if (nIds >= 7 && hasOSXSave && hasAVX) {
+            __cpuidex(info.data(), 7, 0);
+            const bool hasAVX2 = (info[1] & (1 << 5)) != 0;
+            // The operating system also has to save the AVX registers on context switches
+            const bool hasOSSupport = (_xgetbv(0) & 0x6) == 0x6;
+            if (hasAVX2 && hasOSSupport) {
+                return InstructionSet::AVX2;
+            }
+        }
+        if (hasSSSE3) {
+            return InstructionSet::SSSE3;
+        }
+#endif // __GNUC__ || __clang__
+#endif // SGCT_PIXELOPS_X86
+        return InstructionSet::Scalar;
+    }
+
+    std::atomic<InstructionSet> gInstructionSet = supportedInstructionSet();
+
+    //
+    // Scalar
+    //
+    void swapRedBlueScalar(const unsigned char* src, unsigned char* dst, size_t nPixels,
+                           int nChannels)
+    {
+        for (size_t i = 0; i < nPixels; i++) {
+            const unsigned char r = src[0];
+            const unsigned char g = src[1];
+            const unsigned char b = src[2];
+            dst[0] = b;
+            dst[1] = g;
+            dst[2] = r;
+            if (nChannels == 4) {
+                dst[3] = src[3];
+            }
+            src += nChannels;
+            dst += nChannels;
+        }
+    }
+
+    void swapBytes16Scalar(const unsigned char* src, unsigned char* dst, size_t nValues) {
+        for (size_t i = 0; i < nValues; i++) {
+            const unsigned char lo = src[2 * i];
+            const unsigned char hi = src[2 * i + 1];
+            dst[2 * i] = hi;
+            dst[2 * i + 1] = lo;
+        }
+    }
+
+    void expandScalar(const unsigned char* src, unsigned char* dst, size_t nPixels,
+                      unsigned char alpha)
+    {
+        for (size_t i = 0; i < nPixels; i++) {
+            dst[4 * i] = src[3 * i];
+            dst[4 * i + 1] = src[3 * i + 1];
+            dst[4 * i + 2] = src[3 * i + 2];
+            dst[4 * i + 3] = alpha;
+        }
+    }
+
+    void removeFourthScalar(const unsigned char* src, unsigned char* dst,
+                            size_t nPixels)
+    {
+        for (size_t i = 0; i < nPixels; i++) {
+            dst[3 * i] = src[4 * i];
+            dst[3 * i + 1] = src[4 * i + 1];
+            dst[3 * i + 2] = src[4 * i + 2];
+        }
+    }
+
+#ifdef SGCT_PIXELOPS_X86
+    //
+    // SSSE3
+    //
+    SGCT_TARGET_SSSE3
+    __m128i load(const unsigned char* p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+
+    SGCT_TARGET_SSSE3
+    void store(unsigned char* p, __m128i v) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+    }
+
+    SGCT_TARGET_SSSE3
+    void swapRedBlueSSSE3(const unsigned char* src, unsigned char* dst, size_t nPixels,
+                          int nChannels)
+    {
+        size_t i = 0;
+        if (nChannels == 4) {
+            const __m128i mask = _mm_setr_epi8(
+                2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+            );
+            for (; i + 4 <= nPixels; i += 4) {
+                store(dst, _mm_shuffle_epi8(load(src), mask));
+                src += 16;
+                dst += 16;
+            }
+        }
+        else {
+            // Converts 4 pixels at a time, but loads and stores 16 bytes. The last 4
+            // bytes are stored unchanged and are overwritten in the next iteration
+            const __m128i mask = _mm_setr_epi8(
+                2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15
+            );
+            for (; i + 6 <= nPixels; i += 4) {
+                store(dst, _mm_shuffle_epi8(load(src), mask));
+                src += 12;
+                dst += 12;
+            }
+        }
+        swapRedBlueScalar(src, dst, nPixels - i, nChannels);
+    }
+
+    SGCT_TARGET_SSSE3
+    void swapBytes16SSSE3(const unsigned char* src, unsigned char* dst, size_t nValues) {
+        size_t i = 0;
+        for (; i + 8 <= nValues; i += 8) {
+            const __m128i v = load(src);
+            store(dst, _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+            src += 16;
+            dst += 16;
+        }
+        swapBytes16Scalar(src, dst, nValues - i);
+    }
+
+    SGCT_TARGET_SSSE3
+    void expandSSSE3(const unsigned char* src, unsigned char* dst, size_t nPixels,
+                     unsigned char alpha)
+    {
+        const __m128i mask = _mm_setr_epi8(
+            0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128
+        );
+        const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(uint32_t(alpha) << 24));
+
+        size_t i = 0;
+        // Only 12 of the 16 loaded bytes are used, so the loop has to stop early enough
+        // to not read past the end of the source
+        for (; i + 6 <= nPixels; i += 4) {
+            store(dst, _mm_or_si128(_mm_shuffle_epi8(load(src), mask), alphaMask));
+            src += 12;
+            dst += 16;
+        }
+        expandScalar(src, dst, nPixels - i, alpha);
+    }
+
+    SGCT_TARGET_SSSE3
+    void removeFourthSSSE3(const unsigned char* src, unsigned char* dst, size_t nPixels) {
+        const __m128i mask = _mm_setr_epi8(
+            0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -128, -128, -128, -128
+        );
+
+        size_t i = 0;
+        // Only 12 of the 16 stored bytes are used, so the loop has to stop early enough
+        // to not write past the end of the destination
+        for (; i + 6 <= nPixels; i += 4) {
+            store(dst, _mm_shuffle_epi8(load(src), mask));
+            src += 16;
+            dst += 12;
+        }
+        removeFourthScalar(src, dst, nPixels - i);
+    }
+
+    //
+    // AVX2
+    //
+    SGCT_TARGET_AVX2
+    __m256i loadTwo(const unsigned char* lo, const unsigned char* hi) {
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(load(lo)), load(hi), 1);
+    }
+
+    SGCT_TARGET_AVX2
+    void storeTwo(unsigned char* lo, unsigned char* hi, __m256i v) {
+        // The lower half has to be stored first as the halves can overlap
+        store(lo, _mm256_castsi256_si128(v));
+        store(hi, _mm256_extracti128_si256(v, 1));
+    }
+
+    SGCT_TARGET_AVX2
+    void swapRedBlueAVX2(const unsigned char* src, unsigned char* dst, size_t nPixels,
+                         int nChannels)
+    {
+        size_t i = 0;
+        if (nChannels == 4) {
+            const __m256i mask = _mm256_setr_epi8(
+                2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15
+            );
+            for (; i + 8 <= nPixels; i += 8) {
+                const __m256i v =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+                _mm256_storeu_si256(
+                    reinterpret_cast<__m256i*>(dst),
+                    _mm256_shuffle_epi8(v, mask)
+                );
+                src += 32;
+                dst += 32;
+            }
+        }
+        else {
+            // The shuffle can't cross the 128 bit lanes, so each lane converts 4 pixels
+            const __m256i mask = _mm256_setr_epi8(
+                2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15,
+                2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15
+            );
+            for (; i + 10 <= nPixels; i += 8) {
+                const __m256i v = loadTwo(src, src + 12);
+                storeTwo(dst, dst + 12, _mm256_shuffle_epi8(v, mask));
+                src += 24;
+                dst += 24;
+            }
+        }
+        swapRedBlueSSSE3(src, dst, nPixels - i, nChannels);
+    }
+
+    SGCT_TARGET_AVX2
+    void swapBytes16AVX2(const unsigned char* src, unsigned char* dst, size_t nValues) {
+        size_t i = 0;
+        for (; i + 16 <= nValues; i += 16) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            const __m256i swapped =
+                _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), swapped);
+            src += 32;
+            dst += 32;
+        }
+        swapBytes16SSSE3(src, dst, nValues - i);
+    }
+
+    SGCT_TARGET_AVX2
+    void expandAVX2(const unsigned char* src, unsigned char* dst, size_t nPixels,
+                    unsigned char alpha)
+    {
+        const __m256i mask = _mm256_setr_epi8(
+            0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128,
+            0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, -128
+        );
+        const __m256i alphaMask =
+            _mm256_set1_epi32(static_cast<int>(uint32_t(alpha) << 24));
+
+        size_t i = 0;
+        for (; i + 10 <= nPixels; i += 8) {
+            const __m256i v = loadTwo(src, src + 12);
+            const __m256i res = _mm256_or_si256(_mm256_shuffle_epi8(v, mask), alphaMask);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), res);
+            src += 24;
+            dst += 32;
+        }
+        expandSSSE3(src, dst, nPixels - i, alpha);
+    }
+
+    SGCT_TARGET_AVX2
+    void removeFourthAVX2(const unsigned char* src, unsigned char* dst, size_t nPixels) {
+        const __m256i mask = _mm256_setr_epi8(
+            0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -128, -128, -128, -128,
+            0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -128, -128, -128, -128
+        );
+
+        size_t i = 0;
+        for (; i + 10 <= nPixels; i += 8) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+            storeTwo(dst, dst + 12, _mm256_shuffle_epi8(v, mask));
+            src += 32;
+            dst += 24;
+        }
+        removeFourthSSSE3(src, dst, nPixels - i);
+    }
+#endif // SGCT_PIXELOPS_X86
+} // namespace
+
+InstructionSet supportedInstructionSet() {
+    static const InstructionSet Supported = detectInstructionSet();
+    return Supported;
+}
+
+InstructionSet instructionSet() {
+    return gInstructionSet.load(std::memory_order_relaxed);
+}
+
+InstructionSet setInstructionSet(InstructionSet set) {
+    const InstructionSet res = std::min(set, supportedInstructionSet());
+    gInstructionSet.store(res, std::memory_order_relaxed);
+    return res;
+}
+
+void swapRedBlue(const unsigned char* src, unsigned char* dst, size_t nPixels,
+                 int nChannels)
+{
+    if (nChannels != 3 && nChannels != 4) {
+        throw std::logic_error("Red and blue can only be swapped for 3 or 4 channels");
+    }
+
+    switch (instructionSet()) {
+        case InstructionSet::Scalar:
+            swapRedBlueScalar(src, dst, nPixels, nChannels);
+            break;
+#ifdef SGCT_PIXELOPS_X86
+        case InstructionSet::SSSE3:
+            swapRedBlueSSSE3(src, dst, nPixels, nChannels);
+            break;
+        case InstructionSet::AVX2:
+            swapRedBlueAVX2(src, dst, nPixels, nChannels);
+            break;
+#endif // SGCT_PIXELOPS_X86
+        default:
+            throw std::logic_error("Unhandled case label");
+    }
+}
+
+void swapBytes16(const unsigned char* src, unsigned char* dst, size_t nValues) {
+    switch (instructionSet()) {
+        case InstructionSet::Scalar:
+            swapBytes16Scalar(src, dst, nValues);
+            break;
+#ifdef SGCT_PIXELOPS_X86
+        case InstructionSet::SSSE3:
+            swapBytes16SSSE3(src, dst, nValues);
+            break;
+        case InstructionSet::AVX2:
+            swapBytes16AVX2(src, dst, nValues);
+            break;
+#endif // SGCT_PIXELOPS_X86
+        default:
+            throw std::logic_error("Unhandled case label");
+    }
+}
+
+void flipVertically(unsigned char* data, size_t rowSize, size_t nRows) {
+    // Swapping the rows is limited by the memory bandwidth, so there is nothing to gain
+    // from anything but the vectorized copy that the compiler creates anyway
+    for (size_t i = 0; i < nRows / 2; i++) {
+        unsigned char* top = data + i * rowSize;
+        unsigned char* bottom = data + (nRows - 1 - i) * rowSize;
+        std::swap_ranges(top, top + rowSize, bottom);
+    }
+}
+
+void expandToFourChannels(const unsigned char* src, unsigned char* dst, size_t nPixels,
+                          unsigned char alpha)
+{
+    switch (instructionSet()) {
+        case InstructionSet::Scalar:
+            expandScalar(src, dst, nPixels, alpha);
+            break;
+#ifdef SGCT_PIXELOPS_X86
+        case InstructionSet::SSSE3:
+            expandSSSE3(src, dst, nPixels, alpha);
+            break;
+        case InstructionSet::AVX2:
+            expandAVX2(src, dst, nPixels, alpha);
+            break;
+#endif // SGCT_PIXELOPS_X86
+        default:
+            throw std::logic_error("Unhandled case label");
+    }
+}
+
+void removeFourthChannel(const unsigned char* src, unsigned char* dst, size_t nPixels) {
+    switch (instructionSet()) {
+        case InstructionSet::Scalar:
+            removeFourthScalar(src, dst, nPixels);
+            break;
+#ifdef SGCT_PIXELOPS_X86
+        case InstructionSet::SSSE3:
+            removeFourthSSSE3(src, dst, nPixels);
+            break;
+        case InstructionSet::AVX2:
+            removeFourthAVX2(src, dst, nPixels);
+            break;
+#endif // SGCT_PIXELOPS_X86
+        default:
+            throw std::logic_error("Unhandled case label");
+    }
+}
+
+} // namespace sgct::pixelops
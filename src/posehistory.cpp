@@ -0,0 +1,188 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/posehistory.h>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <algorithm>
+
+namespace {
+    // The computations are done in double precision as the timestamps are seconds since
+    // the start of the application and the differences between them are milliseconds
+    struct Pose {
+        double time = 0.0;
+        glm::dvec3 position = glm::dvec3(0.0);
+        glm::dquat rotation = glm::dquat(1.0, 0.0, 0.0, 0.0);
+    };
+
+    sgct::PoseHistory::Sample toSample(const Pose& pose) {
+        sgct::PoseHistory::Sample s;
+        s.time = pose.time;
+        s.position = sgct::vec3(
+            static_cast<float>(pose.position.x),
+            static_cast<float>(pose.position.y),
+            static_cast<float>(pose.position.z)
+        );
+        s.rotation = sgct::quat(
+            static_cast<float>(pose.rotation.x),
+            static_cast<float>(pose.rotation.y),
+            static_cast<float>(pose.rotation.z),
+            static_cast<float>(pose.rotation.w)
+        );
+        return s;
+    }
+
+    // Returns the index of the newest pose that is at least VelocityWindow older than
+    // the pose at index `i`, or the oldest pose if there is none
+    size_t windowStart(const Pose* poses, size_t i) {
+        const double end = poses[i].time - sgct::PoseHistory::VelocityWindow;
+        while (i > 0 && poses[i].time > end) {
+            i--;
+        }
+        return i;
+    }
+
+    // Returns the rotation by which `to` differs from `from` scaled by `f`, so that a
+    // factor of 1 turns `from` into `to`
+    glm::dquat scaledRotation(const glm::dquat& from, const glm::dquat& to, double f) {
+        glm::dquat delta = to * glm::inverse(from);
+        if (delta.w < 0.0) {
+            // Both quaternions represent the same rotation, but this one is the shorter
+            // way around
+            delta = -delta;
+        }
+        const double angle = glm::angle(delta);
+        if (angle < 1e-9) {
+            return glm::dquat(1.0, 0.0, 0.0, 0.0);
+        }
+        return glm::angleAxis(angle * f, glm::axis(delta));
+    }
+} // namespace
+
+namespace sgct {
+
+void PoseHistory::add(const Sample& sample) {
+    if (sample.time <= _newestTime) {
+        return;
+    }
+    _newestTime = sample.time;
+
+    const uint64_t n = _nSamples.load(std::memory_order_relaxed);
+    Slot& slot = _slots[n % Capacity];
+
+    // Readers that see the odd sequence number or a different one afterwards ignore the
+    // values they have read
+    slot.sequence.store(2 * n + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const std::array<double, 8> values = {
+        sample.time,
+        sample.position.x, sample.position.y, sample.position.z,
+        sample.rotation.x, sample.rotation.y, sample.rotation.z, sample.rotation.w
+    };
+    for (size_t i = 0; i < values.size(); i++) {
+        slot.values[i].store(values[i], std::memory_order_relaxed);
+    }
+    slot.sequence.store(2 * n + 2, std::memory_order_release);
+    _nSamples.store(n + 1, std::memory_order_release);
+}
+
+std::optional<PoseHistory::Sample> PoseHistory::pose(double time, Prediction prediction,
+                                                     double maxPrediction) const
+{
+    // Copy the samples, from the newest to the oldest, until one has been overwritten
+    const uint64_t n = _nSamples.load(std::memory_order_acquire);
+    const uint64_t nAvailable = std::min<uint64_t>(n, Capacity);
+    std::array<Pose, Capacity> poses;
+    size_t nPoses = 0;
+    for (uint64_t i = 0; i < nAvailable; i++) {
+        const uint64_t index = n - 1 - i;
+        const Slot& slot = _slots[index % Capacity];
+        const uint64_t expected = 2 * index + 2;
+        if (slot.sequence.load(std::memory_order_acquire) != expected) {
+            break;
+        }
+        std::array<double, 8> v;
+        for (size_t j = 0; j < v.size(); j++) {
+            v[j] = slot.values[j].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != expected) {
+            break;
+        }
+
+        Pose& p = poses[Capacity - 1 - i];
+        p.time = v[0];
+        p.position = glm::dvec3(v[1], v[2], v[3]);
+        p.rotation = glm::normalize(glm::dquat(v[7], v[4], v[5], v[6]));
+        nPoses++;
+    }
+    if (nPoses == 0) {
+        return std::nullopt;
+    }
+    const Pose* first = poses.data() + Capacity - nPoses;
+    const Pose* last = poses.data() + Capacity - 1;
+
+    if (time <= first->time) {
+        return toSample(*first);
+    }
+
+    if (time <= last->time) {
+        // The first pose that is not older than the requested time
+        const Pose* next = std::lower_bound(
+            first,
+            last + 1,
+            time,
+            [](const Pose& p, double t) { return p.time < t; }
+        );
+        const Pose* prev = next - 1;
+        const double f = (time - prev->time) / (next->time - prev->time);
+
+        Pose res;
+        res.time = time;
+        res.position = glm::mix(prev->position, next->position, f);
+        res.rotation = glm::slerp(prev->rotation, next->rotation, f);
+        return toSample(res);
+    }
+
+    if (prediction == Prediction::None || nPoses == 1) {
+        return toSample(*last);
+    }
+
+    const double dt = std::min(time - last->time, maxPrediction);
+    const size_t iLast = nPoses - 1;
+    const size_t iMid = windowStart(first, iLast);
+    const Pose& mid = first[iMid];
+    const double dt1 = last->time - mid.time;
+
+    Pose res;
+    res.time = last->time + dt;
+    glm::dvec3 velocity = (last->position - mid.position) / dt1;
+    glm::dvec3 acceleration = glm::dvec3(0.0);
+    if (prediction == Prediction::Acceleration && iMid > 0) {
+        const Pose& begin = first[windowStart(first, iMid)];
+        const double dt0 = mid.time - begin.time;
+        const glm::dvec3 velocity0 = (mid.position - begin.position) / dt0;
+
+        // The two velocities are the averages over their intervals, so they belong to
+        // the middle of each interval
+        acceleration = (velocity - velocity0) / ((dt0 + dt1) / 2.0);
+        velocity += acceleration * (dt1 / 2.0);
+    }
+    res.position = last->position + velocity * dt + acceleration * (dt * dt / 2.0);
+    res.rotation = glm::normalize(
+        scaledRotation(mid.rotation, last->rotation, dt / dt1) * last->rotation
+    );
+    return toSample(res);
+}
+
+uint64_t PoseHistory::nSamples() const {
+    return _nSamples.load(std::memory_order_relaxed);
+}
+
+} // namespace sgct
@@ -183,9 +183,9 @@ void CubemapProjection::render(const BaseViewport& viewport,
                 _cubemapResolution.y
             );
             if (!s) {
-                Log::Error(std::format(
+                Log::Error(
                     "Error sending texture '{}' for face {}", _cubeFaces[i].texture, i
-                ));
+                );
             }
         }
 #endif // SGCT_HAS_SPOUT
@@ -242,7 +242,7 @@ void CubemapProjection::initTextures(unsigned int internalFormat, unsigned int f
     Log::Debug("CubemapProjection initTextures");
 
     for (int i = 0; i < 6; i++) {
-        Log::Debug(std::format("CubemapProjection initTextures {}", i));
+        Log::Debug("CubemapProjection initTextures {}", i);
         if (!_cubeFaces[i].enabled) {
             continue;
         }
@@ -288,9 +288,9 @@ void CubemapProjection::initTextures(unsigned int internalFormat, unsigned int f
                     _cubemapResolution.y
                 );
                 if (!success) {
-                    Log::Error(std::format(
+                    Log::Error(
                         "Error creating SPOUT handle for {}", CubeMapFaceName[i]
-                    ));
+                    );
                 }
             }
         }
@@ -116,10 +116,10 @@ void NonLinearProjection::initTextures(unsigned int internalFormat, unsigned int
                                        unsigned int type)
 {
     generateCubeMap(_textures.cubeMapColor, internalFormat, format, type);
-    Log::Debug(std::format(
+    Log::Debug(
         "{}x{} color cube map texture (id: {}) generated",
         _cubemapResolution.x, _cubemapResolution.y, _textures.cubeMapColor
-    ));
+    );
 
     if (Engine::instance().settings().useDepthTexture) {
         generateCubeMap(
@@ -128,10 +128,10 @@ void NonLinearProjection::initTextures(unsigned int internalFormat, unsigned int
             GL_DEPTH_COMPONENT,
             GL_FLOAT
         );
-        Log::Debug(std::format(
+        Log::Debug(
             "{}x{} depth cube map texture (id: {}) generated",
             _cubemapResolution.x, _cubemapResolution.y, _textures.cubeMapDepth
-        ));
+        );
 
         if (_useDepthTransformation) {
             // generate swap textures
@@ -141,33 +141,33 @@ void NonLinearProjection::initTextures(unsigned int internalFormat, unsigned int
                 GL_DEPTH_COMPONENT,
                 GL_FLOAT
             );
-            Log::Debug(std::format(
+            Log::Debug(
                 "{}x{} depth swap map texture (id: {}) generated",
                 _cubemapResolution.x, _cubemapResolution.y, _textures.depthSwap
-            ));
+            );
 
             generateMap(_textures.colorSwap, internalFormat, format, type);
-            Log::Debug(std::format(
+            Log::Debug(
                 "{}x{} color swap map texture (id: {}) generated",
                 _cubemapResolution.x, _cubemapResolution.y, _textures.colorSwap
-            ));
+            );
         }
     }
 
     if (Engine::instance().settings().useNormalTexture) {
         generateCubeMap(_textures.cubeMapNormals, GL_RGB32F, GL_RGB, GL_FLOAT);
-        Log::Debug(std::format(
+        Log::Debug(
             "{}x{} normal cube map texture (id: {}) generated",
             _cubemapResolution.x, _cubemapResolution.y, _textures.cubeMapNormals
-        ));
+        );
     }
 
     if (Engine::instance().settings().usePositionTexture) {
         generateCubeMap(_textures.cubeMapPositions, GL_RGB32F, GL_RGB, GL_FLOAT);
-        Log::Debug(std::format(
+        Log::Debug(
             "{}x{} position cube map texture ({}) generated",
             _cubemapResolution.x, _cubemapResolution.y, _textures.cubeMapPositions
-        ));
+        );
     }
 }
 
@@ -196,14 +196,14 @@ void NonLinearProjection::generateMap(unsigned int& texture, unsigned int intern
     GLint maxMapRes = 0;
     glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxMapRes);
     if (_cubemapResolution.x > maxMapRes) {
-        Log::Error(std::format(
+        Log::Error(
             "Requested size is too big ({} > {})", _cubemapResolution.x, maxMapRes
-        ));
+        );
     }
     if (_cubemapResolution.y > maxMapRes) {
-        Log::Error(std::format(
+        Log::Error(
             "Requested size is too big ({} > {})", _cubemapResolution.y, maxMapRes
-        ));
+        );
     }
 
 
@@ -245,11 +245,11 @@ void NonLinearProjection::generateCubeMap(unsigned int& texture,
     glGetIntegerv(GL_MAX_CUBE_MAP_TEXTURE_SIZE, &maxCubeMapRes);
     if (_cubemapResolution.x > maxCubeMapRes) {
         _cubemapResolution.x = maxCubeMapRes;
-        Log::Debug(std::format("Cubemap size set to max size: {}", maxCubeMapRes));
+        Log::Debug("Cubemap size set to max size: {}", maxCubeMapRes);
     }
     if (_cubemapResolution.y > maxCubeMapRes) {
         _cubemapResolution.y = maxCubeMapRes;
-        Log::Debug(std::format("Cubemap size set to max size: {}", maxCubeMapRes));
+        Log::Debug("Cubemap size set to max size: {}", maxCubeMapRes);
     }
 
 
@@ -381,6 +381,12 @@ void NonLinearProjection::renderCubeFace(const BaseViewport& vp, int idx,
         return;
     }
 
+    const GpuTimer::Scope zone = GpuTimer::Scope(
+        Engine::instance().gpuTimer(),
+        "Cube face",
+        idx
+    );
+
     _cubeMapFbo->bind();
     if (!_cubeMapFbo->isMultiSampled()) {
         attachTextures(idx);
@@ -191,10 +191,10 @@ void SphericalMirrorProjection::initTextures(unsigned int internalFormat,
             return;
         }
         generateMap(texture, internalFormat, format, type);
-        Log::Debug(std::format(
+        Log::Debug(
             "{}x{} cube face texture (id: {}) generated",
             _cubemapResolution.x, _cubemapResolution.y, texture
-        ));
+        );
     };
 
     generate(_subViewports.right, _textures.cubeFaceRight);
@@ -8,14 +8,18 @@
 
 #include <sgct/screencapture.h>
 
+#include <sgct/captureencoder.h>
 #include <sgct/clustermanager.h>
 #include <sgct/engine.h>
 #include <sgct/format.h>
 #include <sgct/image.h>
 #include <sgct/log.h>
 #include <sgct/opengl.h>
+#include <sgct/pixelops.h>
 #include <sgct/profiling.h>
+#include <sgct/sequencefile.h>
 #include <sgct/window.h>
+#include <algorithm>
 #include <cstring>
 #include <string>
 
@@ -23,68 +27,60 @@ namespace sgct {
 
 ScreenCapture::ScreenCapture(const Window& window, ScreenCapture::EyeIndex ei,
                              int bytesPerColor, unsigned int colorDataType, bool addAlpha)
-    : _nThreads(Engine::instance().settings().capture.nCaptureThreads)
-    , _downloadType(colorDataType)
+    : _downloadType(colorDataType)
     , _bytesPerColor(bytesPerColor)
     , _addAlpha(addAlpha)
+    , _removeAlpha(bytesPerColor == 1 && !addAlpha)
     , _eyeIndex(ei)
     , _window(window)
-{
-    _captureInfos.resize(_nThreads);
-    for (unsigned int i = 0; i < _nThreads; i++) {
-        _captureInfos[i].frameBufferImage = nullptr;
-        _captureInfos[i].captureThread = nullptr;
-        _captureInfos[i].mutex = &_mutex;
-        _captureInfos[i].isRunning = false;
-    }
-    Log::Debug(std::format("Number of screencapture threads is set to {}", _nThreads));
-}
+{}
 
 ScreenCapture::~ScreenCapture() {
-    for (ScreenCaptureThreadInfo& info : _captureInfos) {
-        // kill threads that are still running
-        if (info.captureThread) {
-            info.captureThread->join();
-            info.captureThread = nullptr;
-        }
+    // Save everything that has been captured so far. The encoder holds on to our images
+    // until they are saved, so we can't go away before that
+    finishDownloads();
+    waitForImages();
 
-        const std::unique_lock lock(_mutex);
-        info.frameBufferImage = nullptr;
-        info.isRunning = false;
+    for (Download& download : _downloads) {
+        glDeleteBuffers(1, &download.pbo);
     }
-
-    glDeleteBuffers(1, &_pbo);
 }
 
 void ScreenCapture::resize(ivec2 resolution) {
-    glDeleteBuffers(1, &_pbo);
+    ZoneScoped;
+
+    // The captures with the previous resolution have to be saved before their images
+    // can be replaced
+    finishDownloads();
+    waitForImages();
+    {
+        const std::unique_lock lock(_mutex);
+        _freeImages.clear();
+        _nImages = 0;
+    }
+
+    for (Download& download : _downloads) {
+        glDeleteBuffers(1, &download.pbo);
+        download.pbo = 0;
+    }
 
     _resolution = std::move(resolution);
 
     const int nChannels = _addAlpha ? 4 : 3;
     _dataSize = _resolution.x * _resolution.y * nChannels * _bytesPerColor;
+    const int nDownloadChannels = (_addAlpha || _removeAlpha) ? 4 : 3;
+    _downloadSize = _resolution.x * _resolution.y * nDownloadChannels * _bytesPerColor;
 
-    const std::unique_lock lock(_mutex);
-    for (ScreenCaptureThreadInfo& info : _captureInfos) {
-        if (info.frameBufferImage) {
-            // kill threads that are still running
-            if (info.captureThread) {
-                info.captureThread->join();
-                info.captureThread = nullptr;
-            }
-            info.frameBufferImage = nullptr;
-        }
-        info.isRunning = false;
+    for (Download& download : _downloads) {
+        glGenBuffers(1, &download.pbo);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, download.pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, _downloadSize, nullptr, GL_STREAM_READ);
     }
-
-    glGenBuffers(1, &_pbo);
-    Log::Debug(std::format(
-        "Generating {}x{}x{} PBO: {}", _resolution.x, _resolution.y, nChannels, _pbo
-    ));
-
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo);
-    glBufferData(GL_PIXEL_PACK_BUFFER, _dataSize, nullptr, GL_STATIC_READ);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    Log::Debug(
+        "Generating {} {}x{}x{} PBOs",
+        NumberOfBuffers, _resolution.x, _resolution.y, nDownloadChannels
+    );
 }
 
 void ScreenCapture::saveScreenCapture(unsigned int textureId, CaptureSource capSrc) {
@@ -96,14 +92,22 @@ void ScreenCapture::saveScreenCapture(unsigned int textureId, CaptureSource capS
         uint64_t end = Engine::instance().settings().capture.limits->second;
 
         if (number < begin || number >= end) {
-            Log::Debug(std::format(
+            Log::Debug(
                 "Skipping screenshot {} outside range [{}, {}]", number, begin, end
-            ));
+            );
             return;
         }
     }
 
-    std::string file = createFilename(number);
+    if (Engine::instance().settings().capture.sequence && !_sequence) {
+        const std::string path = createFilePrefix() + "sequence.sgctseq";
+        _sequence = std::make_unique<SequenceWriter>(
+            path,
+            *Engine::instance().settings().capture.sequence
+        );
+    }
+
+    std::string file = _sequence ? "" : createFilename(number);
 
     const ivec2 res =
         capSrc == CaptureSource::Texture ?
@@ -113,25 +117,26 @@ void ScreenCapture::saveScreenCapture(unsigned int textureId, CaptureSource capS
         resize(res);
     }
 
-    const int threadIndex = availableCaptureThread();
-    if (threadIndex == -1) {
-        Log::Error("Error finding available capture thread");
+    if (_dataSize == 0) {
+        Log::Error("Error capturing an empty frame buffer");
         return;
     }
 
-    Image* imPtr = prepareImage(threadIndex, std::move(file));
+    // If the downloads into all buffers are still in progress, the oldest one has to be
+    // finished now so that its buffer can be reused
+    Download& download = _downloads[_nextDownload];
+    finishDownload(download);
+    _nextDownload = (_nextDownload + 1) % NumberOfBuffers;
+    download.filename = std::move(file);
+    download.frameNumber = number;
+
     glPixelStorei(GL_PACK_ALIGNMENT, 1);
-    glBindBuffer(GL_PIXEL_PACK_BUFFER, _pbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, download.pbo);
 
+    const GLenum format = (_addAlpha || _removeAlpha) ? GL_BGRA : GL_BGR;
     if (capSrc == CaptureSource::Texture) {
         glBindTexture(GL_TEXTURE_2D, textureId);
-        glGetTexImage(
-            GL_TEXTURE_2D,
-            0,
-            _addAlpha ? GL_BGRA : GL_BGR,
-            _downloadType,
-            nullptr
-        );
+        glGetTexImage(GL_TEXTURE_2D, 0, format, _downloadType, nullptr);
     }
     else {
         // set the target framebuffer to read
@@ -148,45 +153,36 @@ void ScreenCapture::saveScreenCapture(unsigned int textureId, CaptureSource capS
             default:
                 throw std::logic_error("Unhandled case label");
         }
-        const ivec2& s = imPtr->size();
-        const GLsizei w = static_cast<GLsizei>(s.x);
-        const GLsizei h = static_cast<GLsizei>(s.y);
-        glReadPixels(0, 0, w, h, _addAlpha ? GL_BGRA : GL_BGR, _downloadType, nullptr);
-    }
-
-    unsigned char* memoryPtr = reinterpret_cast<unsigned char*>(
-        glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY)
-    );
-    if (memoryPtr) {
-        std::memcpy(imPtr->data(), memoryPtr, _dataSize);
-
-        // save the image
-        _captureInfos[threadIndex].isRunning = true;
-        _captureInfos[threadIndex].captureThread = std::make_unique<std::thread>(
-            [](void* arg) {
-                ScreenCaptureThreadInfo* ptr =
-                    reinterpret_cast<ScreenCaptureThreadInfo*>(arg);
-
-                try {
-                    ptr->frameBufferImage->save(ptr->filename);
-                }
-                catch (const std::runtime_error& e) {
-                    Log::Error(e.what());
-                }
-                ptr->isRunning = false;
-            },
-            &_captureInfos[threadIndex]
-        );
-        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
-    }
-    else {
-        Log::Error("Can't map data (0) from GPU in frame capture");
+        const GLsizei w = static_cast<GLsizei>(_resolution.x);
+        const GLsizei h = static_cast<GLsizei>(_resolution.y);
+        glReadPixels(0, 0, w, h, format, _downloadType, nullptr);
     }
 
+    // The download has only been queued on the GPU. The fence tells us when it is done
+    download.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
 }
 
-std::string ScreenCapture::createFilename(uint64_t frameNumber) {
+void ScreenCapture::update() {
+    ZoneScoped;
+
+    // The downloads finish in the order in which they were started, so we can stop at
+    // the first one that is still in progress
+    for (int i = 0; i < NumberOfBuffers; i++) {
+        Download& download = _downloads[(_nextDownload + i) % NumberOfBuffers];
+        if (!download.fence) {
+            continue;
+        }
+
+        const GLenum res = glClientWaitSync(download.fence, 0, 0);
+        if (res == GL_TIMEOUT_EXPIRED) {
+            break;
+        }
+        finishDownload(download);
+    }
+}
+
+std::string ScreenCapture::createFilePrefix() const {
     const std::string eyeSuffix = [](EyeIndex eyeIndex) {
         switch (eyeIndex) {
             case EyeIndex::Mono:        return "";
@@ -196,10 +192,6 @@ std::string ScreenCapture::createFilename(uint64_t frameNumber) {
         }
     }(_eyeIndex);
 
-    std::array<char, 6> Buffer = {};
-    std::fill(Buffer.begin(), Buffer.end(), '\0');
-    std::format_to_n(Buffer.data(), Buffer.size(), "{:06}", frameNumber);
-
     std::filesystem::path file;
     if (!Engine::instance().settings().capture.capturePath.empty()) {
         file = Engine::instance().settings().capture.capturePath / "";
@@ -223,47 +215,123 @@ std::string ScreenCapture::createFilename(uint64_t frameNumber) {
         file += eyeSuffix + '_';
     }
 
-    return std::format("{}{}.png", file, std::string(Buffer.begin(), Buffer.end()));
+    return file.string();
 }
 
-int ScreenCapture::availableCaptureThread() {
-    while (true) {
-        for (unsigned int i = 0; i < _captureInfos.size(); i++) {
-            // check if thread is dead
-            if (_captureInfos[i].captureThread == nullptr) {
-                return i;
-            }
+std::string ScreenCapture::createFilename(uint64_t frameNumber) const {
+    std::array<char, 6> Buffer = {};
+    std::fill(Buffer.begin(), Buffer.end(), '\0');
+    std::format_to_n(Buffer.data(), Buffer.size(), "{:06}", frameNumber);
 
-            if (!_captureInfos[i].isRunning) {
-                _captureInfos[i].captureThread->join();
-                _captureInfos[i].captureThread = nullptr;
+    return std::format(
+        "{}{}.{}",
+        createFilePrefix(),
+        std::string(Buffer.begin(), Buffer.end()),
+        Image::extension(Engine::instance().settings().capture.format)
+    );
+}
+
+void ScreenCapture::finishDownload(Download& download) {
+    if (!download.fence) {
+        return;
+    }
+
+    ZoneScoped;
 
-                return i;
-            }
+    {
+        // Only blocks if the download was started less than a frame ago
+        ZoneScopedN("Wait for download");
+        constexpr GLuint64 Timeout = 5'000'000'000; // 5 s
+        glClientWaitSync(download.fence, GL_SYNC_FLUSH_COMMANDS_BIT, Timeout);
+        glDeleteSync(download.fence);
+        download.fence = nullptr;
+    }
+
+    std::unique_ptr<Image> image = acquireImage();
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, download.pbo);
+    const unsigned char* memoryPtr = reinterpret_cast<const unsigned char*>(
+        glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY)
+    );
+    if (memoryPtr) {
+        if (_removeAlpha) {
+            const size_t nPixels = static_cast<size_t>(_resolution.x) * _resolution.y;
+            pixelops::removeFourthChannel(memoryPtr, image->data(), nPixels);
+        }
+        else {
+            std::memcpy(image->data(), memoryPtr, _dataSize);
         }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        auto done = [this](std::unique_ptr<Image> img) { releaseImage(std::move(img)); };
+        if (_sequence) {
+            const uint64_t frameNumber = download.frameNumber;
+            Engine::instance().captureEncoder().submit(
+                std::format("{} in sequence", frameNumber),
+                [this, frameNumber](const Image& img) {
+                    _sequence->append(frameNumber, img);
+                },
+                std::move(image),
+                std::move(done)
+            );
+        }
+        else {
+            Engine::instance().captureEncoder().submit(
+                std::move(download.filename),
+                Engine::instance().settings().capture.format,
+                std::move(image),
+                std::move(done)
+            );
+        }
+    }
+    else {
+        Log::Error("Can't map data (0) from GPU in frame capture");
+        releaseImage(std::move(image));
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void ScreenCapture::finishDownloads() {
+    for (int i = 0; i < NumberOfBuffers; i++) {
+        finishDownload(_downloads[(_nextDownload + i) % NumberOfBuffers]);
     }
 }
 
-Image* ScreenCapture::prepareImage(int index, std::string file) {
-    Log::Debug(std::format("Starting thread for screenshot/capture [{}]", index));
-
-    if (_captureInfos[index].frameBufferImage == nullptr) {
-        const int nChannels = _addAlpha ? 4 : 3;
-        _captureInfos[index].frameBufferImage = std::make_unique<Image>();
-        _captureInfos[index].frameBufferImage->setBytesPerChannel(_bytesPerColor);
-        _captureInfos[index].frameBufferImage->setChannels(nChannels);
-        _captureInfos[index].frameBufferImage->setSize(_resolution);
-        if (_bytesPerColor * nChannels * _resolution.x * _resolution.y == 0) {
-            _captureInfos[index].frameBufferImage = nullptr;
-            return nullptr;
+std::unique_ptr<Image> ScreenCapture::acquireImage() {
+    {
+        const std::unique_lock lock(_mutex);
+        if (!_freeImages.empty()) {
+            std::unique_ptr<Image> image = std::move(_freeImages.back());
+            _freeImages.pop_back();
+            return image;
         }
-        _captureInfos[index].frameBufferImage->allocateOrResizeData();
+        _nImages++;
     }
-    _captureInfos[index].filename = std::move(file);
 
-    return _captureInfos[index].frameBufferImage.get();
+    auto image = std::make_unique<Image>();
+    image->setBytesPerChannel(_bytesPerColor);
+    image->setChannels(_addAlpha ? 4 : 3);
+    image->setSize(_resolution);
+    image->allocateOrResizeData();
+    return image;
+}
+
+void ScreenCapture::releaseImage(std::unique_ptr<Image> image) {
+    {
+        const std::unique_lock lock(_mutex);
+        _freeImages.push_back(std::move(image));
+    }
+    _imageCond.notify_all();
+}
+
+void ScreenCapture::waitForImages() {
+    ZoneScoped;
+
+    std::unique_lock lock(_mutex);
+    _imageCond.wait(
+        lock,
+        [this]() { return static_cast<int>(_freeImages.size()) == _nImages; }
+    );
 }
 
 } // namespace sgct
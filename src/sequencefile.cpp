@@ -0,0 +1,397 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/sequencefile.h>
+
+#include <sgct/error.h>
+#include <sgct/format.h>
+#include <sgct/image.h>
+#include <sgct/log.h>
+#include <sgct/profiling.h>
+#include <zlib.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
+
+#ifdef WIN32
+#include <io.h>
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <unistd.h>
+#endif // WIN32
+
+#define Err(code, msg) Error(Error::Component::Image, code, msg)
+
+namespace sgct {
+
+namespace {
+    constexpr std::string_view HeaderMagic = std::string_view("SGCTSEQ\0", 8);
+    constexpr std::string_view FooterMagic = std::string_view("SGCTIDX\0", 8);
+    constexpr std::string_view FrameMagic = "FRAM";
+    constexpr uint32_t Version = 1;
+
+    constexpr size_t HeaderSize = 8 + 2 * sizeof(uint32_t);
+    constexpr size_t FrameHeaderSize =
+        4 + sizeof(uint64_t) + 4 * sizeof(uint32_t) + sizeof(uint64_t);
+    constexpr size_t IndexEntrySize = 2 * sizeof(uint64_t);
+    constexpr size_t FooterSize = 2 * sizeof(uint64_t) + 8;
+
+    // The frames are only ever appended, so a large buffer turns the writes of a frame
+    // into few, large, sequential writes
+    constexpr size_t FileBufferSize = 4 << 20;
+
+    template <typename T>
+    void put(unsigned char*& p, T value) {
+        std::memcpy(p, &value, sizeof(T));
+        p += sizeof(T);
+    }
+
+    template <typename T>
+    T get(const unsigned char*& p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return value;
+    }
+
+    bool seek(FILE* file, int64_t offset, int origin) {
+#ifdef WIN32
+        return _fseeki64(file, offset, origin) == 0;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        return fseeko(file, static_cast<off_t>(offset), origin) == 0;
+#endif // WIN32
+    }
+
+    /// Shortens the \p file to \p size bytes, discarding anything that was buffered
+    /// beyond it
+    bool truncate(FILE* file, int64_t size) {
+        if (fflush(file) != 0) {
+            return false;
+        }
+#ifdef WIN32
+        return _chsize_s(_fileno(file), size) == 0;
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        return ftruncate(fileno(file), static_cast<off_t>(size)) == 0;
+#endif // WIN32
+    }
+
+    int64_t tell(FILE* file) {
+#ifdef WIN32
+        return _ftelli64(file);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+        return static_cast<int64_t>(ftello(file));
+#endif // WIN32
+    }
+
+    struct FrameHeader {
+        uint64_t frameNumber = 0;
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint32_t channels = 0;
+        uint32_t bytesPerChannel = 0;
+        uint64_t dataSize = 0;
+    };
+
+    bool readFrameHeader(FILE* file, FrameHeader& header) {
+        std::array<unsigned char, FrameHeaderSize> buffer;
+        if (fread(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+            return false;
+        }
+        if (std::memcmp(buffer.data(), FrameMagic.data(), FrameMagic.size()) != 0) {
+            return false;
+        }
+
+        const unsigned char* p = buffer.data() + FrameMagic.size();
+        header.frameNumber = get<uint64_t>(p);
+        header.width = get<uint32_t>(p);
+        header.height = get<uint32_t>(p);
+        header.channels = get<uint32_t>(p);
+        header.bytesPerChannel = get<uint32_t>(p);
+        header.dataSize = get<uint64_t>(p);
+        return true;
+    }
+} // namespace
+
+SequenceWriter::SequenceWriter(const std::filesystem::path& path, Compression compression)
+    : _compression(compression)
+{
+    std::string f = path.string();
+    _file = fopen(f.c_str(), "wb");
+    if (_file == nullptr) {
+        throw Err(9100, std::format("Cannot create sequence file '{}'", path));
+    }
+    setvbuf(_file, nullptr, _IOFBF, FileBufferSize);
+
+    std::array<unsigned char, HeaderSize> header;
+    std::memcpy(header.data(), HeaderMagic.data(), HeaderMagic.size());
+    unsigned char* p = header.data() + HeaderMagic.size();
+    put(p, Version);
+    put(p, static_cast<uint32_t>(_compression));
+    if (fwrite(header.data(), 1, header.size(), _file) != header.size()) {
+        fclose(_file);
+        throw Err(
+            9101, std::format("Failed to write header of sequence file '{}'", path)
+        );
+    }
+    _offset = header.size();
+
+    Log::Info("Recording screenshots into sequence file '{}'", path);
+}
+
+SequenceWriter::~SequenceWriter() {
+    if (_hasFailed) {
+        // The file ends with an incomplete frame, so the SequenceReader has to search
+        // for the frames that were written completely
+        Log::Error("Not writing the index of the sequence file after a failed write");
+        fclose(_file);
+        return;
+    }
+
+    std::vector<unsigned char> index(_index.size() * IndexEntrySize + FooterSize);
+    unsigned char* p = index.data();
+    for (const IndexEntry& entry : _index) {
+        put(p, entry.frameNumber);
+        put(p, entry.offset);
+    }
+    put(p, _offset);
+    put(p, static_cast<uint64_t>(_index.size()));
+    std::memcpy(p, FooterMagic.data(), FooterMagic.size());
+
+    if (fwrite(index.data(), 1, index.size(), _file) != index.size()) {
+        Log::Error("Failed to write the index of the sequence file");
+    }
+    fclose(_file);
+}
+
+void SequenceWriter::append(uint64_t frameNumber, const Image& image) {
+    ZoneScoped;
+
+    const size_t dataSize = static_cast<size_t>(image.size().x) * image.size().y *
+        image.channels() * image.bytesPerChannel();
+
+    const unsigned char* data = image.data();
+    uint64_t storedSize = dataSize;
+
+    // Reused between frames as the appends happen on the long-lived encoder threads
+    thread_local std::vector<unsigned char> compressed;
+    if (_compression == Compression::Deflate) {
+        ZoneScopedN("Compress");
+
+        uLongf length = compressBound(static_cast<uLong>(dataSize));
+        compressed.resize(length);
+        const int res = compress2(
+            compressed.data(),
+            &length,
+            data,
+            static_cast<uLong>(dataSize),
+            Z_BEST_SPEED
+        );
+        if (res != Z_OK) {
+            throw Err(9102, std::format("Failed to compress frame {}", frameNumber));
+        }
+        data = compressed.data();
+        storedSize = length;
+    }
+
+    std::array<unsigned char, FrameHeaderSize> header;
+    std::memcpy(header.data(), FrameMagic.data(), FrameMagic.size());
+    unsigned char* p = header.data() + FrameMagic.size();
+    put(p, frameNumber);
+    put(p, static_cast<uint32_t>(image.size().x));
+    put(p, static_cast<uint32_t>(image.size().y));
+    put(p, static_cast<uint32_t>(image.channels()));
+    put(p, static_cast<uint32_t>(image.bytesPerChannel()));
+    put(p, storedSize);
+
+    const std::unique_lock lock(_mutex);
+    if (_hasFailed) {
+        throw Err(
+            9103,
+            std::format("Failed to write frame {} after an earlier failure", frameNumber)
+        );
+    }
+    if (fwrite(header.data(), 1, header.size(), _file) != header.size() ||
+        fwrite(data, 1, storedSize, _file) != storedSize)
+    {
+        // Remove the part of the frame that was written so that the next frame and the
+        // index start where the last complete frame ended. If that is not possible, the
+        // offsets would no longer match the file and we stop writing to it altogether
+        clearerr(_file);
+        const int64_t offset = static_cast<int64_t>(_offset);
+        _hasFailed = !seek(_file, offset, SEEK_SET) || !truncate(_file, offset);
+        throw Err(9103, std::format("Failed to write frame {}", frameNumber));
+    }
+    _index.push_back({ .frameNumber = frameNumber, .offset = _offset });
+    _offset += header.size() + storedSize;
+}
+
+SequenceReader::SequenceReader(const std::filesystem::path& path) {
+    std::string f = path.string();
+    _file = fopen(f.c_str(), "rb");
+    if (_file == nullptr) {
+        throw Err(9104, std::format("Cannot open sequence file '{}'", path));
+    }
+
+    std::array<unsigned char, HeaderSize> header;
+    if (fread(header.data(), 1, header.size(), _file) != header.size() ||
+        std::memcmp(header.data(), HeaderMagic.data(), HeaderMagic.size()) != 0)
+    {
+        fclose(_file);
+        throw Err(9105, std::format("'{}' is not a sequence file", path));
+    }
+    const unsigned char* p = header.data() + HeaderMagic.size();
+    const uint32_t version = get<uint32_t>(p);
+    if (version != Version) {
+        fclose(_file);
+        throw Err(
+            9106,
+            std::format("Unsupported version {} of sequence file '{}'", version, path)
+        );
+    }
+    _compression = static_cast<SequenceWriter::Compression>(get<uint32_t>(p));
+
+    std::array<unsigned char, FooterSize> footer;
+    const bool hasFooter =
+        seek(_file, -static_cast<int64_t>(FooterSize), SEEK_END) &&
+        fread(footer.data(), 1, footer.size(), _file) == footer.size() &&
+        std::memcmp(
+            footer.data() + 2 * sizeof(uint64_t),
+            FooterMagic.data(),
+            FooterMagic.size()
+        ) == 0;
+
+    if (hasFooter) {
+        p = footer.data();
+        const uint64_t indexOffset = get<uint64_t>(p);
+        const uint64_t nFrames = get<uint64_t>(p);
+
+        std::vector<unsigned char> index(nFrames * IndexEntrySize);
+        if (!seek(_file, static_cast<int64_t>(indexOffset), SEEK_SET) ||
+            fread(index.data(), 1, index.size(), _file) != index.size())
+        {
+            fclose(_file);
+            throw Err(9107, std::format("Failed to read index of '{}'", path));
+        }
+
+        _index.resize(nFrames);
+        p = index.data();
+        for (IndexEntry& entry : _index) {
+            entry.frameNumber = get<uint64_t>(p);
+            entry.offset = get<uint64_t>(p);
+        }
+    }
+    else {
+        Log::Warning(
+            "Sequence file '{}' has no index. Searching for frames instead", path
+        );
+        rebuildIndex();
+    }
+
+    std::stable_sort(
+        _index.begin(),
+        _index.end(),
+        [](const IndexEntry& lhs, const IndexEntry& rhs) {
+            return lhs.frameNumber < rhs.frameNumber;
+        }
+    );
+}
+
+SequenceReader::~SequenceReader() {
+    fclose(_file);
+}
+
+size_t SequenceReader::numberOfFrames() const {
+    return _index.size();
+}
+
+uint64_t SequenceReader::frameNumber(size_t i) const {
+    return _index[i].frameNumber;
+}
+
+void SequenceReader::read(size_t i, Image& image) {
+    ZoneScoped;
+
+    const IndexEntry& entry = _index[i];
+    FrameHeader header;
+    if (!seek(_file, static_cast<int64_t>(entry.offset), SEEK_SET) ||
+        !readFrameHeader(_file, header))
+    {
+        throw Err(9108, std::format("Failed to read frame {}", entry.frameNumber));
+    }
+
+    image.setSize(
+        ivec2{ static_cast<int>(header.width), static_cast<int>(header.height) }
+    );
+    image.setChannels(static_cast<int>(header.channels));
+    image.setBytesPerChannel(static_cast<int>(header.bytesPerChannel));
+    image.allocateOrResizeData();
+    const size_t dataSize = static_cast<size_t>(header.width) * header.height *
+        header.channels * header.bytesPerChannel;
+
+    switch (_compression) {
+        case SequenceWriter::Compression::None:
+            if (header.dataSize != dataSize ||
+                fread(image.data(), 1, dataSize, _file) != dataSize)
+            {
+                throw Err(
+                    9108, std::format("Failed to read frame {}", entry.frameNumber)
+                );
+            }
+            break;
+        case SequenceWriter::Compression::Deflate:
+        {
+            _buffer.resize(header.dataSize);
+            if (fread(_buffer.data(), 1, _buffer.size(), _file) != _buffer.size()) {
+                throw Err(
+                    9108, std::format("Failed to read frame {}", entry.frameNumber)
+                );
+            }
+
+            uLongf length = static_cast<uLongf>(dataSize);
+            const int res = uncompress(
+                image.data(),
+                &length,
+                _buffer.data(),
+                static_cast<uLong>(_buffer.size())
+            );
+            if (res != Z_OK || length != dataSize) {
+                throw Err(
+                    9109,
+                    std::format("Failed to decompress frame {}", entry.frameNumber)
+                );
+            }
+            break;
+        }
+        default:
+            throw std::logic_error("Unhandled case label");
+    }
+}
+
+void SequenceReader::rebuildIndex() {
+    seek(_file, 0, SEEK_END);
+    const int64_t fileSize = tell(_file);
+
+    // The last frame might have been cut off while it was written, so we only keep the
+    // frames that are complete
+    int64_t offset = static_cast<int64_t>(HeaderSize);
+    FrameHeader header;
+    while (seek(_file, offset, SEEK_SET) && readFrameHeader(_file, header)) {
+        const int64_t next = offset + static_cast<int64_t>(FrameHeaderSize) +
+            static_cast<int64_t>(header.dataSize);
+        if (next > fileSize) {
+            break;
+        }
+        _index.push_back({
+            .frameNumber = header.frameNumber,
+            .offset = static_cast<uint64_t>(offset)
+        });
+        offset = next;
+    }
+}
+
+} // namespace sgct
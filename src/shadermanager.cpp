@@ -66,7 +66,7 @@ bool ShaderManager::removeShaderProgram(std::string_view name) {
 
     if (shaderIt == _shaderPrograms.end()) {
         Log::Warning(
-            std::format("Unable to remove shader program '{}': Not found", name)
+            "Unable to remove shader program '{}': Not found", name
         );
         return false;
     }
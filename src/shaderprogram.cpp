@@ -28,7 +28,7 @@ namespace {
             glGetProgramInfoLog(programId, logLength, nullptr, log.data());
 
             sgct::Log::Error(
-                std::format("Shader '{}' linking error: {}", name, log.data())
+                "Shader '{}' linking error: {}", name, log.data()
             );
         }
         return linkStatus != 0;
@@ -52,16 +52,16 @@ namespace {
             glGetShaderiv(id, GL_INFO_LOG_LENGTH, &logLength);
 
             if (logLength == 0) {
-                sgct::Log::Error(std::format(
+                sgct::Log::Error(
                     "{} compile error: Unknown error", shaderTypeName(type)
-                ));
+                );
             }
 
             std::vector<GLchar> log(logLength);
             glGetShaderInfoLog(id, logLength, nullptr, log.data());
-            sgct::Log::Error(std::format(
+            sgct::Log::Error(
                 "{} compile error: {}", shaderTypeName(type), log.data()
-            ));
+            );
         }
     }
 } // namespace
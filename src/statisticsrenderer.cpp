@@ -422,6 +422,84 @@ void StatisticsRenderer::render(const Window& window, const Viewport& viewport)
             ColorLoopTimeMax,
             std::format("Max Loop time: {} ms", _statistics.loopTimeMax[0] * 1000.0)
         );
+
+        // The times that the clients reported are listed above the other values with one
+        // line per node, the slowest drawing node is marked
+        const float lineOffset = 0.75f * penOffset;
+        float linePosition = penPosition.y + 10 * penOffset;
+        const std::vector<Engine::Statistics::NodeTiming>& nodes =
+            _statistics.nodeTimings;
+        auto slowest = std::max_element(
+            nodes.cbegin(),
+            nodes.cend(),
+            [](const Engine::Statistics::NodeTiming& lhs,
+               const Engine::Statistics::NodeTiming& rhs)
+            {
+                return lhs.drawTime < rhs.drawTime;
+            }
+        );
+        for (auto it = nodes.crbegin(); it != nodes.crend(); it++) {
+            text::print(
+                window,
+                viewport,
+                f2,
+                mode,
+                penPosition.x, linePosition,
+                ColorSyncTime,
+                std::format(
+                    "  Node {}: draw {:.2f} ms, sync {:.2f} ms, swap {:.2f} ms, "
+                    "{} dropped{}",
+                    it->nodeIndex, it->drawTime * 1000.0, it->syncTime * 1000.0,
+                    it->swapTime * 1000.0, it->nDroppedFrames,
+                    it.base() - 1 == slowest ? " (slowest)" : ""
+                )
+            );
+            linePosition += lineOffset;
+        }
+        if (!nodes.empty()) {
+            text::print(
+                window,
+                viewport,
+                f2,
+                mode,
+                penPosition.x, linePosition,
+                ColorSyncTime,
+                std::format("Clients ({} dropped here):", _statistics.nDroppedFrames)
+            );
+            linePosition += lineOffset;
+        }
+
+        // The GPU time of the zones of the frame is listed above the clients with nested
+        // zones indented below their parent
+        const float zoneOffset = lineOffset;
+        float zonePosition =
+            linePosition + zoneOffset * static_cast<float>(_statistics.gpuZones.size());
+        if (!_statistics.gpuZones.empty()) {
+            text::print(
+                window,
+                viewport,
+                f2,
+                mode,
+                penPosition.x, zonePosition,
+                ColorDrawTime,
+                "GPU time:"
+            );
+        }
+        for (const GpuTimer::Zone& zone : _statistics.gpuZones) {
+            zonePosition -= zoneOffset;
+            text::print(
+                window,
+                viewport,
+                f2,
+                mode,
+                penPosition.x, zonePosition,
+                ColorDrawTime,
+                std::format(
+                    "{:{}}{}: {:.3f} ms",
+                    "", 2 * (zone.depth + 1), zone.name, zone.duration * 1000.0
+                )
+            );
+        }
 #endif // SGCT_HAS_TEXT
     }
 
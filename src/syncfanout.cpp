@@ -0,0 +1,117 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/syncfanout.h>
+
+#include <sgct/engine.h>
+#include <sgct/profiling.h>
+
+namespace sgct {
+
+SyncFanOut::SyncFanOut(int nThreads) {
+    _threads.reserve(nThreads);
+    for (int i = 0; i < nThreads; i++) {
+        _threads.emplace_back([this]() { worker(); });
+    }
+}
+
+SyncFanOut::~SyncFanOut() {
+    {
+        const std::unique_lock lk(_mutex);
+        _shouldTerminate = true;
+    }
+    _startCond.notify_all();
+    for (std::thread& thread : _threads) {
+        thread.join();
+    }
+}
+
+void SyncFanOut::run(std::vector<Job>& js) {
+    ZoneScoped;
+
+    {
+        const std::unique_lock lk(_mutex);
+        _jobs = &js;
+        _nRemainingJobs = js.size();
+        _nextJob = 0;
+        _generation++;
+    }
+    _startCond.notify_all();
+
+    processJobs();
+
+    // Workers that woke up late might still be looking at the job list, so we have to
+    // wait for them too before the list can be reused in the next frame
+    std::unique_lock lk(_mutex);
+    _doneCond.wait(lk, [this]() { return _nRemainingJobs == 0 && _nBusyWorkers == 0; });
+    _jobs = nullptr;
+}
+
+void SyncFanOut::send(Job& job) {
+    const double t0 = time();
+    try {
+        job.connection->sendData(
+            job.header.data(),
+            Network::HeaderSize,
+            job.payload,
+            job.length
+        );
+    }
+    catch (...) {
+        job.error = std::current_exception();
+    }
+    job.sendTime = time() - t0;
+}
+
+void SyncFanOut::processJobs() {
+    while (true) {
+        const size_t i = _nextJob.fetch_add(1);
+        if (i >= _jobs->size()) {
+            break;
+        }
+
+        send((*_jobs)[i]);
+
+        const std::unique_lock lk(_mutex);
+        _nRemainingJobs--;
+        if (_nRemainingJobs == 0) {
+            _doneCond.notify_all();
+        }
+    }
+}
+
+void SyncFanOut::worker() {
+    uint64_t generation = 0;
+    while (true) {
+        {
+            std::unique_lock lk(_mutex);
+            _startCond.wait(
+                lk,
+                [&]() {
+                    return _shouldTerminate ||
+                           (_jobs != nullptr && _generation != generation);
+                }
+            );
+            if (_shouldTerminate) {
+                return;
+            }
+            generation = _generation;
+            _nBusyWorkers++;
+        }
+
+        processJobs();
+
+        const std::unique_lock lk(_mutex);
+        _nBusyWorkers--;
+        if (_nBusyWorkers == 0) {
+            _doneCond.notify_all();
+        }
+    }
+}
+
+} // namespace sgct
@@ -8,56 +8,73 @@
 
 #include <sgct/texturemanager.h>
 
+#include <sgct/compressedtexture.h>
 #include <sgct/format.h>
 #include <sgct/image.h>
 #include <sgct/log.h>
 #include <sgct/opengl.h>
+#include <sgct/pixelops.h>
+#include <sgct/profiling.h>
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <string_view>
+#include <vector>
 
 namespace {
-    unsigned int uploadImage(const sgct::Image& img, bool interpolate, int mipmap,
-                             float anisotropicFilterSize)
-    {
-        unsigned int tex = 0;
-        glGenTextures(1, &tex);
-        glBindTexture(GL_TEXTURE_2D, tex);
+    using TextureInfo = sgct::TextureManager::TextureInfo;
 
-        const auto [type, internalFormat] = [](int c) -> std::pair<GLenum, GLenum> {
-            switch (c) {
-                case 1: return { GL_RED, GL_R8 };
-                case 2: return { GL_RG, GL_RG8 };
-                case 3: return { GL_BGR, GL_RGB8 };
-                case 4: return { GL_BGRA, GL_RGBA8 };
-                default: throw std::logic_error("Unhandled case label");
-            }
-        }(img.channels());
+    // The upload of the images that are decoded asynchronously is spread over multiple
+    // frames if they are larger than this in total, so that a frame is not stalled by
+    // copying them into the pixel buffer objects
+    constexpr size_t UploadBytesPerFrame = 64 << 20;
 
-        sgct::Log::Debug(std::format(
-            "Creating texture. Size: {}x{}, {}-channels, Type: {:#04x}, Format: {:#04x}",
-            img.size().x, img.size().y, img.channels(), type, internalFormat
-        ));
+    /// \return The number of bytes that are uploaded for the \p img
+    size_t uploadSize(const sgct::Image& img) {
+        // 3 channel images are expanded to 4 channels for the upload
+        const int nChannels = img.channels() == 3 ? 4 : img.channels();
+        return static_cast<size_t>(img.size().x) * img.size().y * nChannels;
+    }
 
-        glPixelStorei(GL_PACK_ALIGNMENT, 1);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    /**
+     * Writes the pixels of the \p img into \p dst, which has to be at least as large as
+     * returned by #uploadSize.
+     */
+    void copyForUpload(const sgct::Image& img, unsigned char* dst) {
+        // Drivers convert 3 channel uploads into 4 channels on the CPU one pixel at a
+        // time, so we do that ourselves and upload in the layout the GPU uses natively
+        const size_t nPixels = static_cast<size_t>(img.size().x) * img.size().y;
+        if (img.channels() == 3) {
+            sgct::pixelops::expandToFourChannels(img.data(), dst, nPixels);
+        }
+        else {
+            std::memcpy(dst, img.data(), nPixels * img.channels());
+        }
+    }
 
-        constexpr GLenum Format = GL_UNSIGNED_BYTE;
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            internalFormat,
-            img.size().x,
-            img.size().y,
-            0,
-            type,
-            Format,
-            img.data()
-        );
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mipmap - 1);
+    // BC1 is only part of the S3TC extension, which every desktop driver supports, and
+    // its sRGB variants of the EXT_texture_sRGB extension
+    constexpr GLenum GL_COMPRESSED_RGB_S3TC_DXT1_EXT = 0x83F0;
+    constexpr GLenum GL_COMPRESSED_RGBA_S3TC_DXT1_EXT = 0x83F1;
+    constexpr GLenum GL_COMPRESSED_SRGB_S3TC_DXT1_EXT = 0x8C4C;
+    constexpr GLenum GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT = 0x8C4D;
 
-        if (mipmap > 1) {
-            glGenerateMipmap(GL_TEXTURE_2D);
+    /// \return The number of mipmap levels down to 1x1 for a texture of the \p size
+    int maxLevels(sgct::ivec2 size) {
+        int nLevels = 1;
+        while ((size.x >> nLevels) > 0 || (size.y >> nLevels) > 0) {
+            nLevels++;
+        }
+        return nLevels;
+    }
 
+    /// Sets the filtering and wrapping of the bound texture that has \p nLevels levels
+    void setParameters(bool interpolate, int nLevels, float anisotropicFilterSize) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, nLevels - 1);
+
+        if (nLevels > 1) {
             glTexParameteri(
                 GL_TEXTURE_2D,
                 GL_TEXTURE_MIN_FILTER,
@@ -99,13 +116,211 @@ namespace {
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
 
-        return tex;
+    /**
+     * Creates a texture for an image with the provided \p size and \p nChannels. The
+     * \p data has to be prepared with #copyForUpload and is either a pointer to the
+     * pixels or an offset into the pixel buffer object that is currently bound.
+     */
+    TextureInfo createTexture(sgct::ivec2 size, int nChannels, const void* data,
+                              bool interpolate, int mipmap, float anisotropicFilterSize)
+    {
+        unsigned int tex = 0;
+        glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D, tex);
+
+        struct Layout {
+            GLenum type;
+            GLenum internalFormat;
+            std::string_view name;
+        };
+        const Layout layout = [](int c) -> Layout {
+            switch (c) {
+                case 1: return { GL_RED, GL_R8, "R8" };
+                case 2: return { GL_RG, GL_RG8, "RG8" };
+                case 3: return { GL_BGRA, GL_RGB8, "RGB8" };
+                case 4: return { GL_BGRA, GL_RGBA8, "RGBA8" };
+                default: throw std::logic_error("Unhandled case label");
+            }
+        }(nChannels);
+
+        sgct::Log::Debug(
+            "Creating texture. Size: {}x{}, {}-channels, Type: {:#04x}, Format: {:#04x}",
+            size.x, size.y, nChannels, layout.type, layout.internalFormat
+        );
+
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        // Immutable storage needs the number of levels up front, so it is limited to the
+        // levels that actually exist for the size
+        const int nLevels = std::clamp(mipmap, 1, maxLevels(size));
+
+        constexpr GLenum Format = GL_UNSIGNED_BYTE;
+        if (GLAD_GL_VERSION_4_2) {
+            glTexStorage2D(GL_TEXTURE_2D, nLevels, layout.internalFormat, size.x, size.y);
+            glTexSubImage2D(
+                GL_TEXTURE_2D,
+                0,
+                0,
+                0,
+                size.x,
+                size.y,
+                layout.type,
+                Format,
+                data
+            );
+        }
+        else {
+            glTexImage2D(
+                GL_TEXTURE_2D,
+                0,
+                layout.internalFormat,
+                size.x,
+                size.y,
+                0,
+                layout.type,
+                Format,
+                data
+            );
+        }
+        if (nLevels > 1) {
+            glGenerateMipmap(GL_TEXTURE_2D);
+        }
+        setParameters(interpolate, nLevels, anisotropicFilterSize);
+
+        // 3 channel textures are padded to 4 channels by the drivers
+        const size_t bytesPerPixel = nChannels == 3 ? 4 : nChannels;
+        TextureInfo info;
+        info.id = tex;
+        info.size = size;
+        info.nLevels = nLevels;
+        info.format = layout.name;
+        for (int i = 0; i < nLevels; i++) {
+            const size_t w = std::max(size.x >> i, 1);
+            const size_t h = std::max(size.y >> i, 1);
+            info.nBytes += w * h * bytesPerPixel;
+        }
+        return info;
+    }
+
+    /**
+     * Creates a texture from the blocks of the compressed \p texture. The \p data is
+     * either a pointer to the blocks or `nullptr` if they were copied into the pixel
+     * buffer object that is currently bound.
+     */
+    TextureInfo createCompressedTexture(const sgct::CompressedTexture& texture,
+                                        const unsigned char* data, bool interpolate,
+                                        float anisotropicFilterSize)
+    {
+        using sgct::CompressedTexture;
+
+        unsigned int tex = 0;
+        glGenTextures(1, &tex);
+        glBindTexture(GL_TEXTURE_2D, tex);
+
+        const GLenum internalFormat = [](const CompressedTexture& t) {
+            switch (t.format()) {
+                case CompressedTexture::Format::BC1:
+                    if (t.hasAlpha()) {
+                        return t.isSrgb() ?
+                            GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT :
+                            GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+                    }
+                    return t.isSrgb() ?
+                        GL_COMPRESSED_SRGB_S3TC_DXT1_EXT :
+                        GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+                case CompressedTexture::Format::BC4:
+                    return GLenum(GL_COMPRESSED_RED_RGTC1);
+                case CompressedTexture::Format::BC7:
+                    return t.isSrgb() ?
+                        GLenum(GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM) :
+                        GLenum(GL_COMPRESSED_RGBA_BPTC_UNORM);
+                default: throw std::logic_error("Unhandled case label");
+            }
+        }(texture);
+
+        const std::vector<CompressedTexture::Level>& levels = texture.levels();
+        const int nLevels = static_cast<int>(levels.size());
+        sgct::Log::Debug(
+            "Creating compressed texture. Size: {}x{}, {} levels, Format: {}",
+            texture.size().x, texture.size().y, nLevels,
+            CompressedTexture::name(texture.format())
+        );
+
+        if (GLAD_GL_VERSION_4_2) {
+            glTexStorage2D(
+                GL_TEXTURE_2D,
+                nLevels,
+                internalFormat,
+                texture.size().x,
+                texture.size().y
+            );
+        }
+        for (int i = 0; i < nLevels; i++) {
+            const CompressedTexture::Level& level = levels[i];
+            // An offset into the bound buffer object is passed as a pointer, so the
+            // arithmetic has to work for a nullptr base as well
+            const void* blocks = reinterpret_cast<const void*>(
+                reinterpret_cast<uintptr_t>(data) + level.offset
+            );
+            const GLsizei nBytes = static_cast<GLsizei>(level.nBytes);
+            if (GLAD_GL_VERSION_4_2) {
+                glCompressedTexSubImage2D(
+                    GL_TEXTURE_2D,
+                    i,
+                    0,
+                    0,
+                    level.size.x,
+                    level.size.y,
+                    internalFormat,
+                    nBytes,
+                    blocks
+                );
+            }
+            else {
+                glCompressedTexImage2D(
+                    GL_TEXTURE_2D,
+                    i,
+                    internalFormat,
+                    level.size.x,
+                    level.size.y,
+                    0,
+                    nBytes,
+                    blocks
+                );
+            }
+        }
+        setParameters(interpolate, nLevels, anisotropicFilterSize);
+
+        TextureInfo info;
+        info.id = tex;
+        info.size = texture.size();
+        info.nLevels = nLevels;
+        info.format = CompressedTexture::name(texture.format());
+        info.nBytes = texture.dataSize();
+        return info;
     }
 } // namespace
 
 namespace sgct {
 
+struct TextureManager::Request {
+    std::filesystem::path filename;
+    bool interpolate = true;
+    float anisotropicFilterSize = 1.f;
+    int mipmapLevels = 8;
+    Clock::time_point start;
+    std::promise<unsigned int> promise;
+    /// The decoded image. Released as soon as it has been copied into a buffer object
+    std::unique_ptr<Image> image;
+    /// Used instead of the image for KTX2 and DDS files
+    std::unique_ptr<CompressedTexture> compressed;
+    /// The number of bytes that are uploaded for the image or compressed texture
+    size_t nBytes = 0;
+};
+
 TextureManager* TextureManager::_instance = nullptr;
 
 TextureManager& TextureManager::instance() {
@@ -121,48 +336,384 @@ void TextureManager::destroy() {
 }
 
 TextureManager::~TextureManager() {
-    glDeleteTextures(static_cast<GLsizei>(_textures.size()), _textures.data());
+    {
+        const std::unique_lock lock(_mutex);
+        _shouldTerminate = true;
+    }
+    _requestCond.notify_all();
+    for (std::thread& thread : _threads) {
+        thread.join();
+    }
+
+    // The textures that are still being uploaded are discarded, which the callers see
+    // as a broken promise in their futures. Buffers that were never used were never
+    // created, so no OpenGL context is needed if nothing was uploaded
+    for (Upload& upload : _uploads) {
+        if (upload.fence) {
+            glDeleteSync(upload.fence);
+        }
+        if (upload.texture.id != 0) {
+            glDeleteTextures(1, &upload.texture.id);
+        }
+        if (upload.pbo != 0) {
+            glDeleteBuffers(1, &upload.pbo);
+        }
+    }
+
+    for (const TextureInfo& info : _textures) {
+        glDeleteTextures(1, &info.id);
+    }
 }
 
 unsigned int TextureManager::loadTexture(const std::filesystem::path& filename,
                                          bool interpolate, float anisotropicFilterSize,
                                          int mipmapLevels)
 {
-    // load image
-    Image img;
-    img.load(filename);
-
-    if (img.data() == nullptr) {
-        // image data not valid
-        return 0;
+    unsigned int t = 0;
+    if (CompressedTexture::isCompressedFile(filename)) {
+        CompressedTexture texture;
+        texture.load(filename);
+        t = loadTexture(texture, interpolate, anisotropicFilterSize);
     }
+    else {
+        // load image
+        Image img;
+        img.load(filename);
 
-    unsigned int t = loadTexture(
-        img,
-        interpolate,
-        anisotropicFilterSize,
-        mipmapLevels
-    );
-    Log::Debug(std::format("Texture created from '{}' [id={}]", filename, t));
+        if (img.data() == nullptr) {
+            // image data not valid
+            return 0;
+        }
+
+        t = loadTexture(img, interpolate, anisotropicFilterSize, mipmapLevels);
+    }
+    _textures.back().filename = filename;
+    Log::Debug("Texture created from '{}' [id={}]", filename, t);
     return t;
 }
 
 unsigned int TextureManager::loadTexture(const Image& img, bool interpolate,
                                          float anisotropicFilterSize, int mipmapLevels)
 {
-    const GLuint t = uploadImage(img, interpolate, mipmapLevels, anisotropicFilterSize);
-    _textures.push_back(t);
+    std::vector<unsigned char> expanded;
+    const unsigned char* data = img.data();
+    if (img.channels() == 3) {
+        expanded.resize(uploadSize(img));
+        copyForUpload(img, expanded.data());
+        data = expanded.data();
+    }
+
+    const TextureInfo info = createTexture(
+        img.size(),
+        img.channels(),
+        data,
+        interpolate,
+        mipmapLevels,
+        anisotropicFilterSize
+    );
+    _textures.push_back(info);
+
+    return info.id;
+}
+
+unsigned int TextureManager::loadTexture(const CompressedTexture& texture,
+                                         bool interpolate, float anisotropicFilterSize)
+{
+    const TextureInfo info = createCompressedTexture(
+        texture,
+        texture.data(),
+        interpolate,
+        anisotropicFilterSize
+    );
+    _textures.push_back(info);
 
-    return t;
+    return info.id;
+}
+
+std::future<unsigned int> TextureManager::loadTextureAsync(std::filesystem::path filename,
+                                                           bool interpolate,
+                                                           float anisotropicFilterSize,
+                                                           int mipmapLevels)
+{
+    auto request = std::make_unique<Request>();
+    request->filename = std::move(filename);
+    request->interpolate = interpolate;
+    request->anisotropicFilterSize = anisotropicFilterSize;
+    request->mipmapLevels = mipmapLevels;
+    request->start = Clock::now();
+    std::future<unsigned int> future = request->promise.get_future();
+
+    {
+        const std::unique_lock lock(_mutex);
+        if (_threads.empty()) {
+            // Decoding is mostly limited by the disk for small textures, so there is
+            // little to gain from using all cores
+            const unsigned int nThreads =
+                std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+            _threads.reserve(nThreads);
+            for (unsigned int i = 0; i < nThreads; i++) {
+                _threads.emplace_back([this]() { worker(); });
+            }
+            Log::Debug("Number of texture decode threads is {}", nThreads);
+        }
+
+        _decodeQueue.push_back(std::move(request));
+        _statistics.nPending++;
+    }
+    _requestCond.notify_one();
+    return future;
+}
+
+void TextureManager::update() {
+    ZoneScoped;
+
+    // The uploads that have finished on the GPU are published first so that their buffer
+    // objects can be reused for the next uploads right away
+    for (Upload& upload : _uploads) {
+        if (!upload.fence) {
+            continue;
+        }
+
+        const GLenum res = glClientWaitSync(upload.fence, 0, 0);
+        if (res == GL_ALREADY_SIGNALED || res == GL_CONDITION_SATISFIED) {
+            finishUpload(upload);
+        }
+        else if (res == GL_WAIT_FAILED) {
+            // The fence can not tell whether the upload is done, so all GPU commands
+            // have to finish before the buffer object can be reused
+            Log::Warning(
+                "Checking the upload of '{}' failed with error {}. Waiting for the GPU "
+                "instead",
+                upload.request->filename, glGetError()
+            );
+            glFinish();
+            finishUpload(upload);
+        }
+    }
+
+    size_t nBytes = 0;
+    for (Upload& upload : _uploads) {
+        if (upload.request) {
+            continue;
+        }
+        if (nBytes >= UploadBytesPerFrame) {
+            break;
+        }
+
+        std::unique_ptr<Request> request;
+        {
+            const std::unique_lock lock(_mutex);
+            if (_uploadQueue.empty()) {
+                break;
+            }
+            request = std::move(_uploadQueue.front());
+            _uploadQueue.pop_front();
+        }
+        nBytes += request->nBytes;
+        startUpload(upload, std::move(request));
+    }
+}
+
+TextureManager::Statistics TextureManager::statistics() const {
+    const std::unique_lock lock(_mutex);
+    return _statistics;
 }
 
 void TextureManager::removeTexture(unsigned int textureId) {
-    _textures.erase(
-        std::remove(_textures.begin(), _textures.end(), textureId),
-        _textures.end()
+    std::erase_if(
+        _textures,
+        [textureId](const TextureInfo& info) { return info.id == textureId; }
     );
 
     glDeleteTextures(1, &textureId);
 }
 
+const std::vector<TextureManager::TextureInfo>& TextureManager::textures() const {
+    return _textures;
+}
+
+void TextureManager::logMemoryUsage() const {
+    constexpr double MB = 1024.0 * 1024.0;
+
+    size_t total = 0;
+    for (const TextureInfo& info : _textures) {
+        Log::Info(
+            "Texture {} '{}': {}x{}, {}, {} levels, {:.2f} MB",
+            info.id, info.filename, info.size.x, info.size.y, info.format, info.nLevels,
+            static_cast<double>(info.nBytes) / MB
+        );
+        total += info.nBytes;
+    }
+    Log::Info(
+        "{} textures use {:.2f} MB", _textures.size(), static_cast<double>(total) / MB
+    );
+}
+
+void TextureManager::worker() {
+    while (true) {
+        std::unique_ptr<Request> request;
+        {
+            std::unique_lock lock(_mutex);
+            _requestCond.wait(
+                lock,
+                [this]() { return _shouldTerminate || !_decodeQueue.empty(); }
+            );
+            if (_shouldTerminate) {
+                return;
+            }
+            request = std::move(_decodeQueue.front());
+            _decodeQueue.pop_front();
+        }
+
+        ZoneScopedN("Decode texture");
+        try {
+            if (CompressedTexture::isCompressedFile(request->filename)) {
+                request->compressed = std::make_unique<CompressedTexture>();
+                request->compressed->load(request->filename);
+                request->nBytes = request->compressed->dataSize();
+            }
+            else {
+                request->image = std::make_unique<Image>();
+                request->image->load(request->filename);
+                request->nBytes = uploadSize(*request->image);
+            }
+        }
+        catch (const std::exception& e) {
+            Log::Error(
+                "Failed to load texture '{}': {}", request->filename, e.what()
+            );
+            request->promise.set_exception(std::current_exception());
+
+            const std::unique_lock lock(_mutex);
+            _statistics.nPending--;
+            continue;
+        }
+
+        const std::unique_lock lock(_mutex);
+        _statistics.bytesInFlight += request->nBytes;
+        _uploadQueue.push_back(std::move(request));
+    }
+}
+
+void TextureManager::startUpload(Upload& upload, std::unique_ptr<Request> request) {
+    ZoneScoped;
+
+    if (upload.pbo == 0) {
+        glGenBuffers(1, &upload.pbo);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload.pbo);
+    if (upload.capacity < request->nBytes) {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, request->nBytes, nullptr, GL_STREAM_DRAW);
+        upload.capacity = request->nBytes;
+    }
+
+    // Invalidating the buffer lets the driver hand out fresh memory instead of waiting
+    // for a previous upload from the same buffer to finish
+    void* dst = glMapBufferRange(
+        GL_PIXEL_UNPACK_BUFFER,
+        0,
+        request->nBytes,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT
+    );
+    if (dst) {
+        if (request->compressed) {
+            std::memcpy(dst, request->compressed->data(), request->nBytes);
+        }
+        else {
+            copyForUpload(*request->image, reinterpret_cast<unsigned char*>(dst));
+        }
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        // With the buffer object bound, the texture is filled from its memory by the GPU
+        // and the call returns immediately
+        if (request->compressed) {
+            upload.texture = createCompressedTexture(
+                *request->compressed,
+                nullptr,
+                request->interpolate,
+                request->anisotropicFilterSize
+            );
+        }
+        else {
+            upload.texture = createTexture(
+                request->image->size(),
+                request->image->channels(),
+                nullptr,
+                request->interpolate,
+                request->mipmapLevels,
+                request->anisotropicFilterSize
+            );
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    else {
+        Log::Warning(
+            "Could not map buffer object for '{}'. Uploading directly instead",
+            request->filename
+        );
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (request->compressed) {
+            upload.texture = createCompressedTexture(
+                *request->compressed,
+                request->compressed->data(),
+                request->interpolate,
+                request->anisotropicFilterSize
+            );
+        }
+        else {
+            std::vector<unsigned char> data(request->nBytes);
+            copyForUpload(*request->image, data.data());
+            upload.texture = createTexture(
+                request->image->size(),
+                request->image->channels(),
+                data.data(),
+                request->interpolate,
+                request->mipmapLevels,
+                request->anisotropicFilterSize
+            );
+        }
+    }
+
+    upload.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    upload.start = Clock::now();
+    request->image = nullptr;
+    request->compressed = nullptr;
+    upload.request = std::move(request);
+}
+
+void TextureManager::finishUpload(Upload& upload) {
+    ZoneScoped;
+
+    glDeleteSync(upload.fence);
+    upload.fence = nullptr;
+
+    const Clock::time_point now = Clock::now();
+    using Seconds = std::chrono::duration<double>;
+    const double uploadLatency = Seconds(now - upload.start).count();
+    const double totalLatency = Seconds(now - upload.request->start).count();
+
+    upload.texture.filename = upload.request->filename;
+    _textures.push_back(upload.texture);
+    Log::Debug(
+        "Texture created from '{}' [id={}]", upload.request->filename, upload.texture.id
+    );
+    upload.request->promise.set_value(upload.texture.id);
+
+    {
+        const std::unique_lock lock(_mutex);
+        _statistics.nPending--;
+        _statistics.bytesInFlight -= upload.request->nBytes;
+        _statistics.nLoaded++;
+        _statistics.lastUploadLatency = uploadLatency;
+        _totalUploadLatency += uploadLatency;
+        _statistics.averageUploadLatency =
+            _totalUploadLatency / static_cast<double>(_statistics.nLoaded);
+        _statistics.lastTotalLatency = totalLatency;
+    }
+
+    upload.texture = TextureInfo();
+    upload.request = nullptr;
+}
+
 } // namespace sgct
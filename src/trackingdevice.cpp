@@ -21,6 +21,24 @@
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <algorithm>
+#include <cstring>
+#include <optional>
+
+namespace {
+    // Combines the transforms of the tracker, the sensor, and the device into the
+    // transform of the sensor in world coordinates
+    sgct::mat4 toWorldTransform(const sgct::mat4& parent, const sgct::vec3& position,
+                                const sgct::quat& rotation, const sgct::mat4& device)
+    {
+        const glm::mat4 m = glm::make_mat4(parent.values.data()) *
+            glm::translate(glm::mat4(1.f), glm::make_vec3(&position.x)) *
+            glm::mat4_cast(glm::make_quat(&rotation.x)) *
+            glm::make_mat4(device.values.data());
+        sgct::mat4 res;
+        std::memcpy(&res, glm::value_ptr(m), 16 * sizeof(float));
+        return res;
+    }
+} // namespace
 
 namespace sgct {
 
@@ -54,7 +72,7 @@ void TrackingDevice::setNumberOfAxes(int numOfAxes) {
     _nAxes = numOfAxes;
 }
 
-void TrackingDevice::setSensorTransform(vec3 vec, quat rot) {
+void TrackingDevice::setSensorTransform(vec3 vec, quat rot, double time) {
 #ifdef SGCT_HAS_VRPN
     Tracker* parent = TrackingManager::instance().trackers()[_parentIndex].get();
 #else // ^^^^ SGCT_HAS_VRPN // !SGCT_HAS_VRPN vvvv
@@ -62,35 +80,28 @@ void TrackingDevice::setSensorTransform(vec3 vec, quat rot) {
 #endif
 
     if (parent == nullptr) {
-        Log::Error(std::format("Error getting handle to tracker for device '{}'", _name));
+        Log::Error("Error getting handle to tracker for device '{}'", _name);
         return;
     }
 
-    const glm::mat4 parentTrans = glm::make_mat4(parent->transform().values.data());
-
-    // create matrixes
-    const glm::mat4 sensorTransMat = glm::translate(
-        glm::mat4(1.f),
-        glm::make_vec3(&vec.x)
-    );
-    const glm::mat4 sensorRotMat = glm::mat4_cast(glm::make_quat(&rot.x));
+    const mat4 parentTrans = parent->transform();
 
     {
         const std::unique_lock lock(mutex::Tracking);
 
         // swap
         _sensorRotationPrevious = std::move(_sensorRotation);
-        _sensorRotation = std::move(rot);
+        _sensorRotation = rot;
 
         _sensorPosPrevious = std::move(_sensorPos);
-        _sensorPos = std::move(vec);
+        _sensorPos = vec;
 
         _worldTransformPrevious = std::move(_worldTransform);
-        const glm::mat4 m = parentTrans * sensorTransMat * sensorRotMat *
-                            glm::make_mat4(_deviceTransform.values.data());
-        std::memcpy(&_worldTransform, glm::value_ptr(m), 16 * sizeof(float));
+        _worldTransform = toWorldTransform(parentTrans, vec, rot, _deviceTransform);
+        _parentTransform = parentTrans;
     }
-    setTrackerTimeStamp();
+    _poseHistory.add({ .time = time, .position = vec, .rotation = rot });
+    setTrackerTimeStamp(time);
 }
 
 void TrackingDevice::setButtonValue(bool val, int index) {
@@ -245,6 +256,28 @@ mat4 TrackingDevice::worldTransformPrevious() const {
     return _worldTransformPrevious;
 }
 
+mat4 TrackingDevice::worldTransform(double time, PoseHistory::Prediction prediction,
+                                    double maxPrediction) const
+{
+    const std::optional<PoseHistory::Sample> pose =
+        _poseHistory.pose(time, prediction, maxPrediction);
+
+    const std::unique_lock lock(mutex::Tracking);
+    if (!pose) {
+        return _worldTransform;
+    }
+    return toWorldTransform(
+        _parentTransform,
+        pose->position,
+        pose->rotation,
+        _deviceTransform
+    );
+}
+
+const PoseHistory& TrackingDevice::poseHistory() const {
+    return _poseHistory;
+}
+
 quat TrackingDevice::sensorRotation() const {
     const std::unique_lock lock(mutex::Tracking);
     return _sensorRotation;
@@ -282,10 +315,10 @@ bool TrackingDevice::hasAnalogs() const {
     return _nAxes > 0;
 }
 
-void TrackingDevice::setTrackerTimeStamp() {
+void TrackingDevice::setTrackerTimeStamp(double timeStamp) {
     const std::unique_lock lock(mutex::Tracking);
     _trackerTimePrevious = _trackerTime;
-    _trackerTime = time();
+    _trackerTime = timeStamp;
 }
 
 void TrackingDevice::setAnalogTimeStamp() {
@@ -42,6 +42,34 @@ namespace {
     };
     std::vector<std::vector<VRPNPointer>> gTrackers;
 
+    // Samples that are older than this were either stamped by a clock that is not
+    // synchronized with ours or have been stuck in a queue for too long to be useful
+    constexpr double MaxSampleAge = 1.0;
+    // The clocks of the tracking server and this computer are never exactly in sync, so
+    // samples can appear to be slightly from the future
+    constexpr double MaxClockSkew = 0.01;
+
+    /**
+     * Converts the \p msgTime at which the VRPN server measured a sample into the time
+     * returned by sgct::time, based on how long ago the sample was measured. Falls back
+     * to the current time if the \p msgTime is not set or is implausible.
+     */
+    double sampleTime(const timeval& msgTime) {
+        const double now = sgct::time();
+        if (msgTime.tv_sec == 0 && msgTime.tv_usec == 0) {
+            return now;
+        }
+
+        timeval wallClock;
+        vrpn_gettimeofday(&wallClock, nullptr);
+        const double age = static_cast<double>(wallClock.tv_sec - msgTime.tv_sec) +
+            static_cast<double>(wallClock.tv_usec - msgTime.tv_usec) / 1e6;
+        if (age < -MaxClockSkew || age > MaxSampleAge) {
+            return now;
+        }
+        return now - std::max(age, 0.0);
+    }
+
     void VRPN_CALLBACK updateTracker(void* userdata, const vrpn_TRACKERCB t) {
         if (userdata == nullptr) {
             return;
@@ -65,7 +93,7 @@ namespace {
             static_cast<float>(t.quat[2]),
             static_cast<float>(t.quat[3])
         };
-        device->setSensorTransform(pos, rotation);
+        device->setSensorTransform(pos, rotation, sampleTime(t.msg_time));
     }
 
     void VRPN_CALLBACK updateButton(void* userdata, const vrpn_BUTTONCB b) {
@@ -220,22 +248,26 @@ void TrackingManager::startSampling() {
     }
 
     if (_head == nullptr && !trackerName.empty() && !deviceName.empty()) {
-        Log::Error(std::format(
+        Log::Error(
             "Failed to set head tracker to {}@{}", deviceName, trackerName
-        ));
+        );
         return;
     }
 
     _samplingThread = std::make_unique<std::thread>(samplingLoop, this);
 }
 
-void TrackingManager::updateTrackingDevices() {
+void TrackingManager::updateTrackingDevices(double displayTime) {
     ZoneScoped
 
     for (const std::unique_ptr<Tracker>& tracker : _trackers) {
         for (const std::unique_ptr<TrackingDevice>& device : tracker->devices()) {
             if (device->isEnabled() && device.get() == _head && _headUser) {
-                _headUser->setTransform(device->worldTransform());
+                const mat4 transform = device->worldTransform(
+                    displayTime + _headUser->headTrackerLatency(),
+                    _headUser->headTrackerPrediction()
+                );
+                _headUser->setTransform(transform);
             }
         }
     }
@@ -245,10 +277,10 @@ void TrackingManager::addTracker(std::string name) {
     if (!tracker(name)) {
         _trackers.push_back(std::make_unique<Tracker>(name));
         gTrackers.emplace_back(std::vector<VRPNPointer>());
-        Log::Info(std::format("Tracker '{}' added successfully", name));
+        Log::Info("Tracker '{}' added successfully", name);
     }
     else {
-        Log::Warning(std::format("Tracker '{}' already exists", name));
+        Log::Warning("Tracker '{}' already exists", name);
     }
 }
 
@@ -271,7 +303,7 @@ void TrackingManager::addSensorToCurrentDevice(std::string address, int id) {
         device->setSensorId(id);
 
         if (retVal.second && ptr.sensorDevice == nullptr) {
-            Log::Info(std::format("Connecting to sensor '{}'", address));
+            Log::Info("Connecting to sensor '{}'", address);
             ptr.sensorDevice = std::make_unique<vrpn_Tracker_Remote>(address.c_str());
             ptr.sensorDevice->register_change_handler(
                 _trackers.back().get(),
@@ -280,7 +312,7 @@ void TrackingManager::addSensorToCurrentDevice(std::string address, int id) {
         }
     }
     else {
-        Log::Error(std::format("Failed to connect to sensor '{}'", address));
+        Log::Error("Failed to connect to sensor '{}'", address);
     }
 }
 
@@ -293,15 +325,15 @@ void TrackingManager::addButtonsToCurrentDevice(std::string address, int nButton
     TrackingDevice* device = _trackers.back()->devices().back().get();
 
     if (ptr.buttonDevice == nullptr && device) {
-        Log::Info(std::format(
+        Log::Info(
             "Connecting to buttons '{}' on device {}", address, device->name()
-        ));
+        );
         ptr.buttonDevice = std::make_unique<vrpn_Button_Remote>(address.c_str());
         ptr.buttonDevice->register_change_handler(device, updateButton);
         device->setNumberOfButtons(nButtons);
     }
     else {
-        Log::Error(std::format("Failed to connect to buttons '{}'", address));
+        Log::Error("Failed to connect to buttons '{}'", address);
     }
 }
 
@@ -314,16 +346,16 @@ void TrackingManager::addAnalogsToCurrentDevice(std::string address, int nAxes)
     TrackingDevice* device = _trackers.back()->devices().back().get();
 
     if (ptr.analogDevice == nullptr && device) {
-        Log::Info(std::format(
+        Log::Info(
             "Connecting to analog '{}' on device {}", address, device->name()
-        ));
+        );
 
         ptr.analogDevice = std::make_unique<vrpn_Analog_Remote>(address.c_str());
         ptr.analogDevice->register_change_handler(device, updateAnalog);
         device->setNumberOfAxes(nAxes);
     }
     else {
-        Log::Error(std::format("Failed to connect to analogs '{}'", address));
+        Log::Error("Failed to connect to analogs '{}'", address);
     }
 }
 
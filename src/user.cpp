@@ -8,11 +8,27 @@
 
 #include <sgct/user.h>
 
+#include <sgct/config.h>
 #include <glm/glm.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/euler_angles.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <stdexcept>
+
+namespace {
+    sgct::PoseHistory::Prediction toPrediction(
+                                   sgct::config::User::Tracking::Prediction prediction)
+    {
+        using P = sgct::config::User::Tracking::Prediction;
+        switch (prediction) {
+            case P::None:         return sgct::PoseHistory::Prediction::None;
+            case P::Velocity:     return sgct::PoseHistory::Prediction::Velocity;
+            case P::Acceleration: return sgct::PoseHistory::Prediction::Acceleration;
+            default:              throw std::logic_error("Unhandled case label");
+        }
+    }
+} // namespace
 
 namespace sgct {
 
@@ -24,6 +40,13 @@ User::User(const config::User& user)
     , _headTrackerDeviceName(user.tracking ? user.tracking->device : std::string())
     , _headTrackerName(user.tracking ? user.tracking->tracker : std::string())
 {
+    if (user.tracking && user.tracking->prediction) {
+        _headTrackerPrediction = toPrediction(*user.tracking->prediction);
+    }
+    if (user.tracking && user.tracking->latency) {
+        _headTrackerLatency = *user.tracking->latency;
+    }
+
     updateEyeTransform();
     updateEyeSeparation();
 }
@@ -113,6 +136,14 @@ const std::string& User::headTrackerDeviceName() const {
     return _headTrackerDeviceName;
 }
 
+PoseHistory::Prediction User::headTrackerPrediction() const {
+    return _headTrackerPrediction;
+}
+
+double User::headTrackerLatency() const {
+    return _headTrackerLatency;
+}
+
 const std::string& User::name() const {
     return _name;
 }
@@ -51,13 +51,14 @@ Viewport::Viewport(const config::Viewport& viewport, const Window& parent)
         viewport.blackLevelMaskTexture.value_or(std::filesystem::path())
     )
     , _meshFilename(viewport.correctionMeshTexture.value_or(std::filesystem::path()))
+    , _meshTolerance(viewport.correctionMeshTolerance)
     , _isTracked(viewport.isTracked.value_or(false))
 {
     if (viewport.user) {
         User* user = ClusterManager::instance().user(*viewport.user);
         if (!user) {
             Log::Warning(
-                std::format("Could not find user with name '{}'", *viewport.user)
+                "Could not find user with name '{}'", *viewport.user
             );
         }
 
@@ -162,7 +163,8 @@ void Viewport::loadData() {
         _meshFilename,
         *this,
         hasBlendMaskTexture() || hasBlackLevelMaskTexture(),
-        _useTextureMappedProjection
+        _useTextureMappedProjection,
+        _meshTolerance
     );
 }
 
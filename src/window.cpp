@@ -209,16 +209,16 @@ void Window::initNvidiaSwapGroups() {
         if (res == GL_FALSE) {
             throw Err(3006, "Error requesting maximum number of swap groups");
         }
-        Log::Info(std::format(
+        Log::Info(
             "WGL_NV_swap_group extension is supported. Max number of groups: {}. "
             "Max number of barriers: {}", maxGroup, maxBarrier
-        ));
+        );
 
         if (maxGroup > 0) {
             _useSwapGroups = wglJoinSwapGroupNV(hDC, 1) == GL_TRUE;
-            Log::Info(std::format(
+            Log::Info(
                 "Joining swapgroup 1 [{}]", _useSwapGroups ? "ok" : "failed"
-            ));
+            );
         }
         else {
             Log::Error("No swap group found. This instance will not use swap groups");
@@ -508,7 +508,7 @@ void Window::openWindow(GLFWwindow* share, bool isLastWindow) {
 
     if (_stereoMode == StereoMode::Active) {
         glfwWindowHint(GLFW_STEREO, GLFW_TRUE);
-        Log::Info(std::format("Window {}: Enabling quadbuffered rendering", _id));
+        Log::Info("Window {}: Enabling quadbuffered rendering", _id);
     }
 
     GLFWmonitor* mon = nullptr;
@@ -523,10 +523,10 @@ void Window::openWindow(GLFWwindow* share, bool isLastWindow) {
         else {
             mon = glfwGetPrimaryMonitor();
             if (_monitorIndex >= count) {
-                Log::Info(std::format(
+                Log::Info(
                     "Window({}): Invalid monitor index ({}). Computer has {} monitors",
                     _id, _monitorIndex, count
-                ));
+                );
             }
         }
 
@@ -708,22 +708,22 @@ void Window::closeWindow() {
 
     makeSharedContextCurrent();
 
-    Log::Info(std::format("Deleting screen capture data for window {}", _id));
+    Log::Info("Deleting screen capture data for window {}", _id);
     _screenCaptureLeftOrMono = nullptr;
     _screenCaptureRight = nullptr;
 
     // delete FBO stuff
     if (_finalFBO) {
-        Log::Info(std::format("Releasing OpenGL buffers for window {}", _id));
+        Log::Info("Releasing OpenGL buffers for window {}", _id);
         _finalFBO = nullptr;
         destroyFBOs();
     }
 
-    Log::Info(std::format("Deleting VBOs for window {}", _id));
+    Log::Info("Deleting VBOs for window {}", _id);
     glDeleteBuffers(1, &_vbo);
     _vbo = 0;
 
-    Log::Info(std::format("Deleting VAOs for window {}", _id));
+    Log::Info("Deleting VAOs for window {}", _id);
     glDeleteVertexArrays(1, &_vao);
     _vao = 0;
 
@@ -736,6 +736,7 @@ void Window::closeWindow() {
 
     // Current handle must be set at the end to properly destroy the window
     makeOpenGLContextCurrent();
+    _gpuTimer.deleteQueries();
 
     _viewports.clear();
 
@@ -761,10 +762,10 @@ void Window::initialize() {
 
     _finalFBO->createFBO(_framebufferRes.x, _framebufferRes.y, _nAASamples);
 
-    Log::Debug(std::format(
+    Log::Debug(
         "Window {}: FBO initiated successfully. Number of samples: {}",
         _id, _finalFBO->isMultiSampled() ? _nAASamples : 1
-    ));
+    );
 
     const ivec2 res =
         Engine::instance().settings().captureBackBuffer ?
@@ -795,7 +796,7 @@ void Window::initialize() {
             );
         }
         if (!success) {
-            Log::Error(std::format("Error creating SPOUT handle for {}", _spoutName));
+            Log::Error("Error creating SPOUT handle for {}", _spoutName);
         }
     }
 #endif // SGCT_HAS_SPOUT
@@ -856,18 +857,18 @@ void Window::updateResolutions() {
         // adjusting only the horizontal (x) values
         for (const std::unique_ptr<Viewport>& vp : _viewports) {
             vp->updateFovToMatchAspectRatio(_aspectRatio, ratio);
-            Log::Debug(std::format(
+            Log::Debug(
                 "Update aspect ratio in viewport ({} -> {})", _aspectRatio, ratio
-            ));
+            );
         }
         _aspectRatio = ratio;
 
         // Redraw window
         glfwSetWindowSize(_windowHandle, _windowRes->x, _windowRes->y);
 
-        Log::Debug(std::format(
+        Log::Debug(
             "Resolution changed to {}x{} in window {}", _windowRes->x, _windowRes->y, _id
-        ));
+        );
         _pendingWindowRes = std::nullopt;
 
 #ifdef SGCT_HAS_NDI
@@ -894,10 +895,10 @@ void Window::updateResolutions() {
     if (_pendingFramebufferRes) {
         _framebufferRes = *_pendingFramebufferRes;
 
-        Log::Debug(std::format(
+        Log::Debug(
             "Framebuffer resolution changed to {}x{} for window {}",
             _framebufferRes.x, _framebufferRes.y, _id
-        ));
+        );
 
         _pendingFramebufferRes = std::nullopt;
     }
@@ -943,14 +944,23 @@ void Window::draw() {
         return;
     }
 
+    GpuTimer& gpuTimer = Engine::instance().gpuTimer();
+    const GpuTimer::Scope windowZone = GpuTimer::Scope(gpuTimer, "Window", _id);
+
     // Render Left/Mono non-linear projection viewports to cubemap
-    for (const std::unique_ptr<Viewport>& vp : viewports()) {
+    for (size_t i = 0; i < _viewports.size(); i++) {
         ZoneScopedN("Render viewport");
 
+        const std::unique_ptr<Viewport>& vp = _viewports[i];
         if (!vp->hasSubViewports()) {
             continue;
         }
 
+        const GpuTimer::Scope zone = GpuTimer::Scope(
+            gpuTimer,
+            "Cubemap of viewport",
+            static_cast<int>(i)
+        );
         NonLinearProjection* nonLinearProj = vp->nonLinearProjection();
         if (_stereoMode == Window::StereoMode::NoStereo) {
             // for mono viewports frustum mode can be selected by user or config
@@ -974,11 +984,17 @@ void Window::draw() {
     }
 
     // Render right non-linear projection viewports to cubemap
-    for (const std::unique_ptr<Viewport>& vp : viewports()) {
+    for (size_t i = 0; i < _viewports.size(); i++) {
         ZoneScopedN("Render Cubemap");
+        const std::unique_ptr<Viewport>& vp = _viewports[i];
         if (!vp->hasSubViewports()) {
             continue;
         }
+        const GpuTimer::Scope zone = GpuTimer::Scope(
+            gpuTimer,
+            "Cubemap of viewport",
+            static_cast<int>(i)
+        );
         NonLinearProjection* p = vp->nonLinearProjection();
         p->renderCubemap(FrustumMode::StereoRight);
     }
@@ -1004,6 +1020,13 @@ void Window::renderFBOTexture() {
 
     makeOpenGLContextCurrent();
 
+    // The queries of the timer belong to this window's context, so the frame is measured
+    // separately from the rendering in the shared context
+    if (Engine::instance().statisticsRenderer()) [[unlikely]] {
+        _gpuTimer.beginFrame();
+    }
+    _gpuTimer.begin("Warp and blend in window", _id);
+
     glDisable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
@@ -1020,6 +1043,7 @@ void Window::renderFBOTexture() {
     glViewport(0, 0, size.x, size.y);
     setAndClearBuffer(*this, BufferMode::BackBufferBlack, frustum);
 
+    _gpuTimer.begin("Warp");
     bool maskShaderSet = false;
     const std::vector<std::unique_ptr<Viewport>>& vps = _viewports;
     if (_stereoMode > Window::StereoMode::Active &&
@@ -1068,9 +1092,12 @@ void Window::renderFBOTexture() {
             std::for_each(vps.begin(), vps.end(), std::mem_fn(&Viewport::renderWarpMesh));
         }
     }
+    _gpuTimer.end();
 
     // render mask (mono)
     if (_hasAnyMasks) {
+        const GpuTimer::Scope zone = GpuTimer::Scope(_gpuTimer, "Blend masks");
+
         if (!maskShaderSet) {
             _fboQuad.bind();
 
@@ -1105,6 +1132,9 @@ void Window::renderFBOTexture() {
     ShaderProgram::unbind();
     glDisable(GL_BLEND);
 
+    _gpuTimer.end();
+    _gpuTimer.endFrame();
+
 #ifdef SGCT_HAS_SPOUT
     if (_spoutHandle) {
         // Share the window via Spout
@@ -1127,7 +1157,7 @@ void Window::renderFBOTexture() {
             _framebufferRes.y
         );
         if (!s) {
-            Log::Error(std::format("Error sending Spout texture for '{}'", _spoutName));
+            Log::Error("Error sending Spout texture for '{}'", _spoutName);
         }
     }
 #endif // SGCT_HAS_SPOUT
@@ -1214,6 +1244,14 @@ void Window::swapBuffers(bool takeScreenshot) {
         }
     }
 
+    // Save the screenshots of previous frames whose downloads have finished by now
+    if (_screenCaptureLeftOrMono) {
+        _screenCaptureLeftOrMono->update();
+    }
+    if (_screenCaptureRight) {
+        _screenCaptureRight->update();
+    }
+
     // swap
     _windowResChanged = false;
 
@@ -1304,6 +1342,10 @@ void Window::setFramebufferResolution(ivec2 resolution) {
     }
 }
 
+const GpuTimer& Window::gpuTimer() const {
+    return _gpuTimer;
+}
+
 ivec2 Window::framebufferResolution() const {
     return _framebufferRes;
 }
@@ -1398,7 +1440,7 @@ void Window::setHorizFieldOfView(float hFovDeg) {
     for (const std::unique_ptr<Viewport>& vp : _viewports) {
         vp->setHorizontalFieldOfView(hFovDeg);
     }
-    Log::Debug(std::format("HFOV changed to {} for window {}", hFovDeg, _id));
+    Log::Debug("HFOV changed to {} for window {}", hFovDeg, _id);
 }
 
 float Window::horizFieldOfViewDegrees() const {
@@ -1433,9 +1475,9 @@ void Window::createTextures() {
     GLint max = 0;
     glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max);
     if (_framebufferRes.x > max || _framebufferRes.y > max) {
-        Log::Error(std::format(
+        Log::Error(
             "Window {}: Requested framebuffer too big (Max: {})", _id, max
-        ));
+        );
         return;
     }
 
@@ -1458,7 +1500,7 @@ void Window::createTextures() {
         generateTexture(_frameBufferTextures.positions, TextureType::Position);
     }
 
-    Log::Debug(std::format("Targets initialized successfully for window {}", _id));
+    Log::Debug("Targets initialized successfully for window {}", _id);
 }
 
 void Window::generateTexture(unsigned int& id, Window::TextureType type) {
@@ -1498,7 +1540,7 @@ void Window::generateTexture(unsigned int& id, Window::TextureType type) {
         std::get<2>(formats),
         nullptr
     );
-    Log::Debug(std::format("{}x{} texture generated for window {}", res.x, res.y, id));
+    Log::Debug("{}x{} texture generated for window {}", res.x, res.y, id);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -1567,13 +1609,21 @@ void Window::renderViewports(FrustumMode frustum, Eye eye) const {
         );
     }
 
+    GpuTimer& gpuTimer = Engine::instance().gpuTimer();
     const Window::StereoMode sm = stereoMode();
     // render all viewports for selected eye
-    for (const std::unique_ptr<Viewport>& vp : viewports()) {
+    for (size_t i = 0; i < _viewports.size(); i++) {
+        const std::unique_ptr<Viewport>& vp = _viewports[i];
         if (!vp->isEnabled()) {
             continue;
         }
 
+        const GpuTimer::Scope zone = GpuTimer::Scope(
+            gpuTimer,
+            "Viewport",
+            static_cast<int>(i)
+        );
+
         // if passive stereo or mono
         if (sm == Window::StereoMode::NoStereo) {
             // @TODO (abock, 2019-12-04) Not sure about this one; the frustum is set in
@@ -1705,6 +1755,7 @@ void Window::renderViewports(FrustumMode frustum, Eye eye) const {
 
         if (_useFXAA) {
             assert(_fxaa);
+            const GpuTimer::Scope zone = GpuTimer::Scope(gpuTimer, "FXAA");
 
             glDrawBuffer(GL_COLOR_ATTACHMENT0);
             // bind target FBO
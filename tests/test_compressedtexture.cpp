@@ -0,0 +1,358 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/compressedtexture.h>
+#include <sgct/error.h>
+#include <sgct/image.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+using namespace sgct;
+
+namespace {
+    // A smooth gradient that BC1 can represent with little error
+    std::unique_ptr<Image> createImage(ivec2 size, int nChannels) {
+        auto image = std::make_unique<Image>();
+        image->setSize(size);
+        image->setChannels(nChannels);
+        image->setBytesPerChannel(1);
+        image->allocateOrResizeData();
+
+        for (int y = 0; y < size.y; y++) {
+            for (int x = 0; x < size.x; x++) {
+                unsigned char* p = image->data() + (y * size.x + x) * nChannels;
+                for (int c = 0; c < nChannels; c++) {
+                    p[c] = static_cast<unsigned char>((x * 4 + y * 2 + c * 40) % 256);
+                }
+            }
+        }
+        return image;
+    }
+
+    /// \return The RGB color of pixel \p i in the BC1 \p block
+    std::array<int, 3> decodeBC1(const unsigned char* block, int i) {
+        auto expand = [](uint16_t c) {
+            const int r = (c >> 11) & 0x1F;
+            const int g = (c >> 5) & 0x3F;
+            const int b = c & 0x1F;
+            return std::array<int, 3>{
+                r << 3 | r >> 2, g << 2 | g >> 4, b << 3 | b >> 2
+            };
+        };
+
+        uint16_t c0 = 0;
+        uint16_t c1 = 0;
+        uint32_t indices = 0;
+        std::memcpy(&c0, block, 2);
+        std::memcpy(&c1, block + 2, 2);
+        std::memcpy(&indices, block + 4, 4);
+        REQUIRE(c0 >= c1);
+
+        const std::array<int, 3> e0 = expand(c0);
+        const std::array<int, 3> e1 = expand(c1);
+        const int index = (indices >> (2 * i)) & 0x3;
+        std::array<int, 3> res;
+        for (int c = 0; c < 3; c++) {
+            switch (index) {
+                case 0: res[c] = e0[c]; break;
+                case 1: res[c] = e1[c]; break;
+                case 2: res[c] = (2 * e0[c] + e1[c]) / 3; break;
+                case 3: res[c] = (e0[c] + 2 * e1[c]) / 3; break;
+            }
+        }
+        return res;
+    }
+
+    void checkRoundTrip(const std::filesystem::path& path, CompressedTexture::Format f) {
+        std::unique_ptr<Image> image = createImage(ivec2{ 37, 21 }, 3);
+        CompressedTexture texture;
+        texture.compress(*image, f);
+        texture.save(path);
+
+        CompressedTexture loaded;
+        loaded.load(path);
+        std::filesystem::remove(path);
+
+        CHECK(loaded.format() == f);
+        CHECK(loaded.size().x == 37);
+        CHECK(loaded.size().y == 21);
+        REQUIRE(loaded.levels().size() == texture.levels().size());
+        REQUIRE(loaded.dataSize() == texture.dataSize());
+        CHECK(std::memcmp(loaded.data(), texture.data(), texture.dataSize()) == 0);
+    }
+
+    /// Saves the \p texture as a KTX2 file and changes its Vulkan format to \p vkFormat
+    /// and its orientation to \p orientation
+    void saveKtx2(const CompressedTexture& texture, const std::filesystem::path& path,
+                  uint32_t vkFormat, std::string_view orientation)
+    {
+        texture.save(path);
+
+        std::vector<unsigned char> data(std::filesystem::file_size(path));
+        FILE* file = fopen(path.string().c_str(), "rb");
+        REQUIRE(file != nullptr);
+        REQUIRE(fread(data.data(), 1, data.size(), file) == data.size());
+        fclose(file);
+
+        // The format follows the 12 bytes of the identifier
+        std::memcpy(data.data() + 12, &vkFormat, sizeof(uint32_t));
+        constexpr std::string_view Key = "KTXorientation";
+        auto it = std::search(data.begin(), data.end(), Key.begin(), Key.end());
+        REQUIRE(it != data.end());
+        REQUIRE(orientation.size() == 2);
+        std::copy(orientation.begin(), orientation.end(), it + Key.size() + 1);
+
+        file = fopen(path.string().c_str(), "wb");
+        REQUIRE(file != nullptr);
+        REQUIRE(fwrite(data.data(), 1, data.size(), file) == data.size());
+        fclose(file);
+    }
+
+    /**
+     * \return The values that determine pixel \p x, \p y of \p level in the \p texture,
+     *         which are the color for BC1 and the endpoints and index for BC4
+     */
+    std::array<int, 3> texel(const CompressedTexture& texture, size_t level, int x,
+                             int y)
+    {
+        const CompressedTexture::Level& l = texture.levels()[level];
+        const size_t blockIndex = static_cast<size_t>((y / 4) * ((l.size.x + 3) / 4)) +
+            static_cast<size_t>(x / 4);
+        const size_t blockSize = CompressedTexture::blockSize(texture.format());
+        const unsigned char* block = texture.data() + l.offset + blockIndex * blockSize;
+        const int i = (y % 4) * 4 + x % 4;
+        if (texture.format() == CompressedTexture::Format::BC1) {
+            return decodeBC1(block, i);
+        }
+
+        uint64_t indices = 0;
+        for (int j = 0; j < 6; j++) {
+            indices |= static_cast<uint64_t>(block[2 + j]) << (8 * j);
+        }
+        return { block[0], block[1], static_cast<int>((indices >> (3 * i)) & 0x7) };
+    }
+
+    void checkFlipped(const CompressedTexture& texture, const CompressedTexture& flipped)
+    {
+        REQUIRE(flipped.levels().size() == texture.levels().size());
+        for (size_t i = 0; i < texture.levels().size(); i++) {
+            const ivec2 size = texture.levels()[i].size;
+            for (int y = 0; y < size.y; y++) {
+                for (int x = 0; x < size.x; x++) {
+                    const int flippedY = size.y - y - 1;
+                    CHECK(texel(flipped, i, x, y) == texel(texture, i, x, flippedY));
+                }
+            }
+        }
+    }
+} // namespace
+
+TEST_CASE("CompressedTexture: Levels", "[compressedtexture]") {
+    CompressedTexture texture;
+    texture.compress(*createImage(ivec2{ 13, 5 }, 4), CompressedTexture::Format::BC1);
+
+    const std::vector<CompressedTexture::Level>& levels = texture.levels();
+    REQUIRE(levels.size() == 4);
+    CHECK(levels[0].size.x == 13);
+    CHECK(levels[0].size.y == 5);
+    CHECK(levels[0].nBytes == 4 * 2 * 8);
+    CHECK(levels[1].size.x == 6);
+    CHECK(levels[1].size.y == 2);
+    CHECK(levels[1].nBytes == 2 * 1 * 8);
+    CHECK(levels[2].size.x == 3);
+    CHECK(levels[2].size.y == 1);
+    CHECK(levels[3].size.x == 1);
+    CHECK(levels[3].size.y == 1);
+    CHECK(levels[3].offset + levels[3].nBytes == texture.dataSize());
+
+    CompressedTexture limited;
+    limited.compress(*createImage(ivec2{ 64, 64 }, 1), CompressedTexture::Format::BC4, 3);
+    CHECK(limited.levels().size() == 3);
+}
+
+TEST_CASE("CompressedTexture: BC1 Quality", "[compressedtexture]") {
+    std::unique_ptr<Image> image = createImage(ivec2{ 16, 16 }, 3);
+    CompressedTexture texture;
+    texture.compress(*image, CompressedTexture::Format::BC1, 1);
+
+    int maxError = 0;
+    for (int y = 0; y < 16; y++) {
+        for (int x = 0; x < 16; x++) {
+            const unsigned char* block = texture.data() + ((y / 4) * 4 + x / 4) * 8;
+            const std::array<int, 3> rgb = decodeBC1(block, (y % 4) * 4 + x % 4);
+            const unsigned char* bgr = image->data() + (y * 16 + x) * 3;
+            maxError = std::max(maxError, std::abs(rgb[0] - bgr[2]));
+            maxError = std::max(maxError, std::abs(rgb[1] - bgr[1]));
+            maxError = std::max(maxError, std::abs(rgb[2] - bgr[0]));
+        }
+    }
+    CHECK(maxError <= 12);
+}
+
+TEST_CASE("CompressedTexture: BC4 Constant", "[compressedtexture]") {
+    std::unique_ptr<Image> image = createImage(ivec2{ 8, 8 }, 1);
+    std::memset(image->data(), 77, 64);
+    CompressedTexture texture;
+    texture.compress(*image, CompressedTexture::Format::BC4, 1);
+
+    REQUIRE(texture.dataSize() == 4 * 8);
+    for (int i = 0; i < 4; i++) {
+        const unsigned char* block = texture.data() + i * 8;
+        CHECK(block[0] == 77);
+        CHECK(block[1] == 77);
+        for (int j = 2; j < 8; j++) {
+            CHECK(block[j] == 0);
+        }
+    }
+}
+
+TEST_CASE("CompressedTexture: KTX2", "[compressedtexture]") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test.ktx2";
+    checkRoundTrip(path, CompressedTexture::Format::BC1);
+    checkRoundTrip(path, CompressedTexture::Format::BC4);
+}
+
+TEST_CASE("CompressedTexture: DDS", "[compressedtexture]") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test.dds";
+    checkRoundTrip(path, CompressedTexture::Format::BC1);
+    checkRoundTrip(path, CompressedTexture::Format::BC4);
+}
+
+TEST_CASE("CompressedTexture: DDS Orientation", "[compressedtexture]") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test.dds";
+    const std::filesystem::path ktx2Path =
+        std::filesystem::temp_directory_path() / "sgct-test.ktx2";
+
+    CompressedTexture texture;
+    texture.compress(*createImage(ivec2{ 12, 8 }, 3), CompressedTexture::Format::BC1);
+    texture.save(path);
+
+    // A KTX2 file that claims to store its rows top to bottom is flipped while loading,
+    // which is what the DDS file has to contain
+    saveKtx2(texture, ktx2Path, 131, "rd");
+    CompressedTexture flipped;
+    flipped.load(ktx2Path);
+    std::filesystem::remove(ktx2Path);
+
+    std::vector<unsigned char> data(std::filesystem::file_size(path));
+    FILE* file = fopen(path.string().c_str(), "rb");
+    REQUIRE(file != nullptr);
+    REQUIRE(fread(data.data(), 1, data.size(), file) == data.size());
+    fclose(file);
+
+    // The DXT1 texture has no DX10 header after the 4 byte magic and the 124 byte header
+    constexpr size_t HeaderSize = 128;
+    REQUIRE(data.size() == HeaderSize + flipped.dataSize());
+    CHECK(std::memcmp(data.data() + HeaderSize, flipped.data(), flipped.dataSize()) == 0);
+
+    CompressedTexture loaded;
+    loaded.load(path);
+    std::filesystem::remove(path);
+    REQUIRE(loaded.dataSize() == texture.dataSize());
+    CHECK(std::memcmp(loaded.data(), texture.data(), texture.dataSize()) == 0);
+}
+
+TEST_CASE("CompressedTexture: KTX2 sRGB And Alpha", "[compressedtexture]") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test.ktx2";
+    CompressedTexture texture;
+    texture.compress(*createImage(ivec2{ 8, 8 }, 4), CompressedTexture::Format::BC1);
+    CHECK_FALSE(texture.isSrgb());
+    CHECK_FALSE(texture.hasAlpha());
+
+    // VK_FORMAT_BC1_RGBA_SRGB_BLOCK
+    saveKtx2(texture, path, 134, "ru");
+    CompressedTexture loaded;
+    loaded.load(path);
+    CHECK(loaded.isSrgb());
+    CHECK(loaded.hasAlpha());
+
+    // Saving keeps the format in both file types
+    loaded.save(path);
+    CompressedTexture reloaded;
+    reloaded.load(path);
+    CHECK(reloaded.isSrgb());
+    CHECK(reloaded.hasAlpha());
+
+    // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+    saveKtx2(texture, path, 132, "ru");
+    loaded.load(path);
+    std::filesystem::remove(path);
+    CHECK(loaded.isSrgb());
+    CHECK_FALSE(loaded.hasAlpha());
+
+    const std::filesystem::path ddsPath =
+        std::filesystem::temp_directory_path() / "sgct-test.dds";
+    loaded.save(ddsPath);
+    reloaded.load(ddsPath);
+    std::filesystem::remove(ddsPath);
+    CHECK(reloaded.format() == CompressedTexture::Format::BC1);
+    CHECK(reloaded.isSrgb());
+    REQUIRE(reloaded.dataSize() == texture.dataSize());
+    CHECK(std::memcmp(reloaded.data(), texture.data(), texture.dataSize()) == 0);
+}
+
+TEST_CASE("CompressedTexture: KTX2 Orientation", "[compressedtexture]") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test.ktx2";
+
+    // The levels are 12x8, 6x4, 3x2, and 1x1, which covers both flipping whole blocks
+    // and flipping only the rows inside a block that are part of the level
+    CompressedTexture bc1;
+    bc1.compress(*createImage(ivec2{ 12, 8 }, 3), CompressedTexture::Format::BC1);
+    saveKtx2(bc1, path, 131, "rd");
+    CompressedTexture loaded;
+    loaded.load(path);
+    checkFlipped(bc1, loaded);
+
+    CompressedTexture bc4;
+    bc4.compress(*createImage(ivec2{ 8, 8 }, 1), CompressedTexture::Format::BC4);
+    saveKtx2(bc4, path, 139, "rd");
+    loaded.load(path);
+    checkFlipped(bc4, loaded);
+
+    // Files that store the rows bottom to top are loaded as they are
+    saveKtx2(bc4, path, 139, "ru");
+    loaded.load(path);
+    std::filesystem::remove(path);
+    REQUIRE(loaded.dataSize() == bc4.dataSize());
+    CHECK(std::memcmp(loaded.data(), bc4.data(), bc4.dataSize()) == 0);
+}
+
+TEST_CASE("CompressedTexture: KTX2 Orientation Not Flippable", "[compressedtexture]") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test.ktx2";
+
+    // The rows of a 6 pixel high level would have to move between the blocks, so the
+    // texture is loaded as it is
+    CompressedTexture texture;
+    texture.compress(*createImage(ivec2{ 8, 6 }, 3), CompressedTexture::Format::BC1);
+    saveKtx2(texture, path, 131, "rd");
+    CompressedTexture loaded;
+    CHECK_NOTHROW(loaded.load(path));
+    REQUIRE(loaded.dataSize() == texture.dataSize());
+    CHECK(std::memcmp(loaded.data(), texture.data(), texture.dataSize()) == 0);
+
+    // Orientations other than right-down and right-up are not supported
+    saveKtx2(texture, path, 131, "lu");
+    CHECK_THROWS_AS(loaded.load(path), Error);
+    std::filesystem::remove(path);
+}
@@ -1492,6 +1492,27 @@ TEST_CASE("Load Example: Two Nodes", "[parse]") {
     CHECK(u.position->z == 4.f);
 }
 
+TEST_CASE("Load Example: Two Nodes Multicast", "[parse]") {
+    Cluster res = sgct::readConfig(
+        std::string(BASE_PATH) + "/config/two_nodes_multicast.json"
+    );
+
+    CHECK(res.masterAddress == "127.0.0.1");
+
+    REQUIRE(res.multicast.has_value());
+    CHECK(res.multicast->address == "239.255.42.99");
+    CHECK(res.multicast->port == 20410);
+    CHECK(!res.multicast->ttl.has_value());
+    REQUIRE(res.multicast->interfaceAddress.has_value());
+    CHECK(*res.multicast->interfaceAddress == "127.0.0.1");
+
+    REQUIRE(res.nodes.size() == 2);
+    CHECK(res.nodes[0].address == "127.0.0.1");
+    CHECK(res.nodes[0].port == 20401);
+    CHECK(res.nodes[1].address == "127.0.0.2");
+    CHECK(res.nodes[1].port == 20402);
+}
+
 TEST_CASE("Load Example: TextureMappedProjection", "[parse]") {
     Cluster res = sgct::readConfig(std::string(BASE_PATH) +
         "/config/single_texturemapped.json");
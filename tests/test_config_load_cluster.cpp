@@ -182,6 +182,70 @@ TEST_CASE("Load: Cluster/FirmSync", "[parse]") {
     }
 }
 
+TEST_CASE("Load: Cluster/Multicast", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "multicast": {
+    "address": "239.255.42.99",
+    "port": 20500
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .multicast = Cluster::Multicast {
+                .address = "239.255.42.99",
+                .port = 20500
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "multicast": {
+    "address": "239.255.42.99",
+    "port": 20500,
+    "ttl": 2,
+    "interface": "127.0.0.1"
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .multicast = Cluster::Multicast {
+                .address = "239.255.42.99",
+                .port = 20500,
+                .ttl = 2,
+                .interfaceAddress = "127.0.0.1"
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
 
 
 
@@ -383,6 +447,105 @@ TEST_CASE("Validate: Cluster/Settings/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
+TEST_CASE("Validate: Cluster/Multicast/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "multicast": "abc"
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Cluster/Multicast/Address/Missing", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "multicast": {
+    "port": 20500
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+    CHECK_THROWS_MATCHES(
+        readJsonConfig(Config),
+        std::runtime_error,
+        Catch::Matchers::Message(
+            "[ReadConfig] (6090): Missing field address in multicast"
+        )
+    );
+}
+
+TEST_CASE("Validate: Cluster/Multicast/Port/Missing", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "multicast": {
+    "address": "239.255.42.99"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+    CHECK_THROWS_MATCHES(
+        readJsonConfig(Config),
+        std::runtime_error,
+        Catch::Matchers::Message("[ReadConfig] (6091): Missing field port in multicast")
+    );
+}
+
+TEST_CASE("Validate: Cluster/Multicast/Port/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "multicast": {
+    "address": "239.255.42.99",
+    "port": 0
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Cluster/Multicast/TTL/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "multicast": {
+    "address": "239.255.42.99",
+    "port": 20500,
+    "ttl": 256
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Cluster/Multicast/Additional Property", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "multicast": {
+    "address": "239.255.42.99",
+    "port": 20500,
+    "abc": 1
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
 TEST_CASE("Validate: Cluster/Generator/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
@@ -207,6 +207,118 @@ TEST_CASE("Load: Settings/UsePositionTexture", "[parse]") {
     }
 }
 
+TEST_CASE("Load: Settings/UseMeshCache", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "meshcache": false
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .useMeshCache = false
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "meshcache": true
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .useMeshCache = true
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
+TEST_CASE("Load: Settings/PackCorrectionMeshes", "[parse]") {
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "packcorrectionmeshes": false
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .packCorrectionMeshes = false
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "packcorrectionmeshes": true
+  }
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .settings = Settings {
+                .packCorrectionMeshes = true
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
+}
+
 TEST_CASE("Load: Settings/BufferFloatPrecision", "[parse]") {
     {
         constexpr std::string_view String = R"(
@@ -418,6 +530,215 @@ TEST_CASE("Load: Settings/Display/RefreshRate", "[parse]") {
     }
 }
 
+TEST_CASE("Load: Settings/Compression/Minimal", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "compression": {}
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .compression = Settings::Compression()
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Compression/Level", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "compression": {
+      "level": 6
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .compression = Settings::Compression {
+                .level = 6
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Compression/Threshold", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "compression": {
+      "threshold": 65536
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .compression = Settings::Compression {
+                .threshold = 65536
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/DeltaEncoding/Minimal", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "deltaencoding": {}
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .deltaEncoding = Settings::DeltaEncoding()
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/DeltaEncoding/KeyframeInterval", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "deltaencoding": {
+      "keyframeinterval": 60
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .deltaEncoding = Settings::DeltaEncoding {
+                .keyframeInterval = 60
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Telemetry/Minimal", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "telemetry": {}
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .telemetry = Settings::Telemetry()
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
+TEST_CASE("Load: Settings/Telemetry/Full", "[parse]") {
+    constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "telemetry": {
+      "path": "frames.sgcttel",
+      "capacity": 3600,
+      "window": 30.5
+    }
+  }
+}
+)";
+
+    const Cluster Object = {
+        .success = true,
+        .masterAddress = "localhost",
+        .settings = Settings {
+            .telemetry = Settings::Telemetry {
+                .path = "frames.sgcttel",
+                .capacity = 3600,
+                .window = 30.5f
+            }
+        }
+    };
+
+    Cluster res = sgct::readJsonConfig(String);
+    CHECK(res == Object);
+
+    const std::string str = serializeConfig(Object);
+    const config::Cluster output = readJsonConfig(str);
+    CHECK(output == Object);
+}
+
 TEST_CASE("Load: Settings/Full", "[parse]") {
     constexpr std::string_view String = R"(
 {
@@ -427,10 +748,19 @@ TEST_CASE("Load: Settings/Full", "[parse]") {
     "depthbuffertexture": true,
     "normaltexture": true,
     "positiontexture": true,
+    "meshcache": false,
+    "packcorrectionmeshes": false,
     "precision": 16.0,
     "display": {
       "swapinterval": 2,
       "refreshrate": 3
+    },
+    "compression": {
+      "level": 4,
+      "threshold": 1024
+    },
+    "deltaencoding": {
+      "keyframeinterval": 30
     }
   }
 }
@@ -443,10 +773,19 @@ TEST_CASE("Load: Settings/Full", "[parse]") {
             .useDepthTexture = true,
             .useNormalTexture = true,
             .usePositionTexture = true,
+            .useMeshCache = false,
+            .packCorrectionMeshes = false,
             .bufferFloatPrecision = Settings::BufferFloatPrecision::Float16Bit,
             .display = Settings::Display {
                 .swapInterval = 2,
                 .refreshRate = 3
+            },
+            .compression = Settings::Compression {
+                .level = 4,
+                .threshold = 1024
+            },
+            .deltaEncoding = Settings::DeltaEncoding {
+                .keyframeInterval = 30
             }
         }
     };
@@ -505,6 +844,34 @@ TEST_CASE("Validate: Settings/UsePositionTexture/Wrong Type", "[validate]") {
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
 
+TEST_CASE("Validate: Settings/UseMeshCache/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "meshcache": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/PackCorrectionMeshes/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "packcorrectionmeshes": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
 TEST_CASE("Validate: Settings/BufferFloatPrecision/Wrong Type", "[validate]") {
     constexpr std::string_view Config = R"(
 {
@@ -644,3 +1011,143 @@ TEST_CASE("Validate: Settings/Display/RefreshRate/Illegal Value", "[validate]")
 
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
+
+TEST_CASE("Validate: Settings/Compression/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "compression": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Compression/Level/Illegal Value", "[validate]") {
+    {
+        constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "compression": {
+      "level": -1
+    }
+  }
+}
+)";
+
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
+
+    {
+        constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "compression": {
+      "level": 10
+    }
+  }
+}
+)";
+
+        CHECK_THROWS_AS(validate(Config), ParsingError);
+    }
+}
+
+TEST_CASE("Validate: Settings/Compression/Threshold/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "compression": {
+      "threshold": -1
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/DeltaEncoding/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "deltaencoding": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/DeltaEncoding/Interval/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "deltaencoding": {
+      "keyframeinterval": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Telemetry/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "telemetry": "abc"
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Telemetry/Capacity/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "telemetry": {
+      "capacity": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: Settings/Telemetry/Window/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "settings": {
+    "telemetry": {
+      "window": 0
+    }
+  }
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
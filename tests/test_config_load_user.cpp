@@ -435,6 +435,47 @@ TEST_CASE("Load: User/Tracking", "[parse]") {
         const config::Cluster output = readJsonConfig(str);
         CHECK(output == Object);
     }
+
+    {
+        constexpr std::string_view String = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "users": [
+    {
+      "tracking": {
+        "tracker": "mno",
+        "device": "pqr",
+        "prediction": "acceleration",
+        "latency": 0.025
+      }
+    }
+  ]
+}
+)";
+
+        const Cluster Object = {
+            .success = true,
+            .masterAddress = "localhost",
+            .users = {
+                User {
+                    .tracking = User::Tracking {
+                        .tracker = "mno",
+                        .device = "pqr",
+                        .prediction = User::Tracking::Prediction::Acceleration,
+                        .latency = 0.025f
+                    }
+                }
+            }
+        };
+
+        Cluster res = sgct::readJsonConfig(String);
+        CHECK(res == Object);
+
+        const std::string str = serializeConfig(Object);
+        const config::Cluster output = readJsonConfig(str);
+        CHECK(output == Object);
+    }
 }
 
 TEST_CASE("Load: User/Full", "[parse]") {
@@ -858,3 +899,63 @@ TEST_CASE("Validate: User/Tracking/Device/Wrong Type", "[validate]") {
 
     CHECK_THROWS_AS(validate(Config), ParsingError);
 }
+
+TEST_CASE("Validate: User/Tracking/Prediction/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "users": [
+    {
+      "tracking": {
+        "tracker": "abc",
+        "device": "def",
+        "prediction": "ghi"
+      }
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: User/Tracking/Latency/Wrong Type", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "users": [
+    {
+      "tracking": {
+        "tracker": "abc",
+        "device": "def",
+        "latency": "ghi"
+      }
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
+
+TEST_CASE("Validate: User/Tracking/Latency/Illegal Value", "[validate]") {
+    constexpr std::string_view Config = R"(
+{
+  "version": 1,
+  "masteraddress": "localhost",
+  "users": [
+    {
+      "tracking": {
+        "tracker": "abc",
+        "device": "def",
+        "latency": -1.0
+      }
+    }
+  ]
+}
+)";
+
+    CHECK_THROWS_AS(validate(Config), ParsingError);
+}
@@ -0,0 +1,176 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/error.h>
+#include <sgct/frametelemetry.h>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+
+using namespace sgct;
+
+namespace {
+    using Phase = FrameTelemetry::Phase;
+
+    // An arbitrary point in time that is not aligned to the slices of the window
+    constexpr double Start = 1.7e9 + 0.37;
+
+    FrameTelemetry::Sample createSample(uint64_t frame, double time, double frameTime) {
+        FrameTelemetry::Sample sample;
+        sample.frameNumber = frame;
+        sample.timestamp = time;
+        for (int p = 0; p < FrameTelemetry::NumberOfPhases; p++) {
+            sample.durations[p] = frameTime / (p + 2);
+        }
+        sample.durations[static_cast<int>(Phase::Frame)] = frameTime;
+        return sample;
+    }
+
+    bool isClose(double value, double expected) {
+        return std::abs(value - expected) <= expected / 32.0;
+    }
+
+    std::filesystem::path tempPath() {
+        return std::filesystem::temp_directory_path() / "sgct-test.sgcttel";
+    }
+} // namespace
+
+TEST_CASE("FrameTelemetry: Empty", "[telemetry]") {
+    const FrameTelemetry telemetry;
+    const FrameTelemetry::Percentiles p = telemetry.percentiles(Phase::Frame);
+    CHECK(p.nFrames == 0);
+    CHECK(p.p50 == 0.0);
+    CHECK(p.max == 0.0);
+}
+
+TEST_CASE("FrameTelemetry: Percentiles", "[telemetry]") {
+    FrameTelemetry telemetry;
+
+    // Frame times from 10 us to 100 ms in a shuffled order
+    constexpr int N = 10000;
+    for (int i = 0; i < N; i++) {
+        const int v = (i * 7919) % N + 1;
+        telemetry.add(createSample(i, Start + i * 0.001, v * 1e-5));
+    }
+
+    const FrameTelemetry::Percentiles p = telemetry.percentiles(Phase::Frame);
+    CHECK(p.nFrames == N);
+    CHECK(isClose(p.p50, 0.05));
+    CHECK(isClose(p.p95, 0.095));
+    CHECK(isClose(p.p99, 0.099));
+    CHECK(p.max == 0.1);
+
+    const FrameTelemetry::Percentiles draw = telemetry.percentiles(Phase::Draw);
+    CHECK(draw.nFrames == N);
+    CHECK(isClose(draw.p50, 0.05 / 5));
+    CHECK(draw.max == 0.1 / 5);
+}
+
+TEST_CASE("FrameTelemetry: Rolling Window", "[telemetry]") {
+    // The window of 10 s is split into slices of 1 s
+    FrameTelemetry telemetry(10.0);
+
+    // A single hitch, followed by regular frames
+    telemetry.add(createSample(0, Start, 0.5));
+    for (int i = 1; i <= 480; i++) {
+        telemetry.add(createSample(i, Start + i / 60.0, 1.0 / 60.0));
+    }
+
+    {
+        const FrameTelemetry::Percentiles p = telemetry.percentiles(Phase::Frame);
+        CHECK(p.nFrames == 481);
+        CHECK(p.max == 0.5);
+        CHECK(isClose(p.p99, 1.0 / 60.0));
+    }
+
+    // After more than the length of the window, the hitch is no longer included
+    // and only between 9 and 10 s worth of frames are kept
+    for (int i = 481; i <= 720; i++) {
+        telemetry.add(createSample(i, Start + i / 60.0, 1.0 / 60.0));
+    }
+    {
+        const FrameTelemetry::Percentiles p = telemetry.percentiles(Phase::Frame);
+        CHECK(p.nFrames >= 540);
+        CHECK(p.nFrames <= 600);
+        CHECK(p.max == 1.0 / 60.0);
+    }
+
+    // A gap longer than the window leaves only the newest sample
+    telemetry.add(createSample(721, Start + 100.0, 0.02));
+    {
+        const FrameTelemetry::Percentiles p = telemetry.percentiles(Phase::Frame);
+        CHECK(p.nFrames == 1);
+        CHECK(p.max == 0.02);
+        CHECK(isClose(p.p50, 0.02));
+    }
+}
+
+TEST_CASE("FrameTelemetry: Recording", "[telemetry]") {
+    const std::filesystem::path path = tempPath();
+    {
+        FrameTelemetry telemetry;
+        telemetry.startRecording(path, 1000, 3);
+        for (int i = 0; i < 250; i++) {
+            telemetry.add(createSample(i, Start + i * 0.01, 0.001 * (i % 20)));
+        }
+        CHECK(telemetry.nDroppedSamples() == 0);
+    }
+
+    const FrameTelemetry::Recording recording = FrameTelemetry::readRecording(path);
+    CHECK(recording.nodeIndex == 3);
+    REQUIRE(recording.samples.size() == 250);
+    for (size_t i = 0; i < recording.samples.size(); i++) {
+        const FrameTelemetry::Sample& s = recording.samples[i];
+        const FrameTelemetry::Sample expected =
+            createSample(i, Start + i * 0.01, 0.001 * (i % 20));
+        CHECK(s.frameNumber == i);
+        CHECK(s.timestamp == expected.timestamp);
+        for (int p = 0; p < FrameTelemetry::NumberOfPhases; p++) {
+            CHECK(s.durations[p] == static_cast<float>(expected.durations[p]));
+        }
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("FrameTelemetry: Recording Wraps Around", "[telemetry]") {
+    const std::filesystem::path path = tempPath();
+    {
+        FrameTelemetry telemetry;
+        telemetry.startRecording(path, 100, 0);
+        for (int i = 0; i < 250; i++) {
+            telemetry.add(createSample(i, Start + i * 0.01, 0.01));
+        }
+    }
+
+    // Only the newest samples are kept, in the order in which they were added
+    const FrameTelemetry::Recording recording = FrameTelemetry::readRecording(path);
+    REQUIRE(recording.samples.size() == 100);
+    for (size_t i = 0; i < recording.samples.size(); i++) {
+        CHECK(recording.samples[i].frameNumber == 150 + i);
+    }
+    CHECK(std::filesystem::file_size(path) < 100 * 64);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("FrameTelemetry: Read Invalid File", "[telemetry]") {
+    const std::filesystem::path path = tempPath();
+    {
+        FILE* file = fopen(path.string().c_str(), "wb");
+        REQUIRE(file != nullptr);
+        fputs("This is not a telemetry file, but it is long enough for a header", file);
+        fclose(file);
+    }
+    CHECK_THROWS_AS(FrameTelemetry::readRecording(path), Error);
+    std::filesystem::remove(path);
+
+    CHECK_THROWS_AS(FrameTelemetry::readRecording(path), Error);
+}
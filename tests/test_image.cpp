@@ -0,0 +1,302 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/image.h>
+#include <sgct/math.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace sgct;
+
+namespace {
+    void fillPattern(Image& image) {
+        const ivec2 size = image.size();
+        // Every byte of a 16 bit channel is filled with a different value
+        const int nValues = image.channels() * image.bytesPerChannel();
+        unsigned char* data = image.data();
+        for (int y = 0; y < size.y; y++) {
+            for (int x = 0; x < size.x; x++) {
+                for (int c = 0; c < nValues; c++) {
+                    // Mix of flat areas, gradients, and noise to exercise all filters
+                    const int value = (x / 16 + y / 16) % 2 == 0 ?
+                        (x * (c + 1) + y * 3) :
+                        ((x * 7919 + y * 104729 + c * 31) >> 3);
+                    data[(y * size.x + x) * nValues + c] =
+                        static_cast<unsigned char>(value);
+                }
+            }
+        }
+    }
+
+    void checkRoundTrip(ivec2 size, int nChannels, Image::Format format, int bpc = 1,
+                        int nThreads = 0)
+    {
+        Image image;
+        image.setSize(size);
+        image.setChannels(nChannels);
+        image.setBytesPerChannel(bpc);
+        image.allocateOrResizeData();
+        fillPattern(image);
+
+        const std::filesystem::path path =
+            std::filesystem::temp_directory_path() /
+            std::format(
+                "sgct-test-{}x{}-{}-{}.{}",
+                size.x, size.y, nChannels, bpc, Image::extension(format)
+            );
+        image.save(path, format, nThreads);
+
+        // 16 bit images are loaded with 8 bits per channel, which keeps the more
+        // significant byte of each channel
+        Image loaded;
+        loaded.load(path);
+        std::filesystem::remove(path);
+
+        REQUIRE(loaded.size().x == size.x);
+        REQUIRE(loaded.size().y == size.y);
+        REQUIRE(loaded.channels() == nChannels);
+        const size_t nValues = static_cast<size_t>(size.x) * size.y * nChannels;
+        if (bpc == 1) {
+            CHECK(std::memcmp(loaded.data(), image.data(), nValues) == 0);
+        }
+        else {
+            size_t nMismatches = 0;
+            for (size_t i = 0; i < nValues; i++) {
+                // The images are stored in little endian
+                if (loaded.data()[i] != image.data()[i * bpc + bpc - 1]) {
+                    nMismatches++;
+                }
+            }
+            CHECK(nMismatches == 0);
+        }
+    }
+
+    /// The result of decoding a QOI file with the reference decoder below
+    struct QoiImage {
+        ivec2 size = ivec2{ 0, 0 };
+        int nChannels = 0;
+
+        /// The pixels in RGBA order with the rows stored top to bottom
+        std::vector<std::array<unsigned char, 4>> pixels;
+
+        /// How often each chunk type appears in the file
+        int nRgb = 0;
+        int nRgba = 0;
+        int nIndex = 0;
+        int nDiff = 0;
+        int nLuma = 0;
+        int nRun = 0;
+        int longestRun = 0;
+    };
+
+    /// A straightforward decoder that follows https://qoiformat.org/qoi-specification.pdf
+    QoiImage decodeQoi(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        const std::vector<unsigned char> data = std::vector<unsigned char>(
+            std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>()
+        );
+        constexpr size_t HeaderSize = 14;
+        constexpr std::array<unsigned char, 8> EndMarker = { 0, 0, 0, 0, 0, 0, 0, 1 };
+        REQUIRE(data.size() >= HeaderSize + EndMarker.size());
+        REQUIRE(std::memcmp(data.data(), "qoif", 4) == 0);
+
+        auto read32 = [&data](size_t p) {
+            return static_cast<int>(
+                static_cast<uint32_t>(data[p]) << 24 |
+                static_cast<uint32_t>(data[p + 1]) << 16 |
+                static_cast<uint32_t>(data[p + 2]) << 8 |
+                static_cast<uint32_t>(data[p + 3])
+            );
+        };
+        QoiImage res;
+        res.size = ivec2{ read32(4), read32(8) };
+        res.nChannels = data[12];
+        CHECK(data[13] == 0);
+
+        const size_t nPixels = static_cast<size_t>(res.size.x) * res.size.y;
+        const size_t end = data.size() - EndMarker.size();
+        std::array<std::array<unsigned char, 4>, 64> index = {};
+        std::array<unsigned char, 4> px = { 0, 0, 0, 255 };
+        size_t p = HeaderSize;
+        while (res.pixels.size() < nPixels && p < end) {
+            const unsigned char tag = data[p++];
+            int run = 1;
+            if (tag == 0xFE) {
+                px = { data[p], data[p + 1], data[p + 2], px[3] };
+                p += 3;
+                res.nRgb++;
+            }
+            else if (tag == 0xFF) {
+                px = { data[p], data[p + 1], data[p + 2], data[p + 3] };
+                p += 4;
+                res.nRgba++;
+            }
+            else if ((tag >> 6) == 0) {
+                px = index[tag];
+                res.nIndex++;
+            }
+            else if ((tag >> 6) == 1) {
+                px[0] = static_cast<unsigned char>(px[0] + ((tag >> 4) & 0x03) - 2);
+                px[1] = static_cast<unsigned char>(px[1] + ((tag >> 2) & 0x03) - 2);
+                px[2] = static_cast<unsigned char>(px[2] + (tag & 0x03) - 2);
+                res.nDiff++;
+            }
+            else if ((tag >> 6) == 2) {
+                const int dg = (tag & 0x3F) - 32;
+                const unsigned char next = data[p++];
+                px[0] = static_cast<unsigned char>(px[0] + dg + (next >> 4) - 8);
+                px[1] = static_cast<unsigned char>(px[1] + dg);
+                px[2] = static_cast<unsigned char>(px[2] + dg + (next & 0x0F) - 8);
+                res.nLuma++;
+            }
+            else {
+                run = (tag & 0x3F) + 1;
+                res.nRun++;
+                res.longestRun = std::max(res.longestRun, run);
+            }
+
+            const int hash = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64;
+            index[hash] = px;
+            res.pixels.insert(res.pixels.end(), run, px);
+        }
+        CHECK(res.pixels.size() == nPixels);
+        CHECK(p == end);
+        CHECK(std::memcmp(data.data() + end, EndMarker.data(), EndMarker.size()) == 0);
+        return res;
+    }
+} // namespace
+
+TEST_CASE("Image: ParallelPng/Round Trip", "[image]") {
+    // Small enough for a single stripe
+    checkRoundTrip(ivec2{ 17, 5 }, 3, Image::Format::ParallelPng);
+    checkRoundTrip(ivec2{ 1, 1 }, 4, Image::Format::ParallelPng);
+
+    // Large enough for multiple stripes with a number of rows that is not divisible by
+    // the number of stripes
+    checkRoundTrip(ivec2{ 301, 1031 }, 3, Image::Format::ParallelPng);
+    checkRoundTrip(ivec2{ 256, 997 }, 4, Image::Format::ParallelPng);
+
+    // Limiting the number of threads results in fewer stripes
+    checkRoundTrip(ivec2{ 301, 1031 }, 3, Image::Format::ParallelPng, 1, 1);
+    checkRoundTrip(ivec2{ 256, 997 }, 4, Image::Format::ParallelPng, 1, 3);
+}
+
+TEST_CASE("Image: ParallelPng/16 Bit Round Trip", "[image]") {
+    for (int nChannels = 1; nChannels <= 4; nChannels++) {
+        checkRoundTrip(ivec2{ 17, 5 }, nChannels, Image::Format::ParallelPng, 2);
+        checkRoundTrip(ivec2{ 301, 1031 }, nChannels, Image::Format::ParallelPng, 2);
+    }
+}
+
+TEST_CASE("Image: Png/Round Trip", "[image]") {
+    checkRoundTrip(ivec2{ 301, 1031 }, 3, Image::Format::Png);
+    checkRoundTrip(ivec2{ 256, 997 }, 4, Image::Format::FastPng);
+}
+
+TEST_CASE("Image: Png/16 Bit Round Trip", "[image]") {
+    for (int nChannels = 1; nChannels <= 4; nChannels++) {
+        checkRoundTrip(ivec2{ 301, 1031 }, nChannels, Image::Format::Png, 2);
+    }
+}
+
+TEST_CASE("Image: Tga/Round Trip", "[image]") {
+    checkRoundTrip(ivec2{ 17, 5 }, 1, Image::Format::Tga);
+    checkRoundTrip(ivec2{ 301, 1031 }, 3, Image::Format::Tga);
+    checkRoundTrip(ivec2{ 256, 997 }, 4, Image::Format::Tga);
+}
+
+TEST_CASE("Image: Qoi/Reference Decoder", "[image]") {
+    for (const int nChannels : { 3, 4 }) {
+        // Every row, counted from the top, produces a different type of chunk
+        const ivec2 size = ivec2{ 150, 5 };
+        auto pixel = [nChannels](int x, int row) -> std::array<unsigned char, 4> {
+            auto v = [](int i) { return static_cast<unsigned char>(i); };
+            switch (row) {
+                // A single color that is longer than the longest run
+                case 0: return { 10, 20, 30, 255 };
+                // Small differences to the previous pixel
+                case 1: return { v(x), v(x + 1), v(x + 2), 255 };
+                // Larger differences that fit the luma chunk
+                case 2: return { v(x * 12), v(x * 10), v(x * 10), 255 };
+                // Two colors that are found in the index after their first appearance
+                case 3: return x % 2 == 0 ?
+                    std::array<unsigned char, 4>{ 200, 0, 100, 255 } :
+                    std::array<unsigned char, 4>{ 0, 200, 50, 255 };
+                // Unrelated colors and a changing alpha
+                default: return {
+                    v(x * 37), v(x * 59), v(x * 91), nChannels == 4 ? v(255 - x) : v(255)
+                };
+            }
+        };
+
+        Image image;
+        image.setSize(size);
+        image.setChannels(nChannels);
+        image.setBytesPerChannel(1);
+        image.allocateOrResizeData();
+        for (int row = 0; row < size.y; row++) {
+            // Our images are stored bottom to top in BGR(A) order
+            unsigned char* dst = image.data() +
+                static_cast<size_t>(size.y - 1 - row) * size.x * nChannels;
+            for (int x = 0; x < size.x; x++) {
+                const std::array<unsigned char, 4> px = pixel(x, row);
+                unsigned char* d = dst + static_cast<size_t>(x) * nChannels;
+                d[0] = px[2];
+                d[1] = px[1];
+                d[2] = px[0];
+                if (nChannels == 4) {
+                    d[3] = px[3];
+                }
+            }
+        }
+
+        const std::filesystem::path path =
+            std::filesystem::temp_directory_path() /
+            std::format("sgct-test-qoi-{}.qoi", nChannels);
+        image.save(path, Image::Format::Qoi);
+        const QoiImage qoi = decodeQoi(path);
+        std::filesystem::remove(path);
+
+        REQUIRE(qoi.size.x == size.x);
+        REQUIRE(qoi.size.y == size.y);
+        REQUIRE(qoi.nChannels == nChannels);
+        REQUIRE(qoi.pixels.size() == static_cast<size_t>(size.x) * size.y);
+        size_t nMismatches = 0;
+        for (int row = 0; row < size.y; row++) {
+            for (int x = 0; x < size.x; x++) {
+                if (qoi.pixels[static_cast<size_t>(row) * size.x + x] != pixel(x, row)) {
+                    nMismatches++;
+                }
+            }
+        }
+        CHECK(nMismatches == 0);
+
+        CHECK(qoi.nRgb > 0);
+        CHECK(qoi.nIndex > 0);
+        CHECK(qoi.nDiff > 0);
+        CHECK(qoi.nLuma > 0);
+        CHECK(qoi.nRun > 0);
+        CHECK(qoi.longestRun == 62);
+        if (nChannels == 4) {
+            CHECK(qoi.nRgba > 0);
+        }
+        else {
+            CHECK(qoi.nRgba == 0);
+        }
+    }
+}
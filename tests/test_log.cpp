@@ -0,0 +1,136 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/log.h>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace sgct;
+
+namespace {
+    struct Message {
+        Log::Level level;
+        std::string text;
+    };
+
+    // Collects all messages through the callback instead of writing them to the console
+    struct Capture {
+        Capture() {
+            Log::instance().setNotifyLevel(Log::Level::Debug);
+            Log::instance().setLogToConsole(false);
+            Log::instance().setShowLogLevel(false);
+            Log::instance().setLogCallback(
+                [this](Log::Level level, std::string_view message) {
+                    const std::unique_lock lock(mutex);
+                    messages.push_back({ level, std::string(message) });
+                }
+            );
+        }
+
+        ~Capture() {
+            Log::destroy();
+            Log::instance().setNotifyLevel(Log::Level::Info);
+        }
+
+        std::mutex mutex;
+        std::vector<Message> messages;
+    };
+} // namespace
+
+TEST_CASE("Log: Notify Level", "[log]") {
+    Capture capture;
+    Log::instance().setNotifyLevel(Log::Level::Warning);
+    CHECK_FALSE(Log::isEnabled(Log::Level::Debug));
+    CHECK_FALSE(Log::isEnabled(Log::Level::Info));
+    CHECK(Log::isEnabled(Log::Level::Warning));
+    CHECK(Log::isEnabled(Log::Level::Error));
+
+    Log::Debug("debug {}", 1);
+    Log::Info("info");
+    Log::Warning("warning {} {}", 2, "abc");
+    Log::Error("error");
+    Log::instance().flush();
+
+    REQUIRE(capture.messages.size() == 2);
+    CHECK(capture.messages[0].level == Log::Level::Warning);
+    CHECK(capture.messages[0].text == "warning 2 abc");
+    CHECK(capture.messages[1].level == Log::Level::Error);
+    CHECK(capture.messages[1].text == "error");
+}
+
+TEST_CASE("Log: Multiple Threads", "[log]") {
+    Capture capture;
+
+    constexpr int NumberOfThreads = 4;
+    constexpr int NumberOfMessages = 500;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NumberOfThreads; t++) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < NumberOfMessages; i++) {
+                Log::Info("{} {}", t, i);
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    Log::instance().flush();
+
+    // The messages of each thread arrive in the order in which they were logged
+    REQUIRE(capture.messages.size() == NumberOfThreads * NumberOfMessages);
+    std::vector<int> next(NumberOfThreads, 0);
+    for (const Message& m : capture.messages) {
+        const size_t space = m.text.find(' ');
+        REQUIRE(space != std::string::npos);
+        const int t = std::stoi(m.text.substr(0, space));
+        const int i = std::stoi(m.text.substr(space + 1));
+        REQUIRE(t >= 0);
+        REQUIRE(t < NumberOfThreads);
+        CHECK(i == next[t]);
+        next[t] = i + 1;
+    }
+    CHECK(Log::instance().nDroppedMessages() == 0);
+}
+
+TEST_CASE("Log: File Rotation", "[log]") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test.log";
+    auto backup = [&path](int i) {
+        std::filesystem::path p = path;
+        p += std::format(".{}", i);
+        return p;
+    };
+    for (int i = 0; i <= 3; i++) {
+        std::filesystem::remove(i == 0 ? path : backup(i));
+    }
+
+    {
+        Capture capture;
+        Log::instance().setLogFile(path, 100, 2);
+        for (int i = 0; i < 20; i++) {
+            // Each message is 20 bytes, including the newline
+            Log::Info("Message number {:04}", i);
+            Log::instance().flush();
+        }
+        Log::instance().setLogFile("");
+    }
+
+    CHECK(std::filesystem::file_size(path) == 100);
+    CHECK(std::filesystem::file_size(backup(1)) == 100);
+    CHECK(std::filesystem::file_size(backup(2)) == 100);
+    CHECK_FALSE(std::filesystem::exists(backup(3)));
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(backup(1));
+    std::filesystem::remove(backup(2));
+}
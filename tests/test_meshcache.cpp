@@ -0,0 +1,144 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/correction/meshcache.h>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+
+using namespace sgct;
+using namespace sgct::correction;
+
+namespace {
+    std::filesystem::path writeMesh(const char* contents) {
+        const std::filesystem::path path =
+            std::filesystem::temp_directory_path() / "sgct-test-mesh.ol";
+        std::ofstream(path) << contents;
+        return path;
+    }
+
+    Buffer createBuffer() {
+        Buffer buffer;
+        buffer.geometryType = 0x0005;
+        for (int i = 0; i < 100; i++) {
+            const float f = static_cast<float>(i);
+            const float t = f / 100.f;
+            buffer.vertices.push_back({ f, -f, t, 1.f - t, 1.f, 0.5f, f, 1.f });
+            buffer.indices.push_back(99 - i);
+        }
+        return buffer;
+    }
+} // namespace
+
+TEST_CASE("MeshCache: Key", "[meshcache]") {
+    const std::filesystem::path path = writeMesh("ORIGINAL 4 2\nVERTICES\n0 0 0 0 0");
+    constexpr std::array<float, 2> Parameters = { 0.f, 1.f };
+    const std::optional<uint64_t> key = meshCacheKey(path, Parameters);
+    REQUIRE(key.has_value());
+    CHECK(meshCacheKey(path, Parameters) == key);
+
+    constexpr std::array<float, 2> Other = { 0.f, 0.5f };
+    CHECK(meshCacheKey(path, Other) != key);
+
+    writeMesh("ORIGINAL 4 2\nVERTICES\n0 0 0 0 1");
+    CHECK(meshCacheKey(path, Parameters) != key);
+
+    std::filesystem::remove(path);
+    CHECK_FALSE(meshCacheKey(path, Parameters).has_value());
+}
+
+TEST_CASE("MeshCache: Round Trip", "[meshcache]") {
+    Buffer buffer = createBuffer();
+    buffer.view.userPosition = vec3{ 1.f, 2.f, 3.f };
+    buffer.view.frustum = Buffer::View::Frustum{
+        .up = 40.f,
+        .down = -30.f,
+        .left = -50.f,
+        .right = 45.f,
+        .orientation = quat(0.f, 0.f, 0.f, 1.f)
+    };
+
+    const std::filesystem::path cachePath =
+        std::filesystem::temp_directory_path() / "sgct-test-mesh.sgctmesh";
+    saveMeshCache(cachePath, 1234, buffer);
+
+    CHECK(CachedMesh::open(cachePath, 4321) == nullptr);
+
+    {
+        const std::unique_ptr<CachedMesh> mesh = CachedMesh::open(cachePath, 1234);
+        REQUIRE(mesh != nullptr);
+        CHECK(mesh->geometryType() == 0x0005);
+        REQUIRE(mesh->vertices().size() == 100);
+        REQUIRE(mesh->indices().size() == 100);
+        for (size_t i = 0; i < 100; i++) {
+            CHECK(mesh->vertices()[i].x == buffer.vertices[i].x);
+            CHECK(mesh->vertices()[i].t == buffer.vertices[i].t);
+            CHECK(mesh->vertices()[i].b == buffer.vertices[i].b);
+            CHECK(mesh->indices()[i] == buffer.indices[i]);
+        }
+        REQUIRE(mesh->view().userPosition.has_value());
+        CHECK(mesh->view().userPosition->z == 3.f);
+        REQUIRE(mesh->view().frustum.has_value());
+        CHECK(mesh->view().frustum->left == -50.f);
+        CHECK(mesh->view().frustum->orientation.w == 1.f);
+        CHECK_FALSE(mesh->view().planeOffset.has_value());
+    }
+
+    // A truncated file is rejected instead of reading past its end
+    std::filesystem::resize_file(cachePath, std::filesystem::file_size(cachePath) - 4);
+    CHECK(CachedMesh::open(cachePath, 1234) == nullptr);
+    std::filesystem::remove(cachePath);
+}
+
+TEST_CASE("MeshCache: Overflowing Counts", "[meshcache]") {
+    const std::filesystem::path cachePath =
+        std::filesystem::temp_directory_path() / "sgct-test-mesh.sgctmesh";
+
+    // The number of vertices and indices are stored at these offsets in the header
+    auto checkCount = [&](std::streamoff offset, uint64_t count) {
+        saveMeshCache(cachePath, 1234, createBuffer());
+        {
+            std::fstream file = std::fstream(
+                cachePath,
+                std::ios::in | std::ios::out | std::ios::binary
+            );
+            file.seekp(offset);
+            file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        }
+        CHECK(CachedMesh::open(cachePath, 1234) == nullptr);
+    };
+
+    // Counts that only match the size of the file after their number of bytes wraps
+    // around 64 bits
+    checkCount(24, (uint64_t(1) << 59) + 100);
+    checkCount(32, (uint64_t(1) << 62) + 100);
+    std::filesystem::remove(cachePath);
+}
+
+TEST_CASE("MeshCache: Directory", "[meshcache]") {
+    // The cache is never stored in the shared temporary directory
+    const std::filesystem::path directory = meshCacheDirectory();
+    if (!directory.empty()) {
+        CHECK(directory.parent_path() != std::filesystem::temp_directory_path());
+    }
+
+    const std::filesystem::path cacheDirectory =
+        std::filesystem::temp_directory_path() / "sgct-test-meshcache";
+    std::filesystem::remove_all(cacheDirectory);
+    saveMeshCache(cacheDirectory / "mesh.sgctmesh", 1234, createBuffer());
+    CHECK(CachedMesh::open(cacheDirectory / "mesh.sgctmesh", 1234) != nullptr);
+#ifndef WIN32
+    // Other users cannot place their own files in the directory
+    using std::filesystem::perms;
+    CHECK(std::filesystem::status(cacheDirectory).permissions() == perms::owner_all);
+#endif // WIN32
+    std::filesystem::remove_all(cacheDirectory);
+}
@@ -0,0 +1,345 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/correction/meshoptimizer.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <numbers>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace sgct;
+using namespace sgct::correction;
+
+namespace {
+    /// \return The triangles of a grid with \p size x \p size vertices in random order
+    std::vector<unsigned int> createGrid(unsigned int size) {
+        std::vector<std::array<unsigned int, 3>> triangles;
+        for (unsigned int y = 0; y < size - 1; y++) {
+            for (unsigned int x = 0; x < size - 1; x++) {
+                const unsigned int i0 = y * size + x;
+                triangles.push_back({ i0, i0 + 1, i0 + size + 1 });
+                triangles.push_back({ i0, i0 + size + 1, i0 + size });
+            }
+        }
+        std::shuffle(triangles.begin(), triangles.end(), std::mt19937(1234));
+
+        std::vector<unsigned int> res;
+        for (const std::array<unsigned int, 3>& t : triangles) {
+            res.insert(res.end(), t.begin(), t.end());
+        }
+        return res;
+    }
+
+    /// \return The triangles in \p ids rotated to start with their smallest index
+    std::vector<std::array<unsigned int, 3>> sortedTriangles(
+                                                     const std::vector<unsigned int>& ids)
+    {
+        std::vector<std::array<unsigned int, 3>> res;
+        for (size_t i = 0; i < ids.size(); i += 3) {
+            std::array<unsigned int, 3> t = { ids[i], ids[i + 1], ids[i + 2] };
+            std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+            res.push_back(t);
+        }
+        std::sort(res.begin(), res.end());
+        return res;
+    }
+
+    /// \return A vertex that covers the screen and is linear in \p s and \p t
+    Buffer::Vertex flatVertex(float s, float t) {
+        Buffer::Vertex v = { 2.f * s - 1.f, 1.f - 2.f * t, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f };
+        return v;
+    }
+
+    /// \return A grid of \p nColumns x \p nRows vertices created by \p vertex from the
+    ///         texture coordinates, which go from 0 to 1 across the grid
+    Buffer createGridBuffer(unsigned int nColumns, unsigned int nRows,
+                            const std::function<Buffer::Vertex(float, float)>& vertex)
+    {
+        Buffer buf;
+        for (unsigned int y = 0; y < nRows; y++) {
+            for (unsigned int x = 0; x < nColumns; x++) {
+                const float s = static_cast<float>(x) / static_cast<float>(nColumns - 1);
+                const float t = static_cast<float>(y) / static_cast<float>(nRows - 1);
+                Buffer::Vertex v = vertex(s, t);
+                v.s = s;
+                v.t = t;
+                buf.vertices.push_back(v);
+            }
+        }
+        for (unsigned int y = 0; y < nRows - 1; y++) {
+            for (unsigned int x = 0; x < nColumns - 1; x++) {
+                const unsigned int i0 = y * nColumns + x;
+                const unsigned int i2 = i0 + nColumns + 1;
+                buf.indices.insert(buf.indices.end(), { i0, i0 + 1, i2 });
+                buf.indices.insert(buf.indices.end(), { i0, i2, i0 + nColumns });
+            }
+        }
+        buf.grid = Buffer::Grid{ nColumns, nRows };
+        return buf;
+    }
+
+    /// \return The area of the triangles in \p buf in texture coordinates. It is
+    ///         positive for counter-clockwise triangles
+    double textureArea(const Buffer& buf) {
+        double area = 0.0;
+        for (size_t i = 0; i < buf.indices.size(); i += 3) {
+            const Buffer::Vertex& a = buf.vertices[buf.indices[i]];
+            const Buffer::Vertex& b = buf.vertices[buf.indices[i + 1]];
+            const Buffer::Vertex& c = buf.vertices[buf.indices[i + 2]];
+            area += 0.5 * ((b.s - a.s) * (c.t - a.t) - (b.t - a.t) * (c.s - a.s));
+        }
+        return area;
+    }
+
+    /**
+     * \return `true` if every edge of the triangles in \p buf is shared with another
+     *         triangle in the opposite direction, unless it is on the border of the
+     *         texture. A T-junction or a crack leaves an edge without a partner
+     */
+    bool isWatertight(const Buffer& buf) {
+        std::map<std::pair<unsigned int, unsigned int>, int> edges;
+        for (size_t i = 0; i < buf.indices.size(); i += 3) {
+            for (size_t j = 0; j < 3; j++) {
+                const unsigned int a = buf.indices[i + j];
+                const unsigned int b = buf.indices[i + (j + 1) % 3];
+                edges[{ a, b }]++;
+            }
+        }
+        auto isBorder = [&buf](unsigned int a, unsigned int b) {
+            const Buffer::Vertex& va = buf.vertices[a];
+            const Buffer::Vertex& vb = buf.vertices[b];
+            return (va.s == vb.s && (va.s == 0.f || va.s == 1.f)) ||
+                (va.t == vb.t && (va.t == 0.f || va.t == 1.f));
+        };
+        for (const auto& [edge, count] : edges) {
+            const auto it = edges.find({ edge.second, edge.first });
+            const int opposite = it == edges.end() ? 0 : it->second;
+            if (count != 1 || (opposite != 1 && !isBorder(edge.first, edge.second))) {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace
+
+TEST_CASE("MeshOptimizer: Pack", "[meshoptimizer]") {
+    const std::array<Buffer::Vertex, 3> vertices = {
+        Buffer::Vertex{ -1.f, 1.f, 0.f, 1.f, 0.f, 1.f, 0.5f, 1.f },
+        Buffer::Vertex{ 0.25f, -0.5f, 0.3f, 0.7f, 0.2f, 0.4f, 0.6f, 0.8f },
+        Buffer::Vertex{ 0.f, 0.f, 0.5f, 0.5f, 1.f, 1.f, 1.f, 1.f }
+    };
+    const std::optional<std::vector<PackedVertex>> packed = packVertices(vertices);
+    REQUIRE(packed.has_value());
+    REQUIRE(packed->size() == 3);
+
+    CHECK((*packed)[0].x == -32767);
+    CHECK((*packed)[0].y == 32767);
+    CHECK((*packed)[0].s == 0);
+    CHECK((*packed)[0].t == 65535);
+    CHECK((*packed)[0].g == 255);
+    CHECK((*packed)[0].b == 128);
+
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const Buffer::Vertex& v = vertices[i];
+        const PackedVertex& p = (*packed)[i];
+        CHECK(std::abs(p.x / 32767.f - v.x) <= 0.5f / 32767.f);
+        CHECK(std::abs(p.y / 32767.f - v.y) <= 0.5f / 32767.f);
+        CHECK(std::abs(p.s / 65535.f - v.s) <= 0.5f / 65535.f);
+        CHECK(std::abs(p.t / 65535.f - v.t) <= 0.5f / 65535.f);
+        CHECK(std::abs(p.r / 255.f - v.r) <= 0.5f / 255.f);
+        CHECK(std::abs(p.a / 255.f - v.a) <= 0.5f / 255.f);
+    }
+
+    const std::array<Buffer::Vertex, 1> outside = {
+        Buffer::Vertex{ 1.5f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f }
+    };
+    CHECK_FALSE(packVertices(outside).has_value());
+}
+
+TEST_CASE("MeshOptimizer: Cache Miss Ratio", "[meshoptimizer]") {
+    const std::vector<unsigned int> separate = { 0, 1, 2, 3, 4, 5 };
+    CHECK(averageCacheMissRatio(separate) == 3.f);
+
+    const std::vector<unsigned int> shared = { 0, 1, 2, 2, 1, 3 };
+    CHECK(averageCacheMissRatio(shared) == 2.f);
+
+    // With a cache of 3 vertices, the vertex 0 has been evicted by the time it is used
+    // again in the third triangle
+    const std::vector<unsigned int> evicted = { 0, 1, 2, 3, 4, 5, 0, 4, 5 };
+    CHECK(averageCacheMissRatio(evicted, 3) == 7.f / 3.f);
+    CHECK(averageCacheMissRatio(evicted, 6) == 2.f);
+}
+
+TEST_CASE("MeshOptimizer: Vertex Cache", "[meshoptimizer]") {
+    constexpr unsigned int Size = 64;
+    std::vector<unsigned int> indices = createGrid(Size);
+    const std::vector<unsigned int> original = indices;
+    const float before = averageCacheMissRatio(indices);
+
+    optimizeVertexCache(indices, Size * Size);
+    const float after = averageCacheMissRatio(indices);
+
+    // The same triangles with the same winding order have to be drawn
+    REQUIRE(indices.size() == original.size());
+    CHECK(sortedTriangles(indices) == sortedTriangles(original));
+
+    // A randomly ordered grid fetches almost every vertex of each triangle, while a
+    // well ordered one is close to the optimum of 0.5
+    CHECK(before > 2.f);
+    CHECK(after < 0.8f);
+}
+
+TEST_CASE("MeshOptimizer: Vertex Cache Index Out Of Range", "[meshoptimizer]") {
+    std::vector<unsigned int> indices = createGrid(4);
+    const std::vector<unsigned int> original = indices;
+    CHECK_THROWS_AS(optimizeVertexCache(indices, 4 * 4 - 1), std::out_of_range);
+    CHECK(indices == original);
+}
+
+TEST_CASE("MeshOptimizer: Simplify Flat Grid", "[meshoptimizer]") {
+    // A grid whose values are linear can be replaced by the fan of the root block
+    Buffer buf = createGridBuffer(65, 65, flatVertex);
+    const SimplificationTolerance tolerance = {
+        .position = vec2{ 1e-5f, 1e-5f },
+        .textureCoordinate = vec2{ 1e-5f, 1e-5f },
+        .color = 1e-5f
+    };
+    const std::optional<SimplificationReport> report = simplifyGrid(buf, tolerance);
+    REQUIRE(report.has_value());
+    CHECK(report->nVerticesBefore == 65 * 65);
+    CHECK(report->nTrianglesBefore == 64 * 64 * 2);
+    CHECK(report->nVerticesAfter == 5);
+    CHECK(report->nTrianglesAfter == 4);
+    CHECK(report->nVerticesAfter == buf.vertices.size());
+    CHECK(report->nTrianglesAfter * 3 == buf.indices.size());
+    CHECK(report->positionError.x <= tolerance.position.x);
+    CHECK(report->colorError <= tolerance.color);
+
+    CHECK_FALSE(buf.grid.has_value());
+    CHECK(std::abs(textureArea(buf) - 1.0) < 1e-6);
+    CHECK(isWatertight(buf));
+
+    // Without a grid nothing is changed
+    CHECK_FALSE(simplifyGrid(buf, tolerance).has_value());
+    CHECK(buf.indices.size() == 12);
+}
+
+TEST_CASE("MeshOptimizer: Simplify Curved Grid", "[meshoptimizer]") {
+    // A dome-like distortion with a blend ramp on the left and right, which are the
+    // regions that have to keep more of their vertices
+    constexpr unsigned int NColumns = 400;
+    constexpr unsigned int NRows = 300;
+    auto vertex = [](float s, float t) {
+        const float bulge = 0.05f * std::sin(std::numbers::pi_v<float> * s) *
+            std::sin(std::numbers::pi_v<float> * t);
+        const float blend = std::clamp(std::min(s, 1.f - s) / 0.15f, 0.f, 1.f);
+        const float c = blend * blend * (3.f - 2.f * blend);
+        return Buffer::Vertex{
+            (2.f * s - 1.f) * (1.f - bulge), (1.f - 2.f * t) * (1.f - bulge),
+            0.f, 0.f, c, c, c, 1.f
+        };
+    };
+    Buffer buf = createGridBuffer(NColumns, NRows, vertex);
+    const Buffer original = buf;
+
+    // Half a pixel of a 1920x1080 projector and one step of an 8 bit color
+    const SimplificationTolerance tolerance = {
+        .position = vec2{ 1.f / 1920.f, 1.f / 1080.f },
+        .textureCoordinate = vec2{ 0.5f / 1920.f, 0.5f / 1080.f },
+        .color = 1.f / 255.f
+    };
+    const std::optional<SimplificationReport> report = simplifyGrid(buf, tolerance);
+    REQUIRE(report.has_value());
+    CHECK(report->nVerticesAfter * 10 < report->nVerticesBefore);
+    CHECK(report->nTrianglesAfter * 10 < report->nTrianglesBefore);
+    CHECK(report->positionError.x <= tolerance.position.x);
+    CHECK(report->positionError.y <= tolerance.position.y);
+    CHECK(report->colorError <= tolerance.color);
+    CHECK(std::abs(textureArea(buf) - 1.0) < 1e-5);
+    CHECK(isWatertight(buf));
+
+    // Every original vertex is checked against the triangle that contains its texture
+    // coordinate. They are exactly the grid positions, as the texture coordinates are
+    // linear in this mesh
+    size_t nChecked = 0;
+    bool isWithinTolerance = true;
+    for (size_t i = 0; i < buf.indices.size(); i += 3) {
+        std::array<vec2, 3> p;
+        std::array<const Buffer::Vertex*, 3> v;
+        for (size_t j = 0; j < 3; j++) {
+            v[j] = &buf.vertices[buf.indices[i + j]];
+            p[j] = vec2{ v[j]->s * (NColumns - 1), v[j]->t * (NRows - 1) };
+        }
+        const float d = (p[1].y - p[2].y) * (p[0].x - p[2].x) +
+            (p[2].x - p[1].x) * (p[0].y - p[2].y);
+        const float minX = std::min({ p[0].x, p[1].x, p[2].x });
+        const float maxX = std::max({ p[0].x, p[1].x, p[2].x });
+        const float minY = std::min({ p[0].y, p[1].y, p[2].y });
+        const float maxY = std::max({ p[0].y, p[1].y, p[2].y });
+        for (unsigned int y = 0; y < NRows; y++) {
+            if (y + 0.5f < minY || y - 0.5f > maxY) {
+                continue;
+            }
+            for (unsigned int x = 0; x < NColumns; x++) {
+                if (x + 0.5f < minX || x - 0.5f > maxX) {
+                    continue;
+                }
+                const float px = static_cast<float>(x);
+                const float py = static_cast<float>(y);
+                const float a = ((p[1].y - p[2].y) * (px - p[2].x) +
+                    (p[2].x - p[1].x) * (py - p[2].y)) / d;
+                const float b = ((p[2].y - p[0].y) * (px - p[2].x) +
+                    (p[0].x - p[2].x) * (py - p[2].y)) / d;
+                const float c = 1.f - a - b;
+                if (a < -1e-4f || b < -1e-4f || c < -1e-4f) {
+                    continue;
+                }
+                const Buffer::Vertex& o = original.vertices[y * NColumns + x];
+                const float ix = a * v[0]->x + b * v[1]->x + c * v[2]->x;
+                const float iy = a * v[0]->y + b * v[1]->y + c * v[2]->y;
+                const float ir = a * v[0]->r + b * v[1]->r + c * v[2]->r;
+                isWithinTolerance &= std::abs(ix - o.x) <= tolerance.position.x * 1.01f;
+                isWithinTolerance &= std::abs(iy - o.y) <= tolerance.position.y * 1.01f;
+                isWithinTolerance &= std::abs(ir - o.r) <= tolerance.color * 1.01f;
+                nChecked++;
+            }
+        }
+    }
+    CHECK(nChecked >= NColumns * NRows);
+    CHECK(isWithinTolerance);
+}
+
+TEST_CASE("MeshOptimizer: Simplify Grid With Hole", "[meshoptimizer]") {
+    // Cells that are not covered by two triangles are kept as they are, like the masked
+    // out regions of a SkySkan mesh
+    Buffer buf = createGridBuffer(33, 33, flatVertex);
+    // Remove the first triangle of the cell at 10, 20
+    const size_t cell = 20 * 32 + 10;
+    buf.indices.erase(
+        buf.indices.begin() + cell * 6,
+        buf.indices.begin() + cell * 6 + 3
+    );
+    const double area = textureArea(buf);
+
+    const SimplificationTolerance tolerance = {
+        .position = vec2{ 1e-5f, 1e-5f },
+        .textureCoordinate = vec2{ 1e-5f, 1e-5f },
+        .color = 1e-5f
+    };
+    const std::optional<SimplificationReport> report = simplifyGrid(buf, tolerance);
+    REQUIRE(report.has_value());
+    CHECK(report->nTrianglesAfter * 10 < report->nTrianglesBefore);
+    CHECK(std::abs(textureArea(buf) - area) < 1e-6);
+}
@@ -0,0 +1,246 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/multicast.h>
+#include <sgct/network.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef WIN32
+#include <winsock2.h>
+#endif // WIN32
+
+using namespace sgct;
+
+namespace {
+    // The datagrams are sent to the loopback interface, which never drops them unless
+    // nobody is listening
+    constexpr std::string_view Address = "127.0.0.1";
+    constexpr int Port = 27917;
+
+    /// Collects the results of MulticastReceiver::takeAsync in the order of their calls
+    struct Results {
+        void add(uint32_t sequence, std::vector<char>* message) {
+            {
+                const std::unique_lock lock(mutex);
+                order.push_back(sequence);
+                messages[sequence] =
+                    message ? std::optional(std::move(*message)) : std::nullopt;
+            }
+            cond.notify_all();
+        }
+
+        bool waitFor(size_t n) {
+            std::unique_lock lock(mutex);
+            return cond.wait_for(
+                lock,
+                std::chrono::seconds(5),
+                [this, n]() { return order.size() >= n; }
+            );
+        }
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::vector<uint32_t> order;
+        std::map<uint32_t, std::optional<std::vector<char>>> messages;
+    };
+
+    std::vector<char> createMessage(uint32_t seed, size_t size) {
+        std::vector<char> res(size);
+        for (size_t i = 0; i < size; i++) {
+            res[i] = static_cast<char>((i * 31 + seed * 7) & 0xFF);
+        }
+        return res;
+    }
+
+    uint32_t send(MulticastSender& sender, const std::vector<char>& message) {
+        const Network::Buffer buffer = {
+            message.data(),
+            static_cast<int>(message.size())
+        };
+        return sender.send(std::span(&buffer, 1));
+    }
+
+#ifdef WIN32
+    struct WinsockInit {
+        WinsockInit() {
+            WSADATA data;
+            WSAStartup(MAKEWORD(2, 2), &data);
+        }
+        ~WinsockInit() { WSACleanup(); }
+    };
+#endif // WIN32
+} // namespace
+
+TEST_CASE("Multicast: In Order", "[multicast]") {
+#ifdef WIN32
+    const WinsockInit winsock;
+#endif // WIN32
+    // Outlives the receiver, which might still call the callbacks until it is destroyed
+    Results results;
+    MulticastReceiver receiver(std::string(Address), Port, "");
+    MulticastSender sender(std::string(Address), Port, 1, "");
+
+    // Messages of a single datagram and ones that are split into many of them
+    const std::vector<size_t> sizes = { 1, 100, 1400, 10000, 100000 };
+    std::vector<std::vector<char>> messages;
+    std::vector<uint32_t> sequences;
+    for (size_t i = 0; i < sizes.size(); i++) {
+        messages.push_back(createMessage(static_cast<uint32_t>(i), sizes[i]));
+        sequences.push_back(send(sender, messages.back()));
+    }
+
+    for (const uint32_t sequence : sequences) {
+        receiver.takeAsync(
+            sequence,
+            std::chrono::milliseconds(2000),
+            [&results](uint32_t s, std::vector<char>* m) { results.add(s, m); }
+        );
+    }
+    REQUIRE(results.waitFor(sequences.size()));
+
+    const std::unique_lock lock(results.mutex);
+    CHECK(results.order == sequences);
+    for (size_t i = 0; i < sequences.size(); i++) {
+        REQUIRE(results.messages[sequences[i]].has_value());
+        CHECK(*results.messages[sequences[i]] == messages[i]);
+    }
+}
+
+TEST_CASE("Multicast: Requested Before Sent", "[multicast]") {
+#ifdef WIN32
+    const WinsockInit winsock;
+#endif // WIN32
+    Results results;
+    MulticastReceiver receiver(std::string(Address), Port, "");
+    MulticastSender sender(std::string(Address), Port, 1, "");
+
+    // The request does not wait for the message, which completes it once it arrives
+    receiver.takeAsync(
+        0,
+        std::chrono::milliseconds(2000),
+        [&results](uint32_t s, std::vector<char>* m) { results.add(s, m); }
+    );
+    const std::vector<char> message = createMessage(1, 5000);
+    REQUIRE(send(sender, message) == 0);
+
+    REQUIRE(results.waitFor(1));
+    const std::unique_lock lock(results.mutex);
+    REQUIRE(results.messages[0].has_value());
+    CHECK(*results.messages[0] == message);
+}
+
+TEST_CASE("Multicast: Dropped Message Is Repaired", "[multicast]") {
+#ifdef WIN32
+    const WinsockInit winsock;
+#endif // WIN32
+    Results results;
+    MulticastSender sender(std::string(Address), Port, 1, "");
+
+    // Nobody is listening yet, so the first message is lost
+    const std::vector<char> lost = createMessage(0, 3000);
+    REQUIRE(send(sender, lost) == 0);
+
+    MulticastReceiver receiver(std::string(Address), Port, "");
+    const std::vector<char> first = createMessage(1, 3000);
+    const std::vector<char> second = createMessage(2, 3000);
+    REQUIRE(send(sender, first) == 1);
+    REQUIRE(send(sender, second) == 2);
+
+    // The lost message times out while the following ones are delivered, and it can be
+    // sent again from the sender's history, which is what the connection's NACK does
+    for (uint32_t sequence = 0; sequence < 3; sequence++) {
+        receiver.takeAsync(
+            sequence,
+            std::chrono::milliseconds(sequence == 0 ? 50 : 2000),
+            [&results](uint32_t s, std::vector<char>* m) { results.add(s, m); }
+        );
+    }
+    REQUIRE(results.waitFor(3));
+
+    const std::unique_lock lock(results.mutex);
+    CHECK_FALSE(results.messages[0].has_value());
+    REQUIRE(results.messages[1].has_value());
+    CHECK(*results.messages[1] == first);
+    REQUIRE(results.messages[2].has_value());
+    CHECK(*results.messages[2] == second);
+
+    std::vector<char> repair;
+    REQUIRE(sender.message(0, repair));
+    CHECK(repair == lost);
+}
+
+TEST_CASE("Multicast: Cancel", "[multicast]") {
+#ifdef WIN32
+    const WinsockInit winsock;
+#endif // WIN32
+    Results results;
+    MulticastReceiver receiver(std::string(Address), Port, "");
+    MulticastSender sender(std::string(Address), Port, 1, "");
+
+    receiver.takeAsync(
+        0,
+        std::chrono::milliseconds(20),
+        [&results](uint32_t s, std::vector<char>* m) { results.add(s, m); }
+    );
+    receiver.cancel();
+
+    // Neither the timeout nor the message call the callback after it was cancelled
+    send(sender, createMessage(0, 100));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const std::unique_lock lock(results.mutex);
+    CHECK(results.order.empty());
+}
+
+TEST_CASE("Multicast: Cancel While Timing Out", "[multicast]") {
+#ifdef WIN32
+    const WinsockInit winsock;
+#endif // WIN32
+    MulticastReceiver receiver(std::string(Address), Port, "");
+
+    std::atomic_bool isCancelled = false;
+    std::atomic_bool isRunning = false;
+    std::atomic_int nLateCalls = 0;
+    for (uint32_t i = 0; i < 200; i++) {
+        isCancelled = false;
+        receiver.takeAsync(
+            i,
+            std::chrono::milliseconds(1),
+            [&](uint32_t, std::vector<char>*) {
+                if (isCancelled) {
+                    nLateCalls++;
+                }
+                isRunning = true;
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+                isRunning = false;
+            }
+        );
+
+        // Cancels before, while, and after the timeout calls the callback
+        std::this_thread::sleep_for(std::chrono::microseconds((i % 20) * 100));
+        receiver.cancel();
+        isCancelled = true;
+        if (isRunning) {
+            nLateCalls++;
+        }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(nLateCalls == 0);
+}
@@ -0,0 +1,616 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/clustermanager.h>
+#include <sgct/config.h>
+#include <sgct/error.h>
+#include <sgct/network.h>
+#include <sgct/networkreactor.h>
+#include <sgct/syncfanout.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef WIN32
+#include <winsock2.h>
+#else // ^^^^ WIN32 // !WIN32 vvvv
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <csignal>
+#include <pthread.h>
+#include <unistd.h>
+#endif // WIN32
+
+using namespace sgct;
+
+namespace {
+    std::vector<char> createData(size_t size, int seed) {
+        std::vector<char> res(size);
+        for (size_t i = 0; i < size; i++) {
+            res[i] = static_cast<char>((i * 7 + seed * 13) % 251);
+        }
+        return res;
+    }
+
+    std::vector<char> encode(const std::vector<char>& previous,
+                             const std::vector<char>& data)
+    {
+        std::vector<char> buffer;
+        const int size = Network::encodeDelta(
+            previous.data(),
+            static_cast<int>(previous.size()),
+            data.data(),
+            static_cast<int>(data.size()),
+            buffer
+        );
+        buffer.resize(size);
+        return buffer;
+    }
+
+    /// Encodes the delta from \p previous to \p data and checks that applying it to the
+    /// \p previous data results in the \p data
+    std::vector<char> checkRoundTrip(const std::vector<char>& previous,
+                                     const std::vector<char>& data)
+    {
+        const std::vector<char> delta = encode(previous, data);
+        REQUIRE_FALSE(delta.empty());
+        CHECK(delta.size() < data.size());
+
+        std::vector<char> res = previous;
+        Network::applyDelta(delta.data(), static_cast<int>(delta.size()), res);
+        CHECK(res == data);
+        return delta;
+    }
+
+    /// Polls the \p condition until it is fulfilled or a few seconds have passed
+    bool waitUntil(const std::function<bool()>& condition) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    }
+
+#ifdef WIN32
+    struct WinsockInit {
+        WinsockInit() {
+            WSADATA data;
+            WSAStartup(MAKEWORD(2, 2), &data);
+        }
+        ~WinsockInit() { WSACleanup(); }
+    };
+#endif // WIN32
+
+    /// One end of a loopback TCP connection that is read and written directly, so that
+    /// the bytes on the wire can be controlled and inspected
+    struct RawSocket {
+        explicit RawSocket(SGCT_SOCKET s) : socket(s) {}
+        RawSocket(const RawSocket&) = delete;
+        RawSocket& operator=(const RawSocket&) = delete;
+        ~RawSocket() {
+#ifdef WIN32
+            closesocket(socket);
+#else // ^^^^ WIN32 // !WIN32 vvvv
+            close(socket);
+#endif // WIN32
+        }
+
+        void send(const char* data, size_t length) const {
+            while (length > 0) {
+                const int chunk = static_cast<int>(std::min<size_t>(length, 65536));
+                const auto res = ::send(socket, data, chunk, 0);
+                REQUIRE(res > 0);
+                data += res;
+                length -= static_cast<size_t>(res);
+            }
+        }
+
+        std::vector<char> receive(size_t length) const {
+            std::vector<char> res(length);
+            size_t offset = 0;
+            while (offset < length) {
+                const size_t chunk = std::min<size_t>(length - offset, 65536);
+                const auto r =
+                    recv(socket, res.data() + offset, static_cast<int>(chunk), 0);
+                if (r <= 0) {
+                    res.resize(offset);
+                    break;
+                }
+                offset += static_cast<size_t>(r);
+            }
+            return res;
+        }
+
+        SGCT_SOCKET socket;
+    };
+
+    sockaddr_in loopbackAddress(int port) {
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons(static_cast<uint16_t>(port));
+        return address;
+    }
+
+    /// Listens for the connection of a client Network, which has to be created after this
+    SGCT_SOCKET listenOn(int port) {
+        const SGCT_SOCKET res = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        constexpr int TrueFlag = 1;
+        setsockopt(
+            res,
+            SOL_SOCKET,
+            SO_REUSEADDR,
+            reinterpret_cast<const char*>(&TrueFlag),
+            sizeof(TrueFlag)
+        );
+        const sockaddr_in address = loopbackAddress(port);
+        const sockaddr* a = reinterpret_cast<const sockaddr*>(&address);
+        REQUIRE(bind(res, a, sizeof(address)) == 0);
+        REQUIRE(listen(res, 1) == 0);
+        return res;
+    }
+
+    /// Connects to a server Network, which starts listening when it is created
+    SGCT_SOCKET connectTo(int port) {
+        const SGCT_SOCKET res = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        const sockaddr_in address = loopbackAddress(port);
+        const sockaddr* a = reinterpret_cast<const sockaddr*>(&address);
+        REQUIRE(connect(res, a, sizeof(address)) == 0);
+        return res;
+    }
+
+    /// \return The header of a message with the \p id and \p frame followed by the
+    ///         \p payload
+    std::vector<char> createMessage(char id, int32_t frame,
+                                    const std::vector<char>& payload)
+    {
+        const uint32_t size = static_cast<uint32_t>(payload.size());
+        std::vector<char> res(Network::HeaderSize, 0);
+        res[0] = id;
+        std::memcpy(res.data() + 1, &frame, sizeof(frame));
+        std::memcpy(res.data() + 5, &size, sizeof(size));
+        res.insert(res.end(), payload.begin(), payload.end());
+        return res;
+    }
+} // namespace
+
+TEST_CASE("Network: Delta Identical", "[network]") {
+    const std::vector<char> data = createData(1000, 0);
+
+    // Only the total length and the number of runs remain
+    const std::vector<char> delta = checkRoundTrip(data, data);
+    CHECK(delta.size() == 2 * sizeof(uint32_t));
+}
+
+TEST_CASE("Network: Delta Single Byte", "[network]") {
+    const std::vector<char> previous = createData(1000, 0);
+    for (const size_t i : { size_t(0), size_t(1), size_t(500), size_t(999) }) {
+        std::vector<char> data = previous;
+        data[i] = static_cast<char>(~data[i]);
+
+        // A single run with its offset, length, and the changed byte
+        const std::vector<char> delta = checkRoundTrip(previous, data);
+        CHECK(delta.size() == 4 * sizeof(uint32_t) + 1);
+    }
+}
+
+TEST_CASE("Network: Delta Separate Changes", "[network]") {
+    const std::vector<char> previous = createData(1000, 0);
+    std::vector<char> data = previous;
+    // Changes that are close together end up in the same run
+    for (const size_t i : { size_t(10), size_t(12), size_t(300), size_t(700) }) {
+        data[i] = static_cast<char>(~data[i]);
+    }
+    checkRoundTrip(previous, data);
+}
+
+TEST_CASE("Network: Delta Growth", "[network]") {
+    const std::vector<char> previous = createData(1000, 0);
+    std::vector<char> data = previous;
+    data[100] = static_cast<char>(~data[100]);
+    const std::vector<char> tail = createData(200, 1);
+    data.insert(data.end(), tail.begin(), tail.end());
+    checkRoundTrip(previous, data);
+
+    // Growing from nothing is the same as sending the data, which is never smaller
+    CHECK(encode(std::vector<char>(), data).empty());
+}
+
+TEST_CASE("Network: Delta Shrink", "[network]") {
+    const std::vector<char> previous = createData(1000, 0);
+
+    std::vector<char> data(previous.begin(), previous.begin() + 600);
+    checkRoundTrip(previous, data);
+
+    data[300] = static_cast<char>(~data[300]);
+    checkRoundTrip(previous, data);
+}
+
+TEST_CASE("Network: Delta Not Smaller", "[network]") {
+    const std::vector<char> previous = createData(1000, 0);
+    const std::vector<char> data = createData(1000, 1);
+    CHECK(encode(previous, data).empty());
+}
+
+TEST_CASE("Network: Delta Truncated", "[network]") {
+    const std::vector<char> previous = createData(1000, 0);
+    std::vector<char> data = previous;
+    for (const size_t i : { size_t(10), size_t(300), size_t(700) }) {
+        data[i] = static_cast<char>(~data[i]);
+    }
+    data.resize(1100, 'x');
+    const std::vector<char> delta = checkRoundTrip(previous, data);
+
+    // Cutting the delta off anywhere, including between two runs, is detected and leaves
+    // the data untouched
+    for (size_t length = 0; length < delta.size(); length++) {
+        std::vector<char> res = previous;
+        CHECK_THROWS_AS(
+            Network::applyDelta(delta.data(), static_cast<int>(length), res),
+            Error
+        );
+        CHECK(res == previous);
+    }
+}
+
+TEST_CASE("Network: Delta Corrupted", "[network]") {
+    const std::vector<char> previous = createData(1000, 0);
+    std::vector<char> data = previous;
+    data[500] = static_cast<char>(~data[500]);
+    const std::vector<char> delta = checkRoundTrip(previous, data);
+    REQUIRE(delta.size() == 4 * sizeof(uint32_t) + 1);
+
+    auto checkCorrupted = [&](size_t position, uint32_t value) {
+        std::vector<char> corrupted = delta;
+        std::memcpy(corrupted.data() + position, &value, sizeof(value));
+        const int length = static_cast<int>(corrupted.size());
+        std::vector<char> res = previous;
+        CHECK_THROWS_AS(Network::applyDelta(corrupted.data(), length, res), Error);
+        CHECK(res == previous);
+    };
+
+    // A total length that grows the data without a run that fills the new bytes
+    checkCorrupted(0, 2000);
+    // More runs than there are in the delta
+    checkCorrupted(4, 2);
+    // An offset past the end of the data
+    checkCorrupted(8, 1000);
+    // A run that is longer than the remaining delta
+    checkCorrupted(12, 2);
+
+    // Trailing bytes after the last run
+    std::vector<char> extended = delta;
+    extended.push_back('x');
+    std::vector<char> res = previous;
+    CHECK_THROWS_AS(
+        Network::applyDelta(extended.data(), static_cast<int>(extended.size()), res),
+        Error
+    );
+}
+
+TEST_CASE("Network: Unexpected Stream Chunk", "[network]") {
+#ifdef WIN32
+    const WinsockInit winsock;
+#endif // WIN32
+    constexpr int Port = 27918;
+    using Type = Network::ConnectionType;
+
+    std::atomic_int nConnections = 0;
+    std::mutex packageMutex;
+    std::vector<char> package;
+    Network server(Port, "", true, Type::DataTransfer);
+    server.setUpdateFunction([&nConnections](Network& connection) {
+        if (connection.isConnected()) {
+            nConnections++;
+        }
+        else {
+            // Restarts the connection, which is what the NetworkManager does
+            connection.startConnectionConditionVar().notify_all();
+        }
+    });
+    server.setPackageDecodeFunction([&](void* data, int length, int, int) {
+        const std::unique_lock lock(packageMutex);
+        const char* d = reinterpret_cast<const char*>(data);
+        package.assign(d, d + length);
+    });
+    server.initialize();
+
+    const std::vector<char> data = createData(1000, 0);
+    {
+        Network client(Port, "127.0.0.1", false, Type::DataTransfer);
+        client.initialize();
+        REQUIRE(waitUntil([&]() { return nConnections == 1 && client.isConnected(); }));
+
+        // A chunk of a stream that was never started closes the connection
+        client.sendStreamChunk(1, 0, data.data(), static_cast<int>(data.size()), 0);
+        CHECK(waitUntil([&]() { return !client.isConnected(); }));
+        client.initShutdown();
+        client.closeNetwork(false);
+    }
+
+    // The server accepts the next connection, which can transfer data again
+    Network client(Port, "127.0.0.1", false, Type::DataTransfer);
+    client.initialize();
+    REQUIRE(waitUntil([&]() { return nConnections == 2 && client.isConnected(); }));
+    client.sendStreamBegin(2, static_cast<int64_t>(data.size()));
+    client.sendStreamChunk(2, 0, data.data(), static_cast<int>(data.size()), 0);
+    CHECK(waitUntil([&]() {
+        const std::unique_lock lock(packageMutex);
+        return package == data;
+    }));
+
+    client.initShutdown();
+    server.initShutdown();
+    client.closeNetwork(false);
+    server.closeNetwork(false);
+}
+
+TEST_CASE("Network: Reactor Partial Messages", "[network]") {
+#ifdef WIN32
+    const WinsockInit winsock;
+#endif // WIN32
+    constexpr int Port = 27919;
+
+    NetworkReactor reactor;
+    std::mutex messagesMutex;
+    std::vector<std::vector<char>> messages;
+    Network server(Port, "", true, Network::ConnectionType::SyncConnection);
+    server.setReactor(&reactor);
+    server.setDecodeFunction([&](const char* data, int length) {
+        const std::unique_lock lock(messagesMutex);
+        messages.emplace_back(data, data + length);
+    });
+    server.initialize();
+
+    const RawSocket client(connectTo(Port));
+    REQUIRE(waitUntil([&]() { return server.isConnected(); }));
+
+    const std::vector<char> first = createData(100, 1);
+    const std::vector<char> second = createData(50, 2);
+    std::vector<char> stream = createMessage(Network::DataId, 1, first);
+    const std::vector<char> secondMessage = createMessage(Network::DataId, 2, second);
+    stream.insert(stream.end(), secondMessage.begin(), secondMessage.end());
+
+    // The first header arrives in two parts and the second part also carries the start
+    // of the first payload. The rest of it arrives together with the whole second message
+    const std::array<size_t, 3> ends = { 5, Network::HeaderSize + 30, stream.size() };
+    size_t begin = 0;
+    for (size_t end : ends) {
+        client.send(stream.data() + begin, end - begin);
+        begin = end;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        if (end < Network::HeaderSize + first.size()) {
+            const std::unique_lock lock(messagesMutex);
+            CHECK(messages.empty());
+        }
+    }
+
+    REQUIRE(waitUntil([&]() {
+        const std::unique_lock lock(messagesMutex);
+        return messages.size() == 2;
+    }));
+    CHECK(messages[0] == first);
+    CHECK(messages[1] == second);
+    CHECK(server.recvFrameCurrent() == 2);
+
+    server.initShutdown();
+    server.closeNetwork(false);
+}
+
+TEST_CASE("Network: Sync Fan Out", "[network]") {
+#ifdef WIN32
+    const WinsockInit winsock;
+#endif // WIN32
+    constexpr int BasePort = 27920;
+    constexpr int NumberOfClients = 4;
+    using Type = Network::ConnectionType;
+
+    // The clients are the receiving ends of the connections, which are read directly
+    std::vector<std::unique_ptr<RawSocket>> listeners;
+    std::vector<std::unique_ptr<Network>> connections;
+    std::vector<std::unique_ptr<RawSocket>> clients;
+    for (int i = 0; i < NumberOfClients; i++) {
+        const int port = BasePort + i;
+        listeners.push_back(std::make_unique<RawSocket>(listenOn(port)));
+        connections.push_back(
+            std::make_unique<Network>(port, "127.0.0.1", false, Type::SyncConnection)
+        );
+        const SGCT_SOCKET client = accept(listeners.back()->socket, nullptr, nullptr);
+        clients.push_back(std::make_unique<RawSocket>(client));
+    }
+    // A connection that was never established, so sending on it fails
+    Network failing(BasePort + NumberOfClients, "", true, Type::SyncConnection);
+
+    // The payload is larger than the socket buffers so that the sends overlap
+    const std::vector<char> payload = createData(4 * 1024 * 1024, 3);
+    const std::vector<char> message = createMessage(Network::DataId, 7, payload);
+
+    SyncFanOut fanOut(2);
+    std::vector<SyncFanOut::Job> jobs;
+    for (int i = 0; i < NumberOfClients; i++) {
+        if (i == NumberOfClients / 2) {
+            SyncFanOut::Job& job = jobs.emplace_back();
+            job.connection = &failing;
+            job.index = NumberOfClients;
+            std::memcpy(job.header.data(), message.data(), Network::HeaderSize);
+            job.payload = payload.data();
+            job.length = static_cast<int>(payload.size());
+        }
+
+        SyncFanOut::Job& job = jobs.emplace_back();
+        job.connection = connections[i].get();
+        job.index = i;
+        std::memcpy(job.header.data(), message.data(), Network::HeaderSize);
+        job.payload = payload.data();
+        job.length = static_cast<int>(payload.size());
+    }
+
+    std::vector<std::future<std::vector<char>>> received;
+    for (const std::unique_ptr<RawSocket>& client : clients) {
+        received.push_back(std::async(
+            std::launch::async,
+            [&client, &message]() { return client->receive(message.size()); }
+        ));
+    }
+    fanOut.run(jobs);
+
+    // Every client receives the same header and payload, even though one send failed
+    for (std::future<std::vector<char>>& r : received) {
+        CHECK(r.get() == message);
+    }
+    for (const SyncFanOut::Job& job : jobs) {
+        if (job.connection == &failing) {
+            REQUIRE(job.error);
+            CHECK_THROWS_AS(std::rethrow_exception(job.error), Error);
+        }
+        else {
+            CHECK_FALSE(job.error);
+        }
+    }
+
+    for (const std::unique_ptr<Network>& connection : connections) {
+        connection->initShutdown();
+    }
+    failing.initShutdown();
+}
+
+TEST_CASE("Network: Gathered Send", "[network]") {
+#ifdef WIN32
+    const WinsockInit winsock;
+#endif // WIN32
+    constexpr int Port = 27925;
+
+    const RawSocket listener(listenOn(Port));
+    Network connection(Port, "127.0.0.1", false, Network::ConnectionType::DataTransfer);
+    const RawSocket receiver(accept(listener.socket, nullptr, nullptr));
+
+    // The payload is larger than the socket buffers, so the send blocks until the
+    // receiver starts reading
+    const std::vector<char> payload = createData(16 * 1024 * 1024, 4);
+    const std::vector<char> message = createMessage(Network::DataId, 1, payload);
+
+#ifndef WIN32
+    // A signal that interrupts the blocked send makes it return after only a part of the
+    // data was written, and the rest has to continue exactly where it stopped
+    struct sigaction action = {};
+    action.sa_handler = [](int) {};
+    struct sigaction previous = {};
+    sigaction(SIGUSR1, &action, &previous);
+#endif // WIN32
+
+    std::exception_ptr error;
+    std::thread sender([&]() {
+        try {
+            connection.sendData(
+                message.data(),
+                Network::HeaderSize,
+                payload.data(),
+                static_cast<int>(payload.size())
+            );
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+    });
+#ifndef WIN32
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    pthread_kill(sender.native_handle(), SIGUSR1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+#endif // WIN32
+    CHECK(receiver.receive(message.size()) == message);
+    sender.join();
+    CHECK_FALSE(error);
+
+#ifndef WIN32
+    sigaction(SIGUSR1, &previous, nullptr);
+#endif // WIN32
+
+    // More parts than a single system call accepts are sent in several calls
+    std::vector<Network::Buffer> buffers;
+    size_t length = 0;
+    for (int i = 0; i < 3000; i++) {
+        const int size = i % 7 + 1;
+        buffers.push_back({ payload.data() + length, size });
+        length += size;
+    }
+    const std::vector<char> part(payload.begin(), payload.begin() + length);
+    const std::vector<char> partMessage = createMessage(Network::DataId, 2, part);
+    connection.sendData(partMessage.data(), Network::HeaderSize, buffers);
+    CHECK(receiver.receive(partMessage.size()) == partMessage);
+
+    connection.initShutdown();
+}
+
+TEST_CASE("Network: Wait For Update", "[network]") {
+#ifdef WIN32
+    const WinsockInit winsock;
+#endif // WIN32
+    constexpr int BasePort = 27926;
+    using Type = Network::ConnectionType;
+
+    // Without the firm frame lock, every sync message updates a client connection
+    struct ClusterInit {
+        ClusterInit() { ClusterManager::create(config::Cluster(), 0); }
+        ~ClusterInit() { ClusterManager::destroy(); }
+    };
+    const ClusterInit cluster;
+
+    const RawSocket listenerA(listenOn(BasePort));
+    const RawSocket listenerB(listenOn(BasePort + 1));
+    Network a(BasePort, "127.0.0.1", false, Type::SyncConnection);
+    Network b(BasePort + 1, "127.0.0.1", false, Type::SyncConnection);
+    const RawSocket serverA(accept(listenerA.socket, nullptr, nullptr));
+    const RawSocket serverB(accept(listenerB.socket, nullptr, nullptr));
+    a.setDecodeFunction([](const char*, int) {});
+    b.setDecodeFunction([](const char*, int) {});
+    a.initialize();
+    b.initialize();
+    REQUIRE(waitUntil([&]() { return a.isConnected() && b.isConnected(); }));
+
+    std::future<bool> waiter = std::async(
+        std::launch::async,
+        [&a]() {
+            return a.waitForUpdate(
+                std::chrono::steady_clock::now() + std::chrono::seconds(5)
+            );
+        }
+    );
+
+    // A message on the other connection does not wake up the waiting thread
+    const std::vector<char> message =
+        createMessage(Network::DataId, 1, createData(16, 5));
+    serverB.send(message.data(), message.size());
+    REQUIRE(waitUntil([&]() { return b.isUpdated(); }));
+    CHECK(waiter.wait_for(std::chrono::milliseconds(200)) == std::future_status::timeout);
+    CHECK_FALSE(a.isUpdated());
+
+    // A message on its own connection does, long before the deadline has passed
+    serverA.send(message.data(), message.size());
+    REQUIRE(waiter.wait_for(std::chrono::seconds(2)) == std::future_status::ready);
+    CHECK(waiter.get());
+
+    a.initShutdown();
+    b.initShutdown();
+    a.closeNetwork(false);
+    b.closeNetwork(false);
+}
@@ -0,0 +1,141 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/pixelops.h>
+#include <array>
+#include <vector>
+
+using namespace sgct;
+
+namespace {
+    // Sizes that exercise the vectorized loops as well as the scalar tails
+    constexpr std::array<size_t, 8> Sizes = { 0, 1, 5, 6, 10, 17, 64, 1027 };
+
+    std::vector<unsigned char> createData(size_t nBytes) {
+        std::vector<unsigned char> data(nBytes);
+        for (size_t i = 0; i < nBytes; i++) {
+            data[i] = static_cast<unsigned char>((i * 37 + 11) % 256);
+        }
+        return data;
+    }
+
+    std::vector<pixelops::InstructionSet> instructionSets() {
+        std::vector<pixelops::InstructionSet> res = { pixelops::InstructionSet::Scalar };
+        if (pixelops::supportedInstructionSet() >= pixelops::InstructionSet::SSSE3) {
+            res.push_back(pixelops::InstructionSet::SSSE3);
+        }
+        if (pixelops::supportedInstructionSet() >= pixelops::InstructionSet::AVX2) {
+            res.push_back(pixelops::InstructionSet::AVX2);
+        }
+        return res;
+    }
+} // namespace
+
+TEST_CASE("PixelOps: Swap Red Blue", "[pixelops]") {
+    for (pixelops::InstructionSet set : instructionSets()) {
+        pixelops::setInstructionSet(set);
+        for (int nChannels : { 3, 4 }) {
+            for (size_t nPixels : Sizes) {
+                const std::vector<unsigned char> src = createData(nPixels * nChannels);
+                std::vector<unsigned char> dst(src.size());
+                pixelops::swapRedBlue(src.data(), dst.data(), nPixels, nChannels);
+                for (size_t i = 0; i < nPixels; i++) {
+                    const size_t p = i * nChannels;
+                    REQUIRE(dst[p] == src[p + 2]);
+                    REQUIRE(dst[p + 1] == src[p + 1]);
+                    REQUIRE(dst[p + 2] == src[p]);
+                    if (nChannels == 4) {
+                        REQUIRE(dst[p + 3] == src[p + 3]);
+                    }
+                }
+
+                // Converting in place has to give the same result
+                std::vector<unsigned char> inPlace = src;
+                pixelops::swapRedBlue(inPlace.data(), inPlace.data(), nPixels, nChannels);
+                REQUIRE(inPlace == dst);
+            }
+        }
+    }
+    pixelops::setInstructionSet(pixelops::supportedInstructionSet());
+}
+
+TEST_CASE("PixelOps: Swap Bytes 16", "[pixelops]") {
+    for (pixelops::InstructionSet set : instructionSets()) {
+        pixelops::setInstructionSet(set);
+        for (size_t nValues : Sizes) {
+            const std::vector<unsigned char> src = createData(nValues * 2);
+            std::vector<unsigned char> dst(src.size());
+            pixelops::swapBytes16(src.data(), dst.data(), nValues);
+            for (size_t i = 0; i < nValues; i++) {
+                REQUIRE(dst[2 * i] == src[2 * i + 1]);
+                REQUIRE(dst[2 * i + 1] == src[2 * i]);
+            }
+
+            std::vector<unsigned char> inPlace = src;
+            pixelops::swapBytes16(inPlace.data(), inPlace.data(), nValues);
+            REQUIRE(inPlace == dst);
+        }
+    }
+    pixelops::setInstructionSet(pixelops::supportedInstructionSet());
+}
+
+TEST_CASE("PixelOps: Flip Vertically", "[pixelops]") {
+    for (size_t nRows : { 0, 1, 2, 7 }) {
+        constexpr size_t RowSize = 13;
+        const std::vector<unsigned char> src = createData(nRows * RowSize);
+        std::vector<unsigned char> data = src;
+        pixelops::flipVertically(data.data(), RowSize, nRows);
+        for (size_t y = 0; y < nRows; y++) {
+            for (size_t x = 0; x < RowSize; x++) {
+                REQUIRE(data[y * RowSize + x] == src[(nRows - 1 - y) * RowSize + x]);
+            }
+        }
+    }
+}
+
+TEST_CASE("PixelOps: Expand To Four Channels", "[pixelops]") {
+    for (pixelops::InstructionSet set : instructionSets()) {
+        pixelops::setInstructionSet(set);
+        for (size_t nPixels : Sizes) {
+            const std::vector<unsigned char> src = createData(nPixels * 3);
+            std::vector<unsigned char> dst(nPixels * 4);
+            pixelops::expandToFourChannels(src.data(), dst.data(), nPixels, 42);
+            for (size_t i = 0; i < nPixels; i++) {
+                REQUIRE(dst[4 * i] == src[3 * i]);
+                REQUIRE(dst[4 * i + 1] == src[3 * i + 1]);
+                REQUIRE(dst[4 * i + 2] == src[3 * i + 2]);
+                REQUIRE(dst[4 * i + 3] == 42);
+            }
+        }
+    }
+    pixelops::setInstructionSet(pixelops::supportedInstructionSet());
+}
+
+TEST_CASE("PixelOps: Remove Fourth Channel", "[pixelops]") {
+    for (pixelops::InstructionSet set : instructionSets()) {
+        pixelops::setInstructionSet(set);
+        for (size_t nPixels : Sizes) {
+            const std::vector<unsigned char> src = createData(nPixels * 4);
+            std::vector<unsigned char> dst(nPixels * 3);
+            pixelops::removeFourthChannel(src.data(), dst.data(), nPixels);
+            for (size_t i = 0; i < nPixels; i++) {
+                REQUIRE(dst[3 * i] == src[4 * i]);
+                REQUIRE(dst[3 * i + 1] == src[4 * i + 1]);
+                REQUIRE(dst[3 * i + 2] == src[4 * i + 2]);
+            }
+
+            std::vector<unsigned char> inPlace = src;
+            pixelops::removeFourthChannel(inPlace.data(), inPlace.data(), nPixels);
+            inPlace.resize(dst.size());
+            REQUIRE(inPlace == dst);
+        }
+    }
+    pixelops::setInstructionSet(pixelops::supportedInstructionSet());
+}
@@ -0,0 +1,186 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/posehistory.h>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+using namespace sgct;
+
+namespace {
+    using Prediction = PoseHistory::Prediction;
+
+    // The rate of a typical optical tracking system
+    constexpr double SampleRate = 240.0;
+
+    quat rotationZ(double angle) {
+        return quat(
+            0.f,
+            0.f,
+            static_cast<float>(std::sin(angle / 2.0)),
+            static_cast<float>(std::cos(angle / 2.0))
+        );
+    }
+
+    PoseHistory::Sample createSample(double time, vec3 position, quat rotation) {
+        PoseHistory::Sample s;
+        s.time = time;
+        s.position = position;
+        s.rotation = rotation;
+        return s;
+    }
+
+    bool isClose(vec3 a, vec3 b, float eps = 1e-4f) {
+        return std::abs(a.x - b.x) <= eps && std::abs(a.y - b.y) <= eps &&
+               std::abs(a.z - b.z) <= eps;
+    }
+
+    bool isClose(quat a, quat b, float eps = 1e-4f) {
+        // q and -q are the same rotation
+        const float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        return std::abs(std::abs(dot) - 1.f) <= eps;
+    }
+} // namespace
+
+TEST_CASE("PoseHistory: Empty", "[posehistory]") {
+    const PoseHistory history;
+    CHECK(history.nSamples() == 0);
+    CHECK_FALSE(history.pose(1.0).has_value());
+}
+
+TEST_CASE("PoseHistory: Interpolation", "[posehistory]") {
+    PoseHistory history;
+    history.add(createSample(1.0, vec3(0.f, 0.f, 0.f), rotationZ(0.0)));
+    history.add(createSample(2.0, vec3(2.f, 4.f, 0.f), rotationZ(1.0)));
+
+    const std::optional<PoseHistory::Sample> mid = history.pose(1.25);
+    REQUIRE(mid.has_value());
+    CHECK(mid->time == 1.25);
+    CHECK(isClose(mid->position, vec3(0.5f, 1.f, 0.f)));
+    CHECK(isClose(mid->rotation, rotationZ(0.25)));
+
+    const std::optional<PoseHistory::Sample> end = history.pose(2.0);
+    REQUIRE(end.has_value());
+    CHECK(isClose(end->position, vec3(2.f, 4.f, 0.f)));
+    CHECK(isClose(end->rotation, rotationZ(1.0)));
+
+    // Times before the first sample get the first sample
+    const std::optional<PoseHistory::Sample> before = history.pose(0.0);
+    REQUIRE(before.has_value());
+    CHECK(before->time == 1.0);
+    CHECK(isClose(before->position, vec3(0.f, 0.f, 0.f)));
+}
+
+TEST_CASE("PoseHistory: Constant Velocity", "[posehistory]") {
+    // Moving at 1 m/s along x and turning at 2 rad/s around z
+    PoseHistory history;
+    for (int i = 0; i < 100; i++) {
+        const double t = i / SampleRate;
+        const vec3 pos = vec3(static_cast<float>(t), 1.f, 0.f);
+        history.add(createSample(t, pos, rotationZ(2 * t)));
+    }
+    const double newest = 99 / SampleRate;
+
+    const std::optional<PoseHistory::Sample> p = history.pose(newest + 0.05);
+    REQUIRE(p.has_value());
+    CHECK(isClose(p->position, vec3(static_cast<float>(newest + 0.05), 1.f, 0.f)));
+    CHECK(isClose(p->rotation, rotationZ(2 * (newest + 0.05))));
+
+    // Without prediction the pose stays at the newest sample
+    const std::optional<PoseHistory::Sample> held =
+        history.pose(newest + 0.05, Prediction::None);
+    REQUIRE(held.has_value());
+    CHECK(held->time == newest);
+    CHECK(isClose(held->position, vec3(static_cast<float>(newest), 1.f, 0.f)));
+
+    // The prediction does not go further than the maximum
+    const std::optional<PoseHistory::Sample> clamped =
+        history.pose(newest + 1.0, Prediction::Velocity, 0.02);
+    REQUIRE(clamped.has_value());
+    CHECK(clamped->time == newest + 0.02);
+    CHECK(isClose(clamped->position, vec3(static_cast<float>(newest + 0.02), 1.f, 0.f)));
+}
+
+TEST_CASE("PoseHistory: Constant Acceleration", "[posehistory]") {
+    // Starting at rest and accelerating at 4 m/s^2 along y
+    auto position = [](double t) {
+        return vec3(0.f, static_cast<float>(2.0 * t * t), 0.f);
+    };
+
+    PoseHistory history;
+    for (int i = 0; i < 100; i++) {
+        const double t = i / SampleRate;
+        history.add(createSample(t, position(t), rotationZ(0.0)));
+    }
+    const double target = 99 / SampleRate + 0.04;
+
+    const std::optional<PoseHistory::Sample> acc =
+        history.pose(target, Prediction::Acceleration);
+    REQUIRE(acc.has_value());
+    CHECK(isClose(acc->position, position(target)));
+
+    // Assuming a constant velocity lags behind the accelerating sensor
+    const std::optional<PoseHistory::Sample> vel =
+        history.pose(target, Prediction::Velocity);
+    REQUIRE(vel.has_value());
+    CHECK(vel->position.y < position(target).y - 0.003f);
+}
+
+TEST_CASE("PoseHistory: Ring Buffer", "[posehistory]") {
+    PoseHistory history;
+    for (int i = 0; i < 200; i++) {
+        history.add(createSample(i, vec3(static_cast<float>(i), 0.f, 0.f), quat()));
+    }
+    CHECK(history.nSamples() == 200);
+
+    // Only the newest samples are kept
+    const std::optional<PoseHistory::Sample> oldest = history.pose(0.0);
+    REQUIRE(oldest.has_value());
+    CHECK(oldest->time == 200 - PoseHistory::Capacity);
+
+    // Samples that are not newer than the newest one are ignored
+    history.add(createSample(150.0, vec3(0.f, 0.f, 0.f), quat()));
+    history.add(createSample(199.0, vec3(0.f, 0.f, 0.f), quat()));
+    CHECK(history.nSamples() == 200);
+    const std::optional<PoseHistory::Sample> p = history.pose(150.5);
+    REQUIRE(p.has_value());
+    CHECK(isClose(p->position, vec3(150.5f, 0.f, 0.f)));
+}
+
+TEST_CASE("PoseHistory: Concurrent Access", "[posehistory]") {
+    // The position along x is always equal to the time, so every pose that is returned,
+    // whether interpolated or extrapolated, has to satisfy that as well
+    PoseHistory history;
+    std::atomic_bool isDone = false;
+    std::thread writer([&history, &isDone]() {
+        for (int i = 0; i < 20000; i++) {
+            const double t = i / SampleRate;
+            history.add(createSample(t, vec3(static_cast<float>(t), 0.f, 0.f), quat()));
+        }
+        isDone = true;
+    });
+
+    bool wasDone = false;
+    do {
+        wasDone = isDone;
+        const uint64_t n = history.nSamples();
+        if (n < 2) {
+            continue;
+        }
+        const double newest = (n - 1) / SampleRate;
+        for (double offset : { -0.1, -0.01, 0.0, 0.01 }) {
+            const std::optional<PoseHistory::Sample> p = history.pose(newest + offset);
+            REQUIRE(p.has_value());
+            REQUIRE(std::abs(p->position.x - p->time) < 1e-3);
+        }
+    } while (!wasDone);
+    writer.join();
+}
@@ -0,0 +1,171 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/error.h>
+#include <sgct/image.h>
+#include <sgct/math.h>
+#include <sgct/sequencefile.h>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#ifdef __linux__
+#include <csignal>
+#include <sys/resource.h>
+#endif // __linux__
+
+using namespace sgct;
+
+namespace {
+    std::unique_ptr<Image> createImage(ivec2 size, int nChannels, int seed) {
+        auto image = std::make_unique<Image>();
+        image->setSize(size);
+        image->setChannels(nChannels);
+        image->setBytesPerChannel(1);
+        image->allocateOrResizeData();
+
+        const size_t nBytes = static_cast<size_t>(size.x) * size.y * nChannels;
+        for (size_t i = 0; i < nBytes; i++) {
+            image->data()[i] = static_cast<unsigned char>((i / 7 + seed * 13) % 251);
+        }
+        return image;
+    }
+
+    bool isEqual(const Image& lhs, const Image& rhs) {
+        if (lhs.size().x != rhs.size().x || lhs.size().y != rhs.size().y ||
+            lhs.channels() != rhs.channels())
+        {
+            return false;
+        }
+        const size_t nBytes =
+            static_cast<size_t>(lhs.size().x) * lhs.size().y * lhs.channels();
+        return std::memcmp(lhs.data(), rhs.data(), nBytes) == 0;
+    }
+
+    void checkRoundTrip(SequenceWriter::Compression compression) {
+        const std::filesystem::path path =
+            std::filesystem::temp_directory_path() / "sgct-test.sgctseq";
+
+        // The frames are appended out of order and change size in the middle, as it
+        // happens when the window is resized
+        std::vector<std::unique_ptr<Image>> images;
+        images.push_back(createImage(ivec2{ 64, 32 }, 3, 2));
+        images.push_back(createImage(ivec2{ 64, 32 }, 3, 0));
+        images.push_back(createImage(ivec2{ 17, 9 }, 4, 1));
+        {
+            SequenceWriter writer(path, compression);
+            writer.append(12, *images[0]);
+            writer.append(10, *images[1]);
+            writer.append(11, *images[2]);
+        }
+
+        SequenceReader reader(path);
+        REQUIRE(reader.numberOfFrames() == 3);
+        CHECK(reader.frameNumber(0) == 10);
+        CHECK(reader.frameNumber(1) == 11);
+        CHECK(reader.frameNumber(2) == 12);
+
+        Image image;
+        reader.read(0, image);
+        CHECK(isEqual(image, *images[1]));
+        reader.read(1, image);
+        CHECK(isEqual(image, *images[2]));
+        reader.read(2, image);
+        CHECK(isEqual(image, *images[0]));
+
+        std::filesystem::remove(path);
+    }
+} // namespace
+
+TEST_CASE("SequenceFile: Raw", "[sequence]") {
+    checkRoundTrip(SequenceWriter::Compression::None);
+}
+
+TEST_CASE("SequenceFile: Deflate", "[sequence]") {
+    checkRoundTrip(SequenceWriter::Compression::Deflate);
+}
+
+TEST_CASE("SequenceFile: Missing Index", "[sequence]") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test-missing-index.sgctseq";
+
+    std::unique_ptr<Image> first = createImage(ivec2{ 32, 32 }, 3, 0);
+    std::unique_ptr<Image> second = createImage(ivec2{ 32, 32 }, 3, 1);
+    {
+        SequenceWriter writer(path, SequenceWriter::Compression::Deflate);
+        writer.append(0, *first);
+        writer.append(1, *second);
+    }
+
+    // Simulate a crash while the second frame was written by cutting off the index and
+    // the end of the second frame
+    const uintmax_t size = std::filesystem::file_size(path);
+    std::filesystem::resize_file(path, size - 2 * 16 - 24 - 10);
+
+    SequenceReader reader(path);
+    REQUIRE(reader.numberOfFrames() == 1);
+    CHECK(reader.frameNumber(0) == 0);
+    Image image;
+    reader.read(0, image);
+    CHECK(isEqual(image, *first));
+
+    std::filesystem::remove(path);
+}
+
+#ifdef __linux__
+TEST_CASE("SequenceFile: Failed Write Is Removed", "[sequence]") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test-failed-write.sgctseq";
+
+    // Limiting the file size makes the writes beyond it fail instead of raising a signal
+    // while the signal is ignored
+    rlimit limit;
+    REQUIRE(getrlimit(RLIMIT_FSIZE, &limit) == 0);
+    const rlimit previous = limit;
+    limit.rlim_cur = 1 << 20;
+    void (*handler)(int) = std::signal(SIGXFSZ, SIG_IGN);
+    REQUIRE(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+
+    std::unique_ptr<Image> first = createImage(ivec2{ 64, 64 }, 3, 0);
+    std::unique_ptr<Image> tooLarge = createImage(ivec2{ 1024, 1024 }, 3, 1);
+    std::unique_ptr<Image> third = createImage(ivec2{ 64, 64 }, 3, 2);
+    {
+        SequenceWriter writer(path, SequenceWriter::Compression::None);
+        writer.append(0, *first);
+        CHECK_THROWS_AS(writer.append(1, *tooLarge), Error);
+        writer.append(2, *third);
+    }
+    REQUIRE(setrlimit(RLIMIT_FSIZE, &previous) == 0);
+    std::signal(SIGXFSZ, handler);
+
+    // The part of the frame that was written has been replaced by the next frame
+    SequenceReader reader(path);
+    REQUIRE(reader.numberOfFrames() == 2);
+    CHECK(reader.frameNumber(0) == 0);
+    CHECK(reader.frameNumber(1) == 2);
+    Image image;
+    reader.read(0, image);
+    CHECK(isEqual(image, *first));
+    reader.read(1, image);
+    CHECK(isEqual(image, *third));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("SequenceFile: Failed Write Stops Writing", "[sequence]") {
+    // Every write to /dev/full fails and it cannot be truncated either
+    std::unique_ptr<Image> image = createImage(ivec2{ 1024, 1024 }, 3, 0);
+    std::unique_ptr<Image> small = createImage(ivec2{ 4, 4 }, 3, 1);
+    SequenceWriter writer("/dev/full", SequenceWriter::Compression::None);
+    CHECK_THROWS_AS(writer.append(0, *image), Error);
+    CHECK_THROWS_AS(writer.append(1, *small), Error);
+}
+#endif // __linux__
@@ -0,0 +1,182 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/correction/domeprojection.h>
+#include <sgct/correction/textparser.h>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace sgct;
+using namespace sgct::correction;
+
+TEST_CASE("TextParser: Lines", "[textparser]") {
+    std::string_view text = "first\r\nsecond\n\nlast";
+    CHECK(nextLine(text) == "first");
+    CHECK(nextLine(text) == "second");
+    CHECK(nextLine(text).empty());
+    CHECK(nextLine(text) == "last");
+    CHECK(text.empty());
+}
+
+TEST_CASE("TextParser: Numbers", "[textparser]") {
+    std::string_view text = "  1.5\t-2 +3e2 7;8 x";
+
+    float f = 0.f;
+    REQUIRE(parseNumber(text, f));
+    CHECK(f == 1.5f);
+    int i = 0;
+    REQUIRE(parseNumber(text, i));
+    CHECK(i == -2);
+    REQUIRE(parseNumber(text, f));
+    CHECK(f == 300.f);
+
+    unsigned int u = 0;
+    REQUIRE(parseNumber(text, u));
+    CHECK(u == 7);
+    CHECK_FALSE(parseCharacter(text, ','));
+    REQUIRE(parseCharacter(text, ';'));
+    REQUIRE(parseNumber(text, u));
+    CHECK(u == 8);
+
+    CHECK_FALSE(parseNumber(text, f));
+    CHECK(parseWord(text) == "x");
+    CHECK(text.empty());
+
+    CHECK(startsWithNumber(" -0.5 1"));
+    CHECK(startsWithNumber(".5"));
+    CHECK_FALSE(startsWithNumber("VERTICES 4"));
+    CHECK_FALSE(startsWithNumber("   "));
+}
+
+TEST_CASE("TextParser: Parallel", "[textparser]") {
+    // Large enough to be split into multiple chunks on any machine with more than one
+    // core
+    constexpr int NumberOfLines = 200000;
+    std::string text;
+    for (int i = 0; i < NumberOfLines; i++) {
+        text += std::to_string(i) + '\n';
+    }
+
+    const std::vector<std::vector<int>> chunks = parseInParallel(
+        text,
+        [](std::string_view chunk) {
+            std::vector<int> res;
+            while (!chunk.empty()) {
+                std::string_view line = nextLine(chunk);
+                // Catch2 assertions are not thread-safe, so failures are marked instead
+                int value = -1;
+                parseNumber(line, value);
+                res.push_back(value);
+            }
+            return res;
+        }
+    );
+
+    std::vector<int> values;
+    for (const std::vector<int>& chunk : chunks) {
+        values.insert(values.end(), chunk.begin(), chunk.end());
+    }
+    REQUIRE(values.size() == NumberOfLines);
+    bool isInOrder = true;
+    for (int i = 0; i < NumberOfLines; i++) {
+        isInOrder &= values[i] == i;
+    }
+    CHECK(isInOrder);
+
+    CHECK_THROWS_AS(
+        parseInParallel(
+            text,
+            [](std::string_view chunk) -> int {
+                if (chunk.find("123456\n") != std::string_view::npos) {
+                    throw std::runtime_error("Failed");
+                }
+                return 0;
+            }
+        ),
+        std::runtime_error
+    );
+
+    const std::vector<int> empty = parseInParallel(
+        std::string_view(),
+        [](std::string_view chunk) { return static_cast<int>(chunk.size()); }
+    );
+    REQUIRE(empty.size() == 1);
+    CHECK(empty[0] == 0);
+}
+
+TEST_CASE("TextParser: DomeProjection", "[textparser]") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test-mesh.csv";
+    std::ofstream(path) <<
+        "x;y;u;v;column;row\r\n"
+        "0;0;0;0;0;0\r\n"
+        "1;0;1;0;1;0\r\n"
+        "0;1;0;1;0;1\r\n"
+        "1;1;1;1;1;1\r\n";
+
+    const Buffer buf =
+        generateDomeProjectionMesh(path, vec2{ 0.f, 0.f }, vec2{ 1.f, 1.f });
+    std::filesystem::remove(path);
+
+    REQUIRE(buf.vertices.size() == 4);
+    CHECK(buf.vertices[0].x == -1.f);
+    CHECK(buf.vertices[0].y == 1.f);
+    CHECK(buf.vertices[1].x == 1.f);
+    CHECK(buf.vertices[3].s == 1.f);
+    CHECK(buf.vertices[3].t == 0.f);
+    CHECK(buf.vertices[2].a == 1.f);
+    // A grid of 2x2 vertices consists of a single quad
+    REQUIRE(buf.indices.size() == 6);
+    CHECK(std::ranges::all_of(
+        buf.indices,
+        [&buf](unsigned int i) { return i < buf.vertices.size(); }
+    ));
+    REQUIRE(buf.grid.has_value());
+    CHECK(buf.grid->nColumns == 2);
+    CHECK(buf.grid->nRows == 2);
+}
+
+TEST_CASE("TextParser: DomeProjection Non-Square", "[textparser]") {
+    // The vertices are placed by their column and row, not by the order of the lines
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test-mesh.csv";
+    std::ofstream(path) <<
+        "x;y;u;v;column;row\n"
+        "0;1;0;1;0;1\n"
+        "0;0;0;0;0;0\n"
+        "0.5;0;0.5;0;1;0\n"
+        "1;0;1;0;2;0\n"
+        "0.5;1;0.5;1;1;1\n"
+        "1;1;1;1;2;1\n";
+
+    const Buffer buf =
+        generateDomeProjectionMesh(path, vec2{ 0.f, 0.f }, vec2{ 1.f, 1.f });
+    std::filesystem::remove(path);
+
+    REQUIRE(buf.vertices.size() == 6);
+    CHECK(buf.vertices[0].x == -1.f);
+    CHECK(buf.vertices[1].x == 0.f);
+    CHECK(buf.vertices[2].x == 1.f);
+    CHECK(buf.vertices[3].y == -1.f);
+    CHECK(buf.vertices[3].x == -1.f);
+
+    // 3x2 vertices make up 2x1 quads with two triangles each
+    REQUIRE(buf.indices.size() == 2 * 1 * 6);
+    CHECK(std::ranges::all_of(
+        buf.indices,
+        [&buf](unsigned int i) { return i < buf.vertices.size(); }
+    ));
+    REQUIRE(buf.grid.has_value());
+    CHECK(buf.grid->nColumns == 3);
+    CHECK(buf.grid->nRows == 2);
+}
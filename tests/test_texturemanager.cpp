@@ -0,0 +1,90 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sgct/error.h>
+#include <sgct/image.h>
+#include <sgct/texturemanager.h>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <thread>
+
+using namespace sgct;
+
+// The textures only become available in TextureManager::update, which needs an OpenGL
+// context. These tests only cover the decoding, which happens before the upload
+
+namespace {
+    /// Polls the \p condition until it is fulfilled or a few seconds have passed
+    bool waitUntil(const std::function<bool()>& condition) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!condition()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        return true;
+    }
+} // namespace
+
+TEST_CASE("TextureManager: Async Decode Failure", "[texturemanager]") {
+    TextureManager& manager = TextureManager::instance();
+
+    std::future<unsigned int> future = manager.loadTextureAsync(
+        std::filesystem::temp_directory_path() / "sgct-test-does-not-exist.png"
+    );
+    REQUIRE(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+    CHECK_THROWS_AS(future.get(), Error);
+
+    // The failed texture is no longer pending and was never loaded
+    CHECK(waitUntil([&]() { return manager.statistics().nPending == 0; }));
+    const TextureManager::Statistics stats = manager.statistics();
+    CHECK(stats.bytesInFlight == 0);
+    CHECK(stats.nLoaded == 0);
+
+    TextureManager::destroy();
+}
+
+TEST_CASE("TextureManager: Async Decode Statistics", "[texturemanager]") {
+    const std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "sgct-test-texture.png";
+    Image image;
+    image.setSize(ivec2{ 16, 8 });
+    image.setChannels(3);
+    image.setBytesPerChannel(1);
+    image.allocateOrResizeData();
+    image.save(path);
+
+    TextureManager& manager = TextureManager::instance();
+    std::future<unsigned int> loaded = manager.loadTextureAsync(path);
+    std::future<unsigned int> failed = manager.loadTextureAsync(
+        std::filesystem::temp_directory_path() / "sgct-test-does-not-exist.png"
+    );
+    CHECK(manager.statistics().nPending <= 2);
+
+    // The decoded texture waits for its upload with the 3 channels expanded to 4, while
+    // the one that failed to decode is no longer counted
+    CHECK(waitUntil([&]() {
+        const TextureManager::Statistics stats = manager.statistics();
+        return stats.nPending == 1 && stats.bytesInFlight > 0;
+    }));
+    const TextureManager::Statistics stats = manager.statistics();
+    CHECK(stats.bytesInFlight == 16 * 8 * 4);
+    CHECK(stats.nLoaded == 0);
+    CHECK_THROWS_AS(failed.get(), Error);
+    CHECK(loaded.wait_for(std::chrono::milliseconds(0)) == std::future_status::timeout);
+
+    // Textures that are discarded before their upload break their promise
+    TextureManager::destroy();
+    CHECK_THROWS_AS(loaded.get(), std::future_error);
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,74 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/image.h>
+#include <sgct/sequencefile.h>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+// Extracts all frames of a sequence file, as it is written when the capture `sequence`
+// setting is used, into separate images. The images are named after the sequence file
+// and the frame number, for example `SGCT_win0_sequence_000123.png`
+
+namespace {
+    void printUsage() {
+        std::cout <<
+            "Usage: sequenceextractor <sequence file> [output folder] [format]\n"
+            "  output folder  The folder into which the images are written. Defaults to\n"
+            "                 the folder that contains the sequence file\n"
+            "  format         png, tga, qoi, or raw. Defaults to png\n";
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 4) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path input = argv[1];
+    const std::filesystem::path output = argc > 2 ? argv[2] : input.parent_path();
+    const std::string_view format = argc > 3 ? argv[3] : "png";
+    if (format != "png" && format != "tga" && format != "qoi" && format != "raw") {
+        std::cerr << std::format("Unknown format '{}'\n", format);
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    try {
+        if (!output.empty()) {
+            std::filesystem::create_directories(output);
+        }
+
+        sgct::SequenceReader reader(input);
+        std::cout << std::format(
+            "Extracting {} frames from {}\n", reader.numberOfFrames(), input.string()
+        );
+
+        sgct::Image image;
+        for (size_t i = 0; i < reader.numberOfFrames(); i++) {
+            reader.read(i, image);
+
+            const std::filesystem::path file = output / std::format(
+                "{}_{:06}.{}", input.stem().string(), reader.frameNumber(i), format
+            );
+            image.save(file);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,102 @@
+/*****************************************************************************************
+ * SGCT                                                                                  *
+ * Simple Graphics Cluster Toolkit                                                       *
+ *                                                                                       *
+ * Copyright (c) 2012-2025                                                               *
+ * For conditions of distribution and use, see copyright notice in LICENSE.md            *
+ ****************************************************************************************/
+
+#include <sgct/compressedtexture.h>
+#include <sgct/image.h>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+// Converts an image into a block-compressed texture with a precomputed mipmap chain that
+// the TextureManager uploads without any conversion. The output format is determined by
+// the suffix of the output file, `.ktx2` or `.dds`
+
+namespace {
+    void printUsage() {
+        std::cout <<
+            "Usage: textureconverter <input image> <output file> [format] [levels]\n"
+            "  output file  The .ktx2 or .dds file that is written\n"
+            "  format       bc1 for color images or bc4 for single channel images such\n"
+            "               as blend masks. Defaults to bc4 for images with a single\n"
+            "               channel and bc1 otherwise\n"
+            "  levels       The number of mipmap levels. Defaults to all levels\n";
+    }
+
+    double megabytes(size_t bytes) {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace sgct;
+
+    if (argc < 3 || argc > 5) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    const std::filesystem::path input = argv[1];
+    const std::filesystem::path output = argv[2];
+    if (!CompressedTexture::isCompressedFile(output)) {
+        std::cerr << std::format("Output file '{}' has to be .ktx2 or .dds\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        Image image;
+        image.load(input);
+
+        CompressedTexture::Format format =
+            image.channels() == 1 ?
+            CompressedTexture::Format::BC4 :
+            CompressedTexture::Format::BC1;
+        if (argc > 3) {
+            const std::string_view f = argv[3];
+            if (f == "bc1") {
+                format = CompressedTexture::Format::BC1;
+            }
+            else if (f == "bc4") {
+                format = CompressedTexture::Format::BC4;
+            }
+            else {
+                std::cerr << std::format("Unknown format '{}'\n", f);
+                printUsage();
+                return EXIT_FAILURE;
+            }
+        }
+        const int nLevels = argc > 4 ? std::stoi(argv[4]) : 0;
+
+        CompressedTexture texture;
+        texture.compress(image, format, nLevels);
+        texture.save(output);
+
+        // The same texture loaded from the image uses 4 bytes per pixel for color
+        // images, as RGB is padded on the GPU
+        const int nChannels = image.channels() == 3 ? 4 : image.channels();
+        size_t uncompressed = 0;
+        for (const CompressedTexture::Level& level : texture.levels()) {
+            uncompressed += static_cast<size_t>(level.size.x) * level.size.y * nChannels;
+        }
+        std::cout << std::format(
+            "{}: {}x{}, {}, {} levels, {:.2f} MB on the GPU instead of {:.2f} MB\n",
+            output.string(), texture.size().x, texture.size().y,
+            CompressedTexture::name(format), texture.levels().size(),
+            megabytes(texture.dataSize()), megabytes(uncompressed)
+        );
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}